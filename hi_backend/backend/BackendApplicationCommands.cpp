@@ -160,6 +160,7 @@ void BackendCommandTarget::getAllCommands(Array<CommandID>& commands)
 		MenuToolsRemoveAllSampleMaps,
 		MenuToolsUnloadAllAudioFiles,
 		MenuToolsRecordOneSecond,
+		MenuToolsShowUIFrameStatistics,
 		MenuToolsEnableDebugLogging,
 		MenuToolsImportArchivedSamples,
 		MenuToolsCreateRSAKeys,
@@ -552,6 +553,10 @@ void BackendCommandTarget::getCommandInfo(CommandID commandID, ApplicationComman
 		setCommandTarget(result, "Record one second audio file", true, false, 'X', false);
 		result.categoryName = "Tools";
 		break;
+	case MenuToolsShowUIFrameStatistics:
+		setCommandTarget(result, "Show UI frame statistics", true, false, 'X', false);
+		result.categoryName = "Tools";
+		break;
 	case MenuToolsCreateRSAKeys:
 		setCommandTarget(result, "Create RSA Key pair", true, false, 'X', false);
 		result.categoryName = "Tools";
@@ -737,6 +742,7 @@ bool BackendCommandTarget::perform(const InvocationInfo &info)
 	case MenuToolsCheckAllSampleMaps:	Actions::checkAllSamplemaps(bpe); return true;
 	case MenuToolsImportArchivedSamples: Actions::importArchivedSamples(bpe); return true;
 	case MenuToolsRecordOneSecond:		bpe->owner->getDebugLogger().startRecording(); return true;
+	case MenuToolsShowUIFrameStatistics: Actions::showUIFrameStatistics(bpe); return true;
     case MenuToolsEnableDebugLogging:	bpe->owner->getDebugLogger().toggleLogging(); updateCommands(); return true;
     case MenuViewFullscreen:            Actions::toggleFullscreen(bpe); updateCommands(); return true;
 	case MenuViewBack:					bpe->mainEditor->getViewUndoManager()->undo(); updateCommands(); return true;
@@ -975,6 +981,7 @@ PopupMenu BackendCommandTarget::getMenuForIndex(int topLevelMenuIndex, const Str
 		ADD_DESKTOP_ONLY(MenuToolsRemoveAllSampleMaps);
 		ADD_DESKTOP_ONLY(MenuToolsUnloadAllAudioFiles);
 		ADD_DESKTOP_ONLY(MenuToolsRecordOneSecond);
+		ADD_DESKTOP_ONLY(MenuToolsShowUIFrameStatistics);
 		p.addSeparator();
 		p.addSectionHeader("License Management");
 		ADD_DESKTOP_ONLY(MenuToolsCreateDummyLicenseFile);
@@ -2588,6 +2595,14 @@ void BackendCommandTarget::Actions::unloadAllAudioFiles(BackendRootWindow * bpe)
 }
 
 
+void BackendCommandTarget::Actions::showUIFrameStatistics(BackendRootWindow * bpe)
+{
+	auto updater = bpe->getBackendProcessor()->getGlobalUIUpdater();
+
+	debugToConsole(bpe->getMainSynthChain(), updater->getFrameStatistics().toString());
+	updater->resetFrameStatistics();
+}
+
 void BackendCommandTarget::Actions::createUIDataFromDesktop(BackendRootWindow * bpe)
 {
 	auto mp = JavascriptMidiProcessor::getFirstInterfaceScriptProcessor(bpe->getBackendProcessor());
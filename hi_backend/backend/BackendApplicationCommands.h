@@ -196,6 +196,7 @@ public:
 		MenuToolsEnableAutoSaving,
 		MenuToolsEnableDebugLogging,
 		MenuToolsRecordOneSecond,
+		MenuToolsShowUIFrameStatistics,
 		
 		MenuToolsDeviceSimulatorOffset,
 		MenuHelpShowAboutPage = 0x70000,
@@ -356,6 +357,7 @@ public:
 		static void importArchivedSamples(BackendRootWindow * bpe);
 		static void checkCyclicReferences(BackendRootWindow * bpe);
 		static void unloadAllAudioFiles(BackendRootWindow * bpe);
+		static void showUIFrameStatistics(BackendRootWindow * bpe);
 		static void createUIDataFromDesktop(BackendRootWindow * bpe);
 
 		static String createWindowsInstallerTemplate(MainController* mc, bool includeAAX, bool include32, bool include64, bool includeRLottie);
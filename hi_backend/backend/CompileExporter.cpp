@@ -94,6 +94,7 @@ juce::ValueTree BaseExporter::exportEmbeddedFiles()
 	
 	ValueTree externalFiles("ExternalFiles");
 	externalFiles.addChild(externalScriptFiles, -1, nullptr);
+	externalFiles.addChild(FileChangeListener::collectAllTokenSnapshots(chainToExport, externalScriptFiles), -1, nullptr);
 	externalFiles.addChild(customFonts, -1, nullptr);
 	externalFiles.addChild(markdownDocs, -1, nullptr);
 
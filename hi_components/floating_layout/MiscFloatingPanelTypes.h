@@ -563,11 +563,12 @@ public:
 
 
 class ProcessorPeakMeter : public Component,
-	public Timer
+	public PooledUIUpdater::SimpleTimer
 {
 public:
 
 	ProcessorPeakMeter(Processor* p) :
+		SimpleTimer(p->getMainController()->getGlobalUIUpdater(), false, Priority::High),
 		processor(p)
 	{
 		addAndMakeVisible(vuMeter = new VuMeter());
@@ -578,12 +579,13 @@ public:
 		vuMeter->setColour(VuMeter::ledColour, Colours::lightgrey);
 		vuMeter->setColour(VuMeter::outlineColour, Colour(0x22000000));
 
-		startTimer(30);
+		setComponentToCheck(this);
+		start();
 	}
 
 	~ProcessorPeakMeter()
 	{
-		stopTimer();
+		stop();
 		vuMeter = nullptr;
 		processor = nullptr;
 	}
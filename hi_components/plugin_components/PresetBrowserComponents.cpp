@@ -265,16 +265,8 @@ int PresetBrowserColumn::ColumnListModel::getNumRows()
 
 			if (currentlyActiveTags.size() > 0)
 			{
-				const auto& cachedTags = getCachedTags();
-
-				for (auto& t : cachedTags)
-				{
-					if (t.hashCode == hash)
-					{
-						matchesTags = t.shown;
-						break;
-					}
-				}
+				if (auto t = parent->getMainController()->getUserPresetHandler().getTagDataBase().getCachedTag(hash))
+					matchesTags = t->shown;
 			}
 
 			if (matchesWildcard && matchesTags)
@@ -365,6 +365,7 @@ void CustomSettingsWindow::rebuildMenus(bool rebuildDeviceTypes, bool rebuildDev
 	diskModeSelector->clear(dontSendNotification);
 	diskModeSelector->addItem("Fast - SSD", 1);
 	diskModeSelector->addItem("Slow - HDD", 2);
+	diskModeSelector->addItem("Adaptive", 3);
 
 	voiceAmountMultiplier->clear(dontSendNotification);
 	voiceAmountMultiplier->addItem(String(NUM_POLYPHONIC_VOICES) + " voices", 1);
@@ -478,7 +478,9 @@ void SamplerSoundWaveform::setSoundToDisplay(const ModulatorSamplerSound *s, int
 				numSamplesInCurrentSample = currentSound->getReferenceToSound()->getSampleLength();
 			}
 
-			preview->setReader(afr.release(), numSamplesInCurrentSample);
+			auto cacheKey = PeakPyramid::createCacheKey(sound->getFileName(true), sound->getMonolithOffset(), afr->lengthInSamples, sound->getMonolithFile());
+
+			preview->setReader(afr.release(), numSamplesInCurrentSample, cacheKey);
 
 			updateRanges();
 		}
@@ -90,6 +90,14 @@
 #endif
 
 
+/** If enabled, loading a module tree will build the new sound generators in the background and
+	crossfade them with the old ones instead of suspending the audio (if the root container is compatible).
+	Presets that can't be swapped this way are loaded with the regular (suspending) method.
+*/
+#ifndef HISE_USE_CROSSFADED_PRESET_SWAP
+#define HISE_USE_CROSSFADED_PRESET_SWAP 1
+#endif
+
 #ifndef HISE_AUV3_MAX_INSTANCE_COUNT
 #define HISE_AUV3_MAX_INSTANCE_COUNT 2
 #endif
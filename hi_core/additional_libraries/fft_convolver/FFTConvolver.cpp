@@ -31,13 +31,66 @@
 
 namespace fftconvolver
 {  
+IRSpectrum::~IRSpectrum()
+{
+  for (auto s : segments)
+    delete s;
+}
+
+
+std::shared_ptr<const IRSpectrum> IRSpectrum::create(audiofft::ImplementationType fftType, size_t blockSize, const Sample* ir, size_t irLen)
+{
+  if (blockSize == 0)
+  {
+    return nullptr;
+  }
+
+  auto spectrum = std::make_shared<IRSpectrum>();
+
+  // Ignore zeros at the end of the impulse response because they only waste computation time
+  while (irLen > 0 && ::fabs(ir[irLen-1]) < 0.000001f)
+  {
+    --irLen;
+  }
+
+  if (irLen == 0)
+  {
+    return spectrum;
+  }
+
+  const size_t segSize = 2 * NextPowerOf2(blockSize);
+
+  spectrum->blockSize = NextPowerOf2(blockSize);
+  spectrum->segCount = static_cast<size_t>(::ceil(static_cast<float>(irLen) / static_cast<float>(spectrum->blockSize)));
+  spectrum->fftComplexSize = audiofft::AudioFFT::ComplexSize(segSize);
+
+  audiofft::AudioFFT fft(fftType);
+  fft.init(segSize);
+
+  SampleBuffer fftBuffer(segSize);
+
+  for (size_t i=0; i<spectrum->segCount; ++i)
+  {
+    SplitComplex* segment = new SplitComplex(spectrum->fftComplexSize);
+    const size_t remaining = irLen - (i * spectrum->blockSize);
+    const size_t sizeCopy = (remaining >= spectrum->blockSize) ? spectrum->blockSize : remaining;
+    CopyAndPad(fftBuffer, &ir[i*spectrum->blockSize], sizeCopy);
+    fft.fft(fftBuffer.data(), segment->re(), segment->im());
+    spectrum->segments.push_back(segment);
+  }
+
+  return spectrum;
+}
+
+
 FFTConvolver::FFTConvolver(audiofft::ImplementationType fftType) :
   _blockSize(0),
   _segSize(0),
   _segCount(0),
   _fftComplexSize(0),
   _segments(),
-  _segmentsIR(),
+  _ir(),
+  _fftType(fftType),
   _fftBuffer(),
   _fft(fftType),
   _preMultiplied(),
@@ -61,7 +114,6 @@ void FFTConvolver::reset()
   for (size_t i=0; i<_segCount; ++i)
   {
     delete _segments[i];
-    delete _segmentsIR[i];
   }
   
   _blockSize = 0;
@@ -69,7 +121,7 @@ void FFTConvolver::reset()
   _segCount = 0;
   _fftComplexSize = 0;
   _segments.clear();
-  _segmentsIR.clear();
+  _ir.reset();
   _fftBuffer.clear();
   _fft.init(0);
   _preMultiplied.clear();
@@ -104,22 +156,30 @@ bool FFTConvolver::init(size_t blockSize, const Sample* ir, size_t irLen)
   {
     return false;
   }
-  
-  // Ignore zeros at the end of the impulse response because they only waste computation time
-  while (irLen > 0 && ::fabs(ir[irLen-1]) < 0.000001f)
+
+  return init(IRSpectrum::create(_fftType, blockSize, ir, irLen));
+}
+
+
+bool FFTConvolver::init(std::shared_ptr<const IRSpectrum> spectrum)
+{
+  reset();
+
+  if (spectrum == nullptr)
   {
-    --irLen;
+    return false;
   }
 
-  if (irLen == 0)
+  if (spectrum->segCount == 0)
   {
     return true;
   }
   
-  _blockSize = NextPowerOf2(blockSize);
+  _ir = spectrum;
+  _blockSize = spectrum->blockSize;
   _segSize = 2 * _blockSize;
-  _segCount = static_cast<size_t>(::ceil(static_cast<float>(irLen) / static_cast<float>(_blockSize)));
-  _fftComplexSize = audiofft::AudioFFT::ComplexSize(_segSize);
+  _segCount = spectrum->segCount;
+  _fftComplexSize = spectrum->fftComplexSize;
   
   // FFT
   _fft.init(_segSize);
@@ -131,17 +191,6 @@ bool FFTConvolver::init(size_t blockSize, const Sample* ir, size_t irLen)
     _segments.push_back(new SplitComplex(_fftComplexSize));    
   }
   
-  // Prepare IR
-  for (size_t i=0; i<_segCount; ++i)
-  {
-    SplitComplex* segment = new SplitComplex(_fftComplexSize);
-    const size_t remaining = irLen - (i * _blockSize);
-    const size_t sizeCopy = (remaining >= _blockSize) ? _blockSize : remaining;
-    CopyAndPad(_fftBuffer, &ir[i*_blockSize], sizeCopy);
-    _fft.fft(_fftBuffer.data(), segment->re(), segment->im());
-    _segmentsIR.push_back(segment);
-  }
-  
   // Prepare convolution buffers  
   _preMultiplied.resize(_fftComplexSize);
   _conv.resize(_fftComplexSize);
@@ -186,11 +235,11 @@ void FFTConvolver::process(const Sample* input, Sample* output, size_t len)
       {
         const size_t indexIr = i;
         const size_t indexAudio = (_current + i) % _segCount;
-        ComplexMultiplyAccumulate(_preMultiplied, *_segmentsIR[indexIr], *_segments[indexAudio]);
+        ComplexMultiplyAccumulate(_preMultiplied, *_ir->segments[indexIr], *_segments[indexAudio]);
       }
     }
     _conv.copyFrom(_preMultiplied);
-    ComplexMultiplyAccumulate(_conv, *_segments[_current], *_segmentsIR[0]);
+    ComplexMultiplyAccumulate(_conv, *_segments[_current], *_ir->segments[0]);
 
     // Backward FFT
     _fft.ifft(_fftBuffer.data(), _conv.re(), _conv.im());
@@ -25,12 +25,44 @@
 #include "AudioFFT.h"
 #include "Utilities.h"
 
+#include <memory>
 #include <vector>
 
 
 namespace fftconvolver
 { 
 
+/**
+* @class IRSpectrum
+* @brief The partitioned spectrum of an impulse response
+*
+* The spectrum is immutable after its creation, so it can be shared between
+* multiple convolvers that use the same impulse response and block size.
+*/
+struct IRSpectrum
+{
+  IRSpectrum() = default;
+  ~IRSpectrum();
+
+  /**
+  * @brief Creates the spectrum of the given impulse response
+  * @param fftType The FFT implementation (must match the one of the convolver)
+  * @param blockSize Block size internally used by the convolver (partition size)
+  * @param ir The impulse response
+  * @param irLen Length of the impulse response
+  */
+  static std::shared_ptr<const IRSpectrum> create(audiofft::ImplementationType fftType, size_t blockSize, const Sample* ir, size_t irLen);
+
+  size_t blockSize = 0;
+  size_t segCount = 0;
+  size_t fftComplexSize = 0;
+  std::vector<SplitComplex*> segments;
+
+private:
+  IRSpectrum(const IRSpectrum&);
+  IRSpectrum& operator=(const IRSpectrum&);
+};
+
 /**
 * @class FFTConvolver
 * @brief Implementation of a partitioned FFT convolution algorithm with uniform block size
@@ -65,6 +97,13 @@ public:
   */
   bool init(size_t blockSize, const Sample* ir, size_t irLen);
 
+  /**
+  * @brief Initializes the convolver with an existing (possibly shared) spectrum
+  * @param spectrum The partitioned impulse response
+  * @return true: Success - false: Failed
+  */
+  bool init(std::shared_ptr<const IRSpectrum> spectrum);
+
   /**
   * @brief Convolves the the given input samples and immediately outputs the result
   * @param input The input samples
@@ -86,7 +125,8 @@ private:
   size_t _segCount;
   size_t _fftComplexSize;
   std::vector<SplitComplex*> _segments;
-  std::vector<SplitComplex*> _segmentsIR;
+  std::shared_ptr<const IRSpectrum> _ir;
+  audiofft::ImplementationType _fftType;
   SampleBuffer _fftBuffer;
   audiofft::AudioFFT _fft;
   SplitComplex _preMultiplied;
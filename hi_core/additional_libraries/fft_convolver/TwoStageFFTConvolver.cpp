@@ -29,6 +29,8 @@ namespace fftconvolver
 {
 
 TwoStageFFTConvolver::TwoStageFFTConvolver(audiofft::ImplementationType fftType) :
+  _fftType(fftType),
+  _spectrum(),
   _headBlockSize(0),
   _tailBlockSize(0),
   _headConvolver(fftType),
@@ -54,6 +56,7 @@ TwoStageFFTConvolver::~TwoStageFFTConvolver()
   
 void TwoStageFFTConvolver::reset()
 {
+  _spectrum.reset();
   _headBlockSize = 0;
   _tailBlockSize = 0;  
   _headConvolver.reset();
@@ -87,16 +90,15 @@ void TwoStageFFTConvolver::cleanPipeline()
 	_headConvolver.resetInput();
 }
 
-bool TwoStageFFTConvolver::init(size_t headBlockSize,
-                                size_t tailBlockSize,
-                                const Sample* ir,
-                                size_t irLen)
+std::shared_ptr<const TwoStageFFTConvolver::Spectrum> TwoStageFFTConvolver::createSpectrum(audiofft::ImplementationType fftType,
+                                                                                         size_t headBlockSize,
+                                                                                         size_t tailBlockSize,
+                                                                                         const Sample* ir,
+                                                                                         size_t irLen)
 {
-  reset();
-
   if (headBlockSize == 0 || tailBlockSize == 0)
   {
-    return false;
+    return nullptr;
   }
   
   headBlockSize = std::max(size_t(1), headBlockSize);
@@ -112,29 +114,80 @@ bool TwoStageFFTConvolver::init(size_t headBlockSize,
     --irLen;
   }
 
+  auto spectrum = std::make_shared<Spectrum>();
+
+  spectrum->irLen = irLen;
+
   if (irLen == 0)
   {
-    return true;
+    return spectrum;
   }
   
-  _headBlockSize = NextPowerOf2(headBlockSize);
-  _tailBlockSize = NextPowerOf2(tailBlockSize);
+  spectrum->headBlockSize = NextPowerOf2(headBlockSize);
+  spectrum->tailBlockSize = NextPowerOf2(tailBlockSize);
+
+  const size_t tailSize = spectrum->tailBlockSize;
+
+  const size_t headIrLen = std::min(irLen, tailSize);
+  spectrum->head = IRSpectrum::create(fftType, spectrum->headBlockSize, ir, headIrLen);
+
+  if (irLen > tailSize)
+  {
+    const size_t conv1IrLen = std::min(irLen-tailSize, tailSize);
+    spectrum->tail0 = IRSpectrum::create(fftType, spectrum->headBlockSize, ir+tailSize, conv1IrLen);
+  }
+
+  if (irLen > 2 * tailSize)
+  {
+    const size_t tailIrLen = irLen - (2*tailSize);
+    spectrum->tail = IRSpectrum::create(fftType, tailSize, ir+(2*tailSize), tailIrLen);
+  }
+
+  return spectrum;
+}
+
+
+bool TwoStageFFTConvolver::init(size_t headBlockSize,
+                                size_t tailBlockSize,
+                                const Sample* ir,
+                                size_t irLen)
+{
+  reset();
+
+  return init(createSpectrum(_fftType, headBlockSize, tailBlockSize, ir, irLen));
+}
+
+
+bool TwoStageFFTConvolver::init(std::shared_ptr<const Spectrum> spectrum)
+{
+  reset();
+
+  if (spectrum == nullptr)
+  {
+    return false;
+  }
+
+  if (spectrum->irLen == 0)
+  {
+    return true;
+  }
+
+  _spectrum = spectrum;
+  _headBlockSize = spectrum->headBlockSize;
+  _tailBlockSize = spectrum->tailBlockSize;
 
-  const size_t headIrLen = std::min(irLen, _tailBlockSize);
-  _headConvolver.init(_headBlockSize, ir, headIrLen);
+  _headConvolver.init(spectrum->head);
 
-  if (irLen > _tailBlockSize)
+  if (spectrum->tail0 != nullptr)
   {
-    const size_t conv1IrLen = std::min(irLen-_tailBlockSize, _tailBlockSize);
-    _tailConvolver0.init(_headBlockSize, ir+_tailBlockSize, conv1IrLen);
+    _tailConvolver0.init(spectrum->tail0);
     _tailOutput0.resize(_tailBlockSize);
     _tailPrecalculated0.resize(_tailBlockSize);
   }
 
-  if (irLen > 2 * _tailBlockSize)
+  if (spectrum->tail != nullptr)
   {
-    const size_t tailIrLen = irLen - (2*_tailBlockSize);
-    _tailConvolver.init(_tailBlockSize, ir+(2*_tailBlockSize), tailIrLen);
+    _tailConvolver.init(spectrum->tail);
     _tailOutput.resize(_tailBlockSize);
     _tailPrecalculated.resize(_tailBlockSize);
     _backgroundProcessingInput.resize(_tailBlockSize);
@@ -55,8 +55,30 @@ namespace fftconvolver
 class TwoStageFFTConvolver
 {  
 public:
+
+  /**
+  * @brief The partitioned spectra of the head and tail stages
+  *
+  * Use createSpectrum() to calculate it once and pass it to multiple convolvers.
+  */
+  struct Spectrum
+  {
+    size_t headBlockSize = 0;
+    size_t tailBlockSize = 0;
+    size_t irLen = 0;
+    std::shared_ptr<const IRSpectrum> head;
+    std::shared_ptr<const IRSpectrum> tail0;
+    std::shared_ptr<const IRSpectrum> tail;
+  };
+
   TwoStageFFTConvolver(audiofft::ImplementationType fftType);  
   virtual ~TwoStageFFTConvolver();
+
+  /**
+  * @brief Calculates the spectra for the given impulse response and block sizes
+  * @return nullptr if the block sizes are invalid
+  */
+  static std::shared_ptr<const Spectrum> createSpectrum(audiofft::ImplementationType fftType, size_t headBlockSize, size_t tailBlockSize, const Sample* ir, size_t irLen);
   
   /**
   * @brief Initialization the convolver
@@ -68,6 +90,12 @@ public:
   */
   bool init(size_t headBlockSize, size_t tailBlockSize, const Sample* ir, size_t irLen);
 
+  /**
+  * @brief Initializes the convolver with a (possibly shared) spectrum
+  * @return true: Success - false: Failed
+  */
+  bool init(std::shared_ptr<const Spectrum> spectrum);
+
   /**
   * @brief Convolves the the given input samples and immediately outputs the result
   * @param input The input samples
@@ -84,6 +112,9 @@ public:
   /** Clears the internal buffers so that it resets the convolution pipeline. */
   void cleanPipeline();
 
+  /** Returns the block size of the tail convolver. */
+  size_t getTailBlockSize() const { return _tailBlockSize; }
+
 protected:
   /**
   * @brief Method called by the convolver if work for background processing is available
@@ -108,6 +139,8 @@ protected:
   void doBackgroundProcessing();
 
 private:
+  audiofft::ImplementationType _fftType;
+  std::shared_ptr<const Spectrum> _spectrum;
   size_t _headBlockSize;
   size_t _tailBlockSize;
   FFTConvolver _headConvolver;
@@ -281,6 +281,16 @@ If this is enabled, compiled plugins will write a startup log to the desktop for
 #define ENABLE_STARTUP_LOG 0
 #endif
 
+/** Config: HISE_SHARE_EMBEDDED_AUDIO_FILES
+
+If enabled, the decoded embedded audio files (impulse responses, loops etc.) are stored in a process-wide cache
+and shared between all plugin instances. Images are always shared. Disable this only if you rely on modifying
+the audio data of an embedded file in one instance without affecting the others.
+*/
+#ifndef HISE_SHARE_EMBEDDED_AUDIO_FILES
+#define HISE_SHARE_EMBEDDED_AUDIO_FILES 1
+#endif
+
 /** Config: HISE_MAX_PROCESSING_BLOCKSIZE
 
 This is the maximum block size that is used for the audio rendering. If the host calls the render
@@ -329,6 +329,11 @@ DebugLogger::~DebugLogger()
 
 }
 
+PooledUIUpdater* DebugLogger::getGlobalUIUpdater()
+{
+	return mc->getGlobalUIUpdater();
+}
+
 double DebugLogger::getCurrentTimeStamp() const
 {
 	return 0.001 * (Time::getMillisecondCounterHiRes() - uptime);
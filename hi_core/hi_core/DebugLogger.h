@@ -207,6 +207,9 @@ public:
 		return mc;
 	}
 
+	/** Returns the UI updater of the MainController (which isn't a complete type here). */
+	PooledUIUpdater* getGlobalUIUpdater();
+
 	void startLogging();
 	bool isLogging() const;
 	void stopLogging();
@@ -342,11 +345,12 @@ class DebugLoggerComponent : public Component,
 							 public DebugLogger::Listener,
 							 public Button::Listener,
 							 public ComboBox::Listener,
-							 public Timer
+							 public PooledUIUpdater::SimpleTimer
 {
 public:
 
 	DebugLoggerComponent(DebugLogger* logger_):
+		SimpleTimer(logger_->getGlobalUIUpdater(), false, Priority::Low),
 		logger(logger_)
 	{
 		logger->addListener(this);
@@ -380,7 +384,7 @@ public:
 		closeAndShowFileButton->setLookAndFeel(laf);
 		closeAndShowFileButton->addListener(this);
 
-		startTimer(30);
+		start();
 	}
 
 	~DebugLoggerComponent()
@@ -403,7 +407,7 @@ public:
 		isFailing = true;
 		repaint();
 
-		startTimer(100);
+		start();
 	}
 
 	void timerCallback() override
@@ -411,7 +415,7 @@ public:
 		if (!logger->isCurrentlyFailing())
 		{
 			isFailing = false;
-			stopTimer();
+			stop();
 			repaint();
 		}
 
@@ -677,6 +677,8 @@ juce::Result PoolBase::DataProvider::restorePool(InputStream* ownedInputStream)
 {
 	pool->clearData();
 
+	ScopedLock sl(inputLock);
+
 	input = ownedInputStream;
 	int64 metadataSize = input->readInt64();
 
@@ -720,15 +722,23 @@ juce::MemoryInputStream* PoolBase::DataProvider::createInputStream(const String&
 			auto offset = (int64)item.getProperty("ChunkStart");
 			auto end = (int64)item.getProperty("ChunkEnd");
 
-			if (input != nullptr && (input->getTotalLength() > offset + metadataOffset))
+			MemoryBlock mb;
+			bool found = false;
+
 			{
-				input->setPosition(offset + metadataOffset);
+				// The input stream is shared between all entries, so seeking and reading must not be interleaved
+				ScopedLock sl(inputLock);
 
-				MemoryBlock mb;
-				input->readIntoMemoryBlock(mb, (size_t)(end - offset));
+				if (input != nullptr && (input->getTotalLength() > offset + metadataOffset))
+				{
+					input->setPosition(offset + metadataOffset);
+					input->readIntoMemoryBlock(mb, (size_t)(end - offset));
+					found = true;
+				}
+			}
 
+			if (found)
 				return new MemoryInputStream(mb, true);
-			}
 		}
 		else
 		{
@@ -1135,8 +1145,9 @@ PoolCollection::PoolCollection(MainController* mc, FileHandlerBase* handler) :
 	// This makes plugins use one global pool of images in order to save memory
 	dataPools[ProjectHandler::SubDirectories::Images]->setUseSharedPool(true);
 
-	// Since memory is super tight on AUv3, we also share the audio files here...
-	if (HiseDeviceSimulator::isAUv3())
+	// The embedded audio files are read-only too, so we share them between all instances
+	// (on AUv3 this is always the case because memory is super tight there)...
+	if (HISE_SHARE_EMBEDDED_AUDIO_FILES || HiseDeviceSimulator::isAUv3())
 		dataPools[ProjectHandler::SubDirectories::AudioFiles]->setUseSharedPool(true);
 #endif
 }
@@ -414,6 +414,7 @@ public:
 		int64 metadataOffset;
 
 		PoolBase* pool = nullptr;
+		CriticalSection inputLock;
 		ScopedPointer<InputStream> input;
 		Array<int64> hashCodes;
 		size_t embeddedSize = 0;
@@ -612,7 +613,10 @@ public:
 /** This class extends the pool to a global data storage used across all instances of the plugin.
 *
 *	This is useful if you have a lot of read-only data (like images), which would increase the memory
-*	usage when multiple instances of your plugin are used. */
+*	usage when multiple instances of your plugin are used. 
+*
+*	The cache is accessed from multiple plugin instances, which might be created on different threads,
+*	so every access is guarded by a lock. */
 template <class DataType> class SharedCache
 {
 
@@ -625,35 +629,42 @@ public:
 		ignoreUnused(unused);
 	}
 
-	bool contains(int64 hashCode)
+	bool contains(int64 hashCode) const
 	{
-		for (const auto& i : sharedItems)
-		{
-			if (i->ref.getHashCode() == hashCode)
-				return true;
-		}
-
-		return false;
+		return getSharedData(hashCode) != nullptr;
 	}
 
-	PoolEntry<DataType>* getSharedData(int64 hashCode)
+	/** Returns the shared entry for the given hash code or nullptr if it's not cached yet. */
+	PoolEntry<DataType>* getSharedData(int64 hashCode) const
 	{
+		ScopedLock sl(lock);
+
 		for (const auto& i: sharedItems)
 		{
 			if (i->ref.getHashCode() == hashCode)
 				return i;
 		}
 
-		jassertfalse;
-		return {};
+		return nullptr;
 	}
 
-	void store(PoolEntry<DataType>* newEntry)
+	/** Adds the entry to the cache and returns the entry that should be used. 
+	
+		If another instance has stored the same data in the meantime, this will return the
+		existing entry so that the data isn't duplicated.
+	*/
+	PoolEntry<DataType>* store(PoolEntry<DataType>* newEntry)
 	{
-		if (contains(newEntry->ref.getHashCode()))
-			return;
+		ScopedLock sl(lock);
+
+		for (const auto& i : sharedItems)
+		{
+			if (i->ref.getHashCode() == newEntry->ref.getHashCode())
+				return i;
+		}
 
 		sharedItems.add(newEntry);
+		return newEntry;
 	}
 
 	~SharedCache()
@@ -665,7 +676,7 @@ public:
 
 private:
 
-	
+	CriticalSection lock;
 
 	ReferenceCountedArray<PoolEntry<DataType>> sharedItems;
 };
@@ -1055,9 +1066,10 @@ public:
 		if (getDataProvider()->isEmbeddedResource(r))
 			r = getDataProvider()->getEmbeddedReference(r);
 
-		if (useSharedCache && sharedCache->contains(r.getHashCode()))
+		if (useSharedCache)
 		{
-			return ManagedPtr(this, sharedCache->getSharedData(r.getHashCode()), true);
+			if (auto sharedEntry = sharedCache->getSharedData(r.getHashCode()))
+				return ManagedPtr(this, sharedEntry, true);
 		}
 
 		if (PoolHelpers::shouldSearchInPool(loadingType))
@@ -1121,7 +1133,7 @@ public:
 				{
 					if (useSharedCache)
 					{
-						sharedCache->store(ne);
+						ne = sharedCache->store(ne.get());
 					}
 					else
 					{
@@ -1155,7 +1167,7 @@ public:
 
 				if (useSharedCache && loadingType != PoolHelpers::LoadAndCacheStrong)
 				{
-					sharedCache->store(ne);
+					ne = sharedCache->store(ne.get());
 				}
 				else
 				{
@@ -89,6 +89,8 @@ void MainController::GlobalAsyncModuleHandler::addAsync(Processor* p, const Safe
 
 void MainController::GlobalAsyncModuleHandler::addPendingUIJob(Processor* p, What what)
 {
+	mc->getProcessorRegistry().bumpGeneration();
+
 	bool synchronous = p->getMainController()->isBeingDeleted();
 
 	if (what == Add)
@@ -79,6 +79,7 @@ MainController::MainController() :
 	killStateHandler(this),
 	debugLogger(this),
 	globalAsyncModuleHandler(this),
+	processorRegistry(this),
 	//presetLoadRampFlag(OldUserPresetHandler::Active),
 	controlUndoManager(new UndoManager())
 {
@@ -203,7 +204,12 @@ void MainController::loadPresetFromFile(const File &f, Component* /*mainEditor*/
 		FileInputStream fis(f);
 
 		ValueTree v = ValueTree::readFromStream(fis);
+
+#if HISE_USE_CROSSFADED_PRESET_SWAP
+		p->getMainController()->loadPresetWithCrossfade(v);
+#else
 		p->getMainController()->loadPresetFromValueTree(v);
+#endif
 		return SafeFunctionCall::OK;
 	};
 
@@ -212,6 +218,10 @@ void MainController::loadPresetFromFile(const File &f, Component* /*mainEditor*/
 
 	if (synchronous)
 		f2(getMainSynthChain());
+#if HISE_USE_CROSSFADED_PRESET_SWAP
+	else if (getKillStateHandler().isAudioRunning())
+		getSampleManager().addDeferredFunction(getMainSynthChain(), f2);
+#endif
 	else
 		killAndCallOnLoadingThread(f2);
 #else
@@ -388,7 +398,221 @@ void MainController::loadPresetInternal(const ValueTree& v)
 	getKillStateHandler().killVoicesAndCall(getMainSynthChain(), f, KillStateHandler::SampleLoadingThread);
 }
 
+void MainController::loadPresetWithCrossfade(const ValueTree& v)
+{
+	auto f = [v](Processor* p)
+	{
+		p->getMainController()->swapPresetInternal(v);
+		return SafeFunctionCall::OK;
+	};
 
+	// Don't use killAndCallOnLoadingThread here, the whole point is to keep the audio running...
+	if (getKillStateHandler().getCurrentThread() == KillStateHandler::SampleLoadingThread)
+		f(getMainSynthChain());
+	else
+		getSampleManager().addDeferredFunction(getMainSynthChain(), f);
+}
+
+bool MainController::canSwapPresetWithCrossfade(const ValueTree& v, String& reason)
+{
+	if (!getKillStateHandler().isAudioRunning() || sampleRate <= 0.0)
+	{
+		reason = "the audio is not running";
+		return false;
+	}
+
+	if (!v.isValid() || v.getProperty("Type", var::undefined()).toString() != "SynthChain")
+	{
+		reason = "the preset is not a SynthChain";
+		return false;
+	}
+
+	auto chain = getMainSynthChain();
+
+	if (chain->isFadingOut())
+	{
+		reason = "the last swap is still fading out";
+		return false;
+	}
+
+	auto childProcessors = v.getChildWithName("ChildProcessors");
+
+	if (childProcessors.getNumChildren() < ModulatorSynth::numInternalChains)
+	{
+		reason = "the internal chains are missing";
+		return false;
+	}
+
+	for (int i = 0; i < ModulatorSynth::numInternalChains; i++)
+	{
+		if (!chain->getChildProcessor(i)->exportAsValueTree().isEquivalentTo(childProcessors.getChild(i)))
+		{
+			reason = "the root container (" + chain->getChildProcessor(i)->getId() + ") has changed";
+			return false;
+		}
+	}
+
+	// Global modulators connect to their container while they are restored, which would be the
+	// container of the old preset. Scripts are fine, they are compiled after the new synths are attached.
+	std::function<bool(const ValueTree&)> containsGlobalModulators;
+
+	containsGlobalModulators = [&containsGlobalModulators](const ValueTree& t)
+	{
+		if (t.getProperty("Type").toString().startsWith("Global"))
+			return true;
+
+		for (auto c : t)
+		{
+			if (containsGlobalModulators(c))
+				return true;
+		}
+
+		return false;
+	};
+
+	for (int i = ModulatorSynth::numInternalChains; i < childProcessors.getNumChildren(); i++)
+	{
+		if (containsGlobalModulators(childProcessors.getChild(i)))
+		{
+			reason = childProcessors.getChild(i).getProperty("ID").toString() + " contains global modulators";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void MainController::swapPresetInternal(const ValueTree& v)
+{
+	LockHelpers::freeToGo(this);
+
+	String reason;
+
+	if (!canSwapPresetWithCrossfade(v, reason))
+	{
+		debugToConsole(getMainSynthChain(), "Can't crossfade the preset (" + reason + "), suspending the audio for loading");
+		loadPresetFromValueTree(v);
+		return;
+	}
+
+	auto chain = getMainSynthChain();
+	auto pool = getSampleManager().getModulatorSamplerSoundPool2();
+
+	PresetSwapStatistics stats;
+	stats.sampleMemoryBeforeSwap = (int64)pool->getMemoryUsageForAllSamples();
+
+	const auto start = Time::getMillisecondCounterHiRes();
+
+	OwnedArray<ModulatorSynth> newSynths;
+
+	try
+	{
+		getSampleManager().setCurrentPreloadMessage("Building modules...");
+		getSampleManager().setShouldSkipPreloading(false);
+
+		ScopedValueSetter<bool> svs(skipCompilingAtPresetLoad, true);
+		chain->createChildSynthsFromValueTree(v, newSynths);
+	}
+	catch (String& errorMessage)
+	{
+		// The old synths are still playing, so we just keep them and tell the user why nothing happened
+		errorMessage = "Can't load the preset: " + errorMessage;
+
+#if USE_BACKEND
+		writeToConsole(errorMessage, 1, chain);
+#else
+		sendOverlayMessage(DeactiveOverlay::CustomErrorMessage, errorMessage);
+#endif
+		return;
+	}
+
+	// Both trees are alive at this point...
+	stats.sampleMemoryDuringSwap = (int64)pool->getMemoryUsageForAllSamples();
+	stats.buildTimeSeconds = (Time::getMillisecondCounterHiRes() - start) * 0.001;
+	stats.numSwappedSynths = newSynths.size();
+
+	Array<WeakReference<JavascriptProcessor>> newScripts;
+
+	for (auto ms : newSynths)
+		newScripts.addArray(ProcessorHelpers::getListOfAllProcessors<JavascriptProcessor>(ms));
+
+	chain->swapChildSynthsWithCrossfade(newSynths, presetSwapFadeTime);
+
+	if (!newScripts.isEmpty() && isCompilingAllScriptsOnPresetLoad())
+	{
+		getSampleManager().setCurrentPreloadMessage("Compiling scripts...");
+
+		// The scripts can resolve other modules now that the synths are part of the main chain
+		for (auto& sp : newScripts)
+		{
+			if (sp == nullptr)
+				continue;
+
+			ValueTreeUpdateWatcher::ScopedDelayer sd(sp->getContent()->getUpdateWatcher());
+			sp->getContent()->resetContentProperties();
+			sp->compileScript();
+		}
+	}
+
+	chain->setId(v.getProperty("ID", "MainSynthChain"));
+
+	for (int i = 0; i < ModulatorSynth::numModulatorSynthParameters; i++)
+	{
+		auto id = chain->getIdentifierForParameterIndex(i);
+
+		if (v.hasProperty(id))
+			chain->setAttribute(i, (float)v.getProperty(id), dontSendNotification);
+	}
+
+	ValueTree autoData = v.getChildWithName("MidiAutomation");
+
+	if (autoData.isValid())
+		getMacroManager().getMidiControlAutomationHandler()->restoreFromValueTree(autoData);
+
+	chain->loadMacrosFromValueTree(v);
+
+	// Wait until the old synths are silent before deleting them
+	const int timeoutMilliseconds = (int)(presetSwapFadeTime * 1000.0) + 1000;
+
+	if (!chain->waitForFadeOut(timeoutMilliseconds))
+	{
+		// The audio callback stopped while fading out, so we need to suspend it until the old synths are removed
+		auto f = [](Processor* p)
+		{
+			auto c = dynamic_cast<ModulatorSynthChain*>(p);
+			c->resetAllVoices();
+			c->disposeFadedOutSynths();
+			return SafeFunctionCall::OK;
+		};
+
+		getKillStateHandler().killVoicesAndCall(chain, f, KillStateHandler::SampleLoadingThread);
+	}
+	else
+		chain->disposeFadedOutSynths();
+
+	lastPresetSwapStatistics = stats;
+
+	String message;
+	message << "Preset swapped in " << String(stats.buildTimeSeconds * 1000.0, 1) << "ms. ";
+	message << "Sample memory: " << String((double)stats.sampleMemoryBeforeSwap / 1024.0 / 1024.0, 1) << "MB -> ";
+	message << String((double)stats.sampleMemoryDuringSwap / 1024.0 / 1024.0, 1) << "MB during the swap";
+
+#if USE_BACKEND
+	writeToConsole(message, 0, chain);
+#else
+	DBG(message);
+#endif
+
+	auto f = [](Dispatchable* obj)
+	{
+		auto p = static_cast<Processor*>(obj);
+		p->sendRebuildMessage(true);
+		p->getMainController()->getLockFreeDispatcher().sendPresetReloadMessage();
+		return Dispatchable::Status::OK;
+	};
+
+	getLockFreeDispatcher().callOnMessageThreadAfterSuspension(chain, f);
+}
 
 
 void MainController::startCpuBenchmark(int bufferSize_)
@@ -484,11 +708,40 @@ void MainController::killAndCallOnLoadingThread(const ProcessorFunction& f)
 	getKillStateHandler().killVoicesAndCall(getMainSynthChain(), f, KillStateHandler::SampleLoadingThread);
 }
 
+void MainController::setLatencySamplesForSource(LatencySource source, int numSamples)
+{
+	jassert(source != LatencySource::numLatencySources);
+
+	latencySamples[(int)source] = jmax(0, numSamples);
+	updateReportedLatency();
+}
+
+int MainController::getLatencySamplesForSource(LatencySource source) const
+{
+	jassert(source != LatencySource::numLatencySources);
+
+	return latencySamples[(int)source];
+}
+
+void MainController::updateReportedLatency()
+{
+	int totalLatency = 0;
+
+	for (auto l : latencySamples)
+		totalLatency += l;
+
+	if (auto ap = dynamic_cast<AudioProcessor*>(this))
+	{
+		if (ap->getLatencySamples() != totalLatency)
+			ap->setLatencySamples(totalLatency);
+	}
+}
+
 bool MainController::refreshOversampling()
 {
 	auto requiredOversamplingFactor = (double)jlimit(1, 8, nextPowerOfTwo((int)(minimumSamplerate / getOriginalSamplerate())));
 
-	int numChannelsOfOversampler = oversampler != nullptr ? (int)oversampler->numChannels : -1;
+	int numChannelsOfOversampler = oversampler != nullptr ? oversampler->getNumChannels() : -1;
 
 	bool channelsNeedUpdating = numChannelsOfOversampler > 0 && numChannelsOfOversampler != multiChannelBuffer.getNumChannels();
 
@@ -496,12 +749,11 @@ bool MainController::refreshOversampling()
 	{
 		auto f = [this, requiredOversamplingFactor](Processor* p)
 		{
-			ScopedPointer<juce::dsp::Oversampling<float>> newOversampler;
+			ScopedPointer<PolyphaseOversampler> newOversampler;
 			
 			if(requiredOversamplingFactor != 1)
-				newOversampler = new juce::dsp::Oversampling<float>(multiChannelBuffer.getNumChannels(),
-				log2(requiredOversamplingFactor),
-				juce::dsp::Oversampling<float>::FilterType::filterHalfBandPolyphaseIIR);
+				newOversampler = new PolyphaseOversampler(multiChannelBuffer.getNumChannels(),
+				roundToInt(log2(requiredOversamplingFactor)));
 
 			{
 				ScopedLock sl(getLock());
@@ -513,9 +765,13 @@ bool MainController::refreshOversampling()
 				currentOversampleFactor = requiredOversamplingFactor;
 
 				prepareToPlay(originalSampleRate, originalBufferSize);
-
-				return SafeFunctionCall::OK;
 			}
+
+			// Report the filter latency of the new oversampler to the host
+			auto filterLatency = oversampler != nullptr ? roundToInt(oversampler->getLatencyInSamples()) : 0;
+			setLatencySamplesForSource(LatencySource::Oversampling, filterLatency);
+
+			return SafeFunctionCall::OK;
 		};
 
 		allNotesOff(false);
@@ -156,6 +156,7 @@ public:
 		{
 			SSD = 0,
 			HDD,
+			Adaptive, ///< sizes the preload and streaming buffers from the measured read latency
 			numDiskModes
 		};
 
@@ -195,6 +196,8 @@ public:
 
 		bool isUsingHddMode() const noexcept{ return hddMode; };
 
+		bool isUsingAdaptiveMode() const noexcept { return adaptiveMode; };
+
 		bool isPreloading() const noexcept { return preloadFlag; };
 
 		bool shouldSkipPreloading() const { return skipPreloading; };
@@ -333,6 +336,7 @@ public:
 		ScopedPointer<SampleThreadPool> samplerLoaderThreadPool;
 
 		bool hddMode = false;
+		bool adaptiveMode = false;
 		bool skipPreloading = false;
 
 		PreloadJob internalPreloadJob;
@@ -598,12 +602,32 @@ public:
 				int64 hashCode;
 				Array<Identifier> tags;
 				bool shown = false;
+
+				String relativePath;
+				String name;
+				int64 modificationTime = 0;
+				int64 fileSize = 0;
 			};
 
 			void setRootDirectory(const File& newRoot);;
 
+			/** Updates the tag cache.
+			*
+			*	The first call will load the index file from the root directory. Afterwards the folders are
+			*	listed again, but only the presets with a changed modification time or file size will be
+			*	parsed. If force is false, it will only update the cache if the root directory was changed.
+			*/
 			void buildDataBase(bool force = false);
 
+			/** Returns the full path of all presets whose name starts with the given string (case insensitive). */
+			Array<File> getPresetsWithPrefix(const String& prefix) const;
+
+			/** Returns all presets that contain every tag of the given list. */
+			Array<File> getPresetsWithTags(const StringArray& tagsToMatch) const;
+
+			/** Returns the index file that stores the cache between sessions. */
+			File getIndexFile() const { return root.getChildFile("tags.json"); }
+
 			/** If you want to use the tag system, supply a list of Strings and it will
 			create the tags automatically.
 			*/
@@ -617,6 +641,13 @@ public:
 
 			const Array<CachedTag>& getCachedTags() const { return cachedTags; }
 
+			/** Returns the cache entry for the file with the given hash code (File::hashCode64()) or nullptr. */
+			const CachedTag* getCachedTag(int64 fileHash) const
+			{
+				auto index = hashIndex[fileHash] - 1;
+				return isPositiveAndBelow(index, cachedTags.size()) ? cachedTags.begin() + index : nullptr;
+			}
+
 		private:
 
 			StringArray tagList;
@@ -627,6 +658,17 @@ public:
 
 			void buildInternal();
 
+			void scanDirectory(const File& directory, Array<CachedTag>& newTags, bool& indexChanged);
+
+			void loadIndexFile();
+			void saveIndexFile() const;
+			void rebuildHashIndex();
+
+			// stores the index + 1 so that the default value can be used for missing entries
+			HashMap<int64, int> hashIndex;
+
+			bool indexLoaded = false;
+
 			bool dirty = true;
 		};
 
@@ -756,6 +798,76 @@ public:
 		MainController * mc;
 	};
 
+	/** A cache that indexes all processors of the module tree by their ID.
+	*
+	*	Walking the tree with a Processor::Iterator takes the iterator lock and creates a list of the
+	*	entire tree, so looking up modules by name during initialisation costs O(modules) per call.
+	*	This class builds the index lazily and rebuilds it when the generation counter was bumped,
+	*	which happens whenever a processor is added, removed or renamed.
+	*/
+	class ProcessorRegistry
+	{
+	public:
+
+		ProcessorRegistry(MainController* mc_) :
+			mc(mc_)
+		{};
+
+		/** Invalidates the index. It will be rebuilt with the next lookup. */
+		void bumpGeneration() noexcept { ++generation; }
+
+		int getGeneration() const noexcept { return generation.load(); }
+
+		/** Returns all processors with the given ID that are either the root processor or one of its children.
+		*
+		*	The processors are sorted in the order of the Processor::Iterator. If the root is not part of the
+		*	module tree or if there is no match in the index, it will walk the tree like before.
+		*/
+		Array<Processor*> getProcessorsWithId(const String& id, const Processor* root, bool* usedIndex=nullptr);
+
+		/** Returns the first processor with the given ID and type.
+		*
+		*	If the index has processors with this ID, but none of them has the requested type, it will walk the
+		*	tree before giving up, so a stale index can never hide a processor.
+		*/
+		template <class ProcessorType> ProcessorType* getFirstProcessorWithId(const String& id, const Processor* root)
+		{
+			bool usedIndex = false;
+
+			for (auto p : getProcessorsWithId(id, root, &usedIndex))
+			{
+				if (auto typed = dynamic_cast<ProcessorType*>(p))
+					return typed;
+			}
+
+			if (usedIndex)
+			{
+				for (auto p : walkTree(id, root))
+				{
+					if (auto typed = dynamic_cast<ProcessorType*>(p))
+						return typed;
+				}
+			}
+
+			return nullptr;
+		}
+
+	private:
+
+		Array<Processor*> walkTree(const String& id, const Processor* root) const;
+
+		void rebuildIfNecessary();
+		bool isPartOfTree(const Processor* p, const Processor* root) const;
+
+		MainController* mc;
+
+		std::atomic<int> generation = { 0 };
+		std::atomic<int> indexedGeneration = { -1 };
+
+		CriticalSection indexLock;
+		HashMap<String, Array<WeakReference<Processor>>> index;
+	};
+
 	class ProcessorChangeHandler : public AsyncUpdater
 	{
 	public:
@@ -798,6 +910,12 @@ public:
 
 		void sendProcessorChangeMessage(Processor* changedProcessor, EventType type, bool synchronous = true)
 		{
+			if (type == EventType::ProcessorAdded || type == EventType::ProcessorRemoved ||
+				type == EventType::ProcessorRenamed || type == EventType::RebuildModuleList)
+			{
+				mc->getProcessorRegistry().bumpGeneration();
+			}
+
 			tempProcessor = changedProcessor;
 			tempType = type;
 
@@ -1114,6 +1232,9 @@ public:
 	GlobalAsyncModuleHandler& getGlobalAsyncModuleHandler() { return globalAsyncModuleHandler; }
 	const GlobalAsyncModuleHandler& getGlobalAsyncModuleHandler() const { return globalAsyncModuleHandler; }
 
+	ProcessorRegistry& getProcessorRegistry() noexcept { return processorRegistry; }
+	const ProcessorRegistry& getProcessorRegistry() const noexcept { return processorRegistry; }
+
 	ExpansionHandler& getExpansionHandler() noexcept { return expansionHandler; }
 	const ExpansionHandler& getExpansionHandler() const noexcept { return expansionHandler; }
 
@@ -1208,6 +1329,32 @@ public:
 
 	void loadPresetFromFile(const File &f, Component *mainEditor=nullptr);
 	void loadPresetFromValueTree(const ValueTree &v, Component *mainEditor=nullptr);
+
+	/** Contains some information about the last crossfaded preset swap. */
+	/** The sample memory is the size of the preload buffers in the sample pool (the memory of the processors is not included). */
+	struct PresetSwapStatistics
+	{
+		double buildTimeSeconds = 0.0;
+		int64 sampleMemoryBeforeSwap = 0;
+		int64 sampleMemoryDuringSwap = 0;
+		int numSwappedSynths = 0;
+	};
+
+	/** Loads the preset without suspending the audio rendering.
+	*
+	*	The sound generators of the new preset are created, prepared and preloaded on the loading thread while the
+	*	old ones keep on playing. They are then swapped at a block boundary and crossfaded, the old ones are
+	*	deleted asynchronously after the fade out. This only works if the root container of the new preset has the same internal chains
+	*	(interface script, master effects) and the sound generators don't contain global modulators. Scripts in the
+	*	sound generators are compiled after the swap. Otherwise it will fall back to loadPresetFromValueTree().
+	*/
+	void loadPresetWithCrossfade(const ValueTree& v);
+
+	/** Sets the time that the old sound generators are faded out after a crossfaded preset swap. */
+	void setPresetSwapFadeTime(double newFadeTimeSeconds) { presetSwapFadeTime = jmax(0.0, newFadeTimeSeconds); }
+
+	PresetSwapStatistics getLastPresetSwapStatistics() const { return lastPresetSwapStatistics; }
+
     void clearPreset();
     
 	/** Compiles all scripts in the main synth chain */
@@ -1494,6 +1641,21 @@ public:
 		return currentPreview;
 	}
 
+	/** The parts of the signal path that add latency to the plugin. */
+	enum class LatencySource
+	{
+		Script,
+		DelayedRendering,
+		Oversampling,
+		numLatencySources
+	};
+
+	/** Sets the latency of the given source and reports the sum of all sources to the host. */
+	void setLatencySamplesForSource(LatencySource source, int numSamples);
+
+	/** Returns the latency of the given source. */
+	int getLatencySamplesForSource(LatencySource source) const;
+
 #if HISE_INCLUDE_RLOTTIE
 	RLottieManager::Ptr getRLottieManager();
 #endif
@@ -1570,6 +1732,8 @@ private:
 	int getOriginalBufferSize() const { return (int)((double)maxBufferSize.get() / getOversampleFactor()); }
 
 	int getOversampleFactor() const { return currentOversampleFactor; }
+
+	void updateReportedLatency();
 	
 
 #if HISE_INCLUDE_RLOTTIE
@@ -1593,6 +1757,12 @@ private:
 
 	void loadPresetInternal(const ValueTree& v);
 
+	bool canSwapPresetWithCrossfade(const ValueTree& v, String& reason);
+	void swapPresetInternal(const ValueTree& v);
+
+	double presetSwapFadeTime = 0.15;
+	PresetSwapStatistics lastPresetSwapStatistics;
+
 	CriticalSection processLock;
 
 	// This lock should be acquired when you add a new processor to the processing chain
@@ -1622,6 +1792,7 @@ private:
 	UserPresetHandler userPresetHandler;
 	ProcessorChangeHandler processorChangeHandler;
 	GlobalAsyncModuleHandler globalAsyncModuleHandler;
+	ProcessorRegistry processorRegistry;
 	
 	void storePlayheadIntoDynamicObject(AudioPlayHead::CurrentPositionInfo &lastPosInfo);
 
@@ -1643,9 +1814,11 @@ private:
 		Identifier id;
 	};
 
-	ScopedPointer<juce::dsp::Oversampling<float>> oversampler;
+	ScopedPointer<PolyphaseOversampler> oversampler;
 	double minimumSamplerate = 0.0;
 	int currentOversampleFactor = 1;
+
+	int latencySamples[(int)LatencySource::numLatencySources] = { 0, 0, 0 };
 	
 	Array<CustomTypeFace> customTypeFaces;
 	ValueTree customTypeFaceData;
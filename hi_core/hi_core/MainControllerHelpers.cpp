@@ -1237,7 +1237,7 @@ void DelayedRenderer::prepareToPlayWrapped(double sampleRate, int samplesPerBloc
 
 			delayedMidiBuffer.ensureSize(1024);
 
-			dynamic_cast<AudioProcessor*>(mc)->setLatencySamples(fullBlockSize);
+			mc->setLatencySamplesForSource(MainController::LatencySource::DelayedRendering, fullBlockSize);
 
 
 		}
@@ -340,4 +340,98 @@ void MainController::CodeHandler::handleAsyncUpdate()
 #endif
 }
 
+Array<Processor*> MainController::ProcessorRegistry::getProcessorsWithId(const String& id, const Processor* root, bool* usedIndex)
+{
+	Array<Processor*> matches;
+
+	if (root == nullptr)
+		root = mc->getMainSynthChain();
+
+	auto isAudioThread = mc->getKillStateHandler().getCurrentThread() == KillStateHandler::AudioThread;
+
+	if (!isAudioThread && isPartOfTree(root, mc->getMainSynthChain()))
+	{
+		rebuildIfNecessary();
+
+		Array<WeakReference<Processor>> candidates;
+
+		{
+			ScopedLock sl(indexLock);
+			candidates = index[id];
+		}
+
+		for (auto p : candidates)
+		{
+			if (p != nullptr && p->getId() == id && isPartOfTree(p, root))
+				matches.add(p.get());
+		}
+
+		if (!matches.isEmpty())
+		{
+			if (usedIndex != nullptr)
+				*usedIndex = true;
+
+			return matches;
+		}
+	}
+
+	// The processor might not have been indexed yet, so we need to walk the tree
+	return walkTree(id, root);
+}
+
+Array<Processor*> MainController::ProcessorRegistry::walkTree(const String& id, const Processor* root) const
+{
+	Array<Processor*> matches;
+
+	if (root == nullptr)
+		root = mc->getMainSynthChain();
+
+	Processor::Iterator<Processor> iter(const_cast<Processor*>(root), false);
+
+	while (auto p = iter.getNextProcessor())
+	{
+		if (p->getId() == id)
+			matches.add(p);
+	}
+
+	return matches;
+}
+
+void MainController::ProcessorRegistry::rebuildIfNecessary()
+{
+	auto currentGeneration = generation.load();
+
+	if (indexedGeneration == currentGeneration)
+		return;
+
+	// Build the new index without holding the index lock (the iterator takes the iterator lock)
+	HashMap<String, Array<WeakReference<Processor>>> newIndex;
+
+	Processor::Iterator<Processor> iter(mc->getMainSynthChain(), false);
+
+	while (auto p = iter.getNextProcessor())
+	{
+		auto list = newIndex[p->getId()];
+		list.add(p);
+		newIndex.set(p->getId(), list);
+	}
+
+	ScopedLock sl(indexLock);
+	index.swapWith(newIndex);
+	indexedGeneration = currentGeneration;
+}
+
+bool MainController::ProcessorRegistry::isPartOfTree(const Processor* p, const Processor* root) const
+{
+	while (p != nullptr)
+	{
+		if (p == root)
+			return true;
+
+		p = p->getParentProcessor(false, false);
+	}
+
+	return false;
+}
+
 } // namespace hise
@@ -206,11 +206,12 @@ const ValueTree MainController::SampleManager::getLoadedSampleMap(const String &
 
 void MainController::SampleManager::setDiskMode(DiskMode mode) noexcept
 {
-	if (hddMode != (mode == DiskMode::HDD))
+	if (hddMode != (mode == DiskMode::HDD) || adaptiveMode != (mode == DiskMode::Adaptive))
 	{
 		mc->allNotesOff();
 
 		hddMode = mode == DiskMode::HDD;
+		adaptiveMode = mode == DiskMode::Adaptive;
 
 		const int multplier = hddMode ? 2 : 1;
 
@@ -219,6 +220,7 @@ void MainController::SampleManager::setDiskMode(DiskMode mode) noexcept
 		while (ModulatorSampler* sampler = it.getNextProcessor())
 		{
 			sampler->setPreloadMultiplier(multplier);
+			sampler->setUseAdaptiveBufferSizes(adaptiveMode);
 		}
 	}
 }
@@ -319,27 +319,200 @@ void MainController::UserPresetHandler::TagDataBase::buildDataBase(bool force /*
 
 void MainController::UserPresetHandler::TagDataBase::buildInternal()
 {
-	cachedTags.clear();
+	if (!indexLoaded)
+		loadIndexFile();
 
-	Array<File> allPresets;
+	Array<CachedTag> newTags;
+	bool indexChanged = false;
+
+	scanDirectory(root, newTags, indexChanged);
+
+	indexChanged |= newTags.size() != cachedTags.size();
+
+	cachedTags.swapWith(newTags);
+	rebuildHashIndex();
+
+	if (indexChanged)
+		saveIndexFile();
+
+	dirty = false;
+}
+
+void MainController::UserPresetHandler::TagDataBase::scanDirectory(const File& directory, Array<CachedTag>& newTags, bool& indexChanged)
+{
+	// A preset that is younger than this might be changed again within the resolution of the
+	// file system timestamp, so its time is stored as unknown and it will be parsed again next time.
+	static constexpr int64 minAge = 2000;
 
-	root.findChildFiles(allPresets, File::findFiles, true, "*.preset");
+	const auto now = Time::currentTimeMillis();
+	auto getTimeToStore = [now](int64 t) { return (now - t) > minAge ? t : 0; };
 
-	PresetBrowser::DataBaseHelpers::cleanFileList(nullptr, allPresets);
+	Array<File> presets;
+	directory.findChildFiles(presets, File::findFiles, false, "*.preset");
+	PresetBrowser::DataBaseHelpers::cleanFileList(nullptr, presets);
 
-	for (auto f : allPresets)
+	for (auto f : presets)
 	{
-		auto sa = PresetBrowser::DataBaseHelpers::getTagsFromXml(f);
+		auto hash = f.hashCode64();
+		auto presetTime = f.getLastModificationTime().toMilliseconds();
+		auto presetSize = f.getSize();
+
+		if (auto t = getCachedTag(hash))
+		{
+			if (t->modificationTime != 0 && t->modificationTime == presetTime && t->fileSize == presetSize)
+			{
+				newTags.add(*t);
+				continue;
+			}
+		}
+
+		indexChanged = true;
 
 		CachedTag newTag;
-		newTag.hashCode = f.hashCode64();
-		for (auto t : sa)
-			newTag.tags.add(Identifier(t));
+		newTag.hashCode = hash;
+		newTag.relativePath = f.getRelativePathFrom(root);
+		newTag.name = f.getFileNameWithoutExtension();
+		newTag.modificationTime = getTimeToStore(presetTime);
+		newTag.fileSize = presetSize;
 
-		cachedTags.add(std::move(newTag));
+		for (auto t : PresetBrowser::DataBaseHelpers::getTagsFromXml(f))
+		{
+			if (t.isNotEmpty())
+				newTag.tags.add(Identifier(t));
+		}
+
+		newTags.add(std::move(newTag));
 	}
 
-	dirty = false;
+	Array<File> subDirectories;
+	directory.findChildFiles(subDirectories, File::findDirectories, false);
+
+	for (auto sub : subDirectories)
+	{
+		if (!sub.isHidden() && !sub.getFileName().startsWith("."))
+			scanDirectory(sub, newTags, indexChanged);
+	}
+}
+
+void MainController::UserPresetHandler::TagDataBase::loadIndexFile()
+{
+	indexLoaded = true;
+	cachedTags.clear();
+
+	auto data = JSON::parse(getIndexFile());
+
+	if (auto list = data["Presets"].getArray())
+	{
+		cachedTags.ensureStorageAllocated(list->size());
+
+		for (const auto& entry : *list)
+		{
+			CachedTag t;
+			t.relativePath = entry["File"].toString();
+			t.name = entry["Name"].toString();
+			t.modificationTime = (int64)entry["ModificationTime"];
+			t.fileSize = (int64)entry["Size"];
+			t.hashCode = root.getChildFile(t.relativePath).hashCode64();
+
+			if (auto tags = entry["Tags"].getArray())
+			{
+				for (const auto& tag : *tags)
+				{
+					if (tag.toString().isNotEmpty())
+						t.tags.add(Identifier(tag.toString()));
+				}
+			}
+
+			cachedTags.add(std::move(t));
+		}
+	}
+
+	rebuildHashIndex();
+}
+
+void MainController::UserPresetHandler::TagDataBase::rebuildHashIndex()
+{
+	hashIndex.clear();
+
+	for (int i = 0; i < cachedTags.size(); i++)
+		hashIndex.set(cachedTags.getReference(i).hashCode, i + 1);
+}
+
+void MainController::UserPresetHandler::TagDataBase::saveIndexFile() const
+{
+	if (!root.isDirectory())
+		return;
+
+	Array<var> presetList;
+	presetList.ensureStorageAllocated(cachedTags.size());
+
+	for (const auto& t : cachedTags)
+	{
+		DynamicObject::Ptr entry = new DynamicObject();
+
+		Array<var> tags;
+
+		for (auto tag : t.tags)
+			tags.add(tag.toString());
+
+		entry->setProperty("File", t.relativePath);
+		entry->setProperty("Name", t.name);
+		entry->setProperty("ModificationTime", t.modificationTime);
+		entry->setProperty("Size", t.fileSize);
+		entry->setProperty("Tags", var(tags));
+
+		presetList.add(var(entry.get()));
+	}
+
+	DynamicObject::Ptr data = new DynamicObject();
+	data->setProperty("Presets", var(presetList));
+
+	getIndexFile().replaceWithText(JSON::toString(var(data.get()), true));
+}
+
+Array<File> MainController::UserPresetHandler::TagDataBase::getPresetsWithPrefix(const String& prefix) const
+{
+	Array<File> matches;
+
+	for (const auto& t : cachedTags)
+	{
+		if (t.name.startsWithIgnoreCase(prefix))
+			matches.add(root.getChildFile(t.relativePath));
+	}
+
+	return matches;
+}
+
+Array<File> MainController::UserPresetHandler::TagDataBase::getPresetsWithTags(const StringArray& tagsToMatch) const
+{
+	Array<Identifier> ids;
+
+	for (auto t : tagsToMatch)
+	{
+		if (t.isNotEmpty())
+			ids.add(Identifier(t));
+	}
+
+	Array<File> matches;
+
+	for (const auto& t : cachedTags)
+	{
+		bool matchesAll = true;
+
+		for (const auto& id : ids)
+		{
+			if (!t.tags.contains(id))
+			{
+				matchesAll = false;
+				break;
+			}
+		}
+
+		if (matchesAll)
+			matches.add(root.getChildFile(t.relativePath));
+	}
+
+	return matches;
 }
 
 void MainController::UserPresetHandler::TagDataBase::setRootDirectory(const File& newRoot)
@@ -349,6 +522,7 @@ void MainController::UserPresetHandler::TagDataBase::setRootDirectory(const File
 	{
 		root = newRoot;
 		dirty = true;
+		indexLoaded = false;
 	}
 }
 
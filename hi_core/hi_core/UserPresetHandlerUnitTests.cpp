@@ -0,0 +1,141 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+struct UserPresetTagDataBaseUnitTests : public UnitTest
+{
+	using TagDataBase = MainController::UserPresetHandler::TagDataBase;
+
+	UserPresetTagDataBaseUnitTests() :
+		UnitTest("Testing the user preset tag database")
+	{}
+
+	void writePreset(const File& f, const String& tags)
+	{
+		f.replaceWithText("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n\n<Preset Tags=\"" + tags + "\"/>\n");
+
+		// Presets that were just written are not trusted by the index, so we pretend they are older
+		f.setLastModificationTime(oldTime);
+	}
+
+	void editPresetInPlace(const File& f, const String& tags)
+	{
+		FileOutputStream fos(f);
+		fos.setPosition(0);
+		fos.truncate();
+		fos.writeText("<Preset Tags=\"" + tags + "\"/>", false, false, nullptr);
+	}
+
+	int getNumPresetsWithTag(TagDataBase& db, const String& tag)
+	{
+		return db.getPresetsWithTags(StringArray(tag)).size();
+	}
+
+	void runTest() override
+	{
+		auto root = File::getSpecialLocation(File::tempDirectory).getNonexistentChildFile("PresetTagIndexTest", "");
+		auto bank = root.getChildFile("Bank");
+		auto pad = bank.getChildFile("Pad.preset");
+		auto lead = root.getChildFile("Lead.preset");
+
+		bank.createDirectory();
+
+		writePreset(lead, "Bright;Mono");
+		writePreset(pad, "Warm;;Bright;");
+		writePreset(bank.getChildFile(".Hidden.preset"), "Bright");
+
+		beginTest("Testing the initial build");
+
+		TagDataBase db;
+		db.setRootDirectory(root);
+		db.buildDataBase();
+
+		expectEquals(db.getCachedTags().size(), 2, "Preset amount mismatch");
+		expectEquals(getNumPresetsWithTag(db, "Bright"), 2, "Bright");
+		expectEquals(getNumPresetsWithTag(db, "Warm"), 1, "Warm");
+		expect(db.getPresetsWithPrefix("le").getFirst() == lead, "Prefix");
+		expect(db.getIndexFile().existsAsFile(), "No index file");
+
+		auto padTag = db.getCachedTag(pad.hashCode64());
+		expect(padTag != nullptr && padTag->tags.size() == 2, "Empty tags are not skipped");
+
+		beginTest("Testing the index file");
+
+		TagDataBase db2;
+		db2.setRootDirectory(root);
+		db2.buildDataBase();
+
+		expectEquals(db2.getCachedTags().size(), 2, "Index file wasn't restored");
+		expectEquals(getNumPresetsWithTag(db2, "Warm"), 1, "Warm");
+
+		beginTest("Testing presets that are edited in place");
+
+		editPresetInPlace(pad, "Dark");
+		db2.buildDataBase(true);
+
+		expectEquals(getNumPresetsWithTag(db2, "Dark"), 1, "Edited preset not updated");
+		expectEquals(getNumPresetsWithTag(db2, "Warm"), 0, "Old tags not removed");
+
+		// Restoring the old modification time must still be detected through the file size
+		editPresetInPlace(lead, "Dark;Mono;Wide");
+		lead.setLastModificationTime(oldTime);
+		db2.buildDataBase(true);
+
+		expectEquals(getNumPresetsWithTag(db2, "Wide"), 1, "Changed file size not detected");
+
+		beginTest("Testing added and removed presets");
+
+		writePreset(bank.getChildFile("Keys.preset"), "Dark");
+		lead.deleteFile();
+		db2.buildDataBase(true);
+
+		expectEquals(db2.getCachedTags().size(), 2, "Preset amount mismatch after add / remove");
+		expectEquals(getNumPresetsWithTag(db2, "Dark"), 2, "Added preset not found");
+		expectEquals(getNumPresetsWithTag(db2, "Mono"), 0, "Removed preset still found");
+
+		root.deleteRecursively();
+	}
+
+	const Time oldTime = Time::getCurrentTime() - RelativeTime::hours(1);
+};
+
+static UserPresetTagDataBaseUnitTests userPresetTagDataBaseTestInstance;
+
+#endif
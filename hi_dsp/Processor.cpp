@@ -466,16 +466,8 @@ String FactoryType::getUniqueName(Processor *id, String name/*=String()*/)
 
 Processor *ProcessorHelpers::getFirstProcessorWithName(const Processor *root, const String &name)
 {
-	Processor::Iterator<Processor> iter(const_cast<Processor*>(root), false);
-
-	Processor *p;
-
-	while((p = iter.getNextProcessor()) != nullptr)
-	{
-		if(p->getId() == name) return p;
-	}
-
-	return nullptr;
+	auto mc = const_cast<MainController*>(root->getMainController());
+	return mc->getProcessorRegistry().getFirstProcessorWithId<Processor>(name, root);
 }
 
 
@@ -423,6 +423,8 @@ public:
 			idAsIdentifier = Identifier();
 		}
 
+		getMainController()->getProcessorRegistry().bumpGeneration();
+
 		sendChangeMessage();
 
 		if (notifyChangeHandler)
@@ -597,7 +599,25 @@ public:
 		float outR;
 	};
 
-	DisplayValues getDisplayValues() const { return currentValues;};
+	/** Returns the current peak values. 
+	*
+	*	This also marks the metering of this processor as active (see isMeteringActive()).
+	*/
+	DisplayValues getDisplayValues() const 
+	{ 
+		lastDisplayRequestTime.store(Time::getMillisecondCounter());
+		return currentValues;
+	};
+
+	/** Returns true if the peak values of this processor were requested within the last second.
+	*
+	*	The peak meters are polled by timers (in the editor and in scripts), so if nobody has asked
+	*	for the values recently, the audio thread can skip the peak calculation altogether.
+	*/
+	bool isMeteringActive() const noexcept
+	{
+		return Time::getMillisecondCounter() - lastDisplayRequestTime.load() < 1000;
+	}
 
 	struct BypassListener
 	{
@@ -867,6 +887,8 @@ public:
 
 		parentProcessor = newParent;
 
+		getMainController()->getProcessorRegistry().bumpGeneration();
+
 		for (int i = 0; i < getNumChildProcessors(); i++)
 			getChildProcessor(i)->setParentProcessor(this);
 	}
@@ -955,6 +977,8 @@ private:
 	float inputValue;
 	double outputValue;
 
+	mutable std::atomic<uint32> lastDisplayRequestTime = { 0 };
+
 	bool bypassed;
 	bool visible;
 
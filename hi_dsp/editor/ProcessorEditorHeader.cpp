@@ -36,6 +36,7 @@ namespace hise { using namespace juce;
 
 ProcessorEditorHeader::ProcessorEditorHeader(ProcessorEditor *p) :
 	ProcessorEditorChildComponent(p),
+	SimpleTimer(p->getProcessor()->getMainController()->getGlobalUIUpdater(), false),
 	isSoloHeader(false)
 {
 	setLookAndFeel();
@@ -50,12 +51,13 @@ ProcessorEditorHeader::ProcessorEditorHeader(ProcessorEditor *p) :
 	valueMeter->setColour (VuMeter::ledColour, Colours::lightgrey);
 	valueMeter->setColour (VuMeter::outlineColour, isHeaderOfModulatorSynth() ? Colour (0x45000000) : Colour (0x45ffffff));
 	
-	#if JUCE_DEBUG
-	startTimer(150);
-#else
-	startTimer(30);
+#if JUCE_DEBUG
+	setTimerPriority(Priority::Low);
 #endif
 
+	setComponentToCheck(this);
+	start();
+
     addAndMakeVisible (idLabel = new Label ("ID Label",
                                             TRANS("ModulatorName")));
     idLabel->setTooltip (TRANS("The Modulator ID"));
@@ -47,7 +47,7 @@ class ProcessorEditorHeader  : public ProcessorEditorChildComponent,
 							   public LabelListener,
                                public ButtonListener,
 							   public GlobalScriptCompileListener,
-							   public Timer
+							   public PooledUIUpdater::SimpleTimer
 {
 public:
 
@@ -370,8 +370,11 @@ public:
 					}
 				}
 
-				currentValues.outL = softBypassState == Bypassed ? 0.0f : stereoBuffer.getMagnitude(0, 0, samplesToUse);
-				currentValues.outR = softBypassState == Bypassed ? 0.0f : stereoBuffer.getMagnitude(1, 0, samplesToUse);
+				if (isMeteringActive())
+				{
+					currentValues.outL = softBypassState == Bypassed ? 0.0f : stereoBuffer.getMagnitude(0, 0, samplesToUse);
+					currentValues.outR = softBypassState == Bypassed ? 0.0f : stereoBuffer.getMagnitude(1, 0, samplesToUse);
+				}
 			}
 			else
 			{
@@ -379,8 +382,11 @@ public:
 				isTailing = !isSilent(stereoBuffer, 0, samplesToUse);
 
 #if ENABLE_ALL_PEAK_METERS
-				currentValues.outL = stereoBuffer.getMagnitude(0, 0, samplesToUse);
-				currentValues.outR = stereoBuffer.getMagnitude(1, 0, samplesToUse);
+				if (isMeteringActive())
+				{
+					currentValues.outL = stereoBuffer.getMagnitude(0, 0, samplesToUse);
+					currentValues.outR = stereoBuffer.getMagnitude(1, 0, samplesToUse);
+				}
 #endif
 			}
 
@@ -511,8 +517,11 @@ public:
 		}
 
 #if ENABLE_ALL_PEAK_METERS
-		currentValues.outL = buffer.getMagnitude(0, startSample, numSamples);
-		currentValues.outR = buffer.getMagnitude(1, startSample, numSamples);
+		if (isMeteringActive())
+		{
+			currentValues.outL = buffer.getMagnitude(0, startSample, numSamples);
+			currentValues.outR = buffer.getMagnitude(1, startSample, numSamples);
+		}
 #endif
 	}
 };
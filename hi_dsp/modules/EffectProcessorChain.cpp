@@ -74,8 +74,11 @@ void EffectProcessorChain::renderMasterEffects(AudioSampleBuffer &b)
 	}
 
 #if ENABLE_ALL_PEAK_METERS
-	currentValues.outL = (b.getMagnitude(0, 0, b.getNumSamples()));
-	currentValues.outR = (b.getMagnitude(1, 0, b.getNumSamples()));
+	if (isMeteringActive())
+	{
+		currentValues.outL = (b.getMagnitude(0, 0, b.getNumSamples()));
+		currentValues.outR = (b.getMagnitude(1, 0, b.getNumSamples()));
+	}
 #endif
 }
 
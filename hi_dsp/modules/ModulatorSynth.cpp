@@ -435,37 +435,67 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 
 	effectChain->renderMasterEffects(thisInternalBuffer);
 
-	for (int i = 0; i < thisInternalBuffer.getNumChannels(); i++)
+	mixIntoOutputBuffer(thisInternalBuffer, outputBuffer, numSamplesFixed);
+}
+
+void ModulatorSynth::mixIntoOutputBuffer(const AudioSampleBuffer& source, AudioSampleBuffer& outputBuffer, int numSamples)
+{
+	const bool showMatrixPeaks = getMatrix().isEditorShown();
+	const bool showPeaks = isPeakDisplayActive();
+
+	if (!showMatrixPeaks && !showPeaks)
 	{
-		const int destinationChannel = getMatrix().getConnectionForSourceChannel(i);
-		
-		if (destinationChannel >= 0 && destinationChannel < outputBuffer.getNumChannels())
+		for (int i = 0; i < source.getNumChannels(); i++)
 		{
-			const float thisGain = gain.load() * (i % 2 == 0 ? leftBalanceGain : rightBalanceGain);
-			FloatVectorOperations::addWithMultiply(outputBuffer.getWritePointer(destinationChannel, 0), thisInternalBuffer.getReadPointer(i, 0), thisGain, numSamplesFixed);
+			const int destinationChannel = getMatrix().getConnectionForSourceChannel(i);
+
+			if (destinationChannel >= 0 && destinationChannel < outputBuffer.getNumChannels())
+			{
+				const float thisGain = gain.load() * (i % 2 == 0 ? leftBalanceGain : rightBalanceGain);
+				FloatVectorOperations::addWithMultiply(outputBuffer.getWritePointer(destinationChannel, 0), source.getReadPointer(i, 0), thisGain, numSamples);
+			}
 		}
+
+		return;
 	}
 
-	if (getMatrix().isEditorShown())
+	float sourcePeaks[NUM_MAX_CHANNELS];
+	float destinationPeaks[NUM_MAX_CHANNELS];
+	bool destinationWasMeasured[NUM_MAX_CHANNELS] = { false };
+
+	for (int i = 0; i < source.getNumChannels(); i++)
 	{
-		float gainValues[NUM_MAX_CHANNELS];
+		const int destinationChannel = getMatrix().getConnectionForSourceChannel(i);
 
-		for (int i = 0; i < thisInternalBuffer.getNumChannels(); i++)
+		if (destinationChannel >= 0 && destinationChannel < outputBuffer.getNumChannels())
+		{
+			const float thisGain = gain.load() * (i % 2 == 0 ? leftBalanceGain : rightBalanceGain);
+
+			// The last write to a destination channel measures its final peak value
+			sourcePeaks[i] = FusedVectorOperations::addWithMultiplyAndGetMagnitude(outputBuffer.getWritePointer(destinationChannel, 0), source.getReadPointer(i, 0), thisGain, numSamples, destinationPeaks + destinationChannel);
+			destinationWasMeasured[destinationChannel] = true;
+		}
+		else
 		{
-			gainValues[i] = thisInternalBuffer.getMagnitude(i, 0, numSamplesFixed);
+			sourcePeaks[i] = source.getMagnitude(i, 0, numSamples);
 		}
+	}
 
-		getMatrix().setGainValues(gainValues, true);
+	if (showMatrixPeaks)
+	{
+		getMatrix().setGainValues(sourcePeaks, true);
 
 		for (int i = 0; i < outputBuffer.getNumChannels(); i++)
 		{
-			gainValues[i] = outputBuffer.getMagnitude(i, 0, numSamplesFixed);
+			if (!destinationWasMeasured[i])
+				destinationPeaks[i] = outputBuffer.getMagnitude(i, 0, numSamples);
 		}
 
-		getMatrix().setGainValues(gainValues, false);
+		getMatrix().setGainValues(destinationPeaks, false);
 	}
 
-	handlePeakDisplay(numSamplesFixed);
+	if (showPeaks)
+		handlePeakDisplay(sourcePeaks[0], sourcePeaks[1]);
 }
 
 void ModulatorSynth::preVoiceRendering(int startSample, int numThisTime)
@@ -561,22 +591,20 @@ void ModulatorSynth::postVoiceRendering(int startSample, int numThisTime)
 	if (!isChainDisabled(EffectChain)) effectChain->renderNextBlock(internalBuffer, startSample, numThisTime);
 }
 
-void ModulatorSynth::handlePeakDisplay(int numSamplesInOutputBuffer)
+bool ModulatorSynth::isPeakDisplayActive() const
 {
-#if ENABLE_ALL_PEAK_METERS
-	
-	currentValues.outL = gain * internalBuffer.getMagnitude(0, 0, numSamplesInOutputBuffer) * leftBalanceGain;
-	currentValues.outR = gain * internalBuffer.getMagnitude(1, 0, numSamplesInOutputBuffer) * rightBalanceGain;
-	
-#else
+#if !ENABLE_ALL_PEAK_METERS
+	if (this != getMainController()->getMainSynthChain())
+		return false;
+#endif
 
-	if (this == getMainController()->getMainSynthChain())
-	{
-		currentValues.outL = gain * internalBuffer.getMagnitude(0, 0, numSamplesInOutputBuffer) * leftBalanceGain;
-		currentValues.outR = gain * internalBuffer.getMagnitude(1, 0, numSamplesInOutputBuffer) * rightBalanceGain;
-	}
+	return isMeteringActive();
+}
 
-#endif
+void ModulatorSynth::handlePeakDisplay(float leftMagnitude, float rightMagnitude)
+{
+	currentValues.outL = gain * leftMagnitude * leftBalanceGain;
+	currentValues.outR = gain * rightMagnitude * rightBalanceGain;
 }
 
 
@@ -181,7 +181,17 @@ public:
 
 	// ===================================================================================================================
 
-	virtual void handlePeakDisplay(int numSamplesInOutputBuffer);
+	/** Adds the internal buffer to the output buffer using the routing matrix, the gain and the balance of this synth.
+	*
+	*	If the peak meters or the routing matrix editor are active, the peak values are collected in the same pass.
+	*/
+	void mixIntoOutputBuffer(const AudioSampleBuffer& source, AudioSampleBuffer& outputBuffer, int numSamples);
+
+	/** Returns true if the peak values of this synth should be calculated. */
+	bool isPeakDisplayActive() const;
+
+	/** Sets the peak values from the magnitudes of the internal buffer (before gain and balance). */
+	virtual void handlePeakDisplay(float leftMagnitude, float rightMagnitude);
 	void setPeakValues(float l, float r);
 
 	// ===================================================================================================================
@@ -250,6 +260,36 @@ public:
 
 	bool isSoftBypassed() const { return bypassState; };
 
+	// ===================================================================================================================
+
+	/** Enables the measurement of the time this synth spends in renderNextBlockWithModulators().
+	*
+	*	This is used by the offline renderer to report the CPU usage of every child synth. The time is only measured
+	*	for direct children of a ModulatorSynthChain and includes the voices, modulators and effects of the synth.
+	*/
+	void setProfileRendering(bool shouldProfile) noexcept { profileRendering = shouldProfile; profiledRenderTime = 0.0; }
+
+	/** Returns the time in seconds that was spent rendering this synth since setProfileRendering() was called. */
+	double getProfiledRenderTime() const noexcept { return profiledRenderTime; }
+
+	/** Measures the lifetime of this object and adds it to the profiled render time of the synth. */
+	struct ScopedRenderProfiler
+	{
+		ScopedRenderProfiler(ModulatorSynth* s_) :
+			s(s_->profileRendering ? s_ : nullptr),
+			startTicks(s != nullptr ? Time::getHighResolutionTicks() : 0)
+		{}
+
+		~ScopedRenderProfiler()
+		{
+			if (s != nullptr)
+				s->profiledRenderTime += Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+		}
+
+		ModulatorSynth* s;
+		const int64 startTicks;
+	};
+
 	void deleteAllVoices();
     
 	virtual void resetAllVoices();
@@ -580,6 +620,9 @@ private:
 	std::atomic<bool> bypassState;
 
     bool anyTimerActive = false;
+
+	bool profileRendering = false;
+	double profiledRenderTime = 0.0;
     
 	// ===================================================================================================================
 
@@ -79,6 +79,7 @@ ModulatorSynthChain::~ModulatorSynthChain()
 {
 	modChains.clear();
 
+	fadingSynths.clear();
 	getHandler()->clear();
 
 	effectChain = nullptr;
@@ -126,6 +127,9 @@ void ModulatorSynthChain::prepareToPlay(double newSampleRate, int samplesPerBloc
 	ModulatorSynth::prepareToPlay(newSampleRate, samplesPerBlock);
 
 	for (int i = 0; i < synths.size(); i++) synths[i]->prepareToPlay(newSampleRate, samplesPerBlock);
+	for (auto s : fadingSynths) s->prepareToPlay(newSampleRate, samplesPerBlock);
+
+	fadeBuffer.setSize(NUM_MAX_CHANNELS, samplesPerBlock);
 }
 
 void ModulatorSynthChain::numSourceChannelsChanged()
@@ -247,9 +251,14 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	for (int i = 0; i < synths.size(); i++)
     {
         if (!synths[i]->isSoftBypassed())
+        {
+            ModulatorSynth::ScopedRenderProfiler srp(synths[i]);
             synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+        }
     }
 
+	renderFadingSynths(numSamples);
+
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
 
 	while (auto e = eventIterator.getNextConstEventPointer(true, false))
@@ -272,44 +281,27 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	{
 		jassert(internalBuffer.getNumChannels() == getMatrix().getNumSourceChannels());
 
-		for (int i = 0; i < internalBuffer.getNumChannels(); i++)
+		mixIntoOutputBuffer(internalBuffer, buffer, numSamples);
+	}
+	else // save some cycles on non multichannel buffers...
+	{
+		float* l = buffer.getWritePointer(0, 0);
+		float* r = buffer.getWritePointer(1, 0);
+
+		if (isPeakDisplayActive())
 		{
-			const int sourceIndex = i;
-			const int destinationIndex = getMatrix().getConnectionForSourceChannel(i);
+			// Display the output
+			const float peakL = FusedVectorOperations::addWithMultiplyAndGetMagnitude(l, internalBuffer.getReadPointer(0, 0), getGain() * getBalance(false), numSamples);
+			const float peakR = FusedVectorOperations::addWithMultiplyAndGetMagnitude(r, internalBuffer.getReadPointer(1, 0), getGain() * getBalance(true), numSamples);
 
-			if (destinationIndex >= 0 && destinationIndex < buffer.getNumChannels())
-			{
-				FloatVectorOperations::addWithMultiply(buffer.getWritePointer(destinationIndex, 0), internalBuffer.getReadPointer(sourceIndex, 0), getGain() * getBalance(i % 2 != 0), numSamples);
-			}
+			handlePeakDisplay(peakL, peakR);
 		}
-
-		if (getMatrix().isEditorShown())
+		else
 		{
-			float gainValues[NUM_MAX_CHANNELS];
-
-			for (int i = 0; i < internalBuffer.getNumChannels(); i++)
-			{
-				gainValues[i] = FloatVectorOperations::findMaximum(internalBuffer.getReadPointer(i), numSamples);
-			}
-
-			getMatrix().setGainValues(gainValues, true);
-
-			for (int i = 0; i < buffer.getNumChannels(); i++)
-			{
-				gainValues[i] = FloatVectorOperations::findMaximum(buffer.getReadPointer(i), numSamples);
-			}
-
-			getMatrix().setGainValues(gainValues, false);
+			FloatVectorOperations::addWithMultiply(l, internalBuffer.getReadPointer(0, 0), getGain() * getBalance(false), numSamples);
+			FloatVectorOperations::addWithMultiply(r, internalBuffer.getReadPointer(1, 0), getGain() * getBalance(true), numSamples);
 		}
 	}
-	else // save some cycles on non multichannel buffers...
-	{
-		FloatVectorOperations::addWithMultiply(buffer.getWritePointer(0, 0), internalBuffer.getReadPointer(0, 0), getGain() * getBalance(false), numSamples);
-		FloatVectorOperations::addWithMultiply(buffer.getWritePointer(1, 0), internalBuffer.getReadPointer(1, 0), getGain() * getBalance(true), numSamples);
-	}
-
-	// Display the output
-	handlePeakDisplay(numSamples);
 
 #endif
 }
@@ -401,6 +393,9 @@ int ModulatorSynthChain::getNumActiveVoices() const
 	for (auto synth : synths)
 		totalVoices += synth->getNumActiveVoices();
 
+	for (auto synth : fadingSynths)
+		totalVoices += synth->getNumActiveVoices();
+
 	return totalVoices;
 }
 
@@ -409,6 +404,9 @@ void ModulatorSynthChain::killAllVoices()
 	for (auto synth : synths)
 		synth->killAllVoices();
 
+	for (auto synth : fadingSynths)
+		synth->killAllVoices();
+
 	effectChain->killMasterEffects();
 }
 
@@ -417,6 +415,9 @@ void ModulatorSynthChain::resetAllVoices()
 	for (auto synth : synths)
 		synth->resetAllVoices();
 
+	for (auto synth : fadingSynths)
+		synth->resetAllVoices();
+
 	effectChain->resetMasterEffects();
 }
 
@@ -430,10 +431,168 @@ bool ModulatorSynthChain::areVoicesActive() const
 		if (synth->areVoicesActive())
 			return true;
 	}
+
+	if (isFadingOut())
+		return true;
 		
 	return effectChain->hasTailingMasterEffects();
 }
 
+void ModulatorSynthChain::createChildSynthsFromValueTree(const ValueTree& v, OwnedArray<ModulatorSynth>& newSynths)
+{
+	LockHelpers::freeToGo(getMainController());
+
+	auto childProcessors = v.getChildWithName("ChildProcessors");
+
+	for (int i = 0; i < childProcessors.getNumChildren(); i++)
+	{
+		auto child = childProcessors.getChild(i);
+
+		const bool isFixedInternalChain = i < ModulatorSynth::numInternalChains;
+
+		if (isFixedInternalChain || child.getType() != Identifier("Processor"))
+			continue;
+
+		auto p = MainController::createProcessor(getFactoryType(), child.getProperty("Type", String()).toString(), child.getProperty("ID"));
+		auto ms = dynamic_cast<ModulatorSynth*>(p);
+
+		if (ms == nullptr)
+		{
+			delete p;
+			throw String("The Processor " + child.getProperty("ID").toString() + " could not be generated.");
+		}
+
+		ms->getMatrix().setNumDestinationChannels(getMatrix().getNumSourceChannels());
+		ms->getMatrix().setTargetProcessor(this);
+		ms->setParentProcessor(this);
+
+		newSynths.add(ms);
+
+		// The synth is not on air yet, so this will not interfere with the audio rendering
+		ms->restoreFromValueTree(child);
+
+		if (getSampleRate() > 0.0)
+			ms->prepareToPlay(getSampleRate(), getLargestBlockSize());
+	}
+}
+
+void ModulatorSynthChain::swapChildSynthsWithCrossfade(OwnedArray<ModulatorSynth>& newSynths, double fadeTimeSeconds)
+{
+	LockHelpers::freeToGo(getMainController());
+
+	// You need to dispose the last faded synths before swapping again...
+	jassert(fadingSynths.isEmpty());
+
+	const auto numSamplesToFade = jmax(1.0, fadeTimeSeconds * getSampleRate());
+
+	Array<Processor*> addedSynths;
+
+	{
+		LOCK_PROCESSING_CHAIN(this);
+
+		while (!synths.isEmpty())
+			fadingSynths.add(synths.removeAndReturn(0));
+
+		while (!newSynths.isEmpty())
+		{
+			auto ms = newSynths.removeAndReturn(0);
+			ms->setIsOnAir(isOnAir());
+			synths.add(ms);
+			addedSynths.add(ms);
+		}
+
+		fadeDelta = 1.0f / (float)numSamplesToFade;
+		fadeOutFinished.reset();
+		fadeGain.store(fadingSynths.isEmpty() ? 0.0f : 1.0f);
+	}
+
+	for (auto p : addedSynths)
+		getHandler()->notifyListeners(Chain::Handler::Listener::ProcessorAdded, p);
+}
+
+bool ModulatorSynthChain::waitForFadeOut(int timeoutMilliseconds)
+{
+	if (isFadingOut())
+		fadeOutFinished.wait(timeoutMilliseconds);
+
+	return !isFadingOut();
+}
+
+void ModulatorSynthChain::disposeFadedOutSynths()
+{
+	LockHelpers::freeToGo(getMainController());
+
+	jassert(!isFadingOut());
+
+	OwnedArray<ModulatorSynth> synthsToDelete;
+
+	{
+		LOCK_PROCESSING_CHAIN(this);
+
+		while (!fadingSynths.isEmpty())
+		{
+			auto ms = fadingSynths.removeAndReturn(0);
+			ms->setIsOnAir(false);
+			synthsToDelete.add(ms);
+		}
+
+		fadeGain.store(0.0f);
+	}
+
+	while (!synthsToDelete.isEmpty())
+	{
+		auto ms = synthsToDelete.removeAndReturn(0);
+		getHandler()->notifyListeners(Chain::Handler::Listener::ProcessorDeleted, ms);
+		getMainController()->getGlobalAsyncModuleHandler().removeAsync(ms, ProcessorFunction());
+	}
+}
+
+void ModulatorSynthChain::renderFadingSynths(int numSamples)
+{
+	if (fadingSynths.isEmpty())
+		return;
+
+	const float startGain = fadeGain.load();
+
+	if (startGain <= 0.0f)
+		return;
+
+	const float endGain = jmax(0.0f, startGain - fadeDelta * (float)numSamples);
+
+	// The old synths only get the events that end their held notes so that they can go into their release phase
+	fadeEventBuffer.clear();
+
+	HiseEventBuffer::Iterator it(eventBuffer);
+
+	while (auto e = it.getNextConstEventPointer(true, false))
+	{
+		if (e->isNoteOff() || e->isAllNotesOff() || e->isControllerOfType(64))
+			fadeEventBuffer.addEvent(*e);
+	}
+
+	fadeBuffer.setSize(internalBuffer.getNumChannels(), numSamples, false, false, true);
+	fadeBuffer.clear();
+
+	for (auto s : fadingSynths)
+	{
+		if (!s->isSoftBypassed())
+			s->renderNextBlockWithModulators(fadeBuffer, fadeEventBuffer);
+	}
+
+	// The internal buffer only contains the output of the new synths at this point, so fade them in
+	for (int i = 0; i < internalBuffer.getNumChannels(); i++)
+		internalBuffer.applyGainRamp(i, 0, numSamples, 1.0f - startGain, 1.0f - endGain);
+
+	for (int i = 0; i < fadeBuffer.getNumChannels(); i++)
+		internalBuffer.addFromWithRamp(i, 0, fadeBuffer.getReadPointer(i), numSamples, startGain, endGain);
+
+	fadeGain.store(endGain);
+
+	// This happens only once per swap, so the short lock in the event is OK
+	if (endGain <= 0.0f)
+		fadeOutFinished.signal();
+}
+
 
 void ModulatorSynthChain::saveInterfaceValues(ValueTree &v)
 {
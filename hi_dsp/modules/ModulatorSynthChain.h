@@ -188,6 +188,35 @@ public:
 
 	bool areVoicesActive() const override;
 
+	/** Creates and restores the child sound generators of the given ValueTree without adding them to this chain.
+	*
+	*	The synths will be prepared and their samples will be preloaded, so you can call this on the loading thread
+	*	while the audio is running. Throws a String if a processor can't be created.
+	*/
+	void createChildSynthsFromValueTree(const ValueTree& v, OwnedArray<ModulatorSynth>& newSynths);
+
+	/** Replaces the child sound generators with the given (already restored and prepared) synths.
+	*
+	*	The old synths will not be killed, but keep on rendering their active voices with a fade out ramp
+	*	(they only receive note offs and sustain pedal messages) while the new synths are faded in and
+	*	receive the incoming events. Call disposeFadedOutSynths() from
+	*	a background thread after isFadingOut() returns false (or waitForFadeOut() returns true) to get rid of them.
+	*/
+	void swapChildSynthsWithCrossfade(OwnedArray<ModulatorSynth>& newSynths, double fadeTimeSeconds);
+
+	/** Returns true if there are old synths that are still fading out after a swap. */
+	bool isFadingOut() const noexcept { return fadeGain.load() > 0.0f; }
+
+	/** Blocks the calling thread until the old synths are faded out or the timeout is reached.
+	*
+	*	The event is signalled by the audio thread, so if the audio callback stops while fading out,
+	*	this will wait until the timeout. Returns true if the fade out is finished.
+	*/
+	bool waitForFadeOut(int timeoutMilliseconds);
+
+	/** Removes the faded out synths from the audio rendering and deletes them asynchronously. */
+	void disposeFadedOutSynths();
+
 	/** Handles the ModulatorSynthChain. */
 	class ModulatorSynthChainHandler: public Chain::Handler
 	{
@@ -243,6 +272,15 @@ private:
 	ScopedPointer<FactoryType::Constrainer> constrainer;
 	String packageName;
 
+	void renderFadingSynths(int numSamples);
+
+	OwnedArray<ModulatorSynth> fadingSynths;
+	AudioSampleBuffer fadeBuffer;
+	HiseEventBuffer fadeEventBuffer;
+	std::atomic<float> fadeGain = { 0.0f };
+	float fadeDelta = 0.0f;
+	WaitableEvent fadeOutFinished;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(ModulatorSynthChain);
 };
 
@@ -639,8 +639,11 @@ void ModulatorSynthGroupVoice::calculateFMCarrierInternal(ModulatorSynthGroup *
 		}
 
 #if ENABLE_ALL_PEAK_METERS
-		const float peak2 = FloatVectorOperations::findMaximum(carrierVoice->getVoiceValues(0, startSample), numSamples);
-		carrierSynth->setPeakValues(peak2, peak2);
+		if (carrierSynth->isMeteringActive())
+		{
+			const float peak2 = FloatVectorOperations::findMaximum(carrierVoice->getVoiceValues(0, startSample), numSamples);
+			carrierSynth->setPeakValues(peak2, peak2);
+		}
 #endif
 
 		if (carrierVoice->getCurrentlyPlayingSound() == nullptr)
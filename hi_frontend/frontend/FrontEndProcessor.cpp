@@ -33,33 +33,67 @@
 namespace hise { using namespace juce;
 
 
-FrontendProcessor* FrontendFactory::createPluginWithAudioFiles(AudioDeviceManager* deviceManager, AudioProcessorPlayer* callback)
+void EmbeddedDataCache::initialise()
 {
-	ValueTree presetData; 
-	zstd::ZCompressor<PresetDictionaryProvider> pdec; 
+	if (initialised)
+		return;
+
+	LOG_START("Decompressing embedded preset");
+
 	MemoryBlock pBlock;
-	ScopedPointer<MemoryInputStream> pis = getEmbeddedData(FileHandlerBase::Presets);
+	ScopedPointer<MemoryInputStream> pis = FrontendFactory::getEmbeddedData(FileHandlerBase::Presets);
 	pis->readIntoMemoryBlock(pBlock);
+	zstd::ZCompressor<PresetDictionaryProvider> pdec;
 	pdec.expand(pBlock, presetData);
-	
-	/*ValueTree presetData = ValueTree::readFromData(PresetData::preset PresetData::presetSize);\*/ 
-	LOG_START("Loading embedded image data"); 
-	auto imageData = getEmbeddedData(FileHandlerBase::Images);
-	LOG_START("Loading embedded impulse responses"); 
-	auto impulseData = getEmbeddedData(FileHandlerBase::AudioFiles);
-	auto sampleMapData = getEmbeddedData(FileHandlerBase::SampleMaps);
-	auto midiData = getEmbeddedData(FileHandlerBase::MidiFiles);
 
-	LOG_START("Loading embedded other data")
+	LOG_START("Decompressing embedded scripts");
 
-	ValueTree externalFiles;
 	MemoryBlock eBlock;
-	ScopedPointer<MemoryInputStream> eis = getEmbeddedData(FileHandlerBase::Scripts);
+	ScopedPointer<MemoryInputStream> eis = FrontendFactory::getEmbeddedData(FileHandlerBase::Scripts);
 	eis->readIntoMemoryBlock(eBlock);
 	zstd::ZCompressor<JavascriptDictionaryProvider> edec;
 	edec.expand(eBlock, externalFiles);
 
-	//ValueTree externalFiles =  hise::PresetHandler::loadValueTreeFromData(PresetData::externalFiles, PresetData::externalFilesSize, true); 
+	LOG_START("Restoring precompiled script snapshots");
+
+	auto numSnapshots = HiseJavascriptEngine::TokenSnapshot::restoreSnapshotTree(externalFiles.getChildWithName("TokenSnapshots"));
+	ignoreUnused(numSnapshots);
+
+	LOG_START(String(numSnapshots) + " script snapshots restored");
+
+	initialised = true;
+}
+
+juce::ValueTree EmbeddedDataCache::createPresetCopy()
+{
+	ScopedLock sl(lock);
+	initialise();
+	return presetData.createCopy();
+}
+
+juce::ValueTree EmbeddedDataCache::getExternalFiles()
+{
+	ScopedLock sl(lock);
+	initialise();
+	return externalFiles;
+}
+
+FrontendProcessor* FrontendFactory::createPluginWithAudioFiles(AudioDeviceManager* deviceManager, AudioProcessorPlayer* callback)
+{
+	// The decompressed data is shared between all instances, so only the first instance has to expand it.
+	SharedResourcePointer<EmbeddedDataCache> cache;
+
+	LOG_START(cache.getNumberOfReferences() == 1 ? "Embedded data cache miss" : "Embedded data cache hit");
+
+	auto presetData = cache->createPresetCopy();
+	auto externalFiles = cache->getExternalFiles();
+
+	LOG_START("Loading embedded pool data"); 
+	auto imageData = getEmbeddedData(FileHandlerBase::Images);
+	auto impulseData = getEmbeddedData(FileHandlerBase::AudioFiles);
+	auto sampleMapData = getEmbeddedData(FileHandlerBase::SampleMaps);
+	auto midiData = getEmbeddedData(FileHandlerBase::MidiFiles);
+
 	LOG_START("Creating Frontend Processor")
 	auto fp = new hise::FrontendProcessor(presetData, deviceManager, callback, imageData, impulseData, sampleMapData, midiData, &externalFiles, nullptr); 
 
@@ -78,7 +112,7 @@ FrontendProcessor* FrontendFactory::createPluginWithAudioFiles(AudioDeviceManage
         fp->sendOverlayMessage(DeactiveOverlay::State::CriticalCustomErrorMessage, s);
     }
 	 
-	
+	LOG_START("Frontend Processor created");
 
 	return fp;
 }
@@ -385,7 +419,14 @@ void FrontendProcessor::createPreset(const ValueTree& synthData)
 	{
 		LOG_START("Compiling all scripts");
 		LockHelpers::SafeLock sl(this, LockHelpers::ScriptLock);
+
+		const auto compileStart = Time::getMillisecondCounterHiRes();
 		synthChain->compileAllScripts();
+		const auto compileTime = Time::getMillisecondCounterHiRes() - compileStart;
+
+		ignoreUnused(compileTime);
+
+		LOG_START("Scripts compiled in " + String(compileTime, 1) + "ms, " + HiseJavascriptEngine::TokenSnapshot::getStatistics().toString());
 	}
 
 
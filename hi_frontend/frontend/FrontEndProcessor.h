@@ -71,7 +71,40 @@ private:
 };
 #endif
 
+/** A process-wide cache for the decompressed embedded data of a compiled plugin.
 
+	Decompressing the preset and the external script data (scripts, fonts and docs) takes a significant
+	amount of time and memory, so it's done only once when the first instance is created and the result
+	is shared between all FrontendProcessor instances. Obtain it via a SharedResourcePointer - every 
+	FrontendProcessor holds a reference so the data is released when the last instance is deleted.
+
+	The external files are read-only and can be used directly. The preset data is copied for each instance
+	because the restoring of the module tree might alter it.
+*/
+class EmbeddedDataCache
+{
+public:
+
+	EmbeddedDataCache() {};
+
+	/** Returns a deep copy of the embedded preset that can be used by a new instance. */
+	ValueTree createPresetCopy();
+
+	/** Returns the shared external file data. Don't modify this tree! */
+	ValueTree getExternalFiles();
+
+private:
+
+	void initialise();
+
+	CriticalSection lock;
+	bool initialised = false;
+
+	ValueTree presetData;
+	ValueTree externalFiles;
+
+	JUCE_DECLARE_NON_COPYABLE(EmbeddedDataCache);
+};
 
 /** This class lets you take your exported HISE presets and wrap them into a hardcoded plugin (VST / AU, x86/x64, Win / OSX)
 *
@@ -200,6 +233,8 @@ public:
     
 private:
 
+	SharedResourcePointer<EmbeddedDataCache> embeddedDataCache;
+
     struct SuspendUpdater: private Timer
     {
         SuspendUpdater(FrontendProcessor& parent_):
@@ -32,11 +32,17 @@
 
 #include "hi_lac.h"
 
+#if JUCE_LINUX || JUCE_MAC
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "hlac/BitCompressors.cpp"
 #include "hlac/CompressionHelpers.cpp"
 #include "hlac/SampleBuffer.cpp"
 #include "hlac/HlacEncoder.cpp"
 #include "hlac/HlacDecoder.cpp"
+#include "hlac/HlacDecodeCache.cpp"
 #include "hlac/HlacAudioFormatWriter.cpp"
 #include "hlac/HlacAudioFormatReader.cpp"
 #include "hlac/HiseLosslessAudioFormat.cpp"
@@ -118,12 +118,23 @@ If enabled, then the unit test suite will be compiled and added to all unit test
 #define HLAC_INCLUDE_TEST_SUITE 0
 #endif
 
+//=============================================================================
+/** Config: HLAC_DECODE_CACHE_SIZE
+
+The number of decoded HLAC blocks (4096 samples each) that are kept in the cache shared by all monolith readers.
+Every block takes 16KB, so the default uses 4MB. Set this to 0 in order to disable the cache.
+*/
+#ifndef HLAC_DECODE_CACHE_SIZE
+#define HLAC_DECODE_CACHE_SIZE 256
+#endif
+
 
 #include "hlac/BitCompressors.h"
 #include "hlac/CompressionHelpers.h"
 #include "hlac/SampleBuffer.h"
 #include "hlac/HlacEncoder.h"
 #include "hlac/HlacDecoder.h"
+#include "hlac/HlacDecodeCache.h"
 #include "hlac/HlacAudioFormatWriter.h"
 #include "hlac/HlacAudioFormatReader.h"
 #include "hlac/HiseLosslessAudioFormat.h"
@@ -184,6 +184,22 @@ void HlacReaderCommon::setTargetAudioDataType(AudioDataConverters::DataFormat da
 		(dataType == AudioDataConverters::DataFormat::float32LE);
 }
 
+void HlacReaderCommon::setDecodeCache(HlacDecodeCache* cacheToUse, int64 fileKey)
+{
+	if (cacheToUse != nullptr && cacheToUse->isEnabled())
+	{
+		decodeCache = cacheToUse;
+		decodeCacheKey = fileKey;
+		decodedBlock = HiseSampleBuffer(false, (int)header.getNumChannels(), COMPRESSION_BLOCK_SIZE);
+	}
+	else
+	{
+		decodeCache = nullptr;
+		decodeCacheKey = 0;
+		decodedBlock = HiseSampleBuffer();
+	}
+}
+
 bool HlacReaderCommon::internalHlacRead(int** destSamples, int numDestChannels, int startOffsetInDestBuffer, int64 startSampleInFile, int numSamples)
 {
 	ignoreUnused(startSampleInFile);
@@ -289,6 +305,9 @@ bool HlacReaderCommon::fixedBufferRead(HiseSampleBuffer& buffer, int numDestChan
 	if (numSamples == 0)
 		return true;
 
+	if (decodeCache != nullptr)
+		return cachedFixedBufferRead(buffer, isStereo, startOffsetInBuffer, startSampleInFile, numSamples);
+
 	if (startSampleInFile != decoder.getCurrentReadPosition())
 	{
 		auto byteOffset = header.getOffsetForReadPosition(startSampleInFile, useHeaderOffsetWhenSeeking);
@@ -310,6 +329,86 @@ bool HlacReaderCommon::fixedBufferRead(HiseSampleBuffer& buffer, int numDestChan
 	return true;
 }
 
+void HlacReaderCommon::decodeBlockIntoCache(uint32 blockIndex, bool isStereo)
+{
+	// Always decode the entire block so that it can be stored in the cache
+	auto blockStart = blockIndex * COMPRESSION_BLOCK_SIZE;
+
+	decodedBlock.clear();
+	decodedBlock.clearNormalisation({});
+
+	if (blockStart != decoder.getCurrentReadPosition())
+	{
+		auto byteOffset = header.getOffsetForReadPosition(blockStart, useHeaderOffsetWhenSeeking);
+		decoder.seekToPosition(*input, blockStart, byteOffset);
+	}
+
+	decoder.decode(decodedBlock, isStereo, *input, (int)blockStart, COMPRESSION_BLOCK_SIZE);
+
+	decodeCache->store(decodeCacheKey, blockIndex, decodedBlock);
+}
+
+void HlacReaderCommon::decodeIntoCache(int64 startSampleInFile, int64 numSamples, HlacDecodeCache::PinnedBlocks* pinnedBlocks)
+{
+	// Uncompressed monoliths are read directly
+	if (decodeCache == nullptr || header.getVersion() < 2 || numSamples <= 0)
+		return;
+
+	decoder.setHlacVersion(header.getVersion());
+
+	const bool isStereo = header.getNumChannels() == 2;
+	const auto firstBlock = (uint32)(jmax<int64>(0, startSampleInFile) / COMPRESSION_BLOCK_SIZE);
+	const auto lastBlock = jmin<uint32>(header.getBlockAmount(), (uint32)((startSampleInFile + numSamples - 1) / COMPRESSION_BLOCK_SIZE) + 1);
+
+	for (auto blockIndex = firstBlock; blockIndex < lastBlock; blockIndex++)
+	{
+		if (!decodeCache->contains(decodeCacheKey, blockIndex))
+			decodeBlockIntoCache(blockIndex, isStereo);
+
+		if (pinnedBlocks != nullptr && pinnedBlocks->numBlocks < HlacDecodeCache::PinnedBlocks::MaxBlocks)
+		{
+			auto slotIndex = decodeCache->pin(decodeCacheKey, blockIndex);
+
+			if (slotIndex != -1)
+				pinnedBlocks->slotIndexes[pinnedBlocks->numBlocks++] = slotIndex;
+		}
+	}
+}
+
+bool HlacReaderCommon::cachedFixedBufferRead(HiseSampleBuffer& buffer, bool isStereo, int startOffsetInBuffer, int64 startSampleInFile, int numSamples)
+{
+	decoder.setHlacVersion(header.getVersion());
+
+	// The decoder does this when it writes directly into the buffer
+	if (header.getVersion() > 2 && startOffsetInBuffer == 0)
+		buffer.allocateNormalisationTables((int)startSampleInFile);
+
+	while (numSamples > 0)
+	{
+		auto blockIndex = (uint32)(startSampleInFile / COMPRESSION_BLOCK_SIZE);
+		auto offsetInBlock = (int)(startSampleInFile % COMPRESSION_BLOCK_SIZE);
+		auto numThisTime = jmin<int>(numSamples, COMPRESSION_BLOCK_SIZE - offsetInBlock);
+
+		if (blockIndex >= header.getBlockAmount())
+		{
+			buffer.clear(startOffsetInBuffer, numSamples);
+			return true;
+		}
+
+		if (!decodeCache->read(decodeCacheKey, blockIndex, buffer, startOffsetInBuffer, offsetInBlock, numThisTime))
+		{
+			decodeBlockIntoCache(blockIndex, isStereo);
+			HiseSampleBuffer::copy(buffer, decodedBlock, startOffsetInBuffer, offsetInBlock, numThisTime);
+		}
+
+		startOffsetInBuffer += numThisTime;
+		startSampleInFile += numThisTime;
+		numSamples -= numThisTime;
+	}
+
+	return true;
+}
+
 void HiseLosslessAudioFormatReader::copySampleData(int* const* destSamples, int startOffsetInDestBuffer, int numDestChannels, const void* sourceData, int numChannels, int numSamples) noexcept
 {
 	jassert(numDestChannels == numDestChannels);
@@ -464,6 +563,58 @@ bool HlacMemoryMappedAudioFormatReader::mapSectionOfFile(Range<int64> samplesToM
 	}
 }
 
+void HlacMemoryMappedAudioFormatReader::adviseWillNeed(int64 startSampleInFile, int64 numSamples)
+{
+#if JUCE_LINUX || JUCE_MAC
+	if (map == nullptr || numSamples <= 0)
+		return;
+
+	const uint8* start = nullptr;
+	size_t numBytes = 0;
+
+	if (isMonolith)
+	{
+		auto range = Range<int64>(startSampleInFile, startSampleInFile + numSamples).getIntersectionWith(mappedSection);
+
+		if (range.isEmpty())
+			return;
+
+		start = (const uint8*)sampleToPointer(range.getStart());
+		numBytes = (size_t)(range.getLength() * bytesPerFrame);
+	}
+	else
+	{
+		// The byte offsets are relative to the start of the mapped data, so this only works if the entire file is mapped
+		if (mis == nullptr || mappedSection.getStart() != 0)
+			return;
+
+		auto& header = internalReader.header;
+		const auto firstBlock = (uint32)(jmax<int64>(0, startSampleInFile) / COMPRESSION_BLOCK_SIZE);
+		const auto endBlock = (uint32)((startSampleInFile + numSamples - 1) / COMPRESSION_BLOCK_SIZE) + 1;
+
+		if (firstBlock >= header.getBlockAmount())
+			return;
+
+		const auto startByte = (size_t)header.getOffsetForReadPosition(firstBlock * COMPRESSION_BLOCK_SIZE, false);
+		const auto endByte = endBlock < header.getBlockAmount() ? (size_t)header.getOffsetForReadPosition(endBlock * COMPRESSION_BLOCK_SIZE, false) : mis->getDataSize();
+
+		if (endByte <= startByte || endByte > mis->getDataSize())
+			return;
+
+		start = (const uint8*)mis->getData() + startByte;
+		numBytes = endByte - startByte;
+	}
+
+	// madvise needs a page aligned address
+	static const auto pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	const auto misalignment = (size_t)start % pageSize;
+
+	posix_madvise((void*)(start - misalignment), numBytes + misalignment, POSIX_MADV_WILLNEED);
+#else
+	ignoreUnused(startSampleInFile, numSamples);
+#endif
+}
+
 void HlacMemoryMappedAudioFormatReader::setTargetAudioDataType(AudioDataConverters::DataFormat dataType)
 {
 	usesFloatingPointData = (dataType == AudioDataConverters::DataFormat::float32BE) ||
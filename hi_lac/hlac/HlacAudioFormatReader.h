@@ -106,14 +106,32 @@ public:
 		useHeaderOffsetWhenSeeking = shouldUseHeaderOffset;
 	};
 
+	/** Looks up every block in the given cache before decoding it when reading into fixed buffers. 
+	*
+	*	The key must identify the file for all readers that use the cache (use HlacDecodeCache::createKeyForFile()). 
+	*/
+	void setDecodeCache(HlacDecodeCache* cacheToUse, int64 fileKey);
+
+	/** Decodes all blocks of the given range that are not cached yet in one sequential pass.
+	*
+	*	This is used to merge the reads of multiple voices that play nearby regions of the same file.
+	*	If pinnedBlocks is not null, the blocks are pinned until the caller unpins them after they were read.
+	*	It does nothing if no decode cache is set.
+	*/
+	void decodeIntoCache(int64 startSampleInFile, int64 numSamples, HlacDecodeCache::PinnedBlocks* pinnedBlocks=nullptr);
+
 private:
 
 	friend class HlacSubSectionReader;
 
+	void decodeBlockIntoCache(uint32 blockIndex, bool isStereo);
+
 	bool internalHlacRead(int** destSamples, int numDestChannels, int startOffsetInDestBuffer, int64 startSampleInFile, int numSamples);
 
 	bool fixedBufferRead(HiseSampleBuffer& buffer, int numDestChannels, int startOffsetInBuffer, int64 startSampleInFile, int numSamples);
 
+	bool cachedFixedBufferRead(HiseSampleBuffer& buffer, bool isStereo, int startOffsetInBuffer, int64 startSampleInFile, int numSamples);
+
 	
 
 	friend class HiseLosslessAudioFormatReader;
@@ -124,10 +142,13 @@ private:
 	HlacDecoder decoder;
 	HiseLosslessHeader header;
 
-	bool usesFloatingPointData;
+	bool usesFloatingPointData = true;
 
 	bool useHeaderOffsetWhenSeeking = true;
 
+	HlacDecodeCache* decodeCache = nullptr;
+	int64 decodeCacheKey = 0;
+	HiseSampleBuffer decodedBlock;
 };
 
 class HiseLosslessAudioFormatReader : public AudioFormatReader
@@ -141,6 +162,10 @@ public:
 
 	void setTargetAudioDataType(AudioDataConverters::DataFormat dataType);
 
+	void setDecodeCache(HlacDecodeCache* cacheToUse, int64 fileKey) { internalReader.setDecodeCache(cacheToUse, fileKey); }
+
+	void decodeIntoCache(int64 startSampleInFile, int64 numSamples, HlacDecodeCache::PinnedBlocks* pinnedBlocks=nullptr) { internalReader.decodeIntoCache(startSampleInFile, numSamples, pinnedBlocks); }
+
 private:
 
 	friend class HlacSubSectionReader;
@@ -188,6 +213,15 @@ public:
 
 	void setTargetAudioDataType(AudioDataConverters::DataFormat dataType);
 
+	void setDecodeCache(HlacDecodeCache* cacheToUse, int64 fileKey) { internalReader.setDecodeCache(cacheToUse, fileKey); }
+
+	void decodeIntoCache(int64 startSampleInFile, int64 numSamples, HlacDecodeCache::PinnedBlocks* pinnedBlocks=nullptr) { internalReader.decodeIntoCache(startSampleInFile, numSamples, pinnedBlocks); }
+
+	/** Tells the OS that the given range will be read soon, so that it can be paged in asynchronously.
+	*
+	*	This only has an effect on Linux and macOS. */
+	void adviseWillNeed(int64 startSampleInFile, int64 numSamples);
+
 private:
 	
 	friend class HlacSubSectionReader;
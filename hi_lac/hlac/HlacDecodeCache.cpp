@@ -0,0 +1,213 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which must be separately licensed for closed source applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+namespace hlac { using namespace juce; 
+
+HlacDecodeCache::HlacDecodeCache()
+{
+	slots.ensureStorageAllocated(HLAC_DECODE_CACHE_SIZE);
+
+	for (int i = 0; i < HLAC_DECODE_CACHE_SIZE; i++)
+		slots.add(new Slot());
+}
+
+int64 HlacDecodeCache::createKeyForFile(const File& f)
+{
+	auto id = f.getFullPathName() + String(f.getSize()) + String(f.getLastModificationTime().toMilliseconds());
+	return id.hashCode64();
+}
+
+uint64 HlacDecodeCache::createSlotKey(int64 fileKey, uint32 blockIndex) noexcept
+{
+	// A HLAC file can't have more than 2^24 blocks (the offsets are 32bit), so the lower bits
+	// can be used for the block index. The highest bit is set so that a valid key is never zero.
+	jassert(blockIndex < (1 << 24));
+
+	return (uint64(1) << 63) | ((uint64)fileKey & 0x7FFFFFFFFF000000ULL) | (uint64)blockIndex;
+}
+
+bool HlacDecodeCache::read(int64 fileKey, uint32 blockIndex, HiseSampleBuffer& destination, int startSampleInDestination, int offsetInBlock, int numSamples) noexcept
+{
+	const auto key = createSlotKey(fileKey, blockIndex);
+
+	for (auto s : slots)
+	{
+		if (s->key.load(std::memory_order_acquire) != key)
+			continue;
+
+		int numReaders = s->state.load();
+
+		while (numReaders >= 0 && !s->state.compare_exchange_weak(numReaders, numReaders + 1))
+			;
+
+		if (numReaders < 0)
+			continue;
+
+		// The slot might have been replaced before we got the read access
+		const bool found = s->key.load(std::memory_order_acquire) == key;
+
+		if (found)
+		{
+			HiseSampleBuffer::copy(destination, s->data, startSampleInDestination, offsetInBlock, numSamples);
+			s->referenced.store(true);
+		}
+
+		s->state.fetch_sub(1);
+
+		if (found)
+		{
+			numHits.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	numMisses.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+bool HlacDecodeCache::contains(int64 fileKey, uint32 blockIndex) const noexcept
+{
+	const auto key = createSlotKey(fileKey, blockIndex);
+
+	for (auto s : slots)
+	{
+		if (s->key.load(std::memory_order_acquire) == key)
+			return true;
+	}
+
+	return false;
+}
+
+void HlacDecodeCache::store(int64 fileKey, uint32 blockIndex, const HiseSampleBuffer& decodedBlock) noexcept
+{
+	jassert(decodedBlock.getNumSamples() == COMPRESSION_BLOCK_SIZE);
+
+	const auto key = createSlotKey(fileKey, blockIndex);
+	const auto numSlots = (uint32)slots.size();
+
+	for (uint32 i = 0; i < 2 * numSlots; i++)
+	{
+		auto s = slots.getUnchecked((int)(clockHand.fetch_add(1) % numSlots));
+
+		if (s->referenced.exchange(false))
+			continue;
+
+		int expected = 0;
+
+		if (!s->state.compare_exchange_strong(expected, -1))
+			continue;
+
+		// pin() increments the counter before it checks the state, so one of us backs off
+		if (s->numPins.load() > 0)
+		{
+			s->state.store(0);
+			continue;
+		}
+
+		s->key.store(0, std::memory_order_release);
+
+		s->data.clearNormalisation({});
+		HiseSampleBuffer::copy(s->data, decodedBlock, 0, 0, COMPRESSION_BLOCK_SIZE);
+
+		s->key.store(key, std::memory_order_release);
+		s->referenced.store(true);
+		s->state.store(0);
+		return;
+	}
+}
+
+int HlacDecodeCache::pin(int64 fileKey, uint32 blockIndex) noexcept
+{
+	const auto key = createSlotKey(fileKey, blockIndex);
+
+	for (int i = 0; i < slots.size(); i++)
+	{
+		auto s = slots.getUnchecked(i);
+
+		if (s->key.load(std::memory_order_acquire) != key)
+			continue;
+
+		if (s->numPins.fetch_add(1) == 0)
+		{
+			if (numPinnedSlots.fetch_add(1) >= getMaxNumPinnedSlots())
+			{
+				unpin(i);
+				return -1;
+			}
+		}
+
+		// The slot might be overwritten right now or have been replaced before we pinned it
+		if (s->state.load() >= 0 && s->key.load(std::memory_order_acquire) == key)
+			return i;
+
+		unpin(i);
+		return -1;
+	}
+
+	return -1;
+}
+
+void HlacDecodeCache::unpin(int slotIndex) noexcept
+{
+	if (auto s = slots[slotIndex])
+	{
+		jassert(s->numPins.load() > 0);
+
+		if (s->numPins.fetch_sub(1) == 1)
+			numPinnedSlots.fetch_sub(1);
+	}
+}
+
+void HlacDecodeCache::unpin(PinnedBlocks& pinnedBlocks) noexcept
+{
+	for (int i = 0; i < pinnedBlocks.numBlocks; i++)
+		unpin(pinnedBlocks.slotIndexes[i]);
+
+	pinnedBlocks.numBlocks = 0;
+}
+
+HlacDecodeCache::Counters HlacDecodeCache::getCounters() const noexcept
+{
+	Counters c;
+	c.numHits = numHits.load(std::memory_order_relaxed);
+	c.numMisses = numMisses.load(std::memory_order_relaxed);
+	return c;
+}
+
+void HlacDecodeCache::resetCounters() noexcept
+{
+	numHits.store(0);
+	numMisses.store(0);
+}
+
+} // namespace hlac
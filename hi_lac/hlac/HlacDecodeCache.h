@@ -0,0 +1,156 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which must be separately licensed for closed source applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#ifndef HLACDECODECACHE_H_INCLUDED
+#define HLACDECODECACHE_H_INCLUDED
+
+namespace hlac { using namespace juce; 
+
+/** A bounded cache for decoded HLAC blocks that is shared between all readers in the process.
+*
+*	Whenever multiple voices or plugin instances play the same sample region, the HLAC blocks
+*	would be decoded over and over again. This cache stores the last decoded blocks (keyed by
+*	the file and the block index) so that subsequent read operations can just copy the data.
+*
+*	Obtain it with a SharedResourcePointer. Lookup and insertion are lock-free and old blocks
+*	are evicted with the clock algorithm (every slot gets a second chance if it was accessed
+*	since the clock hand passed it the last time).
+*
+*	Blocks that were decoded in advance can be pinned until they are read. At most a quarter of
+*	the slots can be pinned at the same time so that the regular reads always find free slots.
+*/
+class HlacDecodeCache
+{
+public:
+
+	struct Counters
+	{
+		int64 numHits = 0;
+		int64 numMisses = 0;
+
+		/** Returns the ratio of cache hits to all block lookups. */
+		double getHitRate() const noexcept
+		{
+			auto numLookups = numHits + numMisses;
+			return numLookups > 0 ? (double)numHits / (double)numLookups : 0.0;
+		}
+	};
+
+	HlacDecodeCache();
+
+	/** Creates a key for the given file that is shared between all readers of this file.
+	*
+	*	It includes the size and modification time so that a reencoded file doesn't return stale blocks.
+	*/
+	static int64 createKeyForFile(const File& f);
+
+	/** Checks whether the block is cached and copies the given range into the destination buffer. */
+	bool read(int64 fileKey, uint32 blockIndex, HiseSampleBuffer& destination, int startSampleInDestination, int offsetInBlock, int numSamples) noexcept;
+
+	/** Stores a decoded block. If all slots are currently in use, the block is not cached. */
+	void store(int64 fileKey, uint32 blockIndex, const HiseSampleBuffer& decodedBlock) noexcept;
+
+	/** Checks whether the block is cached without copying it or changing the counters. 
+	*
+	*	The block might be evicted right after this call, so only use it to skip unnecessary work. */
+	bool contains(int64 fileKey, uint32 blockIndex) const noexcept;
+
+	int getNumSlots() const noexcept { return slots.size(); }
+
+	bool isEnabled() const noexcept { return slots.size() != 0; }
+
+	/** The slots that were pinned for a prefetched region. */
+	struct PinnedBlocks
+	{
+		// Enough for a region of 65536 samples that doesn't start at a block boundary
+		enum { MaxBlocks = 65536 / COMPRESSION_BLOCK_SIZE + 1 };
+
+		int slotIndexes[MaxBlocks];
+		int numBlocks = 0;
+	};
+
+	/** Keeps the block in the cache until unpin() is called.
+	*
+	*	Returns the index of the slot or -1 if the block isn't cached or too many blocks are pinned already. */
+	int pin(int64 fileKey, uint32 blockIndex) noexcept;
+
+	/** Releases a slot that was returned by pin(). */
+	void unpin(int slotIndex) noexcept;
+
+	/** Releases all slots and resets the pinned blocks. */
+	void unpin(PinnedBlocks& pinnedBlocks) noexcept;
+
+	int getMaxNumPinnedSlots() const noexcept { return slots.size() / 4; }
+
+	Counters getCounters() const noexcept;
+
+	void resetCounters() noexcept;
+
+private:
+
+	struct Slot
+	{
+		Slot() :
+			data(false, 2, COMPRESSION_BLOCK_SIZE)
+		{}
+
+		std::atomic<uint64> key = { 0 };
+
+		// -1 while the slot is written, otherwise the number of readers
+		std::atomic<int> state = { 0 };
+
+		std::atomic<bool> referenced = { false };
+
+		// Pinned slots are skipped by the clock hand
+		std::atomic<int> numPins = { 0 };
+
+		HiseSampleBuffer data;
+	};
+
+	static uint64 createSlotKey(int64 fileKey, uint32 blockIndex) noexcept;
+
+	OwnedArray<Slot> slots;
+
+	std::atomic<uint32> clockHand = { 0 };
+
+	std::atomic<int> numPinnedSlots = { 0 };
+
+	std::atomic<int64> numHits = { 0 };
+	std::atomic<int64> numMisses = { 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(HlacDecodeCache);
+};
+
+} // namespace hlac
+
+#endif  // HLACDECODECACHE_H_INCLUDED
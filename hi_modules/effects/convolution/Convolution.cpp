@@ -39,6 +39,7 @@ AudioSampleProcessor(this),
 dryGain(0.0f),
 wetGain(1.0f),
 wetBuffer(2, 0),
+crossBuffer(1, 0),
 latency(0),
 isReloading(false),
 rampFlag(false),
@@ -60,6 +61,7 @@ loadingThread(*this)
 	parameterNames.add("HiCut");
 	parameterNames.add("Damping");
 	parameterNames.add("FFTType");
+	parameterNames.add("TrueStereo");
 
 	smoothedGainerWet.setParameter((int)ScriptingDsp::SmoothedGainer::Parameters::FastMode, 1.0f);
 	smoothedGainerDry.setParameter((int)ScriptingDsp::SmoothedGainer::Parameters::FastMode, 1.0f);
@@ -76,6 +78,8 @@ ConvolutionEffect::~ConvolutionEffect()
     
 	convolverL = nullptr;
 	convolverR = nullptr;
+	convolverLR = nullptr;
+	convolverRL = nullptr;
 }
 
 void ConvolutionEffect::createEngine(audiofft::ImplementationType fftType)
@@ -86,24 +90,57 @@ void ConvolutionEffect::createEngine(audiofft::ImplementationType fftType)
 
 		ScopedLock sl(getImpulseLock());
 
-		bool useBackground = convolverL != nullptr ? convolverL->isUsingBackgroundThread() : false;
 		bool reload = convolverL != nullptr;
 
-		convolverL = nullptr;
-		convolverR = nullptr;
+		convolverL = createConvolver(fftType);
+		convolverR = createConvolver(fftType);
+		convolverLR = trueStereoEnabled ? createConvolver(fftType) : nullptr;
+		convolverRL = trueStereoEnabled ? createConvolver(fftType) : nullptr;
+		trueStereo = false;
 
-		convolverL = new MultithreadedConvolver(fftType);
-		convolverR = new MultithreadedConvolver(fftType);
+		if (reload)
+			setImpulse();
+	}
+}
 
-		convolverL->reset();
-		convolverR->reset();
+MultithreadedConvolver* ConvolutionEffect::createConvolver(audiofft::ImplementationType fftType) const
+{
+	auto c = new MultithreadedConvolver(fftType);
+	c->reset();
+	c->setUseBackgroundThread(useBackgroundThread && !nonRealtime);
+	return c;
+}
 
-		convolverL->setUseBackgroundThread(useBackground);
-		convolverR->setUseBackgroundThread(useBackground);
+void ConvolutionEffect::setTrueStereo(bool shouldBeEnabled)
+{
+	if (trueStereoEnabled == shouldBeEnabled)
+		return;
 
-		if (reload)
-			setImpulse();
+	trueStereoEnabled = shouldBeEnabled;
+
+	if (shouldBeEnabled)
+	{
+		ScopedPointer<MultithreadedConvolver> newLR = createConvolver(currentType);
+		ScopedPointer<MultithreadedConvolver> newRL = createConvolver(currentType);
+
+		ScopedLock sl(getImpulseLock());
+		convolverLR.swapWith(newLR);
+		convolverRL.swapWith(newRL);
+	}
+	else
+	{
+		ScopedPointer<MultithreadedConvolver> oldLR, oldRL;
+
+		MultithreadedConvolver::callWithIdleConvolvers(getImpulseLock(), getConvolvers(), [&]()
+		{
+			convolverLR.swapWith(oldLR);
+			convolverRL.swapWith(oldRL);
+			trueStereo = false;
+		});
 	}
+
+	if (convolverL != nullptr)
+		setImpulse();
 }
 
 
@@ -128,6 +165,7 @@ float ConvolutionEffect::getAttribute(int parameterIndex) const
 	case HiCut:			return (float)cutoffFrequency;
 	case Damping:		return Decibels::gainToDecibels(damping);
 	case FFTType:		return (float)(int)currentType;
+	case TrueStereo:	return trueStereoEnabled ? 1.0f : 0.0f;
 	default:			jassertfalse; return 1.0f;
 	}
 }
@@ -152,8 +190,8 @@ void ConvolutionEffect::setInternalAttribute(int parameterIndex, float newValue)
 						enableProcessing(processingEnabled); 
 						break;
 	case UseBackgroundThread:	useBackgroundThread = newValue > 0.5f;
-								convolverL->setUseBackgroundThread(useBackgroundThread && !nonRealtime);
-								convolverR->setUseBackgroundThread(useBackgroundThread && !nonRealtime);
+								for (auto c : getConvolvers())
+									c->setUseBackgroundThread(useBackgroundThread && !nonRealtime);
 								break;
 	case Predelay:		predelayMs = newValue;
 						calcPredelay();
@@ -166,6 +204,7 @@ void ConvolutionEffect::setInternalAttribute(int parameterIndex, float newValue)
 						setImpulse();
 						break;
 	case FFTType:		createEngine((audiofft::ImplementationType)(int)newValue); break;
+	case TrueStereo:	setTrueStereo(newValue > 0.5f); break;
 	default:			jassertfalse; return;
 	}
 }
@@ -184,6 +223,7 @@ float ConvolutionEffect::getDefaultValue(int parameterIndex) const
 	case HiCut:			return 20000.0f;
 	case Damping:		return 0.0f;
 	case FFTType:		return (float)(int)audiofft::ImplementationType::BestAvailable;
+	case TrueStereo:	return 0.0f;
 	default:			jassertfalse; return 1.0f;
 	}
 }
@@ -202,6 +242,7 @@ void ConvolutionEffect::restoreFromValueTree(const ValueTree &v)
 	loadAttributeWithDefault(HiCut);
 	loadAttribute(Damping, "Damping");
 	loadAttributeWithDefault(FFTType);
+	loadAttributeWithDefault(TrueStereo);
 
 	AudioSampleProcessor::restoreFromValueTree(v);
 }
@@ -220,6 +261,7 @@ ValueTree ConvolutionEffect::exportAsValueTree() const
 	saveAttribute(HiCut, "HiCut");
 	saveAttribute(Damping, "Damping");
 	saveAttribute(FFTType, "FFTType");
+	saveAttribute(TrueStereo, "TrueStereo");
 
 	AudioSampleProcessor::saveToValueTree(v);
 
@@ -231,6 +273,7 @@ void ConvolutionEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 	MasterEffectProcessor::prepareToPlay(sampleRate, samplesPerBlock);
 
 	ProcessorHelpers::increaseBufferIfNeeded(wetBuffer, samplesPerBlock);
+	ProcessorHelpers::increaseBufferIfNeeded(crossBuffer, samplesPerBlock);
 
 	if (sampleRate != lastSampleRate)
 	{
@@ -271,8 +314,11 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 		smoothedGainerDry.processBlock(channels, 2, numSamples);
 
 #if ENABLE_ALL_PEAK_METERS
-		currentValues.inL = FloatVectorOperations::findMaximum(l, numSamples);
-		currentValues.inR = FloatVectorOperations::findMaximum(r, numSamples);
+		if (isMeteringActive())
+		{
+			currentValues.inL = FloatVectorOperations::findMaximum(l, numSamples);
+			currentValues.inR = FloatVectorOperations::findMaximum(r, numSamples);
+		}
 #endif
 
 		isCurrentlyProcessing.store(false);
@@ -309,28 +355,23 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 				s_gain += s_step;
 			}
 			
-			if (convolverL != nullptr)
-				convolverL->process(smoothed_input_l, convolutedL, numSamples);
-
-			if (convolverR != nullptr)
-				convolverR->process(smoothed_input_r, convolutedR, numSamples);
+			processConvolvers(smoothed_input_l, smoothed_input_r, convolutedL, convolutedR, numSamples);
 
 			smoothInputBuffer = false;
 		}
 		else
 		{
-			if (convolverL != nullptr)
-				convolverL->process(l, convolutedL, numSamples);
-
-			if (convolverR != nullptr)
-				convolverR->process(r, convolutedR, numSamples);
+			processConvolvers(l, r, convolutedL, convolutedR, numSamples);
 		}
 		
 		smoothedGainerDry.processBlock(channels, 2, numSamples);
 
 #if ENABLE_ALL_PEAK_METERS
-		currentValues.inL = FloatVectorOperations::findMaximum(l, numSamples);
-		currentValues.inR = FloatVectorOperations::findMaximum(r, numSamples);
+		if (isMeteringActive())
+		{
+			currentValues.inL = FloatVectorOperations::findMaximum(l, numSamples);
+			currentValues.inR = FloatVectorOperations::findMaximum(r, numSamples);
+		}
 #endif
 
 		if (rampFlag)
@@ -354,8 +395,8 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 			{
 				if (!processFlag)
 				{
-					convolverL->cleanPipeline();
-					convolverR->cleanPipeline();
+					for (auto c : getConvolvers())
+						c->cleanPipeline();
 				}
 
 				rampFlag = false;
@@ -388,12 +429,17 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 			smoothedGainerWet.processBlock(wetBuffer.getArrayOfWritePointers(), 2, availableSamples);
 
 #if ENABLE_ALL_PEAK_METERS
-			currentValues.outL = FloatVectorOperations::findMaximum(wetBuffer.getReadPointer(0), availableSamples);
-			currentValues.outR = FloatVectorOperations::findMaximum(wetBuffer.getReadPointer(1), availableSamples);
+			if (isMeteringActive())
+			{
+				currentValues.outL = FusedVectorOperations::addWithMultiplyAndGetMagnitude(l, wetBuffer.getReadPointer(0), 0.5f, availableSamples);
+				currentValues.outR = FusedVectorOperations::addWithMultiplyAndGetMagnitude(r, wetBuffer.getReadPointer(1), 0.5f, availableSamples);
+			}
+			else
 #endif
-
-			FloatVectorOperations::addWithMultiply(l, wetBuffer.getReadPointer(0), 0.5f, availableSamples);
-			FloatVectorOperations::addWithMultiply(r, wetBuffer.getReadPointer(1), 0.5f, availableSamples);
+			{
+				FloatVectorOperations::addWithMultiply(l, wetBuffer.getReadPointer(0), 0.5f, availableSamples);
+				FloatVectorOperations::addWithMultiply(r, wetBuffer.getReadPointer(1), 0.5f, availableSamples);
+			}
 		}
 	}
 
@@ -403,6 +449,27 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 	CHECK_AND_LOG_BUFFER_DATA(this, DebugLogger::Location::ConvolutionRendering, r, false, numSamples);
 }
 
+void ConvolutionEffect::processConvolvers(const float* inputL, const float* inputR, float* outputL, float* outputR, int numSamples)
+{
+	if (convolverL == nullptr || convolverR == nullptr)
+		return;
+
+	convolverL->process(inputL, outputL, numSamples);
+	convolverR->process(inputR, outputR, numSamples);
+
+	if (trueStereo)
+	{
+		jassert(crossBuffer.getNumSamples() >= numSamples);
+		auto cross = crossBuffer.getWritePointer(0);
+
+		convolverRL->process(inputR, cross, numSamples);
+		FloatVectorOperations::add(outputL, cross, numSamples);
+
+		convolverLR->process(inputL, cross, numSamples);
+		FloatVectorOperations::add(outputR, cross, numSamples);
+	}
+}
+
 ProcessorEditorBody *ConvolutionEffect::createEditor(ProcessorEditor *parentEditor)
 {
 #if USE_BACKEND
@@ -444,19 +511,20 @@ void ConvolutionEffect::calcPredelay()
 
 void ConvolutionEffect::applyExponentialFadeout(AudioSampleBuffer& buffer, int numSamples, float targetValue)
 {
-	float* l = buffer.getWritePointer(0);
-	float* r = buffer.getWritePointer(1);
-
 	const float base = targetValue;
 	const float invBase = 1.0f - targetValue;
 	const float factor = -1.0f * (float)numSamples / 4.0f;
 
-	for (int i = 0; i < numSamples; i++)
+	for (int c = 0; c < buffer.getNumChannels(); c++)
 	{
-		const float multiplier = base + invBase * expf((float)i / factor);
+		float* d = buffer.getWritePointer(c);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const float multiplier = base + invBase * expf((float)i / factor);
 
-		*l++ *= multiplier;
-		*r++ *= multiplier;
+			*d++ *= multiplier;
+		}
 	}
 }
 
@@ -470,13 +538,13 @@ void ConvolutionEffect::applyHighFrequencyDamping(AudioSampleBuffer& buffer, int
 	lp1.setType(SimpleOnePole::FilterType::LP);
 	lp1.setFrequency(20000.0);
 	lp1.setSampleRate(sampleRate >= 0.0 ? sampleRate : 44100.0);
-	lp1.setNumChannels(2);
+	lp1.setNumChannels(buffer.getNumChannels());
 
 	SimpleOnePole lp2;
 	lp2.setType(SimpleOnePole::FilterType::LP);
 	lp2.setFrequency(20000.0);
 	lp2.setSampleRate(sampleRate >= 0.0 ? sampleRate : 44100.0);
-	lp2.setNumChannels(2);
+	lp2.setNumChannels(buffer.getNumChannels());
 	
 
 	for (int i = 0; i < numSamples; i += 64)
@@ -602,10 +670,14 @@ bool ConvolutionEffect::LoadingThread::reloadInternal()
     
 	if (parent.getSampleBuffer() == nullptr || parent.getSampleBuffer()->getNumChannels() == 0)
 	{
-		ScopedLock sl(parent.getImpulseLock());
+		MultithreadedConvolver::callWithIdleConvolvers(parent.getImpulseLock(), parent.getConvolvers(), [this]()
+		{
+			for (auto c : parent.getConvolvers())
+				c->reset();
+
+			parent.trueStereo = false;
+		});
 
-		parent.convolverL->reset();
-		parent.convolverR->reset();
 		return true;
 	}
 
@@ -613,46 +685,104 @@ bool ConvolutionEffect::LoadingThread::reloadInternal()
 
 	auto resampleRatio = parent.getResampleFactor();
 
-	AudioSampleBuffer scratchBuffer;
+	auto range = parent.getRange();
 
-	if (!MultithreadedConvolver::prepareImpulseResponse(pBuffer, scratchBuffer, &shouldRestart, parent.getRange(), resampleRatio))
-		return false;
+	if (range.isEmpty())
+		range = { 0, pBuffer.getNumSamples() };
 
-	auto resampledLength = scratchBuffer.getNumSamples();
+	// Only use the four channels as true stereo if it was explicitly enabled
+	const bool useTrueStereo = parent.trueStereoEnabled && pBuffer.getNumChannels() == 4;
+	const int numIRChannels = useTrueStereo ? 4 : 2;
+	const auto resampledLength = roundToInt((double)range.getLength() * resampleRatio);
+	const auto headSize = nextPowerOfTwo(parent.getLargestBlockSize());
+	const auto tailSize = jmin<int>(8192, nextPowerOfTwo(resampledLength - headSize));
 
-	if (shouldRestart)
-		return false;
+	String processingSettings;
+	processingSettings << String(parent.damping) << ":" << String(parent.cutoffFrequency) << ":" << String(parent.getSampleRate());
 
-	if (parent.damping != 1.0f)
-		applyExponentialFadeout(scratchBuffer, resampledLength, parent.damping);
+	MultithreadedConvolver::SpectrumPtr spectra[4];
+	int64 keys[4];
+	bool allCached = true;
 
-	if (shouldRestart)
-		return false;
+	for (int i = 0; i < numIRChannels; i++)
+	{
+		const int sourceChannel = jmin(i, pBuffer.getNumChannels() - 1);
 
-	if (parent.cutoffFrequency != 20000.0)
-		applyHighFrequencyDamping(scratchBuffer, resampledLength, parent.cutoffFrequency, parent.getSampleRate());
+		keys[i] = MultithreadedConvolver::getSpectrumKey(pBuffer, sourceChannel, range, resampleRatio, headSize, tailSize, parent.currentType, processingSettings);
+		spectra[i] = parent.spectrumCache->getSpectrum(keys[i]);
+		allCached &= spectra[i] != nullptr;
+	}
 
-	if (shouldRestart)
-		return false;
+	if (!allCached)
+	{
+		AudioSampleBuffer scratchBuffer;
 
-	const auto headSize = nextPowerOfTwo(parent.getLargestBlockSize());
-	const auto fullTailLength = nextPowerOfTwo(resampledLength - headSize);
+		if (!MultithreadedConvolver::prepareImpulseResponse(pBuffer, scratchBuffer, &shouldRestart, range, resampleRatio, useTrueStereo))
+			return false;
 
-	ScopedLock sl(parent.getImpulseLock());
+		jassert(scratchBuffer.getNumSamples() == resampledLength);
 
-    
-	parent.convolverL->reset();
-	parent.convolverR->reset();
-	parent.convolverL->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(0), resampledLength);
-	parent.convolverR->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(1), resampledLength);
-	parent.enableProcessing(parent.processingEnabled);
+		if (shouldRestart)
+			return false;
+
+		if (parent.damping != 1.0f)
+			applyExponentialFadeout(scratchBuffer, resampledLength, parent.damping);
+
+		if (shouldRestart)
+			return false;
+
+		if (parent.cutoffFrequency != 20000.0)
+			applyHighFrequencyDamping(scratchBuffer, resampledLength, parent.cutoffFrequency, parent.getSampleRate());
+
+		if (shouldRestart)
+			return false;
+
+		for (int i = 0; i < numIRChannels; i++)
+		{
+			if (spectra[i] == nullptr)
+			{
+				spectra[i] = fftconvolver::TwoStageFFTConvolver::createSpectrum(parent.currentType, headSize, tailSize, scratchBuffer.getReadPointer(i), resampledLength);
+				parent.spectrumCache->addSpectrum(keys[i], spectra[i]);
+			}
+		}
+	}
+
+	MultithreadedConvolver::callWithIdleConvolvers(parent.getImpulseLock(), parent.getConvolvers(), [&]()
+	{
+		for (auto c : parent.getConvolvers())
+		{
+			c->setSampleRate(parent.getSampleRate());
+			c->reset();
+		}
+
+		const bool hasCrossConvolvers = parent.convolverLR != nullptr && parent.convolverRL != nullptr;
+
+		if (useTrueStereo && hasCrossConvolvers)
+		{
+			// Channel order: LL, LR, RL, RR
+			parent.convolverL->init(spectra[0]);
+			parent.convolverLR->init(spectra[1]);
+			parent.convolverRL->init(spectra[2]);
+			parent.convolverR->init(spectra[3]);
+		}
+		else
+		{
+			parent.convolverL->init(spectra[0]);
+			parent.convolverR->init(spectra[1]);
+		}
+
+		parent.trueStereo = useTrueStereo && hasCrossConvolvers;
+		parent.enableProcessing(parent.processingEnabled);
+	});
 
 	return true;
 }
 
-bool MultithreadedConvolver::prepareImpulseResponse(const AudioSampleBuffer& originalBuffer, AudioSampleBuffer& buffer, bool* abortFlag, Range<int> range, double resampleRatio)
+bool MultithreadedConvolver::prepareImpulseResponse(const AudioSampleBuffer& originalBuffer, AudioSampleBuffer& buffer, bool* abortFlag, Range<int> range, double resampleRatio, bool allowTrueStereo)
 {
-	AudioSampleBuffer copyBuffer(2, originalBuffer.getNumSamples());
+	const int numChannels = (allowTrueStereo && originalBuffer.getNumChannels() == 4) ? 4 : 2;
+
+	AudioSampleBuffer copyBuffer(numChannels, originalBuffer.getNumSamples());
 
 	if (range.isEmpty())
 		range = { 0, originalBuffer.getNumSamples() };
@@ -660,8 +790,11 @@ bool MultithreadedConvolver::prepareImpulseResponse(const AudioSampleBuffer& ori
 	if (originalBuffer.getNumSamples() == 0)
 		return true;
 
-	copyBuffer.copyFrom(0, 0, originalBuffer.getReadPointer(0), originalBuffer.getNumSamples(), 1.0f);
-	copyBuffer.copyFrom(1, 0, originalBuffer.getReadPointer(originalBuffer.getNumChannels() >= 2 ? 1 : 0), originalBuffer.getNumSamples(), 1.0f);
+	for (int i = 0; i < numChannels; i++)
+	{
+		auto sourceChannel = jmin(i, originalBuffer.getNumChannels() - 1);
+		copyBuffer.copyFrom(i, 0, originalBuffer.getReadPointer(sourceChannel), originalBuffer.getNumSamples(), 1.0f);
+	}
 
 	if (abortFlag != nullptr && *abortFlag)
 		return false;
@@ -672,30 +805,83 @@ bool MultithreadedConvolver::prepareImpulseResponse(const AudioSampleBuffer& ori
 	if (irLength > 44100 * 20)
 		jassertfalse;
 
-	auto l = copyBuffer.getReadPointer(0, offset);
-	auto r = copyBuffer.getReadPointer(1, offset);
-
 	int resampledLength = roundToInt((double)irLength * resampleRatio);
 
-	buffer.setSize(2, resampledLength);
+	buffer.setSize(numChannels, resampledLength);
 
 	if (abortFlag != nullptr && *abortFlag)
 		return false;
 
-	if (resampleRatio != 1.0)
+	for (int i = 0; i < numChannels; i++)
 	{
-		LagrangeInterpolator resampler;
-		resampler.process(1.0 / resampleRatio, l, buffer.getWritePointer(0), resampledLength);
-		resampler.reset();
-		resampler.process(1.0 / resampleRatio, r, buffer.getWritePointer(1), resampledLength);
+		auto src = copyBuffer.getReadPointer(i, offset);
+
+		if (resampleRatio != 1.0)
+		{
+			LagrangeInterpolator resampler;
+			resampler.process(1.0 / resampleRatio, src, buffer.getWritePointer(i), resampledLength);
+		}
+		else
+		{
+			FloatVectorOperations::copy(buffer.getWritePointer(i), src, irLength);
+		}
 	}
-	else
+
+	return true;
+}
+
+int64 MultithreadedConvolver::getSpectrumKey(const AudioSampleBuffer& originalBuffer, int channelIndex, Range<int> range, double resampleRatio, int headSize, int tailSize, audiofft::ImplementationType fftType, const String& processingSettings)
+{
+	if (range.isEmpty())
+		range = { 0, originalBuffer.getNumSamples() };
+
+	// FNV-1a hash of the sample data
+	uint64 contentHash = 14695981039346656037ULL;
+
+	auto data = originalBuffer.getReadPointer(channelIndex, range.getStart());
+
+	for (int i = 0; i < range.getLength(); i++)
 	{
-		FloatVectorOperations::copy(buffer.getWritePointer(0), l, irLength);
-		FloatVectorOperations::copy(buffer.getWritePointer(1), r, irLength);
+		uint32 bits;
+		memcpy(&bits, data + i, sizeof(uint32));
+
+		contentHash ^= bits;
+		contentHash *= 1099511628211ULL;
 	}
 
-	return true;
+	String key;
+	key << String::toHexString((int64)contentHash) << ":" << String(range.getLength()) << ":" << String(resampleRatio, 8);
+	key << ":" << String(headSize) << ":" << String(tailSize) << ":" << String((int)fftType) << ":" << processingSettings;
+
+	return key.hashCode64();
+}
+
+MultithreadedConvolver::SpectrumPtr MultithreadedConvolver::SpectrumCache::getSpectrum(int64 key)
+{
+	ScopedLock sl(lock);
+
+	auto it = spectra.find(key);
+
+	if (it != spectra.end())
+		return it->second.lock();
+
+	return nullptr;
+}
+
+void MultithreadedConvolver::SpectrumCache::addSpectrum(int64 key, SpectrumPtr spectrum)
+{
+	ScopedLock sl(lock);
+
+	// Remove the spectra that are not used anymore
+	for (auto it = spectra.begin(); it != spectra.end();)
+	{
+		if (it->second.expired())
+			it = spectra.erase(it);
+		else
+			++it;
+	}
+
+	spectra[key] = spectrum;
 }
 
 double MultithreadedConvolver::getResampleFactor(double sampleRate, double impulseSampleRate)
@@ -713,4 +899,159 @@ double MultithreadedConvolver::getResampleFactor(double sampleRate, double impul
 	}
 }
 
+MultithreadedConvolver::~MultithreadedConvolver()
+{
+	// After this no worker can claim a new job from this convolver
+	pool->removeConvolver(this);
+
+	// A job that wasn't picked up by a worker can be discarded, a running one must be finished
+	// because the worker accesses this object until it sets the state back to Idle.
+	while (!cancelBackgroundProcessing())
+		tailFinished.wait();
+
+	// The worker might still be signalling the event
+	ScopedLock sl(tailFinishedLock);
+}
+
+void MultithreadedConvolver::startBackgroundProcessing()
+{
+	if (useBackgroundThread)
+	{
+		const auto now = Time::getMillisecondCounterHiRes();
+
+		jobStartTime.store(now);
+		deadline.store(now + 1000.0 * (double)getTailBlockSize() / sampleRate);
+
+		tailState.store(Pending);
+		pool->notify();
+	}
+	else
+	{
+		doBackgroundProcessing();
+	}
+}
+
+void MultithreadedConvolver::waitForBackgroundProcessing()
+{
+	// If no worker has picked up the job yet, we render it on this thread instead of waiting
+	int expected = Pending;
+
+	if (tailState.compare_exchange_strong(expected, Rendering))
+	{
+		renderTail();
+		return;
+	}
+
+	// A worker is already rendering the tail, so we have to wait until it signals the event.
+	// The event might still be signalled from an earlier job, so check the state again.
+	while (tailState.load() != Idle)
+		tailFinished.wait();
+}
+
+bool MultithreadedConvolver::cancelBackgroundProcessing()
+{
+	int expected = Pending;
+	tailState.compare_exchange_strong(expected, Idle);
+
+	return tailState.load() == Idle;
+}
+
+void MultithreadedConvolver::renderTail()
+{
+	jassert(tailState.load() == Rendering);
+
+	doBackgroundProcessing();
+
+	lastTailLatency.store(Time::getMillisecondCounterHiRes() - jobStartTime.load());
+
+	ScopedLock sl(tailFinishedLock);
+
+	// The destructor (or a reload) might proceed right after this, but it waits for the lock
+	tailState.store(Idle);
+	tailFinished.signal();
+}
+
+MultithreadedConvolver::TailWorkerPool::TailWorkerPool()
+{
+	const int numThreads = jlimit(1, 4, SystemStats::getNumCpus() / 2);
+
+	for (int i = 0; i < numThreads; i++)
+	{
+		auto w = workers.add(new Worker(*this, i));
+		w->startThread(9);
+	}
+}
+
+MultithreadedConvolver::TailWorkerPool::~TailWorkerPool()
+{
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	for (int i = 0; i < workers.size(); i++)
+		jobAvailable.signal();
+
+	for (auto w : workers)
+		w->stopThread(1000);
+}
+
+void MultithreadedConvolver::TailWorkerPool::addConvolver(MultithreadedConvolver* c)
+{
+	ScopedLock sl(convolverLock);
+	convolvers.addIfNotAlreadyThere(c);
+}
+
+void MultithreadedConvolver::TailWorkerPool::removeConvolver(MultithreadedConvolver* c)
+{
+	ScopedLock sl(convolverLock);
+	convolvers.removeAllInstancesOf(c);
+}
+
+MultithreadedConvolver* MultithreadedConvolver::TailWorkerPool::claimNextJob()
+{
+	ScopedLock sl(convolverLock);
+
+	for (;;)
+	{
+		MultithreadedConvolver* nextJob = nullptr;
+		int numPending = 0;
+
+		for (auto c : convolvers)
+		{
+			if (c->tailState.load() == Pending)
+			{
+				numPending++;
+
+				if (nextJob == nullptr || c->deadline.load() < nextJob->deadline.load())
+					nextJob = c;
+			}
+		}
+
+		if (nextJob == nullptr)
+			return nullptr;
+
+		int expected = Pending;
+
+		// The audio thread (or another worker) might have claimed it in the meantime, so look for the next one
+		if (!nextJob->tailState.compare_exchange_strong(expected, Rendering))
+			continue;
+
+		// Wake up another worker for the remaining jobs
+		if (numPending > 1)
+			jobAvailable.signal();
+
+		return nextJob;
+	}
+}
+
+void MultithreadedConvolver::TailWorkerPool::Worker::run()
+{
+	while (!threadShouldExit())
+	{
+		if (auto c = parent.claimNextJob())
+			c->renderTail();
+		else
+			parent.jobAvailable.wait(500);
+	}
+}
+
 } // namespace hise
@@ -105,103 +105,132 @@ private:
 
 class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver
 {
-	class BackgroundThread : public Thread
+public:
+
+	using SpectrumPtr = std::shared_ptr<const fftconvolver::TwoStageFFTConvolver::Spectrum>;
+
+	/** A process-wide cache for the partitioned spectra of impulse responses.
+	*
+	*	Convolvers that use the same impulse response with the same settings share the spectrum
+	*	instead of calculating and storing their own copy. The cache only holds weak references,
+	*	so a spectrum is freed as soon as the last convolver releases it.
+	*/
+	class SpectrumCache
 	{
 	public:
 
-		BackgroundThread(MultithreadedConvolver& parent_) :
-			Thread("Convolution Background Thread"),
-			parent(parent_)
-		{
-			
-		}
+		SpectrumPtr getSpectrum(int64 key);
 
-		void run() override
-		{
-			while (!threadShouldExit())
-			{
+		void addSpectrum(int64 key, SpectrumPtr spectrum);
 
-				if (active)
-				{
-					ScopedValueSetter<bool> svs(currentlyRendering, true);
-					parent.doBackgroundProcessing();
-					active = false;
+	private:
 
-					if (threadShouldExit())
-						return;
-				}
+		CriticalSection lock;
+		std::map<int64, std::weak_ptr<const fftconvolver::TwoStageFFTConvolver::Spectrum>> spectra;
+	};
 
-				wait(500);
-			}
-		};
+	/** A fixed size pool of worker threads that renders the tail segments of all convolvers.
+	*
+	*	Instead of one thread per convolver, all instances share this pool. The pending jobs are
+	*	picked in the order of their deadline (the time when the audio thread will need the result),
+	*	so convolvers with a shorter tail block size will be rendered first.
+	*/
+	class TailWorkerPool
+	{
+	public:
+
+		TailWorkerPool();
+		~TailWorkerPool();
+
+		void addConvolver(MultithreadedConvolver* c);
+		void removeConvolver(MultithreadedConvolver* c);
+
+		/** Wakes up a worker thread. This is called from the audio thread. */
+		void notify() { jobAvailable.signal(); }
 
-		void setSomethingTodo(bool shouldBeActive)
+		int getNumThreads() const { return workers.size(); }
+
+	private:
+
+		struct Worker : public Thread
 		{
-			active = shouldBeActive;
-		}
+			Worker(TailWorkerPool& parent_, int index) :
+				Thread("Convolution Worker " + String(index + 1)),
+				parent(parent_)
+			{};
 
-		bool isBusy() const { return currentlyRendering; }
+			void run() override;
 
-		bool currentlyRendering = false;
-		bool active = false;
+			TailWorkerPool& parent;
+		};
 
-		MultithreadedConvolver& parent;
-	};
+		MultithreadedConvolver* claimNextJob();
 
+		CriticalSection convolverLock;
+		Array<MultithreadedConvolver*> convolvers;
 
-public:
+		WaitableEvent jobAvailable;
+		OwnedArray<Worker> workers;
+	};
 
 	MultithreadedConvolver(audiofft::ImplementationType fftType) :
-		TwoStageFFTConvolver(fftType),
-		backgroundThread(*this)
-	{};
-
-	virtual ~MultithreadedConvolver()
+		TwoStageFFTConvolver(fftType)
 	{
-		backgroundThread.stopThread(1000);
+		pool->addConvolver(this);
 	};
 
-	void startBackgroundProcessing() override
-	{
-		if (useBackgroundThread)
-		{
-			backgroundThread.setSomethingTodo(true);
-			backgroundThread.notify();
-		}
-		else
-		{
-			doBackgroundProcessing();
-		}
-	}
+	virtual ~MultithreadedConvolver();
+
+	void startBackgroundProcessing() override;
+
+	void waitForBackgroundProcessing() override;
+
+	/** Discards a tail job that wasn't picked up by a worker yet.
+	*
+	*	Returns false if a worker is currently rendering the tail. Call this with the impulse lock held
+	*	before resetting the convolver (and call waitForBackgroundProcessing() without the lock if it fails).
+	*/
+	bool cancelBackgroundProcessing();
 
-	void waitForBackgroundProcessing() override
+	/** Calls the function with the lock held and all convolvers idle.
+	*
+	*	The running tail jobs are awaited without holding the lock, so the audio thread is never
+	*	blocked on the lock while a worker is busy.
+	*/
+	template <typename LockType, typename ContainerType, typename F> static void callWithIdleConvolvers(LockType& lock, const ContainerType& convolvers, const F& f)
 	{
-		if (useBackgroundThread)
+		for (;;)
 		{
-			while (backgroundThread.isBusy())
-				jassertfalse;
+			for (auto c : convolvers)
+				c->waitForBackgroundProcessing();
+
+			typename LockType::ScopedLockType sl(lock);
+
+			// The audio thread might have started a new tail job in the meantime
+			bool allIdle = true;
+
+			for (auto c : convolvers)
+				allIdle &= c->cancelBackgroundProcessing();
+
+			if (allIdle)
+			{
+				f();
+				return;
+			}
 		}
 	}
 
-	static bool prepareImpulseResponse(const AudioSampleBuffer& originalBuffer, AudioSampleBuffer& buffer, bool* abortFlag, Range<int> range, double resampleRatio);
+	/** Copies and resamples the impulse response. If allowTrueStereo is true and the buffer has four channels, all channels will be kept. */
+	static bool prepareImpulseResponse(const AudioSampleBuffer& originalBuffer, AudioSampleBuffer& buffer, bool* abortFlag, Range<int> range, double resampleRatio, bool allowTrueStereo=false);
+
+	/** Creates a hash for the given impulse response channel and the settings that affect its spectrum. */
+	static int64 getSpectrumKey(const AudioSampleBuffer& originalBuffer, int channelIndex, Range<int> range, double resampleRatio, int headSize, int tailSize, audiofft::ImplementationType fftType, const String& processingSettings);
 
 	static double getResampleFactor(double sampleRate, double impulseSampleRate);
 
 	void setUseBackgroundThread(bool shouldBeUsingBackgroundThread)
 	{
-		if (useBackgroundThread != shouldBeUsingBackgroundThread)
-		{
-			useBackgroundThread = shouldBeUsingBackgroundThread;
-		
-			if (useBackgroundThread)
-				backgroundThread.startThread(9);
-			else
-			{
-				if(backgroundThread.isThreadRunning())
-					backgroundThread.stopThread(1000);
-			}
-				
-		}
+		useBackgroundThread = shouldBeUsingBackgroundThread;
 	}
 
 	bool isUsingBackgroundThread() const
@@ -209,9 +238,38 @@ public:
 		return useBackgroundThread;
 	}
 
+	/** Sets the sample rate that is used to calculate the deadline of the tail jobs. */
+	void setSampleRate(double newSampleRate) { sampleRate = newSampleRate; }
+
+	/** Returns the time in milliseconds between the start and the completion of the last tail job. */
+	double getTailLatencyMilliseconds() const { return lastTailLatency.load(); }
+
+	int getNumWorkerThreads() const { return pool->getNumThreads(); }
+
 private:
 
-	BackgroundThread backgroundThread;
+	enum TailState
+	{
+		Idle = 0,
+		Pending,
+		Rendering
+	};
+
+	void renderTail();
+
+	SharedResourcePointer<TailWorkerPool> pool;
+
+	std::atomic<int> tailState = { Idle };
+
+	// Signalled when a worker has finished the tail. The lock is held while signalling so
+	// that the destructor can make sure that the worker doesn't access the event anymore.
+	WaitableEvent tailFinished;
+	CriticalSection tailFinishedLock;
+
+	std::atomic<double> jobStartTime = { 0.0 };
+	std::atomic<double> deadline = { 0.0 };
+	double sampleRate = 44100.0;
+	std::atomic<double> lastTailLatency = { 0.0 };
 
 	bool useBackgroundThread = true;
 };
@@ -316,6 +374,7 @@ public:
 		HiCut, ///< applies a low pass filter to the impulse response
 		Damping, ///< applies a fade-out to the impulse response
 		FFTType, ///< the FFT implementation. It picks the best available but for some weird use cases you can force to use another one.
+		TrueStereo, ///< if enabled, a four channel impulse response will be used as true stereo (LL, LR, RL, RR).
 		numEffectParameters
 	};
 
@@ -345,8 +404,13 @@ public:
 
 	void voicesKilled() override
 	{
-		convolverL->cleanPipeline();
-		convolverR->cleanPipeline();
+		for (auto c : getConvolvers())
+		{
+			// A worker might still write into the pipeline
+			c->waitForBackgroundProcessing();
+			c->cleanPipeline();
+		}
+
 		leftPredelay.clear();
 		rightPredelay.clear();
 	}
@@ -363,9 +427,20 @@ public:
 	{
 		nonRealtime = isNonRealtime;
 
-		convolverL->setUseBackgroundThread(!nonRealtime && useBackgroundThread);
-		convolverR->setUseBackgroundThread(!nonRealtime && useBackgroundThread);
+		for (auto c : getConvolvers())
+			c->setUseBackgroundThread(!nonRealtime && useBackgroundThread);
+	}
+
+	/** Returns true if true stereo is enabled and a four channel impulse response (LL, LR, RL, RR) is loaded. */
+	bool isTrueStereo() const { return trueStereo; }
+
+	/** Returns the time it took the worker pool to render the last tail segment. */
+	double getTailLatencyMilliseconds() const
+	{
+		return jmax(convolverL->getTailLatencyMilliseconds(), convolverR->getTailLatencyMilliseconds());
 	}
+
+	int getNumWorkerThreads() const { return convolverL->getNumWorkerThreads(); }
 	
 
 private:
@@ -379,6 +454,11 @@ private:
 
 	void createEngine(audiofft::ImplementationType fftType);
 
+	/** Creates or removes the cross channel convolvers and reloads the impulse. */
+	void setTrueStereo(bool shouldBeEnabled);
+
+	MultithreadedConvolver* createConvolver(audiofft::ImplementationType fftType) const;
+
 	SpinLock swapLock;
 
 	LoadingThread loadingThread;
@@ -398,6 +478,9 @@ private:
 
 	AudioSampleBuffer wetBuffer;
 
+	// Holds the output of the cross channel convolvers in true stereo mode
+	AudioSampleBuffer crossBuffer;
+
 	const CriticalSection& getImpulseLock() const { return lock; };
 
 	void enableProcessing(bool shouldBeProcessed);
@@ -428,9 +511,27 @@ private:
 	
 	float predelayMs = 0.0f;
 
+	Array<MultithreadedConvolver*> getConvolvers() const
+	{
+		Array<MultithreadedConvolver*> list = { convolverL.get(), convolverR.get(), convolverLR.get(), convolverRL.get() };
+		list.removeAllInstancesOf(nullptr);
+		return list;
+	}
+
+	void processConvolvers(const float* inputL, const float* inputR, float* outputL, float* outputR, int numSamples);
+
 	ScopedPointer<MultithreadedConvolver> convolverL;
 	ScopedPointer<MultithreadedConvolver> convolverR;
 
+	// The cross channel convolvers for true stereo impulse responses.
+	// They are only allocated if the TrueStereo attribute is enabled.
+	ScopedPointer<MultithreadedConvolver> convolverLR;
+	ScopedPointer<MultithreadedConvolver> convolverRL;
+	bool trueStereoEnabled = false;
+	bool trueStereo = false;
+
+	SharedResourcePointer<MultithreadedConvolver::SpectrumCache> spectrumCache;
+
 	double cutoffFrequency = 20000.0;
 
 	double lastSampleRate = 0.0;
@@ -507,18 +608,36 @@ struct convolution : public AudioFileNodeBase
 
 		const auto headSize = nextPowerOfTwo(largestBlockSize);
 		const auto fullTailLength = nextPowerOfTwo(impulseBuffer.getNumSamples() - headSize);
+		const auto fftType = audiofft::ImplementationType::BestAvailable;
 
+		// Channels with the same source data will share the spectrum
+		Array<MultithreadedConvolver::SpectrumPtr> spectra;
+
+		for (int i = 0; i < impulseBuffer.getNumChannels(); i++)
 		{
-			SpinLock::ScopedLockType sl(impulseLock);
+			auto key = MultithreadedConvolver::getSpectrumKey(impulseBuffer, i, {}, 1.0, headSize, fullTailLength, fftType, {});
+			auto s = spectrumCache->getSpectrum(key);
 
+			if (s == nullptr)
+			{
+				s = fftconvolver::TwoStageFFTConvolver::createSpectrum(fftType, headSize, fullTailLength, impulseBuffer.getReadPointer(i), impulseBuffer.getNumSamples());
+				spectrumCache->addSpectrum(key, s);
+			}
+
+			spectra.add(s);
+		}
+
+		MultithreadedConvolver::callWithIdleConvolvers(impulseLock, convolvers, [&]()
+		{
 			for (int i = 0; i < convolvers.size(); i++)
 			{
 				int channelIndex = i % impulseBuffer.getNumChannels();
 				auto c = convolvers[i];
 
-				c->init(headSize, fullTailLength, impulseBuffer.getReadPointer(channelIndex), impulseBuffer.getNumSamples());
+				c->setSampleRate(lastSampleRate);
+				c->init(spectra[channelIndex]);
 			}
-		}
+		});
 		
 		reset();
 	}
@@ -532,10 +651,11 @@ struct convolution : public AudioFileNodeBase
 
 	void reset()
 	{
-		SpinLock::ScopedLockType sl(impulseLock);
-
-		for (auto c : convolvers)
-			c->cleanPipeline();
+		MultithreadedConvolver::callWithIdleConvolvers(impulseLock, convolvers, [this]()
+		{
+			for (auto c : convolvers)
+				c->cleanPipeline();
+		});
 	}
 
 	bool handleModulation(double& )
@@ -561,6 +681,7 @@ struct convolution : public AudioFileNodeBase
 	SpinLock impulseLock;
 
 	OwnedArray<hise::MultithreadedConvolver> convolvers;
+	SharedResourcePointer<MultithreadedConvolver::SpectrumCache> spectrumCache;
 	
 	int largestBlockSize = 0; 
 	double lastSampleRate = 44100.0;
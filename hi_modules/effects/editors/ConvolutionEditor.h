@@ -158,6 +158,16 @@ public:
 
 		dryMeter->setPeak(d.inL, d.inR);
 		wetMeter->setPeak(d.outL, d.outR);
+
+		if (auto ce = dynamic_cast<ConvolutionEffect*>(getProcessor()))
+		{
+			String tooltip;
+			tooltip << "Worker threads: " << String(ce->getNumWorkerThreads());
+			tooltip << ", tail latency: " << String(ce->getTailLatencyMilliseconds(), 2) << "ms";
+
+			if (backgroundButton->getTooltip() != tooltip)
+				backgroundButton->setTooltip(tooltip);
+		}
 	}
 
 	int getBodyHeight() const override
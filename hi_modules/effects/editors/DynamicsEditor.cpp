@@ -31,7 +31,8 @@ namespace hise { using namespace juce;
 
 //==============================================================================
 DynamicsEditor::DynamicsEditor (ProcessorEditor *p)
-    : ProcessorEditorBody(p)
+    : ProcessorEditorBody(p),
+      SimpleTimer(p->getProcessor()->getMainController()->getGlobalUIUpdater(), false)
 {
     //[Constructor_pre] You can add your own custom stuff here..
     //[/Constructor_pre]
@@ -189,7 +190,8 @@ DynamicsEditor::DynamicsEditor (ProcessorEditor *p)
 	gateMeter->setPeak(0.0f, 0.0f);
 	compMeter->setPeak(0.0f, 0.0f);
 
-	START_TIMER();
+	setComponentToCheck(this);
+	start();
 
     //[/UserPreSize]
 
@@ -449,8 +451,8 @@ void DynamicsEditor::timerCallback()
 BEGIN_JUCER_METADATA
 
 <JUCER_COMPONENT documentType="Component" className="DynamicsEditor" componentName=""
-                 parentClasses="public ProcessorEditorBody, public Timer" constructorParams="ProcessorEditor *p"
-                 variableInitialisers="ProcessorEditorBody(p)&#10;" snapPixels="8"
+                 parentClasses="public ProcessorEditorBody, public PooledUIUpdater::SimpleTimer" constructorParams="ProcessorEditor *p"
+                 variableInitialisers="ProcessorEditorBody(p)&#10;SimpleTimer(p-&gt;getProcessor()-&gt;getMainController()-&gt;getGlobalUIUpdater(), false)" snapPixels="8"
                  snapActive="1" snapShown="1" overlayOpacity="0.330" fixedSize="1"
                  initialWidth="800" initialHeight="340">
   <BACKGROUND backgroundColour="0">
@@ -37,7 +37,7 @@ namespace hise { using namespace juce;
                                                                     //[/Comments]
 */
 class DynamicsEditor  : public ProcessorEditorBody,
-                        public Timer,
+                        public PooledUIUpdater::SimpleTimer,
                         public Button::Listener,
                         public Slider::Listener
 {
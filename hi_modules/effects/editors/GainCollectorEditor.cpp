@@ -31,7 +31,8 @@ namespace hise { using namespace juce;
 
 //==============================================================================
 GainCollectorEditor::GainCollectorEditor (ProcessorEditor *pe)
-    : ProcessorEditorBody(pe)
+    : ProcessorEditorBody(pe),
+      SimpleTimer(pe->getProcessor()->getMainController()->getGlobalUIUpdater(), false)
 {
     //[Constructor_pre] You can add your own custom stuff here..
     //[/Constructor_pre]
@@ -94,7 +95,8 @@ GainCollectorEditor::GainCollectorEditor (ProcessorEditor *pe)
 
 	gainMeter->setColour(VuMeter::ColourId::outlineColour, Colours::white.withAlpha(0.6f));
 
-	START_TIMER();
+	setComponentToCheck(this);
+	start();
 
     //[/UserPreSize]
 
@@ -209,8 +211,8 @@ void GainCollectorEditor::comboBoxChanged (ComboBox* comboBoxThatHasChanged)
 BEGIN_JUCER_METADATA
 
 <JUCER_COMPONENT documentType="Component" className="GainCollectorEditor" componentName=""
-                 parentClasses="public ProcessorEditorBody, public Timer" constructorParams="ProcessorEditor *pe"
-                 variableInitialisers="ProcessorEditorBody(pe)&#10;" snapPixels="8"
+                 parentClasses="public ProcessorEditorBody, public PooledUIUpdater::SimpleTimer" constructorParams="ProcessorEditor *pe"
+                 variableInitialisers="ProcessorEditorBody(pe)&#10;SimpleTimer(pe-&gt;getProcessor()-&gt;getMainController()-&gt;getGlobalUIUpdater(), false)" snapPixels="8"
                  snapActive="1" snapShown="1" overlayOpacity="0.330" fixedSize="1"
                  initialWidth="900" initialHeight="150">
   <BACKGROUND backgroundColour="ffffff">
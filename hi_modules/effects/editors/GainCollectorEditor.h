@@ -37,7 +37,7 @@ namespace hise { using namespace juce;
                                                                     //[/Comments]
 */
 class GainCollectorEditor  : public ProcessorEditorBody,
-                             public Timer,
+                             public PooledUIUpdater::SimpleTimer,
                              public SliderListener,
                              public ComboBoxListener
 {
@@ -30,7 +30,8 @@ namespace hise { using namespace juce;
 
 //==============================================================================
 GainEditor::GainEditor (ProcessorEditor *p)
-    : ProcessorEditorBody(p)
+    : ProcessorEditorBody(p),
+      SimpleTimer(p->getProcessor()->getMainController()->getGlobalUIUpdater(), false)
 {
     //[Constructor_pre] You can add your own custom stuff here..
     //[/Constructor_pre]
@@ -77,7 +78,8 @@ GainEditor::GainEditor (ProcessorEditor *p)
 	balanceSlider->setMode(HiSlider::Pan);
 	balanceSlider->setIsUsingModulatedRing(true);
 
-    START_TIMER();
+    setComponentToCheck(this);
+    start();
 
     //[/UserPreSize]
 
@@ -184,8 +186,8 @@ void GainEditor::sliderValueChanged (Slider* sliderThatWasMoved)
 BEGIN_JUCER_METADATA
 
 <JUCER_COMPONENT documentType="Component" className="GainEditor" componentName=""
-                 parentClasses="public ProcessorEditorBody, public Timer" constructorParams="ProcessorEditor *p"
-                 variableInitialisers="ProcessorEditorBody(p)&#10;" snapPixels="8"
+                 parentClasses="public ProcessorEditorBody, public PooledUIUpdater::SimpleTimer" constructorParams="ProcessorEditor *p"
+                 variableInitialisers="ProcessorEditorBody(p)&#10;SimpleTimer(p-&gt;getProcessor()-&gt;getMainController()-&gt;getGlobalUIUpdater(), false)" snapPixels="8"
                  snapActive="1" snapShown="1" overlayOpacity="0.330" fixedSize="1"
                  initialWidth="800" initialHeight="80">
   <BACKGROUND backgroundColour="ffffff">
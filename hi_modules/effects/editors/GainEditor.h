@@ -35,7 +35,7 @@ namespace hise { using namespace juce;
                                                                     //[/Comments]
 */
 class GainEditor  : public ProcessorEditorBody,
-                    public Timer,
+                    public PooledUIUpdater::SimpleTimer,
                     public SliderListener
 {
 public:
@@ -30,7 +30,8 @@ using namespace juce;
 
 //==============================================================================
 ShapeFXEditor::ShapeFXEditor (ProcessorEditor* p)
-    : ProcessorEditorBody(p)
+    : ProcessorEditorBody(p),
+      SimpleTimer(p->getProcessor()->getMainController()->getGlobalUIUpdater(), false)
 {
     //[Constructor_pre] You can add your own custom stuff here..
 	auto sfx = dynamic_cast<ShapeFX*>(getProcessor());
@@ -181,7 +182,8 @@ ShapeFXEditor::ShapeFXEditor (ProcessorEditor* p)
 
     //[UserPreSize]
 
-	START_TIMER();
+	setComponentToCheck(this);
+	start();
 
 	oversampling->setup(getProcessor(), ShapeFX::SpecialParameters::Oversampling, "Oversampling");
 	mixSlider->setup(getProcessor(), ShapeFX::SpecialParameters::Mix, "Mix");
@@ -444,8 +446,8 @@ void ShapeFXEditor::buttonClicked (Button* buttonThatWasClicked)
 BEGIN_JUCER_METADATA
 
 <JUCER_COMPONENT documentType="Component" className="ShapeFXEditor" componentName=""
-                 parentClasses="public ProcessorEditorBody, public Timer" constructorParams="ProcessorEditor* p"
-                 variableInitialisers="ProcessorEditorBody(p)&#10;" snapPixels="8"
+                 parentClasses="public ProcessorEditorBody, public PooledUIUpdater::SimpleTimer" constructorParams="ProcessorEditor* p"
+                 variableInitialisers="ProcessorEditorBody(p)&#10;SimpleTimer(p-&gt;getProcessor()-&gt;getMainController()-&gt;getGlobalUIUpdater(), false)" snapPixels="8"
                  snapActive="1" snapShown="1" overlayOpacity="0.330" fixedSize="1"
                  initialWidth="800" initialHeight="600">
   <BACKGROUND backgroundColour="323e44">
@@ -35,7 +35,7 @@ using namespace juce;
                                                                     //[/Comments]
 */
 class ShapeFXEditor  : public ProcessorEditorBody,
-                       public Timer,
+                       public PooledUIUpdater::SimpleTimer,
                        public Slider::Listener,
                        public ComboBox::Listener,
                        public Button::Listener
@@ -29,7 +29,8 @@ namespace hise { using namespace juce;
 
 //==============================================================================
 StereoEditor::StereoEditor (ProcessorEditor *p)
-    : ProcessorEditorBody(p)
+    : ProcessorEditorBody(p),
+      SimpleTimer(p->getProcessor()->getMainController()->getGlobalUIUpdater(), false)
 {
     //[Constructor_pre] You can add your own custom stuff here..
     //[/Constructor_pre]
@@ -63,7 +64,8 @@ StereoEditor::StereoEditor (ProcessorEditor *p)
 
     //[Constructor] You can add your own custom stuff here..
 
-	START_TIMER();
+	setComponentToCheck(this);
+	start();
 
 	h = getHeight();
     //[/Constructor]
@@ -151,8 +153,8 @@ void StereoEditor::sliderValueChanged (Slider* sliderThatWasMoved)
 BEGIN_JUCER_METADATA
 
 <JUCER_COMPONENT documentType="Component" className="StereoEditor" componentName=""
-                 parentClasses="public ProcessorEditorBody" constructorParams="ProcessorEditor *p"
-                 variableInitialisers="ProcessorEditorBody(p)&#10;" snapPixels="8"
+                 parentClasses="public ProcessorEditorBody, public PooledUIUpdater::SimpleTimer" constructorParams="ProcessorEditor *p"
+                 variableInitialisers="ProcessorEditorBody(p)&#10;SimpleTimer(p-&gt;getProcessor()-&gt;getMainController()-&gt;getGlobalUIUpdater(), false)" snapPixels="8"
                  snapActive="1" snapShown="1" overlayOpacity="0.330" fixedSize="1"
                  initialWidth="800" initialHeight="80">
   <BACKGROUND backgroundColour="ffffff">
@@ -36,7 +36,7 @@ namespace hise { using namespace juce;
                                                                     //[/Comments]
 */
 class StereoEditor  : public ProcessorEditorBody,
-                      public Timer,
+                      public PooledUIUpdater::SimpleTimer,
                       public SliderListener
 {
 public:
@@ -286,8 +286,11 @@ void GainEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int num
 
 
 #if ENABLE_PEAK_METERS_FOR_GAIN_EFFECT
-	currentValues.outL = buffer.getMagnitude(0, startIndex, samplesToCopy);
-	currentValues.outR = buffer.getMagnitude(1, startIndex, samplesToCopy);
+	if (isMeteringActive())
+	{
+		currentValues.outL = buffer.getMagnitude(0, startIndex, samplesToCopy);
+		currentValues.outR = buffer.getMagnitude(1, startIndex, samplesToCopy);
+	}
 #endif
 }
 
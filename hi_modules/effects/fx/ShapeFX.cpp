@@ -96,6 +96,7 @@ ShapeFX::ShapeFX(MainController *mc, const String &uid):
 	parameterNames.add("Drive");
 	parameterNames.add("Mix");
 	parameterNames.add("BypassFilters");
+	parameterNames.add("OversamplingProfile");
 
 #if HI_USE_SHAPE_FX_SCRIPTING
 	setupApi();
@@ -146,8 +147,8 @@ void ShapeFX::setInternalAttribute(int parameterIndex, float newValue)
 		{
 			oversampleFactor = (int)newValue;
 			updateOversampling(); 
-			break;
 		}
+		break;
 	case Gain: gain = Decibels::decibelsToGain(newValue); updateMode(); break;
 	case Reduce: reduce = newValue; break;
 	case Autogain: autogain = newValue > 0.5f; updateMode(); break;
@@ -155,6 +156,17 @@ void ShapeFX::setInternalAttribute(int parameterIndex, float newValue)
 	case Drive: drive = newValue; break;
 	case Mix: mix = newValue; updateMix(); break;
 	case BypassFilters:	bypassFilters = newValue > 0.5f; break;
+	case OversamplingProfile:
+	{
+		auto newProfile = (Oversampler::Profile)jlimit(0, (int)Oversampler::Profile::numProfiles - 1, (int)newValue);
+
+		if (newProfile != oversamplingProfile)
+		{
+			oversamplingProfile = newProfile;
+			updateOversampling();
+		}
+		break;
+	}
 	default:  jassertfalse;
 	}
 }
@@ -176,6 +188,7 @@ float ShapeFX::getAttribute(int parameterIndex) const
 	case Drive: return drive;
 	case Mix: return mix;
 	case BypassFilters: return bypassFilters ? 1.0f : 0.0f;
+	case OversamplingProfile: return (float)(int)oversamplingProfile;
 	default:  return 0.0f;
 	}
 }
@@ -197,6 +210,7 @@ float ShapeFX::getDefaultValue(int parameterIndex) const
 	case Drive: return 0.0f;
 	case Mix: return 1.0f;
 	case BypassFilters: return 0.0f;
+	case OversamplingProfile: return (float)(int)Oversampler::Profile::MinimumPhaseIIR;
 	default:  return 0.0f;
 	}
 }
@@ -226,6 +240,7 @@ juce::ValueTree ShapeFX::exportAsValueTree() const
 	saveAttribute(Drive, "Drive");
 	saveAttribute(Mix, "Mix");
 	saveAttribute(BypassFilters, "BypassFilters");
+	saveAttribute(OversamplingProfile, "OversamplingProfile");
 
 	return v;
 }
@@ -255,6 +270,7 @@ void ShapeFX::restoreFromValueTree(const ValueTree &v)
 	loadAttribute(Drive, "Drive");
 	loadAttribute(Mix, "Mix");
 	loadAttributeWithDefault(BypassFilters);
+	loadAttributeWithDefault(OversamplingProfile);
 }
 
 hise::Table* ShapeFX::getTable(int /*tableIndex*/) const
@@ -487,7 +503,7 @@ void ShapeFX::updateOversampling()
     auto factor = 0;
 #endif
 
-    ScopedPointer<Oversampler> newOverSampler = new Oversampler(2, factor, Oversampler::FilterType::filterHalfBandPolyphaseIIR, false);
+    ScopedPointer<Oversampler> newOverSampler = new Oversampler(2, factor, oversamplingProfile);
 
 	if (getLargestBlockSize() > 0)
 		newOverSampler->initProcessing(getLargestBlockSize());
@@ -673,7 +689,7 @@ PolyshapeFX::PolyshapeFX(MainController *mc, const String &uid, int numVoices):
         auto factor = 0;
 #endif
         
-		oversamplers.add(new ShapeFX::Oversampler(2, factor, ShapeFX::Oversampler::FilterType::filterHalfBandPolyphaseIIR, false));
+		oversamplers.add(new ShapeFX::Oversampler(2, factor));
 		driveSmoothers[i] = LinearSmoothedValue<float>(0.0f);
 	}
 
@@ -92,7 +92,7 @@ class ShapeFX : public MasterEffectProcessor,
 {
 public:
 
-	using Oversampler = juce::dsp::Oversampling<float>;
+	using Oversampler = PolyphaseOversampler;
     
 	using ShapeFunction = std::function<float(float)>;
 
@@ -177,6 +177,7 @@ public:
 		Drive,
 		Mix,
 		BypassFilters,
+		OversamplingProfile,
 		numParameters
 	};
 
@@ -324,6 +325,7 @@ private:
 	bool bypassFilters = false;
 
 	int oversampleFactor = 1;
+	Oversampler::Profile oversamplingProfile = Oversampler::Profile::MinimumPhaseIIR;
 
 	float displayTable[SAMPLE_LOOKUP_TABLE_SIZE];
 	float unusedTable[SAMPLE_LOOKUP_TABLE_SIZE];
@@ -167,6 +167,8 @@ temporaryVoiceBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0)
 
 	for (int i = 0; i < 127; i++) samplerDisplayValues.currentNotes[i] = 0;
 
+	adaptiveBufferSizes = mc->getSampleManager().isUsingAdaptiveMode();
+
 	setVoiceAmount(numVoices);
 
 
@@ -183,6 +185,7 @@ temporaryVoiceBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0)
 ModulatorSampler::~ModulatorSampler()
 {
 	soundCollector = nullptr;
+	prefetcher = nullptr;
 	sampleMap = nullptr;
 	abortIteration = true;
 	deleteAllSounds();
@@ -551,11 +554,13 @@ void ModulatorSampler::refreshStreamingBuffers()
 {
 	jassert_processor_idle;
 
+	streamingBufferSize = getStreamingBufferSizeToUse();
+
 	for (int i = 0; i < getNumVoices(); i++)
 	{
 		SynthesiserVoice *v = getVoice(i);
 		static_cast<ModulatorSamplerVoice*>(v)->resetVoice();
-		static_cast<ModulatorSamplerVoice*>(v)->setLoaderBufferSize(bufferSize * preloadScaleFactor);
+		static_cast<ModulatorSamplerVoice*>(v)->setLoaderBufferSize(streamingBufferSize);
 	}
 }
 
@@ -712,11 +717,13 @@ void ModulatorSampler::refreshMemoryUsage()
 	}
 
 	const int64 streamBufferSizePerVoice = 2 *				// two buffers
-		bufferSize *		// buffer size per buffer
+		getActualStreamingBufferSize() *		// buffer size per buffer
 		(sampleMap->isMonolith() ? 2 : 4) *  // bytes per sample
 		2 * numChannels;				// number of channels
 
-	memoryUsage = actualPreloadSize + streamBufferSizePerVoice * getNumVoices();
+	preloadMemoryUsage = actualPreloadSize;
+	streamingMemoryUsage = streamBufferSizePerVoice * getNumVoices();
+	memoryUsage = preloadMemoryUsage + streamingMemoryUsage;
 
 	sendChangeMessage();
 	getSampleMap()->getCurrentSamplePool()->sendChangeMessage();
@@ -803,13 +810,34 @@ bool ModulatorSampler::killAllVoicesAndCall(const ProcessorFunction& f, bool res
 void ModulatorSampler::setSortByGroup(bool shouldSortByGroup)
 {
 	if (shouldSortByGroup != (soundCollector != nullptr))
+	{
+		ScopedPointer<SoundCollectorBase> oldCollector;
+
+		{
+			LockHelpers::SafeLock sl(getMainController(), LockHelpers::AudioLock);
+
+			oldCollector = soundCollector.release();
+
+			if (shouldSortByGroup)
+				soundCollector = new GroupedRoundRobinCollector(this);
+		}
+
+		// The prefetcher might still use the old collector
+		while (prefetcher != nullptr && prefetcher->isRunning())
+			Thread::sleep(1);
+	}
+}
+
+void ModulatorSampler::setUsePredictivePrefetch(bool shouldPrefetch)
+{
+	if (shouldPrefetch != (prefetcher != nullptr))
 	{
 		LockHelpers::SafeLock sl(getMainController(), LockHelpers::AudioLock);
 
-		if (shouldSortByGroup)
-			soundCollector = new GroupedRoundRobinCollector(this);
+		if (shouldPrefetch)
+			prefetcher = new PredictivePrefetcher(this);
 		else
-			soundCollector = nullptr;
+			prefetcher = nullptr;
 	}
 }
 
@@ -900,6 +928,51 @@ SampleThreadPool * ModulatorSampler::getBackgroundThreadPool()
 	return getMainController()->getSampleManager().getGlobalSampleThreadPool();
 }
 
+ModulatorSampler::StreamingStatistics ModulatorSampler::getStreamingStatistics() const
+{
+	StreamingStatistics stats;
+
+	stats.preloadMemory = preloadMemoryUsage;
+	stats.streamingMemory = streamingMemoryUsage;
+
+	if (prefetcher != nullptr)
+		stats.prefetchHitRate = prefetcher->getHitRate();
+
+	const double sampleRate = getSampleRate();
+
+	if (sampleRate <= 0.0)
+		return stats;
+
+	SoundIterator sIter(this, false);
+
+	while (auto sound = sIter.getNextSound())
+	{
+		for (int j = 0; j < numChannels; j++)
+		{
+			auto s = sound->getReferenceToSound(j);
+
+			if (s == nullptr || s->isEntireSampleLoaded() || s->getPreloadBuffer().getNumSamples() == 0)
+				continue;
+
+			auto& tracker = s->getLatencyTracker();
+
+			if (!tracker.hasMeasurements())
+				continue;
+
+			const double latency = tracker.getPeakLatency();
+			const double samplesPerSecond = getStreamingPitchRatio(sound, s) * sampleRate;
+			const int smallestBuffer = jmin(s->getPreloadBuffer().getNumSamples(), getActualStreamingBufferSize());
+
+			stats.peakLatencySeconds = jmax(stats.peakLatencySeconds, latency);
+
+			if (smallestBuffer > 0)
+				stats.underrunRisk = jmax(stats.underrunRisk, latency * samplesPerSecond / (double)smallestBuffer);
+		}
+	}
+
+	return stats;
+}
+
 String ModulatorSampler::getMemoryUsage() const
 {
 	String memory;
@@ -1012,6 +1085,9 @@ void ModulatorSampler::preHiseEventCallback(const HiseEvent &m)
 			}
 
 			samplerDisplayValues.currentGroup = currentRRGroupIndex;
+
+			if (prefetcher != nullptr)
+				prefetcher->notePlayed(m.getNoteNumber() + m.getTransposeAmount(), m.getVelocity(), currentRRGroupIndex);
 		}
 
 		if (m.isNoteOn())
@@ -1278,6 +1354,9 @@ bool ModulatorSampler::preloadAllSamples()
 {
 	const int preloadSizeToUse = (int)getAttribute(ModulatorSampler::PreloadSize) * getPreloadScaleFactor();
 
+	// The sounds that were loaded before their file had a latency measurement
+	Array<std::pair<ModulatorSamplerSound*, StreamingSamplerSound*>> unmeasuredSounds;
+
 	resetNotes();
 	setShouldUpdateUI(false);
 
@@ -1308,7 +1387,10 @@ bool ModulatorSampler::preloadAllSamples()
 
 			progress = (double)currentIndex++ / (double)numToLoad;
 
-			if (!preloadSample(s, preloadSizeToUse))
+			if (adaptiveBufferSizes && !s->getLatencyTracker().hasMeasurements())
+				unmeasuredSounds.add({ sound, s });
+
+			if (!preloadSample(s, getPreloadSizeToUse(sound, s, preloadSizeToUse)))
 				return false;
 		}
 		else
@@ -1323,7 +1405,10 @@ bool ModulatorSampler::preloadAllSamples()
 				{
 					if (isEnabled)
 					{
-						if (!preloadSample(s, preloadSizeToUse))
+						if (adaptiveBufferSizes && !s->getLatencyTracker().hasMeasurements())
+							unmeasuredSounds.add({ sound, s });
+
+						if (!preloadSample(s, getPreloadSizeToUse(sound, s, preloadSizeToUse)))
 							return false;
 					}
 					else
@@ -1335,6 +1420,19 @@ bool ModulatorSampler::preloadAllSamples()
 		sound->setReversed(isReversed);
 	}
 
+	// The first sound of every file was measured with the static size, so we need to load them again
+	for (const auto& u : unmeasuredSounds)
+	{
+		if (u.second->isEntireSampleLoaded() || !u.second->getLatencyTracker().hasMeasurements())
+			continue;
+
+		if (!preloadSample(u.second, getPreloadSizeToUse(u.first, u.second, preloadSizeToUse)))
+			return false;
+	}
+
+	if (adaptiveBufferSizes)
+		refreshStreamingBuffers();
+
 	refreshMemoryUsage();
 	setShouldUpdateUI(true);
 	setHasPendingSampleLoad(false);
@@ -1353,6 +1451,11 @@ bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloa
 	try
 	{
 		s->setPreloadSize(s->hasActiveState() ? preloadSizeToUse : 0, true);
+
+		// One read per file is enough, the voices will update the measurement while streaming
+		if (adaptiveBufferSizes && s->hasActiveState() && !s->getLatencyTracker().hasMeasurements())
+			s->measureReadLatency(bufferSize * preloadScaleFactor);
+
 		s->closeFileHandle();
 		return true;
 	}
@@ -1372,6 +1475,69 @@ bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloa
 	}
 }
 
+double ModulatorSampler::getStreamingPitchRatio(const ModulatorSamplerSound* sound, const StreamingSamplerSound* s) const
+{
+	double sampleRateRatio = 1.0;
+
+	// The sample rate of the file is only known after it was preloaded once
+	if (getSampleRate() > 0.0 && s->getPreloadBuffer().getNumSamples() != 0)
+		sampleRateRatio = s->getSampleRate() / getSampleRate();
+
+	return jmax(1.0, sound->getMaxPitchRatio()) * sampleRateRatio;
+}
+
+int ModulatorSampler::getPreloadSizeToUse(const ModulatorSamplerSound* sound, const StreamingSamplerSound* s, int staticPreloadSize) const
+{
+	// -1 loads the entire sample
+	if (!adaptiveBufferSizes || staticPreloadSize <= 0 || getSampleRate() <= 0.0)
+		return staticPreloadSize;
+
+	auto& tracker = s->getLatencyTracker();
+
+	if (!tracker.hasMeasurements())
+		return staticPreloadSize;
+
+	return StreamingHelpers::getBufferSizeForLatency(tracker.getPeakLatency(), getSampleRate(), getStreamingPitchRatio(sound, s), getLargestBlockSize());
+}
+
+int ModulatorSampler::getActualStreamingBufferSize() const
+{
+	const int sizeToUse = streamingBufferSize != 0 ? streamingBufferSize : bufferSize * preloadScaleFactor;
+
+	// The voices enlarge the buffers if they can't hold one block at the maximum pitch
+	return jmax(sizeToUse, getLargestBlockSize() * MAX_SAMPLER_PITCH);
+}
+
+int ModulatorSampler::getStreamingBufferSizeToUse() const
+{
+	const int staticBufferSize = bufferSize * preloadScaleFactor;
+
+	if (!adaptiveBufferSizes || getSampleRate() <= 0.0)
+		return staticBufferSize;
+
+	// All voices can play every sound, so the buffers must be big enough for the slowest file at its highest pitch
+	int maxSize = 0;
+
+	SoundIterator sIter(this, false);
+
+	while (auto sound = sIter.getNextSound())
+	{
+		for (int j = 0; j < numChannels; j++)
+		{
+			auto s = sound->getReferenceToSound(j);
+
+			if (s == nullptr || s->isEntireSampleLoaded() || !s->getLatencyTracker().hasMeasurements())
+				continue;
+
+			const int size = StreamingHelpers::getBufferSizeForLatency(s->getLatencyTracker().getPeakLatency(), getSampleRate(), getStreamingPitchRatio(sound, s), getLargestBlockSize());
+
+			maxSize = jmax(maxSize, size);
+		}
+	}
+
+	return maxSize != 0 ? maxSize : staticBufferSize;
+}
+
 ModulatorSampler::ScopedUpdateDelayer::ScopedUpdateDelayer(ModulatorSampler* s) :
 	sampler(s)
 {
@@ -1460,4 +1626,163 @@ void ModulatorSampler::GroupedRoundRobinCollector::handleAsyncUpdate()
 	ready.store(true);
 }
 
+ModulatorSampler::PredictivePrefetcher::PredictivePrefetcher(ModulatorSampler* s) :
+	Job("Predictive Prefetch"),
+	sampler(s)
+{
+
+}
+
+ModulatorSampler::PredictivePrefetcher::~PredictivePrefetcher()
+{
+	signalJobShouldExit();
+
+	while (isRunning())
+		Thread::sleep(1);
+}
+
+void ModulatorSampler::PredictivePrefetcher::notePlayed(int noteNumber, int velocity, int rrGroup)
+{
+	GenericScopedTryLock<SpinLock> sl(predictionLock);
+
+	// The sample loading thread is reading the last predictions, skip this note
+	if (!sl.isLocked())
+		return;
+
+	bool hasPredictions = false;
+	bool wasPredicted = false;
+
+	for (const auto& p : predictions)
+	{
+		hasPredictions |= p.noteNumber != -1;
+		wasPredicted |= matches(p, noteNumber, velocity, rrGroup);
+	}
+
+	if (wasPredicted)
+		++numHits;
+	else if (hasPredictions)
+		++numMisses;
+
+	const int nextGroup = sampler->useRoundRobinCycleLogic ? (rrGroup % jmax(1, sampler->rrGroupAmount)) + 1 : rrGroup;
+
+	// The repetition comes first, then the legato transitions to the neighbouring notes
+	static constexpr int noteOffsets[NumPredictions] = { 0, 1, -1, 2, -2 };
+
+	for (int i = 0; i < NumPredictions; i++)
+	{
+		auto& p = predictions[i];
+		const int n = noteNumber + noteOffsets[i];
+
+		if (isPositiveAndBelow(n, 128) && sampler->roundRobinMap.getRRGroupsForMessage(n, velocity) >= nextGroup)
+		{
+			p.noteNumber = n;
+			p.velocity = velocity;
+			p.rrGroup = nextGroup;
+		}
+		else
+			p.noteNumber = -1;
+	}
+
+	if (!isQueued())
+		sampler->getMainController()->getSampleManager().getGlobalSampleThreadPool()->addJob(this, false);
+}
+
+SampleThreadPool::Job::JobStatus ModulatorSampler::PredictivePrefetcher::runJob()
+{
+	Prediction currentPredictions[NumPredictions];
+
+	{
+		SpinLock::ScopedLockType sl(predictionLock);
+
+		for (int i = 0; i < NumPredictions; i++)
+			currentPredictions[i] = predictions[i];
+	}
+
+	int numBlocksLeft = MaxNumBlocksPerRun;
+
+	// The most likely prediction comes first so it gets the budget if there are many matching samples
+	for (const auto& p : currentPredictions)
+	{
+		if (p.noteNumber == -1)
+			continue;
+
+		auto f = [&](ModulatorSamplerSound* sound)
+		{
+			return prefetchIfPredicted(sound, p, numBlocksLeft);
+		};
+
+		auto groupCollector = dynamic_cast<GroupedRoundRobinCollector*>(sampler->soundCollector.get());
+
+		if (groupCollector == nullptr || !groupCollector->callForEachSoundInGroup(p.rrGroup, f))
+		{
+			ModulatorSampler::SoundIterator sIter(sampler);
+
+			if (!sIter.canIterate())
+				return jobHasFinished;
+
+			while (auto sound = sIter.getNextSound())
+			{
+				if (!f(sound.get()))
+					break;
+			}
+		}
+
+		if (numBlocksLeft <= 0 || shouldExit())
+			break;
+	}
+
+	return jobHasFinished;
+}
+
+bool ModulatorSampler::PredictivePrefetcher::prefetchIfPredicted(ModulatorSamplerSound* sound, const Prediction& p, int& numBlocksLeft) const
+{
+	if (numBlocksLeft <= 0 || shouldExit())
+		return false;
+
+	if (!sound->appliesToRRGroup(p.rrGroup) || !sound->appliesToNote(p.noteNumber))
+		return true;
+
+	// Also warm up the neighbouring velocity layers
+	bool velocityFits = false;
+
+	for (int v = jmax(0, p.velocity - VelocitySpread); v <= jmin(127, p.velocity + VelocitySpread); v++)
+		velocityFits |= sound->appliesToVelocity(v);
+
+	if (!velocityFits)
+		return true;
+
+	for (int i = 0; i < sound->getNumMultiMicSamples(); i++)
+	{
+		if (auto s = sound->getReferenceToSound(i))
+		{
+			const int numPrefetched = s->prefetchStreamingArea(NumSamplesToPrefetch);
+
+			// The region might start in the middle of a block, so count the block it ends in as well
+			if (numPrefetched > 0)
+				numBlocksLeft -= numPrefetched / COMPRESSION_BLOCK_SIZE + 1;
+		}
+	}
+
+	return numBlocksLeft > 0;
+}
+
+double ModulatorSampler::PredictivePrefetcher::getHitRate() const noexcept
+{
+	const auto hits = numHits.load();
+	const auto total = hits + numMisses.load();
+
+	return total > 0 ? (double)hits / (double)total : 0.0;
+}
+
+void ModulatorSampler::PredictivePrefetcher::resetHitRate() noexcept
+{
+	numHits.store(0);
+	numMisses.store(0);
+}
+
+bool ModulatorSampler::PredictivePrefetcher::matches(const Prediction& p, int noteNumber, int velocity, int rrGroup) noexcept
+{
+	return p.noteNumber == noteNumber && p.rrGroup == rrGroup && std::abs(p.velocity - velocity) <= VelocitySpread;
+}
+
 } // namespace hise
@@ -113,6 +113,29 @@ public:
 			triggerAsyncUpdate();
 		};
 
+		/** Calls the function for every sound of the given RR group (starting with 1) until it returns false.
+		*
+		*	Returns false if the groups are currently being rebuilt.
+		*/
+		template <typename F> bool callForEachSoundInGroup(int rrGroup, const F& f)
+		{
+			SimpleReadWriteLock::ScopedTryReadLock sl(rebuildLock);
+
+			if (!sl.hasLock() || !ready)
+				return false;
+
+			if (isPositiveAndBelow(rrGroup - 1, groups.size()))
+			{
+				for (auto s : groups.getReference(rrGroup - 1))
+				{
+					if (!f(static_cast<ModulatorSamplerSound*>(s)))
+						break;
+				}
+			}
+
+			return true;
+		}
+
 	private:
 
 		SimpleReadWriteLock rebuildLock;
@@ -126,6 +149,69 @@ public:
 		Array<ReferenceCountedArray<ModulatorSynthSound>> groups;
 	};
 
+	/** Predicts the samples that are most likely played next and decodes the start of their streaming area in advance.
+	*
+	*	For every note-on the audio thread stores a few predictions: a repetition of the same note (using the next
+	*	RR group) and the legato transitions to the neighbouring notes. The RoundRobinMap is used to skip notes that
+	*	have no samples in the predicted group. The sample loading thread then decodes the first blocks after the
+	*	preload buffer of all matching sounds (including the neighbouring velocity layers) into the HLAC decode cache,
+	*	so the voice that eventually plays one of them reads from memory instead of the disk.
+	*
+	*	The predictions are processed in the order above until MaxNumBlocksPerRun blocks were requested, so the
+	*	prefetched blocks never take more than an eighth of the decode cache that is shared with the streaming reads.
+	*	If the sampler sorts its sounds by group, the sounds are taken from the GroupedRoundRobinCollector instead of
+	*	iterating over the whole sample map.
+	*
+	*	This only affects samples that are streamed from a monolith.
+	*/
+	class PredictivePrefetcher : public SampleThreadPool::Job
+	{
+	public:
+
+		PredictivePrefetcher(ModulatorSampler* s);
+
+		~PredictivePrefetcher();
+
+		/** Call this on the audio thread with the note that is about to start and the RR group it will use. */
+		void notePlayed(int noteNumber, int velocity, int rrGroup);
+
+		JobStatus runJob() override;
+
+		/** Returns the ratio of note-ons that were predicted by the note-on before. */
+		double getHitRate() const noexcept;
+
+		void resetHitRate() noexcept;
+
+	private:
+
+		struct Prediction
+		{
+			int noteNumber = -1;
+			int velocity = 0;
+			int rrGroup = 0;
+		};
+
+		static constexpr int NumPredictions = 5;
+		static constexpr int VelocitySpread = 12;
+		static constexpr int NumSamplesToPrefetch = 8192;
+		static constexpr int MaxNumBlocksPerRun = HLAC_DECODE_CACHE_SIZE / 8;
+
+		/** Prefetches the sound if it matches the prediction and returns false if the budget is used up. */
+		bool prefetchIfPredicted(ModulatorSamplerSound* sound, const Prediction& p, int& numBlocksLeft) const;
+
+		static bool matches(const Prediction& p, int noteNumber, int velocity, int rrGroup) noexcept;
+
+		ModulatorSampler* sampler;
+
+		SpinLock predictionLock;
+		Prediction predictions[NumPredictions];
+
+		std::atomic<int64> numHits = { 0 };
+		std::atomic<int64> numMisses = { 0 };
+
+		JUCE_DECLARE_NON_COPYABLE(PredictivePrefetcher);
+	};
+
 	/** A small helper tool that iterates over the sound array in a thread-safe way.
 	*
 	*/
@@ -315,6 +401,24 @@ public:
 	/** Scans all sounds and voices and adds their memory usage. */
 	void refreshMemoryUsage();
 
+	/** The memory usage and the streaming safety of this sampler. */
+	struct StreamingStatistics
+	{
+		int64 preloadMemory = 0;			///< the bytes used by the preload buffers of all sounds
+		int64 streamingMemory = 0;			///< the bytes used by the streaming buffers of all voices
+		double peakLatencySeconds = 0.0;	///< the highest read latency of all files this sampler streams from
+		
+		/** The worst ratio between the read latency and the time a buffer lasts.
+		*
+		*	Values above 1.0 mean that a voice might run out of data before the next read is finished. */
+		double underrunRisk = 0.0;
+
+		double prefetchHitRate = 0.0;		///< the ratio of note-ons that were predicted (if the PredictivePrefetcher is enabled)
+	};
+
+	/** Returns the memory usage and compares the measured read latency with the current buffer sizes. */
+	StreamingStatistics getStreamingStatistics() const;
+
 	int getNumActiveVoices() const override
 	{
 		if (purged) return 0;
@@ -417,6 +521,18 @@ public:
 
 	bool preloadSample(StreamingSamplerSound * s, const int preloadSizeToUse);
 
+	/** Returns the highest playback speed of the file relative to the sampler's sample rate. */
+	double getStreamingPitchRatio(const ModulatorSamplerSound* sound, const StreamingSamplerSound* s) const;
+
+	/** Returns the preload size for the given sound. If the adaptive sizing is disabled, it returns the static size. */
+	int getPreloadSizeToUse(const ModulatorSamplerSound* sound, const StreamingSamplerSound* s, int staticPreloadSize) const;
+
+	/** Returns the size of the streaming buffers. If the adaptive sizing is disabled, this is BufferSize * preload multiplier. */
+	int getStreamingBufferSizeToUse() const;
+
+	/** Returns the size the voices actually use for their streaming buffers. */
+	int getActualStreamingBufferSize() const;
+
 	bool saveSampleMap() const;
 
 	bool saveSampleMapAsReference() const;
@@ -606,6 +722,27 @@ public:
 		return preloadScaleFactor;
 	}
 
+	/** Enables the buffer sizing from the measured disk latency (see DiskMode::Adaptive).
+	*
+	*	If enabled, the PreloadSize and BufferSize attributes are only used until the first read of a file was measured.
+	*	After that each sound gets a preload buffer that lasts as long as the slowest read took (times a safety factor)
+	*	at its highest pitch ratio, and the streaming buffers are sized for the slowest file of this sampler. The sizes
+	*	are recalculated whenever the preload sizes or streaming buffers are refreshed.
+	*/
+	void setUseAdaptiveBufferSizes(bool shouldUseAdaptiveSizes)
+	{
+		if (shouldUseAdaptiveSizes != adaptiveBufferSizes)
+		{
+			adaptiveBufferSizes = shouldUseAdaptiveSizes;
+
+			if (getNumSounds() != 0) refreshPreloadSizes();
+			refreshStreamingBuffers();
+			refreshMemoryUsage();
+		}
+	}
+
+	bool isUsingAdaptiveBufferSizes() const noexcept { return adaptiveBufferSizes; }
+
 	int getCurrentRRGroup() const noexcept { return currentRRGroupIndex; }
 
 	int getNumActiveGroups() const;
@@ -647,6 +784,11 @@ public:
 	
 	void setSortByGroup(bool shouldSortByGroup);
 
+	/** Enables the PredictivePrefetcher for this sampler. */
+	void setUsePredictivePrefetch(bool shouldPrefetch);
+
+	bool isUsingPredictivePrefetch() const noexcept { return prefetcher != nullptr; }
+
 	bool shouldDelayUpdate() const noexcept { return delayUpdate; }
 
 	/** Checks the global queue if there are any jobs that will be executed sometime in the future. 
@@ -672,6 +814,8 @@ private:
 
 	SimpleReadWriteLock iteratorLock;
 
+	ScopedPointer<PredictivePrefetcher> prefetcher;
+
 	bool abortIteration = false;
 	
 	
@@ -776,6 +920,7 @@ private:
 	RepeatMode repeatMode;
 	int voiceAmount;
 	int preloadScaleFactor = 1;
+	bool adaptiveBufferSizes = false;
 
 	mutable SamplerDisplayValues samplerDisplayValues;
 
@@ -789,6 +934,9 @@ private:
 	bool useStaticMatrix = false;
 
 	int64 memoryUsage;
+	int64 preloadMemoryUsage = 0;
+	int64 streamingMemoryUsage = 0;
+	int streamingBufferSize = 0;
 
 	OwnedArray<SampleLookupTable> crossfadeTables;
 
@@ -182,6 +182,15 @@ void SampleComponent::drawSampleRectangle(Graphics &g, Rectangle<int> areaInt)
     }
 }
 
+bool SampleComponent::hasVelocityCrossfade() const
+{
+	if (sound.get() == nullptr)
+		return false;
+
+	return (int)sound->getSampleProperty(SampleIds::LowerVelocityXFade) != 0 ||
+		   (int)sound->getSampleProperty(SampleIds::UpperVelocityXFade) != 0;
+}
+
 bool SampleComponent::needsToBeDrawn()
 {
 	const bool enoughSiblings = numOverlayerSiblings > 4;
@@ -192,6 +201,86 @@ bool SampleComponent::needsToBeDrawn()
 
 // =================================================================================================================== SamplerSoundMap
 
+void SamplerSoundMap::SampleIndex::rebuild(const OwnedArray<SampleComponent>& components)
+{
+	for (auto& c : cells)
+		c.clearQuick();
+
+	wideComponents.clearQuick();
+
+	stamps.clearQuick();
+	stamps.insertMultiple(0, 0, components.size());
+	currentStamp = 0;
+
+	for (int i = 0; i < components.size(); i++)
+	{
+		auto s = components[i]->getSound();
+
+		if (s == nullptr)
+			continue;
+
+		const int loKey = jlimit(0, NumKeys - 1, (int)s->getSampleProperty(SampleIds::LoKey));
+		const int hiKey = jlimit(loKey, NumKeys - 1, (int)s->getSampleProperty(SampleIds::HiKey));
+		const int loBand = jlimit(0, NumBands - 1, (int)s->getSampleProperty(SampleIds::LoVel) / BandSize);
+		const int hiBand = jlimit(loBand, NumBands - 1, (int)s->getSampleProperty(SampleIds::HiVel) / BandSize);
+
+		if ((hiKey - loKey + 1) * (hiBand - loBand + 1) > MaxCellsPerComponent)
+		{
+			wideComponents.add(i);
+			continue;
+		}
+
+		for (int k = loKey; k <= hiKey; k++)
+		{
+			for (int b = loBand; b <= hiBand; b++)
+				cells[k * NumBands + b].add(i);
+		}
+	}
+
+	dirty = false;
+}
+
+void SamplerSoundMap::SampleIndex::getCandidates(int loKey, int hiKey, int loVel, int hiVel, Array<int>& indexes)
+{
+	jassert(!dirty);
+
+	// The stamps make sure that components spanning multiple cells are only added once
+	if (++currentStamp == 0)
+	{
+		stamps.fill(0);
+		currentStamp = 1;
+	}
+
+	auto addIfNew = [&](int index)
+	{
+		if (stamps.getUnchecked(index) != currentStamp)
+		{
+			stamps.setUnchecked(index, currentStamp);
+			indexes.add(index);
+		}
+	};
+
+	loKey = jlimit(0, NumKeys - 1, loKey);
+	hiKey = jlimit(loKey, NumKeys - 1, hiKey);
+
+	const int loBand = jlimit(0, NumBands - 1, loVel / BandSize);
+	const int hiBand = jlimit(loBand, NumBands - 1, hiVel / BandSize);
+
+	for (int k = loKey; k <= hiKey; k++)
+	{
+		for (int b = loBand; b <= hiBand; b++)
+		{
+			for (auto i : cells[k * NumBands + b])
+				addIfNew(i);
+		}
+	}
+
+	for (auto i : wideComponents)
+		addIfNew(i);
+
+	indexes.sort();
+}
+
 SamplerSoundMap::SamplerSoundMap(ModulatorSampler *ownerSampler_):
 	PreloadListener(ownerSampler_->getMainController()->getSampleManager()),
 	ownerSampler(ownerSampler_),
@@ -218,7 +307,7 @@ SamplerSoundMap::SamplerSoundMap(ModulatorSampler *ownerSampler_):
 
 	updateSoundData();
 
-	
+	setEnablePaintProfiling("SamplerSoundMap");
 
 	setOpaque(true);
 };
@@ -456,9 +545,14 @@ void SamplerSoundMap::findLassoItemsInArea(Array<WeakReference<SampleComponent>>
 
 void SamplerSoundMap::refreshSelectedSoundsFromLasso()
 {
+	PaintProfiler profiler("SamplerSoundMap::lasso");
+
 	lassoSelectedComponents.clear();
 
-	for (int i = 0; i < sampleComponents.size(); i++)
+	Array<int> candidates;
+	getSampleComponentsInArea(currentLassoRectangle, candidates);
+
+	for (auto i : candidates)
 	{
 		SampleComponent *c = sampleComponents[i];
 
@@ -532,14 +626,88 @@ void SamplerSoundMap::drawSoundMap(Graphics &g)
         //g.drawLine(i * noteWidth, 0, i * noteWidth, (float)getHeight(), 1.0f);
     }
     
-    for(int i = 0; i < sampleComponents.size(); i++)
-    {
-        SampleComponent *c = sampleComponents[i];
-		
-		if (!c->isVisible()) continue;
+	auto clipBounds = g.getClipBounds();
 
-		c->drawSampleRectangle(g, c->getBoundsInParent());
-    }
+	Array<int> candidates;
+	getSampleComponentsInArea(clipBounds, candidates);
+
+	// Plain rectangles with the same colours are drawn in one batch, the
+	// selected sounds are drawn last so that they end up on top.
+	struct Batch
+	{
+		Colour fillColour;
+		Colour outlineColour;
+		RectangleList<float> fills;
+		RectangleList<float> outlines;
+	};
+
+	ScopedLock sl(ownerSampler->getExportLock());
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const bool drawSelected = pass == 1;
+
+		std::vector<Batch> batches;
+		Array<SampleComponent*> crossfadedComponents;
+
+		for (auto i : candidates)
+		{
+			SampleComponent *c = sampleComponents[i];
+
+			if (!c->isVisible() || c->isSelected() != drawSelected || c->getSound() == nullptr)
+				continue;
+
+			auto b = c->getBoundsInParent();
+
+			if (!clipBounds.intersects(b))
+				continue;
+
+			if (c->hasVelocityCrossfade())
+			{
+				crossfadedComponents.add(c);
+				continue;
+			}
+
+			auto fillColour = c->getColourForSound(false);
+			auto outlineColour = c->getColourForSound(true);
+
+			Batch* batch = nullptr;
+
+			for (auto& existing : batches)
+			{
+				if (existing.fillColour == fillColour && existing.outlineColour == outlineColour)
+				{
+					batch = &existing;
+					break;
+				}
+			}
+
+			if (batch == nullptr)
+			{
+				batches.push_back({ fillColour, outlineColour, {}, {} });
+				batch = &batches.back();
+			}
+
+			auto fb = b.toFloat();
+
+			batch->fills.addWithoutMerging(fb);
+			batch->outlines.addWithoutMerging(fb.withHeight(1.0f));
+			batch->outlines.addWithoutMerging(fb.withTop(fb.getBottom() - 1.0f));
+			batch->outlines.addWithoutMerging(fb.withWidth(1.0f));
+			batch->outlines.addWithoutMerging(fb.withLeft(fb.getRight() - 1.0f));
+		}
+
+		for (const auto& batch : batches)
+		{
+			g.setColour(batch.fillColour);
+			g.fillRectList(batch.fills);
+			g.setColour(batch.outlineColour);
+			g.fillRectList(batch.outlines);
+		}
+
+		for (auto c : crossfadedComponents)
+			c->drawSampleRectangle(g, c->getBoundsInParent());
+	}
 }
 
 void SamplerSoundMap::paint(Graphics &g)
@@ -681,6 +849,7 @@ void SamplerSoundMap::updateSampleComponent(int index, NotificationType )
 		const int y_max = getHeight() - (int)s->getSampleProperty(SampleIds::LoVel) * velocityHeight;
 
 		sampleComponents[index]->setSampleBounds((int)x, (int)y, (int)(x_max - x), (int)(y_max-y));
+		sampleIndex.setDirty();
 		
 		repaint();
 	}
@@ -711,6 +880,8 @@ void SamplerSoundMap::updateSoundData()
 		{
 			sampleComponents.add(new SampleComponent(sound, this));
 		}
+
+		sampleIndex.setDirty();
 	}
 	else
 	{
@@ -852,6 +1023,8 @@ bool SamplerSoundMap::isDragOperation(const MouseEvent& e)
 
 void SamplerSoundMap::mouseMove(const MouseEvent &e)
 {
+	PaintProfiler profiler("SamplerSoundMap::hover");
+
 	const float noteWidth = (float)getWidth() / 128.0f;
 
 	const float velocityHeight = (float)getHeight() / 128.0f;
@@ -993,7 +1166,12 @@ void SamplerSoundMap::setPressedKeys(const uint8 *pressedKeyData)
 
 		if(change)
 		{
-			for (int j = 0; j < sampleComponents.size(); j++)
+			updateIndexIfNecessary();
+
+			Array<int> candidates;
+			sampleIndex.getCandidates(number, number, velocity, velocity, candidates);
+
+			for (auto j : candidates)
 			{
 				if (sampleComponents[j]->isVisible() && sampleComponents[j]->getSound() != nullptr &&
 					sampleComponents[j]->getSound()->appliesToMessage(1, number, velocity) &&
@@ -1013,7 +1191,10 @@ void SamplerSoundMap::setPressedKeys(const uint8 *pressedKeyData)
 
 SampleComponent* SamplerSoundMap::getSampleComponentAt(Point<int> point)
 {
-	for(int i = 0; i < sampleComponents.size(); i++)
+	Array<int> candidates;
+	getSampleComponentsInArea({ point.x, point.y, 1, 1 }, candidates);
+
+	for(auto i : candidates)
 	{
 		if (sampleComponents[i]->isVisible() && sampleComponents[i]->samplePathContains(point)) return sampleComponents[i];
 	}
@@ -1021,6 +1202,33 @@ SampleComponent* SamplerSoundMap::getSampleComponentAt(Point<int> point)
 	return nullptr;
 };
 
+void SamplerSoundMap::getSampleComponentsInArea(Rectangle<int> area, Array<int>& indexes)
+{
+	updateIndexIfNecessary();
+
+	const float noteWidth = (float)getWidth() / 128.0f;
+	const int velocityHeight = getHeight() / 128;
+
+	if (noteWidth <= 0.0f)
+		return;
+
+	// Add a safety margin of one key / velocity because the bounds are rounded
+	// (see updateSampleComponent())
+	const int loKey = (int)((float)area.getX() / noteWidth) - 1;
+	const int hiKey = (int)((float)area.getRight() / noteWidth) + 1;
+
+	int loVel = 0;
+	int hiVel = 127;
+
+	if (velocityHeight > 0)
+	{
+		loVel = jmax(0, (getHeight() - area.getBottom()) / velocityHeight - 1);
+		hiVel = jmax(0, (getHeight() - area.getY()) / velocityHeight + 1);
+	}
+
+	sampleIndex.getCandidates(loKey, hiKey, loVel, hiVel, indexes);
+}
+
 
 
 void SamplerSoundMap::checkEventForSampleDragging(const MouseEvent &e)
@@ -1057,11 +1265,24 @@ void SamplerSoundMap::checkEventForSampleDragging(const MouseEvent &e)
 
 void SamplerSoundMap::setSelectedIds(const SampleSelection& newSelectionList)
 {
+	PaintProfiler profiler("SamplerSoundMap::selection");
+
 	selectedSounds->deselectAll();
 
+	// Use a sorted list so that huge selections don't end up with a quadratic lookup
+	Array<ModulatorSamplerSound*> sortedSelection;
+	sortedSelection.ensureStorageAllocated(newSelectionList.size());
+
+	for (auto s : newSelectionList)
+		sortedSelection.add(s.get());
+
+	sortedSelection.sort();
+
+	DefaultElementComparator<ModulatorSamplerSound*> comparator;
+
 	for(int i = 0; i < sampleComponents.size(); i++)
 	{
-		if(newSelectionList.contains(sampleComponents[i]->getSound()))
+		if(sortedSelection.indexOfSorted(comparator, sampleComponents[i]->getSound()) != -1)
 		{
 			selectedSounds->addToSelection(sampleComponents[i]);
 		}
@@ -231,6 +231,9 @@ public:
 
 	bool samplePathContains(Point<int> localPoint) const;
 
+	/** Returns true if the sound has a velocity crossfade and can't be drawn as plain rectangle. */
+	bool hasVelocityCrossfade() const;
+
     void drawSampleRectangle(Graphics &g, Rectangle<int> area);
 
 	const ModulatorSamplerSound *getSound() const noexcept { return sound; };
@@ -455,6 +458,54 @@ public:
 
 private:
 
+	/** A spatial index over the key / velocity ranges of the sample components.
+	*
+	*	The map is divided into 128 key columns and 16 velocity bands and every component is registered
+	*	in the cells that it covers, so that hit-testing, lasso selection and painting only have to look at
+	*	the components in the affected cells instead of iterating over the whole sample map.
+	*/
+	class SampleIndex
+	{
+	public:
+
+		enum
+		{
+			NumKeys = 128,
+			BandSize = 8,
+			NumBands = 128 / BandSize,
+			MaxCellsPerComponent = 256
+		};
+
+		void rebuild(const OwnedArray<SampleComponent>& components);
+
+		void setDirty() noexcept { dirty = true; }
+		bool isDirty() const noexcept { return dirty; }
+
+		/** Adds the indexes of all components that might intersect the given (inclusive) ranges in ascending order. */
+		void getCandidates(int loKey, int hiKey, int loVel, int hiVel, Array<int>& indexes);
+
+	private:
+
+		Array<int> cells[NumKeys * NumBands];
+
+		// Components that span too many cells are stored (and checked) separately
+		Array<int> wideComponents;
+
+		Array<uint32> stamps;
+		uint32 currentStamp = 0;
+
+		bool dirty = true;
+	};
+
+	/** Adds the indexes of all components that might intersect the area in ascending order. */
+	void getSampleComponentsInArea(Rectangle<int> area, Array<int>& indexes);
+
+	void updateIndexIfNecessary()
+	{
+		if (sampleIndex.isDirty())
+			sampleIndex.rebuild(sampleComponents);
+	}
+
 	PoolReference oldReference;
 
 	bool isPreloading = false;
@@ -499,6 +550,8 @@ private:
 	Array<int> selectedIds;
 	OwnedArray<SampleComponent> sampleComponents;
 
+	SampleIndex sampleIndex;
+
 	Array<WeakReference<SampleComponent>> lassoSelectedComponents;
 
 	ScopedPointer<SelectedItemSet<WeakReference<SampleComponent>>> selectedSounds;
@@ -85,6 +85,19 @@ public:
 
 		memoryUsageLabel->setText(sampler->getMemoryUsage(), dontSendNotification);
 
+		const auto stats = sampler->getStreamingStatistics();
+
+		String statsText;
+		statsText << "Preload: " << String((double)stats.preloadMemory / 1024.0 / 1024.0, 2) << "MB, ";
+		statsText << "Streaming: " << String((double)stats.streamingMemory / 1024.0 / 1024.0, 2) << "MB, ";
+		statsText << "Disk latency: " << String(stats.peakLatencySeconds * 1000.0, 1) << "ms, ";
+		statsText << "Underrun risk: " << String(stats.underrunRisk * 100.0, 0) << "%";
+
+		if (sampler->isUsingPredictivePrefetch())
+			statsText << ", Prefetch hit rate: " << String(stats.prefetchHitRate * 100.0, 0) << "%";
+
+		memoryUsageLabel->setTooltip(statsText);
+
         if(voiceLimitEditor->getCurrentTextEditor() == nullptr)
         {
             voiceLimitEditor->setText(String((int)sampler->getAttribute(ModulatorSampler::VoiceLimit)), dontSendNotification);
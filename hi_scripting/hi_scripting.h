@@ -60,6 +60,26 @@ compile / debug cycle and don't need all nodes in scriptnode you might want to t
 #define INCLUDE_BIG_SCRIPTNODE_OBJECT_COMPILATION 1
 #endif
 
+/** Config: HISE_SCRIPTNODE_USE_COMPILED_GRAPH
+
+If this is true, the DspNetwork will flatten its chain, split and multi containers into a list of
+direct node calls and use this for processing. Editing the network switches back to the dynamic
+node graph until the flattened graph was rebuilt.
+*/
+#ifndef HISE_SCRIPTNODE_USE_COMPILED_GRAPH
+#define HISE_SCRIPTNODE_USE_COMPILED_GRAPH 1
+#endif
+
+/** Config: HISE_SKIP_UNCHANGED_CONTROL_CALLBACKS
+
+If this is true, restoring a user preset will not fire the control callbacks of components whose value
+didn't change. The first restore after compiling the script always fires every callback. Only enable this
+if your control callbacks don't depend on being called for every control on a preset load.
+*/
+#ifndef HISE_SKIP_UNCHANGED_CONTROL_CALLBACKS
+#define HISE_SKIP_UNCHANGED_CONTROL_CALLBACKS 0
+#endif
+
 
 #define INCLUDE_TCC 0
 
@@ -38,6 +38,7 @@
 #include "scripting/scriptnode/nodes/CodeGenerator.h"
 #include "scripting/scriptnode/nodes/NodeContainer.h"
 #include "scripting/scriptnode/nodes/NodeContainerTypes.h"
+#include "scripting/scriptnode/api/CompiledGraph.h"
 #include "scripting/scriptnode/nodes/NodeWrapper.h"
 
 #include "scripting/scriptnode/nodes/ProcessNodes.h"
@@ -67,6 +68,7 @@
 #include "scripting/scriptnode/nodes/CodeGenerator.cpp"
 #include "scripting/scriptnode/nodes/NodeContainer.cpp"
 #include "scripting/scriptnode/nodes/NodeContainerTypes.cpp"
+#include "scripting/scriptnode/api/CompiledGraph.cpp"
 #include "scripting/scriptnode/nodes/NodeWrapper.cpp"
 #include "scripting/scriptnode/nodes/ProcessNodes.cpp"
 #include "scripting/scriptnode/nodes/JitNode.cpp"
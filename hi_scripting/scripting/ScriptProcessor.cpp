@@ -165,7 +165,11 @@ void ProcessorWithScriptingContent::controlCallback(ScriptingApi::Content::Scrip
 	}
 	else if (auto callback = component->getCustomControlCallback())
 	{
-		if (MessageManager::getInstance()->isThisTheMessageThread())
+		if (deferControlCallback(component, controllerValue))
+		{
+			// will be executed when the batch is done...
+		}
+		else if (MessageManager::getInstance()->isThisTheMessageThread())
 		{
 			auto f = [component, controllerValue](JavascriptProcessor* p)
 			{
@@ -194,7 +198,11 @@ void ProcessorWithScriptingContent::controlCallback(ScriptingApi::Content::Scrip
 
 		if (!onControlCallback->isSnippetEmpty())
 		{
-			if (MessageManager::getInstance()->isThisTheMessageThread())
+			if (deferControlCallback(component, controllerValue))
+			{
+				// will be executed when the batch is done...
+			}
+			else if (MessageManager::getInstance()->isThisTheMessageThread())
 			{
 				auto f = [component, controllerValue](JavascriptProcessor* p)
 				{
@@ -220,6 +228,103 @@ void ProcessorWithScriptingContent::controlCallback(ScriptingApi::Content::Scrip
 		thisAsProcessor->sendChangeMessage();
 }
 
+ProcessorWithScriptingContent::ScopedControlCallbackBatch::ScopedControlCallbackBatch(ProcessorWithScriptingContent& p_) :
+	p(p_)
+{
+	auto thisThread = Thread::getCurrentThreadId();
+	Thread::ThreadID expected = nullptr;
+
+	active = p.batchThread.compare_exchange_strong(expected, thisThread) || expected == thisThread;
+
+	if (active)
+		p.numActiveBatches++;
+}
+
+ProcessorWithScriptingContent::ScopedControlCallbackBatch::~ScopedControlCallbackBatch()
+{
+	if (active && --p.numActiveBatches == 0)
+		p.executePendingControlCallbacks();
+}
+
+bool ProcessorWithScriptingContent::deferControlCallback(ScriptingApi::Content::ScriptComponent *component, const var& controllerValue)
+{
+	if (batchThread.load() != Thread::getCurrentThreadId())
+		return false;
+
+	if (pendingControlCallbackIndexes.contains(component))
+	{
+		pendingControlCallbacks.getReference(pendingControlCallbackIndexes[component]).value = controllerValue;
+		pendingStats.numCoalesced++;
+		return true;
+	}
+
+	pendingControlCallbackIndexes.set(component, pendingControlCallbacks.size());
+	pendingControlCallbacks.add({ component, controllerValue });
+	return true;
+}
+
+void ProcessorWithScriptingContent::executePendingControlCallbacks()
+{
+	Array<PendingControlCallback> callbacks;
+	callbacks.swapWith(pendingControlCallbacks);
+	pendingControlCallbackIndexes.clear();
+
+	auto stats = pendingStats;
+	pendingStats = {};
+
+	// Other threads can start a new batch from here
+	batchThread.store(nullptr);
+
+	if (callbacks.isEmpty())
+	{
+		lastBatchStats = stats;
+		return;
+	}
+
+	if (MessageManager::getInstance()->isThisTheMessageThread())
+	{
+		auto f = [callbacks, stats](JavascriptProcessor* p)
+		{
+			dynamic_cast<ProcessorWithScriptingContent*>(p)->executeControlCallbackBatch(callbacks, stats);
+			return p->lastResult;
+		};
+
+		getMainController_()->getJavascriptThreadPool().addJob(JavascriptThreadPool::Task::HiPriorityCallbackExecution,
+															   dynamic_cast<JavascriptProcessor*>(this),
+															   f);
+	}
+	else
+	{
+		executeControlCallbackBatch(callbacks, stats);
+	}
+}
+
+void ProcessorWithScriptingContent::executeControlCallbackBatch(const Array<PendingControlCallback>& callbacks, ControlCallbackBatchStats stats)
+{
+	if (thisAsJavascriptProcessor == nullptr)
+		thisAsJavascriptProcessor = dynamic_cast<JavascriptProcessor*>(this);
+
+	const double start = Time::getMillisecondCounterHiRes();
+
+	{
+		// The callbacks will use the same lock so it is only acquired once for the whole batch
+		LockHelpers::SafeLock sl(getMainController_(), LockHelpers::ScriptLock);
+
+		for (const auto& pc : callbacks)
+		{
+			if (pc.component->getCustomControlCallback())
+				customControlCallbackIdle(pc.component, pc.value, thisAsJavascriptProcessor->lastResult);
+			else
+				defaultControlCallbackIdle(pc.component, pc.value, thisAsJavascriptProcessor->lastResult);
+
+			stats.numExecuted++;
+		}
+	}
+
+	stats.milliSeconds = Time::getMillisecondCounterHiRes() - start;
+	lastBatchStats = stats;
+}
+
 void ProcessorWithScriptingContent::defaultControlCallbackIdle(ScriptingApi::Content::ScriptComponent *component, const var& controllerValue, Result& r)
 {
 	ScopedValueSetter<bool> objectConstructorSetter(allowObjectConstructors, true);
@@ -522,6 +627,24 @@ ValueTree FileChangeListener::collectAllScriptFiles(ModulatorSynthChain *chainTo
 	return externalScriptFiles;
 }
 
+ValueTree FileChangeListener::collectAllTokenSnapshots(ModulatorSynthChain *chainToExport, const ValueTree& externalScriptFiles)
+{
+	StringArray scripts;
+
+	for (const auto& s : externalScriptFiles)
+		scripts.addIfNotAlreadyThere(s.getProperty("Content").toString());
+
+	Processor::Iterator<JavascriptProcessor> iter(chainToExport);
+
+	while (JavascriptProcessor *sp = iter.getNextProcessor())
+	{
+		for (int i = 0; i < sp->getNumSnippets(); i++)
+			scripts.addIfNotAlreadyThere(sp->getSnippet(i)->getSnippetAsFunction());
+	}
+
+	return HiseJavascriptEngine::TokenSnapshot::createSnapshotTree(scripts);
+}
+
 void FileChangeListener::addFileContentToValueTree(ValueTree externalScriptFiles, File scriptFile, ModulatorSynthChain* chainToExport)
 {
 	String fileName = scriptFile.getRelativePathFrom(GET_PROJECT_HANDLER(chainToExport).getSubDirectory(ProjectHandler::SubDirectories::Scripts));
@@ -104,6 +104,43 @@ public:
 
 	virtual int getControlCallbackIndex() const = 0;
 
+	/** Some statistics about the last batch of control callbacks. */
+	struct ControlCallbackBatchStats
+	{
+		int numExecuted = 0;
+		int numCoalesced = 0;
+		int numSkipped = 0;
+		double milliSeconds = 0.0;
+	};
+
+	/** Create one of these on the stack to batch all script control callbacks of this processor.
+	*
+	*	While it is active, the control callbacks will be collected (multiple value changes of the same
+	*	component are coalesced into the last value) and executed with a single script lock acquisition
+	*	when the last batch object goes out of scope.
+	*
+	*	The batch belongs to the thread that created it. Control callbacks from other threads (eg. host
+	*	automation) are executed as usual, and a batch that is created on another thread while one is
+	*	active does nothing.
+	*/
+	struct ScopedControlCallbackBatch
+	{
+		ScopedControlCallbackBatch(ProcessorWithScriptingContent& p_);
+		~ScopedControlCallbackBatch();
+
+		/** Call this if a callback was skipped because the value didn't change. */
+		void addSkippedCallback() { if (active) p.pendingStats.numSkipped++; }
+
+	private:
+
+		ProcessorWithScriptingContent& p;
+		bool active = false;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedControlCallbackBatch);
+	};
+
+	const ControlCallbackBatchStats& getLastControlCallbackBatchStats() const { return lastBatchStats; }
+
 	virtual int getNumScriptParameters() const;
 
 	var getSavedValue(Identifier name)
@@ -176,6 +213,27 @@ private:
 
 	void customControlCallbackIdle(ScriptingApi::Content::ScriptComponent *component, const var& controllerValue, Result& r);
 
+	struct PendingControlCallback
+	{
+		ReferenceCountedObjectPtr<ScriptingApi::Content::ScriptComponent> component;
+		var value;
+	};
+
+	/** Adds the callback to the current batch. Returns false if there is no active batch. */
+	bool deferControlCallback(ScriptingApi::Content::ScriptComponent *component, const var& controllerValue);
+
+	void executePendingControlCallbacks();
+
+	void executeControlCallbackBatch(const Array<PendingControlCallback>& callbacks, ControlCallbackBatchStats stats);
+
+	// Only the thread that owns the batch touches the pending callbacks
+	std::atomic<Thread::ThreadID> batchThread = { nullptr };
+	int numActiveBatches = 0;
+	Array<PendingControlCallback> pendingControlCallbacks;
+	HashMap<ScriptingApi::Content::ScriptComponent*, int> pendingControlCallbackIndexes;
+	ControlCallbackBatchStats pendingStats;
+	ControlCallbackBatchStats lastBatchStats;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(ProcessorWithScriptingContent);
 };
 
@@ -298,6 +356,9 @@ public:
 	/** This includes every external script, compresses it and returns a base64 encoded string that can be shared without further dependencies. */
 	static ValueTree collectAllScriptFiles(ModulatorSynthChain *synthChainToExport);
 
+	/** Creates precompiled token snapshots for every script callback and every collected external file. */
+	static ValueTree collectAllTokenSnapshots(ModulatorSynthChain *synthChainToExport, const ValueTree& externalScriptFiles);
+
 private:
 
 	friend class ExternalScriptFile;
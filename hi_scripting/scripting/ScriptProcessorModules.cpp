@@ -174,6 +174,7 @@ void JavascriptMidiProcessor::registerApiClasses()
 
 	//content = new ScriptingApi::Content(this);
     front = false;
+	realtimeSafeCallbacks = false;
 
 	currentMidiMessage = new ScriptingApi::Message(this);
 	engineObject = new ScriptingApi::Engine(this);
@@ -355,8 +356,29 @@ void JavascriptMidiProcessor::deferCallbacks(bool addToFront_)
 	{
 		stopTimer();
 	}
+
+	updateRealtimeSafeCallbacks();
 };
 
+void JavascriptMidiProcessor::setRealtimeSafeCallbacks(bool shouldBeRealtimeSafe)
+{
+	realtimeSafeCallbacks = shouldBeRealtimeSafe;
+	updateRealtimeSafeCallbacks();
+}
+
+void JavascriptMidiProcessor::updateRealtimeSafeCallbacks()
+{
+	// The callbacks are parsed after onInit, so this is called while the
+	// onInit callback is executed and before the other callbacks are compiled.
+	if (scriptEngine == nullptr)
+		return;
+
+	const bool isRealtime = realtimeSafeCallbacks && !deferred;
+
+	for (auto c : { onNoteOn, onNoteOff, onController, onTimer })
+		scriptEngine->setCallbackIsRealtimeSafe(getSnippet(c)->getCallbackName(), isRealtime);
+}
+
 StringArray JavascriptMidiProcessor::getImageFileNames() const
 {
 	jassert(isFront());
@@ -502,7 +524,8 @@ void JavascriptPolyphonicEffect::renderVoice(int voiceIndex, AudioSampleBuffer &
 		scriptnode::ProcessData d(channels, numChannels, numSamples);
 
 		scriptnode::DspNetwork::VoiceSetter vs(*n, voiceIndex);
-		n->getRootNode()->process(d);
+		ScopedLock sl(n->getConnectionLock());
+		n->process(d);
 	}
 }
 
@@ -1086,7 +1109,7 @@ void JavascriptTimeVariantModulator::calculateBlock(int startSample, int numSamp
 		scriptnode::ProcessData d(&ptr, 1, numSamples);
 
 		ScopedLock sl(n->getConnectionLock());
-		n->getRootNode()->process(d);
+		n->process(d);
 	}
 	else if (!processBlockCallback->isSnippetEmpty() && lastResult.wasOk())
 	{
@@ -1257,7 +1280,7 @@ void JavascriptEnvelopeModulator::calculateBlock(int startSample, int numSamples
 		d.shouldReset = false;
 
 		ScopedLock sl(n->getConnectionLock());
-		n->getRootNode()->process(d);
+		n->process(d);
 
 		if (d.shouldReset)
 			reset(polyManager.getCurrentVoice());
@@ -1892,7 +1915,8 @@ void JavascriptSynthesiser::Voice::calculateBlock(int startSample, int numSample
 
 		{
 			scriptnode::DspNetwork::VoiceSetter vs(*n, getVoiceIndex());
-			rootNode->process(d);
+			ScopedLock sl(n->getConnectionLock());
+			n->process(d);
 		}
 		
 		if (auto modValues = getOwnerSynth()->getVoiceGainValues())
@@ -102,6 +102,14 @@ public:
 	void deferCallbacks(bool addToFront_);
 	bool isDeferred() const { return deferred; };
 
+	/** Rejects expressions that might allocate in the MIDI and timer callbacks at compile time.
+	*
+	*	Allocations inside API methods are not covered by this check. This has no effect if the callbacks 
+	*	are deferred to the message thread.
+	*/
+	void setRealtimeSafeCallbacks(bool shouldBeRealtimeSafe);
+	bool hasRealtimeSafeCallbacks() const { return realtimeSafeCallbacks; }
+
 	void timerCallback() override
 	{
 		jassert(isDeferred());
@@ -186,6 +194,8 @@ private:
 	void runTimerCallback(int offsetInBuffer = -1);
 	void runScriptCallbacks();
 
+	void updateRealtimeSafeCallbacks();
+
 	ScopedPointer<SnippetDocument> onInitCallback;
 	ScopedPointer<SnippetDocument> onNoteOnCallback;
 	ScopedPointer<SnippetDocument> onNoteOffCallback;
@@ -210,6 +220,7 @@ private:
 	ScriptingApi::Synth *synthObject;
 
 	bool front, deferred, deferredUpdatePending;
+	bool realtimeSafeCallbacks = false;
 
 	StringArray storedModuleIds;
 };
@@ -1409,6 +1409,362 @@ private:
 
 static ModulationTests modulationTests;
 
+class ProcessorRegistryTests : public UnitTest
+{
+public:
+
+	ProcessorRegistryTests() :
+		UnitTest("Testing the processor registry")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+		auto& registry = bp->getProcessorRegistry();
+		auto root = bp->getMainSynthChain();
+
+		auto synth = new NoiseSynth(bp, "Duplicate", NUM_POLYPHONIC_VOICES);
+		synth->addProcessorsWhenEmpty();
+		root->getHandler()->add(synth, nullptr);
+
+		auto gainChain = dynamic_cast<ModulatorChain*>(synth->getChildProcessor(ModulatorSynth::GainModulation));
+		auto pitchChain = dynamic_cast<ModulatorChain*>(synth->getChildProcessor(ModulatorSynth::PitchModulation));
+
+		auto gainMod = new ConstantModulator(bp, "Duplicate", NUM_POLYPHONIC_VOICES, gainChain->getMode());
+		gainChain->getHandler()->add(gainMod, nullptr);
+
+		auto pitchMod = new ConstantModulator(bp, "Duplicate", NUM_POLYPHONIC_VOICES, pitchChain->getMode());
+		pitchChain->getHandler()->add(pitchMod, nullptr);
+
+		beginTest("Testing duplicate IDs across processor types");
+
+		auto all = registry.getProcessorsWithId("Duplicate", root);
+
+		expectEquals(all.size(), 3, "Duplicate amount mismatch");
+		expect(all.getFirst() == synth, "Not in tree order");
+		expect(registry.getFirstProcessorWithId<ModulatorSynth>("Duplicate", root) == synth, "Synth lookup");
+		expect(registry.getFirstProcessorWithId<Modulator>("Duplicate", root) == gainMod, "Modulator lookup");
+		expect(registry.getFirstProcessorWithId<Modulator>("Duplicate", pitchChain) == pitchMod, "Lookup with child root");
+		expect(registry.getFirstProcessorWithId<EffectProcessor>("Duplicate", root) == nullptr, "Wrong type lookup");
+
+		beginTest("Testing lookups after rename");
+
+		gainMod->setId("Renamed");
+
+		expect(registry.getFirstProcessorWithId<Modulator>("Renamed", root) == gainMod, "Renamed lookup");
+		expect(registry.getFirstProcessorWithId<Modulator>("Duplicate", root) == pitchMod, "Old ID still indexed");
+		expectEquals(registry.getProcessorsWithId("Duplicate", root).size(), 2, "Duplicate amount after rename");
+
+		beginTest("Testing lookups after adding and removing");
+
+		auto added = new ConstantModulator(bp, "Added", NUM_POLYPHONIC_VOICES, gainChain->getMode());
+		gainChain->getHandler()->add(added, nullptr);
+
+		expect(registry.getFirstProcessorWithId<Modulator>("Added", root) == added, "Added lookup");
+
+		gainChain->getHandler()->remove(added);
+
+		expect(registry.getFirstProcessorWithId<Modulator>("Added", root) == nullptr, "Removed processor still found");
+
+		pitchChain->getHandler()->remove(pitchMod);
+
+		expect(registry.getFirstProcessorWithId<Modulator>("Duplicate", root) == nullptr, "Removed duplicate still found");
+		expect(registry.getFirstProcessorWithId<ModulatorSynth>("Duplicate", root) == synth, "Remaining duplicate not found");
+	}
+};
+
+static ProcessorRegistryTests processorRegistryTests;
+
+class ControlCallbackBatchTests : public UnitTest
+{
+public:
+
+	ControlCallbackBatchTests() :
+		UnitTest("Testing batched control callbacks")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		const String script = R"(const var Knob1 = Content.addKnob("Knob1", 0, 0);)" \
+			R"(const var Knob2 = Content.addKnob("Knob2", 150, 0);)" \
+			R"(var calls = [];)" \
+			R"(function onNoteOn(){}function onNoteOff(){}function onController(){}function onTimer(){})" \
+			R"(function onControl(number, value){ calls.push(number.get("id") + "=" + value); })";
+
+		auto jp = new JavascriptMidiProcessor(bp, "scripter");
+
+		auto mpc = dynamic_cast<MidiProcessorChain*>(bp->getMainSynthChain()->getChildProcessor(ModulatorSynth::MidiProcessor));
+		jp->setOwnerSynth(bp->getMainSynthChain());
+		jp->parseSnippetsFromString(script, true);
+		mpc->getHandler()->add(jp, nullptr);
+		jp->compileScript();
+
+		auto content = jp->getScriptingContent();
+		auto knob1 = content->getComponentWithName("Knob1");
+		auto knob2 = content->getComponentWithName("Knob2");
+
+		expect(knob1 != nullptr && knob2 != nullptr, "Components not created");
+
+		if (knob1 == nullptr || knob2 == nullptr)
+			return;
+
+		beginTest("Testing repeated changes fire the callback once with the last value");
+
+		// Off the message thread the batch is executed synchronously when it goes out of scope
+		BatchThread t(*jp, [knob1, knob2](ProcessorWithScriptingContent& p)
+		{
+			p.controlCallback(knob1, 2);
+			p.controlCallback(knob1, 5);
+			p.controlCallback(knob2, 3);
+			p.controlCallback(knob1, 8);
+		});
+
+		t.startThread();
+		expect(t.waitForThreadToExit(5000), "Batch thread timeout");
+
+		auto calls = jp->getScriptEngine()->getRootObjectProperties()["calls"];
+
+		expect(calls.isArray(), "calls is not an array");
+		expectEquals(calls.size(), 2, "Callback amount mismatch");
+		expectEquals(calls[0].toString(), String("Knob1=8"), "First callback doesn't use the last value");
+		expectEquals(calls[1].toString(), String("Knob2=3"), "Second callback value mismatch");
+
+		const auto& stats = jp->getLastControlCallbackBatchStats();
+
+		expectEquals(stats.numExecuted, 2, "Executed amount mismatch");
+		expectEquals(stats.numCoalesced, 2, "Coalesced amount mismatch");
+
+		bp = nullptr;
+	}
+
+private:
+
+	struct BatchThread : public Thread
+	{
+		using BatchFunction = std::function<void(ProcessorWithScriptingContent&)>;
+
+		BatchThread(ProcessorWithScriptingContent& p_, const BatchFunction& f_) :
+			Thread("Control callback batch"),
+			p(p_),
+			f(f_)
+		{}
+
+		void run() override
+		{
+			ProcessorWithScriptingContent::ScopedControlCallbackBatch batch(p);
+			f(p);
+		}
+
+		ProcessorWithScriptingContent& p;
+		BatchFunction f;
+	};
+};
+
+static ControlCallbackBatchTests controlCallbackBatchTests;
+
+class RealtimeSafeCallbackTests : public UnitTest
+{
+public:
+
+	RealtimeSafeCallbackTests() :
+		UnitTest("Testing real-time safe callbacks")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		beginTest("Testing allocating expressions are rejected");
+
+		expectRejected(bp, "", R"(Console.print("Note: " + Message.getNoteNumber());)", "String concatenation");
+		expectRejected(bp, "", R"(local name = Engine.getMidiNoteName(60);)", "Engine.getMidiNoteName()");
+		expectRejected(bp, "", R"(local list = Engine.createMidiList();)", "Engine.createMidiList()");
+		expectRejected(bp, "", R"(local a = [1, 2];)", "Array creation");
+		expectRejected(bp, "", R"(local t = typeof 5;)", "typeof");
+		expectRejected(bp, R"(const var k = Content.addKnob("Knob1", 0, 0);)", R"(local v = k.getValue();)", "might return a String");
+		expectRejected(bp, R"(reg r = 0;)", R"(local x = 2; x = r;)", "numeric local variable");
+
+		beginTest("Testing inline functions that might allocate are rejected");
+
+		expectRejected(bp, R"(inline function label(x) { return "v" + x; })", R"(label(1);)", "call of label()");
+		expectRejected(bp, R"(inline function add(a, b) { return a + b; } reg r = 0;)", R"(add(r, 1);)", "argument 1 might be a String");
+		expectRejected(bp, R"(inline function add(a, b) { return a + b; } inline function twice(x) { return add(x, x); } reg r = 0;)", 
+					   R"(twice(r);)", "argument 1 might be a String");
+
+		beginTest("Testing numeric expressions are accepted");
+
+		expectAccepted(bp, "", R"(local n = Message.getNoteNumber() + 12; n += Message.getVelocity(); Message.setNoteNumber(n);)");
+		expectAccepted(bp, R"(reg counter = 0;)", R"(counter++; counter += Math.abs(Message.getVelocity() - 64);)");
+		expectAccepted(bp, R"(inline function add(a, b) { return a + b; })", R"(local x = 5; Message.setVelocity(add(Message.getVelocity(), add(x, 2)));)");
+		expectAccepted(bp, R"(const var k = Content.addKnob("Knob1", 0, 0);)", R"(k.setValue(Message.getNoteNumber());)");
+
+		beginTest("Testing the check is disabled by default");
+
+		expectAccepted(bp, "", R"(Console.print("Note: " + Message.getNoteNumber());)", false);
+
+		bp = nullptr;
+	}
+
+private:
+
+	Result compile(BackendProcessor* bp, const String& onInit, const String& onNoteOn, bool realtimeSafe)
+	{
+		String script;
+
+		if (realtimeSafe)
+			script << "Synth.setRealtimeSafeCallbacks(true);";
+
+		script << onInit;
+		script << "function onNoteOn(){" << onNoteOn << "}";
+		script << "function onNoteOff(){}function onController(){}function onTimer(){}function onControl(number, value){}";
+
+		auto jp = new JavascriptMidiProcessor(bp, "scripter" + String(++numProcessors));
+
+		auto mpc = dynamic_cast<MidiProcessorChain*>(bp->getMainSynthChain()->getChildProcessor(ModulatorSynth::MidiProcessor));
+		jp->setOwnerSynth(bp->getMainSynthChain());
+		jp->parseSnippetsFromString(script, true);
+		mpc->getHandler()->add(jp, nullptr);
+		jp->compileScript();
+
+		return jp->wasLastCompileOK() ? Result::ok() : jp->getLastErrorMessage();
+	}
+
+	void expectRejected(BackendProcessor* bp, const String& onInit, const String& onNoteOn, const String& expectedError)
+	{
+		auto r = compile(bp, onInit, onNoteOn, true);
+
+		expect(r.failed(), "Not rejected: " + onNoteOn);
+		expect(r.getErrorMessage().contains(expectedError), "Wrong error for " + onNoteOn + ": " + r.getErrorMessage());
+	}
+
+	void expectAccepted(BackendProcessor* bp, const String& onInit, const String& onNoteOn, bool realtimeSafe=true)
+	{
+		auto r = compile(bp, onInit, onNoteOn, realtimeSafe);
+
+		expect(r.wasOk(), "Rejected: " + onNoteOn + ": " + r.getErrorMessage());
+	}
+
+	int numProcessors = 0;
+};
+
+static RealtimeSafeCallbackTests realtimeSafeCallbackTests;
+
+class CompiledGraphTests : public UnitTest
+{
+public:
+
+	CompiledGraphTests() :
+		UnitTest("Testing the compiled scriptnode graph")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+		ScopedPointer<JavascriptMasterEffect> fx = new JavascriptMasterEffect(bp, "fx");
+
+		auto network = fx->getOrCreate("graph");
+		auto root = network->getRootNode();
+
+		auto gain = createNode(network, "math.mul", "gain", root, 0.5);
+		auto split = dynamic_cast<scriptnode::NodeBase*>(network->create("container.split", "split").getObject());
+		split->setParent(var(root), -1);
+
+		auto first = createNode(network, "math.mul", "first", split, 2.0);
+		auto second = createNode(network, "math.add", "second", split, 0.25);
+		auto third = createNode(network, "math.tanh", "third", split, 1.5);
+
+		ignoreUnused(gain);
+
+		expectEquals(root->getNumChannelsToProcess(), 2, "Channel amount");
+
+		testLayout(network, split, { first, second, third }, "no bypassed nodes", false, { false, false, false });
+		testLayout(network, split, { first, second, third }, "first child bypassed", false, { true, false, false });
+		testLayout(network, split, { first, second, third }, "only first child active", false, { false, true, true });
+		testLayout(network, split, { first, second, third }, "only second child active", false, { true, false, true });
+		testLayout(network, split, { first, second, third }, "all children bypassed", false, { true, true, true });
+		testLayout(network, split, { first, second, third }, "split bypassed", true, { false, false, false });
+	}
+
+private:
+
+	static constexpr int BlockSize = 64;
+
+	scriptnode::NodeBase* createNode(scriptnode::DspNetwork* network, const String& path, const String& id, scriptnode::NodeBase* parent, double value)
+	{
+		auto n = dynamic_cast<scriptnode::NodeBase*>(network->create(path, id).getObject());
+		n->setParent(var(parent), -1);
+		n->getParameter(0)->setValueAndStoreAsync(value);
+		return n;
+	}
+
+	static void setBypassed(scriptnode::NodeBase* n, bool shouldBeBypassed)
+	{
+		// The bypassed state is a cached value of this property
+		n->getValueTree().setProperty(scriptnode::PropertyIds::Bypassed, shouldBeBypassed, nullptr);
+	}
+
+	void testLayout(scriptnode::DspNetwork* network, scriptnode::NodeBase* split, Array<scriptnode::NodeBase*> children, const String& name, bool splitBypassed, Array<bool> childBypassed)
+	{
+		beginTest("Testing compiled split layout: " + name);
+
+		setBypassed(split, splitBypassed);
+
+		for (int i = 0; i < children.size(); i++)
+			setBypassed(children[i], childBypassed[i]);
+
+		// This rebuilds the compiled graph with the current bypass states
+		network->prepareToPlay(44100.0, (double)BlockSize);
+
+		expect(network->hasCompiledGraph(), "No compiled graph");
+
+		AudioSampleBuffer dynamicBuffer(2, BlockSize);
+		AudioSampleBuffer compiledBuffer(2, BlockSize);
+
+		for (int c = 0; c < 2; c++)
+		{
+			for (int i = 0; i < BlockSize; i++)
+				dynamicBuffer.setSample(c, i, (float)std::sin(0.1 * (double)(i + 1) * (double)(c + 1)));
+		}
+
+		compiledBuffer.makeCopyOf(dynamicBuffer);
+
+		scriptnode::ProcessData dynamicData(dynamicBuffer.getArrayOfWritePointers(), 2, BlockSize);
+		scriptnode::ProcessData compiledData(compiledBuffer.getArrayOfWritePointers(), 2, BlockSize);
+
+		network->getRootNode()->process(dynamicData);
+
+		{
+			ScopedLock sl(network->getConnectionLock());
+			network->process(compiledData);
+		}
+
+		int numMismatches = 0;
+
+		for (int c = 0; c < 2; c++)
+		{
+			for (int i = 0; i < BlockSize; i++)
+			{
+				if (dynamicBuffer.getSample(c, i) != compiledBuffer.getSample(c, i))
+					numMismatches++;
+			}
+		}
+
+		expectEquals(numMismatches, 0, "Samples that don't match");
+	}
+};
+
+static CompiledGraphTests compiledGraphTests;
+
 class CustomContainerTest : public UnitTest
 {
 public:
@@ -1942,6 +2298,417 @@ private:
 
 static CustomContainerTest unorderedStackTest;
 
+class OversamplerTests : public UnitTest
+{
+public:
+
+	using Profile = PolyphaseOversampler::Profile;
+
+	OversamplerTests() :
+		UnitTest("Testing polyphase oversampler")
+	{}
+
+	void runTest() override
+	{
+		testReconstruction();
+		testAgainstJuceImplementation();
+		benchmark();
+	}
+
+private:
+
+	static constexpr int NumSamples = 32768;
+	static constexpr int BlockSize = 512;
+
+	static AudioSampleBuffer createSine(double delta)
+	{
+		AudioSampleBuffer b(2, NumSamples);
+
+		for (int i = 0; i < NumSamples; i++)
+		{
+			b.setSample(0, i, (float)std::sin(delta * (double)i));
+			b.setSample(1, i, (float)std::cos(delta * (double)i));
+		}
+
+		return b;
+	}
+
+	template <class OversamplerType> static void processRoundTrip(OversamplerType& os, AudioSampleBuffer& b)
+	{
+		os.initProcessing(BlockSize);
+
+		for (int i = 0; i < b.getNumSamples(); i += BlockSize)
+		{
+			dsp::AudioBlock<float> block(b.getArrayOfWritePointers(), b.getNumChannels(), i, jmin(BlockSize, b.getNumSamples() - i));
+
+			os.processSamplesUp(block);
+			os.processSamplesDown(block);
+		}
+	}
+
+	void testReconstruction()
+	{
+		const double delta = 0.05;
+
+		for (int p = 0; p < (int)Profile::numProfiles; p++)
+		{
+			for (int f = 1; f <= 4; f++)
+			{
+				beginTest("Testing sine reconstruction with " + PolyphaseOversampler::getProfileNames()[p] + " at " + String(1 << f) + "x");
+
+				PolyphaseOversampler os(2, f, (Profile)p);
+				auto b = createSine(delta);
+				processRoundTrip(os, b);
+
+				// the latency is exact, so a delayed sine must match the output
+				auto latency = (double)os.getLatencyInSamples();
+				float maxError = 0.0f;
+
+				for (int i = 4096; i < NumSamples; i++)
+					maxError = jmax(maxError, std::abs(b.getSample(0, i) - (float)std::sin(delta * ((double)i - latency))));
+
+				expect(maxError < 0.02f, "Max error: " + String(maxError));
+			}
+		}
+	}
+
+	void testAgainstJuceImplementation()
+	{
+		using JuceOversampler = juce::dsp::Oversampling<float>;
+
+		for (int f = 1; f <= 4; f++)
+		{
+			beginTest("Testing IIR profile against JUCE at " + String(1 << f) + "x");
+
+			PolyphaseOversampler os(2, f, Profile::MinimumPhaseIIR);
+			JuceOversampler jos(2, f, JuceOversampler::filterHalfBandPolyphaseIIR, false);
+
+			auto b1 = createSine(0.3);
+			auto b2 = createSine(0.3);
+
+			processRoundTrip(os, b1);
+			processRoundTrip(jos, b2);
+
+			expectWithinAbsoluteError(os.getLatencyInSamples(), jos.getLatencyInSamples(), 0.001f, "latency mismatch");
+
+			float maxError = 0.0f;
+
+			for (int c = 0; c < 2; c++)
+			{
+				for (int i = 0; i < NumSamples; i++)
+					maxError = jmax(maxError, std::abs(b1.getSample(c, i) - b2.getSample(c, i)));
+			}
+
+			expect(maxError < 1e-5f, "Output mismatch: " + String(maxError));
+		}
+	}
+
+	template <class OversamplerType> static double measure(OversamplerType& os, AudioSampleBuffer b)
+	{
+		processRoundTrip(os, b);
+
+		auto start = Time::getMillisecondCounterHiRes();
+
+		for (int i = 0; i < 10; i++)
+			processRoundTrip(os, b);
+
+		auto duration = Time::getMillisecondCounterHiRes() - start;
+
+		return duration * 1000000.0 / (10.0 * (double)(b.getNumChannels() * b.getNumSamples()));
+	}
+
+	void benchmark()
+	{
+		using JuceOversampler = juce::dsp::Oversampling<float>;
+
+		beginTest("Benchmarking oversampler against JUCE");
+
+		auto b = createSine(0.1);
+
+		for (int p = 0; p < (int)Profile::numProfiles; p++)
+		{
+			for (int f = 1; f <= 4; f++)
+			{
+				PolyphaseOversampler os(2, f, (Profile)p);
+
+				auto isFIR = p != (int)Profile::MinimumPhaseIIR;
+				JuceOversampler jos(2, f, isFIR ? JuceOversampler::filterHalfBandFIREquiripple : JuceOversampler::filterHalfBandPolyphaseIIR, p == (int)Profile::LinearPhase);
+
+				auto t = measure(os, b);
+				auto jt = measure(jos, b);
+
+				String s;
+				s << PolyphaseOversampler::getProfileNames()[p] << " " << String(1 << f) << "x: ";
+				s << String(t, 2) << "ns (JUCE: " << String(jt, 2) << "ns) per sample, ";
+				s << "latency: " << String(os.getLatencyInSamples(), 2) << " samples";
+
+				logMessage(s);
+			}
+		}
+	}
+};
+
+static OversamplerTests oversamplerTests;
+
+class FusedMixAndMeterTests : public UnitTest
+{
+public:
+
+	FusedMixAndMeterTests() :
+		UnitTest("Testing fused mix and meter operations")
+	{}
+
+	void runTest() override
+	{
+		testAgainstSeparatePasses();
+		benchmark();
+	}
+
+private:
+
+	static constexpr int BlockSize = 512;
+
+	static void fillWithNoise(AudioSampleBuffer& b, Random& r)
+	{
+		for (int c = 0; c < b.getNumChannels(); c++)
+		{
+			for (int i = 0; i < b.getNumSamples(); i++)
+				b.setSample(c, i, r.nextFloat() * 2.0f - 1.0f);
+		}
+	}
+
+	void testAgainstSeparatePasses()
+	{
+		Random r;
+		const int sizes[] = { 0, 1, 3, 4, 7, 64, 255, 500 };
+
+		for (int srcOffset = 0; srcOffset < 4; srcOffset++)
+		{
+			for (int dstOffset = 0; dstOffset < 4; dstOffset++)
+			{
+				beginTest("Testing fused kernel with source offset " + String(srcOffset) + " and destination offset " + String(dstOffset));
+
+				for (auto numSamples : sizes)
+				{
+					AudioSampleBuffer src(1, BlockSize);
+					AudioSampleBuffer expected(1, BlockSize);
+
+					fillWithNoise(src, r);
+					fillWithNoise(expected, r);
+
+					AudioSampleBuffer actual(expected);
+
+					const float gain = r.nextFloat() * 2.0f;
+
+					FloatVectorOperations::addWithMultiply(expected.getWritePointer(0, dstOffset), src.getReadPointer(0, srcOffset), gain, numSamples);
+					const float expectedSourcePeak = src.getMagnitude(0, srcOffset, numSamples);
+					const float expectedDestinationPeak = expected.getMagnitude(0, dstOffset, numSamples);
+
+					float destinationPeak = -1.0f;
+					const float sourcePeak = FusedVectorOperations::addWithMultiplyAndGetMagnitude(actual.getWritePointer(0, dstOffset), src.getReadPointer(0, srcOffset), gain, numSamples, &destinationPeak);
+
+					float maxError = 0.0f;
+
+					for (int i = 0; i < BlockSize; i++)
+						maxError = jmax(maxError, std::abs(expected.getSample(0, i) - actual.getSample(0, i)));
+
+					expect(maxError < 1e-6f, "Mix error with " + String(numSamples) + " samples: " + String(maxError));
+					expectWithinAbsoluteError(sourcePeak, expectedSourcePeak, 1e-6f, "Source peak mismatch with " + String(numSamples) + " samples");
+					expectWithinAbsoluteError(destinationPeak, expectedDestinationPeak, 1e-6f, "Destination peak mismatch with " + String(numSamples) + " samples");
+				}
+			}
+		}
+	}
+
+	template <typename F> static double measure(const F& f)
+	{
+		const int numIterations = 20000;
+
+		f();
+
+		auto start = Time::getMillisecondCounterHiRes();
+
+		for (int i = 0; i < numIterations; i++)
+			f();
+
+		auto duration = Time::getMillisecondCounterHiRes() - start;
+
+		return duration * 1000000.0 / (double)(numIterations * BlockSize * 2);
+	}
+
+	void benchmark()
+	{
+		beginTest("Benchmarking the output stage of a sound generator");
+
+		Random r;
+		AudioSampleBuffer internalBuffer(2, BlockSize);
+		AudioSampleBuffer outputBuffer(2, BlockSize);
+
+		fillWithNoise(internalBuffer, r);
+		outputBuffer.clear();
+
+		const float gain = 0.25f;
+		float peaks[2];
+		float outputPeaks[2];
+
+		// This is the old output stage with the routing matrix editor and the peak meter being visible
+		auto separatePasses = [&]()
+		{
+			for (int c = 0; c < 2; c++)
+			{
+				FloatVectorOperations::addWithMultiply(outputBuffer.getWritePointer(c), internalBuffer.getReadPointer(c), gain, BlockSize);
+				peaks[c] = internalBuffer.getMagnitude(c, 0, BlockSize);
+				outputPeaks[c] = outputBuffer.getMagnitude(c, 0, BlockSize);
+				peaks[c] = gain * internalBuffer.getMagnitude(c, 0, BlockSize);
+			}
+
+			outputBuffer.clear();
+		};
+
+		auto fused = [&]()
+		{
+			for (int c = 0; c < 2; c++)
+				peaks[c] = gain * FusedVectorOperations::addWithMultiplyAndGetMagnitude(outputBuffer.getWritePointer(c), internalBuffer.getReadPointer(c), gain, BlockSize, outputPeaks + c);
+
+			outputBuffer.clear();
+		};
+
+		auto meteringDisabled = [&]()
+		{
+			for (int c = 0; c < 2; c++)
+				FloatVectorOperations::addWithMultiply(outputBuffer.getWritePointer(c), internalBuffer.getReadPointer(c), gain, BlockSize);
+
+			outputBuffer.clear();
+		};
+
+		const double separateTime = measure(separatePasses);
+		const double fusedTime = measure(fused);
+		const double disabledTime = measure(meteringDisabled);
+
+		logMessage("Separate passes: " + String(separateTime, 3) + "ns per sample");
+		logMessage("Fused kernel: " + String(fusedTime, 3) + "ns per sample");
+		logMessage("Metering disabled: " + String(disabledTime, 3) + "ns per sample");
+
+		expect(peaks[0] > 0.0f && outputPeaks[0] > 0.0f, "No peak values");
+	}
+};
+
+static FusedMixAndMeterTests fusedMixAndMeterTests;
+
+class TokenSnapshotTests : public UnitTest
+{
+public:
+
+	using TokenSnapshot = HiseJavascriptEngine::TokenSnapshot;
+
+	TokenSnapshotTests() :
+		UnitTest("Testing token snapshots")
+	{}
+
+	void runTest() override
+	{
+		beginTest("Testing snapshot replay against the lexer");
+
+		auto code = String(R"script(
+/** A doc comment
+	that spans
+	multiple lines. */
+namespace Tokens
+{
+	const var s = "A string with \"escaped\" quotes, a // fake comment and a /* fake block */";
+	const var t = 'single quoted with a tab\t';
+	const var utf8 = "NON_ASCII non-ASCII text shifts the byte offsets";
+}
+
+// A line comment
+var regex = "^([A-G]#?)(-?\\d)$";
+var isMatch = Engine.matchesRegex("C#3", regex);
+var ratio = 10 / 2 / 5; /* a division that could be mistaken for a regex */
+
+/* A block comment
+   over multiple lines */
+var obj =
+{
+	"key": [1, 2.5, 0x1F, .25, 1e-3],
+	nested: { a: true, b: false }
+};
+
+inline function multiLine(a,
+                          b)
+{
+	local x = a >= b ? a : b;
+	return x !== undefined && x != 0;
+};
+
+/** A doc comment for the callback. */
+function onNoteOn()
+{
+	for (i = 0; i < 4; i++)
+		Console.print(multiLine(Message.getNoteNumber(), i) + " " + Tokens.s);
+}
+)script").replace("NON_ASCII", String::fromUTF8("\xc3\xa9\xc3\xa0"));
+
+		expect(TokenSnapshot::getForCode(code) == nullptr, "Snapshot exists before restoring");
+
+		Array<TokenSnapshot::Token> lexedTokens;
+
+		auto start = Time::getMillisecondCounterHiRes();
+		expect(TokenSnapshot::tokenise(code, lexedTokens), "Lexer failed");
+		const auto lexTime = Time::getMillisecondCounterHiRes() - start;
+
+		auto snapshotTree = TokenSnapshot::createSnapshotTree({ code });
+
+		const auto before = TokenSnapshot::getStatistics();
+
+		expectEquals(snapshotTree.getNumChildren(), 1, "Snapshot wasn't created");
+		expectEquals(TokenSnapshot::restoreSnapshotTree(snapshotTree), 1, "Snapshot wasn't restored");
+		expectEquals(TokenSnapshot::getStatistics().numUsed, before.numUsed, "Snapshot used before compiling");
+		expect(TokenSnapshot::getForCode(code) != nullptr, "Snapshot not found after restoring");
+
+		Array<TokenSnapshot::Token> replayedTokens;
+
+		start = Time::getMillisecondCounterHiRes();
+		expect(TokenSnapshot::tokenise(code, replayedTokens), "Replay failed");
+		const auto replayTime = Time::getMillisecondCounterHiRes() - start;
+
+		const auto after = TokenSnapshot::getStatistics();
+
+		expectEquals(after.numRestored, before.numRestored + 1, "Restored amount mismatch");
+		expectEquals(after.numUsed, before.numUsed + 1, "Restored snapshot wasn't hit");
+		expectEquals(after.numHits, before.numHits + 2, "Hit amount mismatch");
+		expectEquals(after.numRejected, before.numRejected, "Checksum mismatch for identical code");
+
+		logMessage("Lexing: " + String(lexTime, 3) + "ms, replaying: " + String(replayTime, 3) + "ms");
+
+		expectEquals(replayedTokens.size(), lexedTokens.size(), "Token amount mismatch");
+
+		for (int i = 0; i < jmin(lexedTokens.size(), replayedTokens.size()); i++)
+		{
+			const auto& l = lexedTokens.getReference(i);
+			const auto& r = replayedTokens.getReference(i);
+			const String index = " at token " + String(i);
+
+			expect(l.type == r.type, "Type mismatch" + index + ": " + String(l.type) + " vs. " + String(r.type));
+			expectEquals(r.byteOffset, l.byteOffset, "Offset mismatch" + index);
+			expect(l.hasValue == r.hasValue, "Value flag mismatch" + index);
+			expect(l.value == r.value && l.value.isString() == r.value.isString(), "Value mismatch" + index);
+			expect(l.hasComment == r.hasComment, "Comment flag mismatch" + index);
+			expectEquals(r.comment, l.comment, "Comment mismatch" + index);
+		}
+
+		expectEquals(String(lexedTokens.getLast().type), String("$eof"), "Last token isn't eof");
+
+		beginTest("Testing changed code falls back to the lexer");
+
+		const auto changedCode = code.replace("10 / 2 / 5", "10 / 2 / 50");
+
+		expect(TokenSnapshot::getForCode(changedCode) == nullptr, "Snapshot used for changed code");
+		expectEquals(TokenSnapshot::getStatistics().numHits, after.numHits, "Changed code counted as hit");
+	}
+};
+
+static TokenSnapshotTests tokenSnapshotTests;
+
 
 
 #endif
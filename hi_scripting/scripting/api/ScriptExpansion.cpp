@@ -828,6 +828,9 @@ juce::Result ScriptEncryptedExpansion::loadValueTree(ValueTree& v)
 			return Result::ok(); // will fail later
 		}
 
+		if (loadHeaderFromCache(v))
+			return Result::ok();
+
 		zstd::ZDefaultCompressor comp;
 		auto f = Helpers::getExpansionInfoFile(getRootFolder(), Encrypted);
 
@@ -840,6 +843,8 @@ juce::Result ScriptEncryptedExpansion::loadValueTree(ValueTree& v)
 
 		return Result::ok();
 	}
+
+	return Result::fail("Can't load expansion data");
 }
 
 
@@ -1123,9 +1128,11 @@ Result ScriptEncryptedExpansion::initialiseFromValueTree(const ValueTree& hxiDat
 		restorePool(hxiData, fileType);
 	}
 
+	if (getExpansionType() == Expansion::Encrypted && hxiData.getChildWithName(ExpansionIds::PoolData).isValid() && !poolCacheFailed)
+		writeHeaderCache(hxiData);
+
+	// The other pools will decrypt their entries when they are requested
 	pool->getSampleMapPool().loadAllFilesFromDataProvider();
-	pool->getMidiFilePool().loadAllFilesFromDataProvider();
-	pool->getAdditionalDataPool().loadAllFilesFromDataProvider();
 	checkSubDirectories();
 	return Result::ok();
 }
@@ -1170,7 +1177,16 @@ void ScriptEncryptedExpansion::addDataType(ValueTree& parent, SubDirectories fil
 
 void ScriptEncryptedExpansion::restorePool(ValueTree encryptedTree, SubDirectories fileType)
 {
+	auto provider = pool->getPoolBase(fileType)->getDataProvider();
 	auto poolData = encryptedTree.getChildWithName(ExpansionIds::PoolData);
+	auto cacheFile = getPoolCacheFile(fileType);
+
+	if (!poolData.isValid() && getExpansionType() == Expansion::Encrypted && cacheFile.existsAsFile())
+	{
+		// The header was loaded from the (validated) cache, so we can read the entries from the pool cache file
+		provider->restorePool(new FileInputStream(cacheFile));
+		return;
+	}
 
 	MemoryBlock mb;
 
@@ -1180,9 +1196,115 @@ void ScriptEncryptedExpansion::restorePool(ValueTree encryptedTree, SubDirectori
 
 	mb.fromBase64Encoding(d);
 
+	if (getExpansionType() == Expansion::Encrypted)
+	{
+		// Invalidate the old cache before writing any pool cache file
+		getHeaderCacheFile().deleteFile();
+		cacheFile.getParentDirectory().createDirectory();
+
+		if (cacheFile.replaceWithData(mb.getData(), mb.getSize()))
+		{
+			ScopedPointer<FileInputStream> fis = new FileInputStream(cacheFile);
+
+			if (fis->openedOk())
+			{
+				provider->restorePool(fis.release());
+				return;
+			}
+		}
+
+		cacheFile.deleteFile();
+		poolCacheFailed = true;
+	}
+
 	ScopedPointer<MemoryInputStream> mis = new MemoryInputStream(mb, true);
 
-	pool->getPoolBase(fileType)->getDataProvider()->restorePool(mis.release());
+	provider->restorePool(mis.release());
+}
+
+juce::File ScriptEncryptedExpansion::getPoolCacheFile(SubDirectories fileType) const
+{
+	auto name = getIdentifier(fileType).removeCharacters("/");
+	return getRootFolder().getChildFile(".poolcache").getChildFile(name + ".dat");
+}
+
+juce::File ScriptEncryptedExpansion::getHeaderCacheFile() const
+{
+	return getRootFolder().getChildFile(".poolcache").getChildFile("Header.dat");
+}
+
+var ScriptEncryptedExpansion::createHxpSignature() const
+{
+	auto hxpFile = Helpers::getExpansionInfoFile(getRootFolder(), Encrypted);
+
+	// Hashing the whole file would read all pool data on every load, so only the start of the file
+	// (which contains the expansion info) is hashed in addition to the size and the modification time
+	static constexpr int NumBytesToHash = 65536;
+
+	MemoryBlock start;
+	FileInputStream fis(hxpFile);
+
+	if (fis.openedOk())
+		fis.readIntoMemoryBlock(start, NumBytesToHash);
+
+	DynamicObject::Ptr obj = new DynamicObject();
+	obj->setProperty("Size", hxpFile.getSize());
+	obj->setProperty("ModificationTime", hxpFile.getLastModificationTime().toMilliseconds());
+	obj->setProperty("Hash", MD5(start).toHexString());
+
+	return var(obj.get());
+}
+
+bool ScriptEncryptedExpansion::loadHeaderFromCache(ValueTree& v)
+{
+	auto headerFile = getHeaderCacheFile();
+
+	if (!headerFile.existsAsFile())
+		return false;
+
+	for (auto fileType : getListOfPooledSubDirectories())
+	{
+		if (!getPoolCacheFile(fileType).existsAsFile())
+			return false;
+	}
+
+	FileInputStream fis(headerFile);
+
+	if (!fis.openedOk())
+		return false;
+
+	auto storedSignature = JSON::parse(fis.readString());
+	auto hxpSignature = createHxpSignature();
+
+	for (auto id : { "Size", "ModificationTime", "Hash" })
+	{
+		if (storedSignature[id].toString() != hxpSignature[id].toString())
+			return false;
+	}
+
+	v = ValueTree::readFromStream(fis);
+
+	return v.isValid();
+}
+
+void ScriptEncryptedExpansion::writeHeaderCache(const ValueTree& hxpData) const
+{
+	// Strip the pool data (which is stored in the pool cache files)
+	auto header = hxpData.createCopy();
+	header.removeChild(header.getChildWithName(ExpansionIds::PoolData), nullptr);
+
+	auto headerFile = getHeaderCacheFile();
+	headerFile.deleteFile();
+
+	FileOutputStream fos(headerFile);
+
+	if (fos.openedOk())
+	{
+		// The signature of the .hxp file the cache was created from, it needs to match exactly
+		fos.writeString(JSON::toString(createHxpSignature(), true));
+		header.writeToStream(fos);
+		fos.flush();
+	}
 }
 
 void ScriptEncryptedExpansion::addUserPresets(ValueTree encryptedTree)
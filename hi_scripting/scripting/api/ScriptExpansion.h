@@ -208,6 +208,17 @@ protected:
 	void restorePool(ValueTree encryptedTree, SubDirectories fileType);
 	void addUserPresets(ValueTree encryptedTree);
 
+	/** The pool data of encrypted expansions is extracted into cache files with the same format
+		that the DataProvider uses (a compressed table of contents followed by the individually
+		encrypted entries) so that the entries can be read from disk when they are requested. */
+	File getPoolCacheFile(SubDirectories fileType) const;
+	File getHeaderCacheFile() const;
+	var createHxpSignature() const;
+	bool loadHeaderFromCache(ValueTree& v);
+	void writeHeaderCache(const ValueTree& hxpData) const;
+
+	bool poolCacheFailed = false;
+
 	Result returnFail(const String& errorMessage);
 };
 
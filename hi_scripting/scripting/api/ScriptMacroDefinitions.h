@@ -14,12 +14,12 @@
 
 // Macros for APIClass objects
 
-#define ADD_API_METHOD_0(name) addFunction(Identifier(#name), &Wrapper::name)
-#define ADD_API_METHOD_1(name) addFunction1(Identifier(#name), &Wrapper::name)
-#define ADD_API_METHOD_2(name) addFunction2(Identifier(#name), &Wrapper::name)
-#define ADD_API_METHOD_3(name) addFunction3(Identifier(#name), &Wrapper::name)
-#define ADD_API_METHOD_4(name) addFunction4(Identifier(#name), &Wrapper::name)
-#define ADD_API_METHOD_5(name) addFunction5(Identifier(#name), &Wrapper::name)
+#define ADD_API_METHOD_0(name) addFunction(Identifier(#name), &Wrapper::name, hise::ApiClass::returnsPlainValue(&std::remove_pointer<decltype(this)>::type::name))
+#define ADD_API_METHOD_1(name) addFunction1(Identifier(#name), &Wrapper::name, hise::ApiClass::returnsPlainValue(&std::remove_pointer<decltype(this)>::type::name))
+#define ADD_API_METHOD_2(name) addFunction2(Identifier(#name), &Wrapper::name, hise::ApiClass::returnsPlainValue(&std::remove_pointer<decltype(this)>::type::name))
+#define ADD_API_METHOD_3(name) addFunction3(Identifier(#name), &Wrapper::name, hise::ApiClass::returnsPlainValue(&std::remove_pointer<decltype(this)>::type::name))
+#define ADD_API_METHOD_4(name) addFunction4(Identifier(#name), &Wrapper::name, hise::ApiClass::returnsPlainValue(&std::remove_pointer<decltype(this)>::type::name))
+#define ADD_API_METHOD_5(name) addFunction5(Identifier(#name), &Wrapper::name, hise::ApiClass::returnsPlainValue(&std::remove_pointer<decltype(this)>::type::name))
 
 #define API_METHOD_WRAPPER_0(className, name)	inline static var name(ApiClass *m) { return var(static_cast<className*>(m)->name()); };
 #define API_METHOD_WRAPPER_1(className, name)	inline static var name(ApiClass *m, var value1) { return var(static_cast<className*>(m)->name(value1)); };
@@ -1449,8 +1449,7 @@ int ScriptingApi::Engine::getLatencySamples() const
 
 void ScriptingApi::Engine::setLatencySamples(int latency)
 {
-	auto ap = dynamic_cast<AudioProcessor*>(getScriptProcessor()->getMainController_());
-	ap->setLatencySamples(latency);
+	getScriptProcessor()->getMainController_()->setLatencySamplesForSource(MainController::LatencySource::Script, latency);
 }
 
 int ScriptingApi::Engine::getMidiNoteFromName(String midiNoteName) const
@@ -2408,6 +2407,8 @@ struct ScriptingApi::Sampler::Wrapper
 	API_METHOD_WRAPPER_2(Sampler, importSamples);
 	API_METHOD_WRAPPER_0(Sampler, clearSampleMap);
 	API_VOID_METHOD_WRAPPER_1(Sampler, setSortByRRGroup);
+	API_METHOD_WRAPPER_0(Sampler, getStreamingStatistics);
+	API_VOID_METHOD_WRAPPER_1(Sampler, enablePredictivePrefetch);
 };
 
 
@@ -2450,6 +2451,8 @@ sampler(sampler_)
 	ADD_API_METHOD_1(saveCurrentSampleMap);
 	ADD_API_METHOD_2(importSamples);
 	ADD_API_METHOD_0(clearSampleMap);
+	ADD_API_METHOD_0(getStreamingStatistics);
+	ADD_API_METHOD_1(enablePredictivePrefetch);
 
 	sampleIds.add(SampleIds::ID);
 	sampleIds.add(SampleIds::FileName);
@@ -3350,6 +3353,45 @@ bool ScriptingApi::Sampler::clearSampleMap()
 	return false;
 }
 
+var ScriptingApi::Sampler::getStreamingStatistics() const
+{
+	ModulatorSampler *s = static_cast<ModulatorSampler*>(sampler.get());
+
+	if (s == nullptr)
+	{
+		reportScriptError("getStreamingStatistics() only works with Samplers.");
+		RETURN_IF_NO_THROW(var());
+	}
+
+	const auto stats = s->getStreamingStatistics();
+
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("PreloadMemory", (double)stats.preloadMemory / 1024.0 / 1024.0);
+	obj->setProperty("StreamingMemory", (double)stats.streamingMemory / 1024.0 / 1024.0);
+	obj->setProperty("PeakLatency", stats.peakLatencySeconds * 1000.0);
+	obj->setProperty("UnderrunRisk", stats.underrunRisk);
+	obj->setProperty("Adaptive", s->isUsingAdaptiveBufferSizes());
+	obj->setProperty("PrefetchHitRate", stats.prefetchHitRate);
+
+	return var(obj.get());
+}
+
+void ScriptingApi::Sampler::enablePredictivePrefetch(bool shouldPrefetch)
+{
+	WARN_IF_AUDIO_THREAD(true, ScriptGuard::IllegalApiCall);
+
+	ModulatorSampler *s = static_cast<ModulatorSampler*>(sampler.get());
+
+	if (s == nullptr)
+	{
+		reportScriptError("enablePredictivePrefetch() only works with Samplers.");
+		RETURN_VOID_IF_NO_THROW()
+	}
+
+	s->setUsePredictivePrefetch(shouldPrefetch);
+}
+
 // ====================================================================================================== Synth functions
 
 
@@ -3359,6 +3401,7 @@ struct ScriptingApi::Synth::Wrapper
 	API_METHOD_WRAPPER_0(Synth, getNumChildSynths);
 	API_VOID_METHOD_WRAPPER_1(Synth, addToFront);
 	API_VOID_METHOD_WRAPPER_1(Synth, deferCallbacks);
+	API_VOID_METHOD_WRAPPER_1(Synth, setRealtimeSafeCallbacks);
 	API_VOID_METHOD_WRAPPER_1(Synth, noteOff);
 	API_VOID_METHOD_WRAPPER_1(Synth, noteOffByEventId);
 	API_VOID_METHOD_WRAPPER_2(Synth, noteOffDelayedByEventId);
@@ -3428,6 +3471,7 @@ ScriptingApi::Synth::Synth(ProcessorWithScriptingContent *p, ModulatorSynth *own
 	ADD_API_METHOD_0(getNumChildSynths);
 	ADD_API_METHOD_1(addToFront);
 	ADD_API_METHOD_1(deferCallbacks);
+	ADD_API_METHOD_1(setRealtimeSafeCallbacks);
 	ADD_API_METHOD_1(noteOff);
 	ADD_API_METHOD_1(noteOffByEventId);
 	ADD_API_METHOD_2(noteOffDelayedByEventId);
@@ -3570,6 +3614,18 @@ void ScriptingApi::Synth::deferCallbacks(bool deferCallbacks)
 	dynamic_cast<JavascriptMidiProcessor*>(getScriptProcessor())->deferCallbacks(deferCallbacks);
 }
 
+void ScriptingApi::Synth::setRealtimeSafeCallbacks(bool shouldBeRealtimeSafe)
+{
+	if (!getScriptProcessor()->objectsCanBeCreated())
+	{
+		reportScriptError("setRealtimeSafeCallbacks() can only be called in onInit");
+		return;
+	}
+
+	if (auto jmp = dynamic_cast<JavascriptMidiProcessor*>(getScriptProcessor()))
+		jmp->setRealtimeSafeCallbacks(shouldBeRealtimeSafe);
+}
+
 int ScriptingApi::Synth::playNote(int noteNumber, int velocity)
 {
 	if(velocity == 0)
@@ -3878,17 +3934,10 @@ ScriptingObjects::ScriptingModulator *ScriptingApi::Synth::getModulator(const St
 {
 	if(getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<Modulator> it(owner);
+		auto& registry = getScriptProcessor()->getMainController_()->getProcessorRegistry();
 
-		Modulator *m;
-
-		while((m = it.getNextProcessor()) != 0)
-		{
-			if(m->getId() == name)
-			{
-				return new ScriptingObjects::ScriptingModulator(getScriptProcessor(), m);
-			}
-		}
+		if (auto m = registry.getFirstProcessorWithId<Modulator>(name, owner))
+			return new ScriptingObjects::ScriptingModulator(getScriptProcessor(), m);
 
 		reportScriptError(name + " was not found. ");
 		RETURN_IF_NO_THROW(new ScriptingObjects::ScriptingModulator(getScriptProcessor(), nullptr))
@@ -3910,17 +3959,10 @@ ScriptingObjects::ScriptingMidiProcessor *ScriptingApi::Synth::getMidiProcessor(
 
 	if(getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<MidiProcessor> it(owner);
+		auto& registry = getScriptProcessor()->getMainController_()->getProcessorRegistry();
 
-		MidiProcessor *mp;
-
-		while((mp = it.getNextProcessor()) != nullptr)
-		{
-			if(mp->getId() == name)
-			{
-				return new ScriptingObjects::ScriptingMidiProcessor(getScriptProcessor(), mp);
-			}
-		}
+		if (auto mp = registry.getFirstProcessorWithId<MidiProcessor>(name, owner))
+			return new ScriptingObjects::ScriptingMidiProcessor(getScriptProcessor(), mp);
 
         reportScriptError(name + " was not found. ");
 
@@ -3940,18 +3982,10 @@ ScriptingObjects::ScriptingSynth *ScriptingApi::Synth::getChildSynth(const Strin
 {
 	if(getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<ModulatorSynth> it(owner);
-
-		ModulatorSynth *m;
-
+		auto& registry = getScriptProcessor()->getMainController_()->getProcessorRegistry();
 
-		while((m = it.getNextProcessor()) != 0)
-		{
-			if(m->getId() == name)
-			{
-				return new ScriptingObjects::ScriptingSynth(getScriptProcessor(), m);
-			}
-		}
+		if (auto m = registry.getFirstProcessorWithId<ModulatorSynth>(name, owner))
+			return new ScriptingObjects::ScriptingSynth(getScriptProcessor(), m);
 
         reportScriptError(name + " was not found. ");
 		RETURN_IF_NO_THROW(new ScriptingObjects::ScriptingSynth(getScriptProcessor(), nullptr))
@@ -4017,18 +4051,10 @@ ScriptingObjects::ScriptingEffect *ScriptingApi::Synth::getEffect(const String &
 
 	if(getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<EffectProcessor> it(owner);
+		auto& registry = getScriptProcessor()->getMainController_()->getProcessorRegistry();
 
-		EffectProcessor *fx;
-
-
-		while((fx = it.getNextProcessor()) != nullptr)
-		{
-			if(fx->getId() == name)
-			{
-				return new ScriptEffect(getScriptProcessor(), fx);
-			}
-		}
+		if (auto fx = registry.getFirstProcessorWithId<EffectProcessor>(name, owner))
+			return new ScriptEffect(getScriptProcessor(), fx);
 
         reportScriptError(name + " was not found. ");
 		RETURN_IF_NO_THROW(new ScriptEffect(getScriptProcessor(), nullptr))
@@ -4071,18 +4097,10 @@ ScriptingObjects::ScriptingAudioSampleProcessor * ScriptingApi::Synth::getAudioS
 {
 	WARN_IF_AUDIO_THREAD(true, ScriptGuard::ObjectCreation);
 
-	Processor::Iterator<AudioSampleProcessor> it(owner);
+	auto& registry = getScriptProcessor()->getMainController_()->getProcessorRegistry();
 
-		AudioSampleProcessor *asp;
-
-
-		while ((asp = it.getNextProcessor()) != nullptr)
-		{
-			if (dynamic_cast<Processor*>(asp)->getId() == name)
-			{
-				return new ScriptAudioSampleProcessor(getScriptProcessor(), asp);
-			}
-		}
+	if (auto asp = registry.getFirstProcessorWithId<AudioSampleProcessor>(name, owner))
+		return new ScriptAudioSampleProcessor(getScriptProcessor(), asp);
 
         reportScriptError(name + " was not found. ");
 		RETURN_IF_NO_THROW(new ScriptAudioSampleProcessor(getScriptProcessor(), nullptr))
@@ -4096,16 +4114,10 @@ ScriptingObjects::ScriptingTableProcessor *ScriptingApi::Synth::getTableProcesso
 
 	if (getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<LookupTableProcessor> it(owner);
-
-		while (LookupTableProcessor *lut = it.getNextProcessor())
-		{
-			if (dynamic_cast<Processor*>(lut)->getId() == name)
-			{
+		auto& registry = getScriptProcessor()->getMainController_()->getProcessorRegistry();
 
-				return new ScriptTableProcessor(getScriptProcessor(), lut);
-			}
-		}
+		if (auto lut = registry.getFirstProcessorWithId<LookupTableProcessor>(name, owner))
+			return new ScriptTableProcessor(getScriptProcessor(), lut);
 
         reportScriptError(name + " was not found. ");
 		RETURN_IF_NO_THROW(new ScriptTableProcessor(getScriptProcessor(), nullptr));
@@ -4123,16 +4135,10 @@ ScriptingApi::Sampler * ScriptingApi::Synth::getSampler(const String &name)
 
 	if (getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<ModulatorSampler> it(owner);
+		auto& registry = getScriptProcessor()->getMainController_()->getProcessorRegistry();
 
-		while (ModulatorSampler *s = it.getNextProcessor())
-		{
-			if (s->getId() == name)
-			{
-
-				return new Sampler(getScriptProcessor(), s);
-			}
-		}
+		if (auto s = registry.getFirstProcessorWithId<ModulatorSampler>(name, owner))
+			return new Sampler(getScriptProcessor(), s);
 
         reportScriptError(name + " was not found. ");
 		RETURN_IF_NO_THROW(new Sampler(getScriptProcessor(), nullptr))
@@ -4150,16 +4156,10 @@ ScriptingApi::Synth::ScriptSlotFX* ScriptingApi::Synth::getSlotFX(const String&
 
 	if (getScriptProcessor()->objectsCanBeCreated())
 	{
-		Processor::Iterator<SlotFX> it(owner);
+		auto& registry = getScriptProcessor()->getMainController_()->getProcessorRegistry();
 
-		while (SlotFX *s = it.getNextProcessor())
-		{
-			if (s->getId() == name)
-			{
-
-				return new ScriptSlotFX(getScriptProcessor(), s);
-			}
-		}
+		if (auto s = registry.getFirstProcessorWithId<SlotFX>(name, owner))
+			return new ScriptSlotFX(getScriptProcessor(), s);
 
 		reportScriptError(name + " was not found. ");
 		RETURN_IF_NO_THROW(new ScriptSlotFX(getScriptProcessor(), nullptr))
@@ -273,7 +273,7 @@ public:
 		/** Returns the latency of the plugin as reported to the host. Default is 0. */
 		int getLatencySamples() const;
 
-		/** sets the latency of the plugin as reported to the host. Default is 0. */
+		/** sets the latency of the script processing. The host gets the sum of this and the internal latency (eg. oversampling filters). Default is 0. */
 		void setLatencySamples(int latency);
 
 		/** Converts MIDI note number to Midi note name ("C3" for middle C). */
@@ -420,7 +420,7 @@ public:
 		/** Sets the new zoom level (1.0 = 100%) */
 		void setZoomLevel(double newLevel);
 
-		/** Sets the Streaming Mode (0 -> Fast-SSD, 1 -> Slow-HDD) */
+		/** Sets the Streaming Mode (0 -> Fast-SSD, 1 -> Slow-HDD, 2 -> Adaptive) */
 		void setDiskMode(int mode);
 
 		/** Returns an object that contains all filter modes. */
@@ -525,10 +525,10 @@ public:
 		/** Changes the UI zoom (1.0 = 100%). */
 		void setZoomLevel(double newLevel);
 
-		/** Gets the Streaming Mode (0 -> Fast-SSD, 1 -> Slow-HDD) */
+		/** Gets the Streaming Mode (0 -> Fast-SSD, 1 -> Slow-HDD, 2 -> Adaptive) */
 		int getDiskMode();
 
-		/** Sets the Streaming Mode (0 -> Fast-SSD, 1 -> Slow-HDD) */
+		/** Sets the Streaming Mode (0 -> Fast-SSD, 1 -> Slow-HDD, 2 -> Adaptive) */
 		void setDiskMode(int mode);
 
 		/** Returns available audio device types. */
@@ -737,6 +737,12 @@ public:
 		/** Clears the current samplemap. */
 		bool clearSampleMap();
 
+		/** Returns an object with the memory usage (in MB), the measured disk latency (in ms) and the underrun risk (> 1.0 is likely to drop out). */
+		var getStreamingStatistics() const;
+
+		/** Decodes the next RR group and the neighbouring notes of every played note in advance (monoliths only). The hit rate is reported by getStreamingStatistics(). */
+		void enablePredictivePrefetch(bool shouldPrefetch);
+
 		// ============================================================================================================
 
 		struct Wrapper;
@@ -785,6 +791,9 @@ public:
 		/** Defers all callbacks to the message thread (midi callbacks become read-only). */
 		void deferCallbacks(bool makeAsynchronous);
 
+		/** Rejects operations that might allocate in the MIDI callbacks and the (non-deferred) timer callback at compile time. Call this in onInit. */
+		void setRealtimeSafeCallbacks(bool shouldBeRealtimeSafe);
+
 		/** Sends a note off message. The envelopes will tail off. */
 		void noteOff(int noteNumber);
 
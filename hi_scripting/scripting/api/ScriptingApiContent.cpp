@@ -3984,41 +3984,30 @@ ScriptingApi::Content::~Content()
 
 ScriptingApi::Content::ScriptComponent * ScriptingApi::Content::getComponentWithName(const Identifier &componentName)
 {
-	for (int i = 0; i < getNumComponents(); i++)
-	{
-		if (components[i]->name == componentName)
-		{
-			return components[i];
-		}
-	}
-
-	return nullptr;
+	return getComponent(getComponentIndex(componentName));
 }
 
 const ScriptingApi::Content::ScriptComponent * ScriptingApi::Content::getComponentWithName(const Identifier &componentName) const
 {
-	for (int i = 0; i < getNumComponents(); i++)
-	{
-		if (components[i]->name == componentName)
-		{
-			return components[i];
-		}
-	}
+	auto index = getComponentIndex(componentName);
 
-	return nullptr;
+	return index != -1 ? components[index].get() : nullptr;
 }
 
 int ScriptingApi::Content::getComponentIndex(const Identifier &componentName) const
 {
-	for (int i = 0; i < getNumComponents(); i++)
-	{
-		if (components[i]->name == componentName)
-		{
-			return i;
-		}
-	}
+	return componentIndexes[componentName] - 1;
+}
 
-	return -1;
+void ScriptingApi::Content::addComponentToList(ScriptComponent* sc)
+{
+	components.add(sc);
+
+	// If there are multiple components with the same name, the first one wins
+	if (!componentIndexes.contains(sc->name))
+		componentIndexes.set(sc->name, components.size());
+
+	componentQueryCache.clear();
 }
 
 ScriptingApi::Content::ScriptComboBox *ScriptingApi::Content::addComboBox(Identifier boxName, int x, int y)
@@ -4096,11 +4085,8 @@ var ScriptingApi::Content::getComponent(var componentName)
 {
 	Identifier n(componentName.toString());
 
-	for (int i = 0; i < components.size(); i++)
-	{
-		if (n == components[i]->getName())
-			return var(components[i]);
-	}
+	if (auto sc = getComponentWithName(n))
+		return var(sc);
 
 	logErrorAndContinue("Component with name " + componentName.toString() + " wasn't found.");
 
@@ -4109,15 +4095,24 @@ var ScriptingApi::Content::getComponent(var componentName)
 
 var ScriptingApi::Content::getAllComponents(String regex)
 {
+	if (componentQueryCache.contains(regex))
+	{
+		// Return a copy so that the script can't change the cached list
+		return var(*componentQueryCache[regex].getArray());
+	}
+
+	StringArray names;
+	names.ensureStorageAllocated(components.size());
+
+	for (auto c : components)
+		names.add(c->getName().toString());
+
 	Array<var> list;
 
-	for (int i = 0; i < getNumComponents(); i++)
-	{	    
-		if (RegexFunctions::matchesWildcard(regex, components[i]->getName().toString()))
-		{
-			list.add(var(components[i]));
-		}
-	}
+	for (auto i : RegexFunctions::getMatchingIndexes(regex, names))
+		list.add(var(components[i]));
+
+	componentQueryCache.set(regex, var(list));
 
 	return var(list);
 }
@@ -4150,6 +4145,7 @@ void ScriptingApi::Content::endInitialization()
 void ScriptingApi::Content::beginInitialization()
 {
 	allowGuiCreation = true;
+	controlsWereRestored = false;
 
 	updateWatcher = nullptr;
 }
@@ -4366,8 +4362,24 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const String &fileName)
 
 void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset)
 {
+#if HISE_SKIP_UNCHANGED_CONTROL_CALLBACKS
+	// The first restore after a compilation must fire all callbacks to initialise the script state
+	const bool skipUnchangedValues = controlsWereRestored;
+	Array<var> previousValues;
+
+	if (skipUnchangedValues)
+	{
+		previousValues.ensureStorageAllocated(components.size());
+
+		for (auto c : components)
+			previousValues.add(c->getValue());
+	}
+#endif
+
 	restoreFromValueTree(preset);
 
+	ProcessorWithScriptingContent::ScopedControlCallbackBatch batch(*getScriptProcessor());
+
 	StringArray macroNames;
 
 	if (components.size() != 0)
@@ -4412,6 +4424,16 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset
 			v = components[i]->getValue();
 		}
 
+#if HISE_SKIP_UNCHANGED_CONTROL_CALLBACKS
+		const bool isSliderPack = dynamic_cast<ScriptSliderPack*>(components[i].get()) != nullptr;
+
+		if (skipUnchangedValues && !isSliderPack && !v.isObject() && v == previousValues[i])
+		{
+			batch.addSkippedCallback();
+			continue;
+		}
+#endif
+
 		if (dynamic_cast<ScriptingApi::Content::ScriptLabel*>(components[i].get()) != nullptr)
 		{
 			getScriptProcessor()->controlCallback(components[i], v);
@@ -4444,6 +4466,8 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset
 			getProcessor()->getMainController()->getMacroManager().getMacroChain()->setMacroControl(macroIndex, range.convertTo0to1(components[i]->getValue()) * 127.0f, sendNotification);
 		}
 	}
+
+	controlsWereRestored = true;
 }
 
 
@@ -4537,7 +4561,7 @@ void ScriptingApi::Content::cleanJavascriptObjects()
 		}
 	}
 
-	
+	componentQueryCache.clear();
 }
 
 
@@ -4546,6 +4570,8 @@ void ScriptingApi::Content::removeAllScriptComponents()
 	cleanJavascriptObjects();
 
 	components.clear();
+	componentIndexes.clear();
+	componentQueryCache.clear();
 }
 
 void ScriptingApi::Content::rebuildComponentListFromValueTree()
@@ -4625,7 +4651,7 @@ void ScriptingApi::Content::addComponentsFromValueTree(const ValueTree& v)
 
 			ValueTreeConverters::copyValueTreePropertiesToDynamicObject(v, d);
 
-			components.add(sc);
+			addComponentToList(sc.get());
 
 			ScriptComponent::ScopedPropertyEnabler spe(sc);
 			sc->setPropertiesFromJSON(d);
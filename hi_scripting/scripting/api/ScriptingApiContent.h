@@ -2095,9 +2095,7 @@ public:
 		
 		SubType* newComponent = new SubType(getScriptProcessor(), this, id, x, y, 0, 0);
 
-
-
-		components.add(newComponent);
+		addComponentToList(newComponent);
 
 		asyncRebuildBroadcaster.notify();
 
@@ -2220,7 +2218,7 @@ private:
 
 		Subtype *t = new Subtype(getScriptProcessor(), this, name, x, y, 0, 0);
 
-		components.add(t);
+		addComponentToList(t);
 
 		restoreSavedValue(name);
 
@@ -2234,6 +2232,27 @@ private:
 
 	void rebuildComponentListFromValueTree();
 
+	/** Adds the component to the list and the name lookup table. Always use this instead of components.add(). */
+	void addComponentToList(ScriptComponent* sc);
+
+	/** Identifiers are pooled, so we can just hash the pointer to the string. */
+	struct IdentifierHash
+	{
+		int generateHash(const Identifier& id, int upperLimit) const noexcept
+		{
+			return DefaultHashFunctions::generateHash((const void*)id.getCharPointer().getAddress(), upperLimit);
+		}
+	};
+
+	/** The index of each component (with an offset of 1 so that a missing entry returns -1). */
+	HashMap<Identifier, int, IdentifierHash> componentIndexes;
+
+	/** The results of getAllComponents() - this will be cleared whenever the component list changes. */
+	HashMap<String, var> componentQueryCache;
+
+	/** Set to true after the first restore since the last compilation. */
+	bool controlsWereRestored = false;
+
 	friend class ScriptContentComponent;
 	friend class WeakReference<ScriptingApi::Content>;
 	WeakReference<ScriptingApi::Content>::Master masterReference;
@@ -33,6 +33,7 @@
 namespace hise { using namespace juce;
 
 ModulatorPeakMeter::ModulatorPeakMeter(Modulator *m) :
+SimpleTimer(m->getMainController()->getGlobalUIUpdater(), false, Priority::High),
 mod(m)
 {
 	addAndMakeVisible(vuMeter = new VuMeter());
@@ -41,7 +42,8 @@ mod(m)
 
 	vuMeter->setColour(VuMeter::ledColour, Colour(0x88dddddd));
 
-	startTimer(40);
+	setComponentToCheck(this);
+	start();
 
 	vuMeter->addMouseListener(this, true);
 }
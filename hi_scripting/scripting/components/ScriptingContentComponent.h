@@ -44,7 +44,7 @@ class VuMeter;
 
 class ModulatorPeakMeter: public Component,
 						  public SettableTooltipClient,
-					  public Timer
+					  public PooledUIUpdater::SimpleTimer
 {
 public:
 
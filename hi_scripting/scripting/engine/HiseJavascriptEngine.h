@@ -126,6 +126,71 @@ public:
 		WeakReference<HiseJavascriptEngine> engine;
 	};
 
+	/** A precompiled token stream of a script.
+	*
+	*	Exported plugins embed a snapshot for every script, so the tokeniser can be skipped when the
+	*	scripts are compiled on load (the parser just replays the stored tokens). The snapshots are kept in
+	*	a process wide cache which is looked up with the hash of the code. A snapshot is only used if the MD5
+	*	checksum of the code matches too, so if the script changed or the snapshot was created with an
+	*	incompatible version, the code is tokenised from the source as usual.
+	*/
+	struct TokenSnapshot : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<TokenSnapshot>;
+
+		/** Bump this whenever the tokeniser or the binary format changes. */
+		static constexpr int Version = 2;
+
+		struct Token
+		{
+			const char* type;
+			int byteOffset;
+			var value;
+			bool hasValue;
+			bool hasComment;
+			String comment;
+		};
+
+		/** The usage statistics of the process wide snapshot cache. */
+		struct Statistics
+		{
+			String toString() const;
+
+			int numRestored = 0;	// the number of snapshots in the cache
+			int numUsed = 0;		// the number of restored snapshots that were replayed at least once
+			int numHits = 0;		// the number of times a snapshot was replayed
+			int numRejected = 0;	// the number of hash matches with a different checksum
+		};
+
+		/** Runs the code through the token iterator and adds every token to the list. This uses a cached snapshot if there is one. Returns false if the code has a syntax error. */
+		static bool tokenise(const String& code, Array<Token>& tokens);
+
+		/** Tokenises the code and writes the snapshot to the stream. Returns false if the code has a syntax error. */
+		static bool write(const String& code, OutputStream& output);
+
+		/** Creates a tree with the snapshots of all given scripts. */
+		static ValueTree createSnapshotTree(const StringArray& scripts);
+
+		/** Adds all (valid) snapshots of the tree to the process wide cache and returns the number of restored snapshots. */
+		static int restoreSnapshotTree(const ValueTree& snapshotTree);
+
+		/** Returns the snapshot for the given code or nullptr if there is none. */
+		static Ptr getForCode(const String& code);
+
+		/** Returns the statistics of the process wide cache. Use this to check whether the embedded snapshots are actually used. */
+		static Statistics getStatistics();
+
+		int64 hash = 0;
+		int numBytes = 0;
+		MemoryBlock checksum;
+		Array<Token> tokens;
+		Atomic<int> numHits;
+
+	private:
+
+		static Ptr read(InputStream& input);
+	};
+
 	/** Attempts to parse and run a block of javascript code.
 	If there's a parse or execution error, the error description is returned in
 	the result.
@@ -196,6 +261,16 @@ public:
 
 	void setCallbackParameter(int callbackIndex, int parameterIndex, const var& newValue);
 
+	/** Marks the callback as real-time safe.
+	*
+	*	This must be called before the callback is parsed. Every expression that might allocate in the script
+	*	engine (object and array literals, var definitions, additions that might concatenate Strings, typeof, 
+	*	calls to non-inline functions, API methods that return a String or an object or inline functions that 
+	*	do any of these) will then be rejected with a compile error. The check relies on the return types of 
+	*	the API methods, so allocations inside the API methods (or growing an existing array) are not detected.
+	*/
+	void setCallbackIsRealtimeSafe(const Identifier& callbackName, bool shouldBeRealtimeSafe);
+
 
 	String getHoverString(const String& token);
 
@@ -504,7 +579,7 @@ public:
 
 		// Arithmetic
 
-		struct AdditionOp;				struct SubtractionOp;
+		struct AdditionOp;				struct NumericAdditionOp;	struct SubtractionOp;
 		struct MultiplyOp;				struct DivideOp;			struct ModuloOp;
 		struct BitwiseAndOp;			struct BitwiseOrOp;			struct BitwiseXorOp;
 		struct LeftShiftOp;				struct RightShiftOp;		struct RightShiftUnsignedOp;
@@ -635,10 +710,33 @@ public:
 				return var(object);
 			}
 
-			void doubleClickCallback(const MouseEvent &/*e*/, Component* /*componentToNotify*/) override
+			/** Prints the execution time histogram to the console. */
+			void doubleClickCallback(const MouseEvent &e, Component* componentToNotify) override;
+
+			void setRealtimeSafe(bool shouldBeRealtimeSafe) noexcept { realtimeSafe = shouldBeRealtimeSafe; }
+
+			bool isRealtimeSafe() const noexcept { return realtimeSafe; }
+
+			/** A lock free histogram of the execution times of a callback. */
+			struct ExecutionHistogram
 			{
-				DBG("JUMP");
-			}
+				enum { NumBuckets = 12 };
+
+				ExecutionHistogram() { clear(); }
+
+				void addValue(double milliSeconds) noexcept;
+
+				void clear() noexcept;
+
+				/** Returns the upper limit of the given bucket in microseconds. */
+				static double getUpperLimit(int bucketIndex) noexcept;
+
+				String toString() const;
+
+				std::atomic<int> counts[NumBuckets];
+			};
+
+			const ExecutionHistogram& getExecutionHistogram() const noexcept { return histogram; }
 
 			void cleanLocalProperties()
 			{
@@ -670,7 +768,10 @@ public:
 
 			const double bufferTime;
 
+			ExecutionHistogram histogram;
+
 			bool isCallbackDefined = false;
+			bool realtimeSafe = false;
 		};
 
 		struct JavascriptNamespace: public ReferenceCountedObject,
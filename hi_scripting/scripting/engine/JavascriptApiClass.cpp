@@ -128,6 +128,7 @@ numConstants(numConstants_)
 		functions3[i] = nullptr;
 		functions4[i] = nullptr;
 		functions5[i] = nullptr;
+		plainReturnValueFlags[i] = 0;
 	}
 
 	if (numConstants > 8)
@@ -218,7 +219,7 @@ Identifier ApiClass::getConstantName(int index) const
     return {};
 }
 
-void ApiClass::addFunction(const Identifier &id, call0 newFunction)
+void ApiClass::addFunction(const Identifier &id, call0 newFunction, bool returnsPlain)
 {
 	for (int i = 0; i < NUM_API_FUNCTION_SLOTS; i++)
 	{
@@ -226,6 +227,10 @@ void ApiClass::addFunction(const Identifier &id, call0 newFunction)
 		{
 			functions0[i] = newFunction;
 			id0[i] = id;
+
+			if (returnsPlain)
+				plainReturnValueFlags[i] |= (uint8)(1 << 0);
+
 			return;
 		}
 	}
@@ -233,7 +238,7 @@ void ApiClass::addFunction(const Identifier &id, call0 newFunction)
 	jassertfalse;
 }
 
-void ApiClass::addFunction1(const Identifier &id, call1 newFunction)
+void ApiClass::addFunction1(const Identifier &id, call1 newFunction, bool returnsPlain)
 {
 	for (int i = 0; i < NUM_API_FUNCTION_SLOTS; i++)
 	{
@@ -241,6 +246,10 @@ void ApiClass::addFunction1(const Identifier &id, call1 newFunction)
 		{
 			functions1[i] = newFunction;
 			id1[i] = id;
+
+			if (returnsPlain)
+				plainReturnValueFlags[i] |= (uint8)(1 << 1);
+
 			return;
 		}
 	}
@@ -248,7 +257,7 @@ void ApiClass::addFunction1(const Identifier &id, call1 newFunction)
 	jassertfalse;
 }
 
-void ApiClass::addFunction2(const Identifier &id, call2 newFunction)
+void ApiClass::addFunction2(const Identifier &id, call2 newFunction, bool returnsPlain)
 {
 	for (int i = 0; i < NUM_API_FUNCTION_SLOTS; i++)
 	{
@@ -256,6 +265,10 @@ void ApiClass::addFunction2(const Identifier &id, call2 newFunction)
 		{
 			functions2[i] = newFunction;
 			id2[i] = id;
+
+			if (returnsPlain)
+				plainReturnValueFlags[i] |= (uint8)(1 << 2);
+
 			return;
 		}
 	}
@@ -263,7 +276,7 @@ void ApiClass::addFunction2(const Identifier &id, call2 newFunction)
 	jassertfalse;
 }
 
-void ApiClass::addFunction3(const Identifier &id, call3 newFunction)
+void ApiClass::addFunction3(const Identifier &id, call3 newFunction, bool returnsPlain)
 {
 	for (int i = 0; i < NUM_API_FUNCTION_SLOTS; i++)
 	{
@@ -271,6 +284,10 @@ void ApiClass::addFunction3(const Identifier &id, call3 newFunction)
 		{
 			functions3[i] = newFunction;
 			id3[i] = id;
+
+			if (returnsPlain)
+				plainReturnValueFlags[i] |= (uint8)(1 << 3);
+
 			return;
 		}
 	}
@@ -278,7 +295,7 @@ void ApiClass::addFunction3(const Identifier &id, call3 newFunction)
 	jassertfalse;
 }
 
-void ApiClass::addFunction4(const Identifier &id, call4 newFunction)
+void ApiClass::addFunction4(const Identifier &id, call4 newFunction, bool returnsPlain)
 {
 	for (int i = 0; i < NUM_API_FUNCTION_SLOTS; i++)
 	{
@@ -286,6 +303,10 @@ void ApiClass::addFunction4(const Identifier &id, call4 newFunction)
 		{
 			functions4[i] = newFunction;
 			id4[i] = id;
+
+			if (returnsPlain)
+				plainReturnValueFlags[i] |= (uint8)(1 << 4);
+
 			return;
 		}
 	}
@@ -293,7 +314,7 @@ void ApiClass::addFunction4(const Identifier &id, call4 newFunction)
 	jassertfalse;
 }
 
-void ApiClass::addFunction5(const Identifier &id, call5 newFunction)
+void ApiClass::addFunction5(const Identifier &id, call5 newFunction, bool returnsPlain)
 {
 	for (int i = 0; i < NUM_API_FUNCTION_SLOTS; i++)
 	{
@@ -301,6 +322,10 @@ void ApiClass::addFunction5(const Identifier &id, call5 newFunction)
 		{
 			functions5[i] = newFunction;
 			id5[i] = id;
+
+			if (returnsPlain)
+				plainReturnValueFlags[i] |= (uint8)(1 << 5);
+
 			return;
 		}
 	}
@@ -353,6 +378,20 @@ void ApiClass::getIndexAndNumArgsForFunction(const Identifier &id, int &index, i
 	numArgs = -1;
 }
 
+bool ApiClass::returnsPlainValue(int index, int numArgs) const
+{
+	if (index < 0 || index >= NUM_API_FUNCTION_SLOTS || numArgs < 0 || numArgs > 5)
+		return false;
+
+	return (plainReturnValueFlags[index] & (1 << numArgs)) != 0;
+}
+
+void ApiClass::setAllFunctionsReturnPlainValues()
+{
+	for (int i = 0; i < NUM_API_FUNCTION_SLOTS; i++)
+		plainReturnValueFlags[i] = 0x3F;
+}
+
 var ApiClass::callFunction(int index, var *args, int numArgs)
 {
 	if (index > NUM_API_FUNCTION_SLOTS)
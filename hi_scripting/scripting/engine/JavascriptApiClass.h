@@ -203,32 +203,32 @@ public:
     /** Adds a function with no parameters. 
     *
     *   You don't need to use this directly, but use the macro ADD_API_METHOD_0() for it. */
-	void addFunction(const Identifier &id, call0 newFunction);;
+	void addFunction(const Identifier &id, call0 newFunction, bool returnsPlain=false);;
 	
     /** Adds a function with one parameter.
      *
      *   You don't need to use this directly, but use the macro ADD_API_METHOD_1() for it. */
-    void addFunction1(const Identifier &id, call1 newFunction);
+    void addFunction1(const Identifier &id, call1 newFunction, bool returnsPlain=false);
 	
     /** Adds a function with two parameters.
      *
      *   You don't need to use this directly, but use the macro ADD_API_METHOD_2() for it. */
-    void addFunction2(const Identifier &id, call2 newFunction);
+    void addFunction2(const Identifier &id, call2 newFunction, bool returnsPlain=false);
 	
     /** Adds a function with three parameters.
      *
      *   You don't need to use this directly, but use the macro ADD_API_METHOD_3() for it. */
-    void addFunction3(const Identifier &id, call3 newFunction);
+    void addFunction3(const Identifier &id, call3 newFunction, bool returnsPlain=false);
 	
     /** Adds a function with four parameters.
      *
      *   You don't need to use this directly, but use the macro ADD_API_METHOD_4() for it. */
-    void addFunction4(const Identifier &id, call4 newFunction);
+    void addFunction4(const Identifier &id, call4 newFunction, bool returnsPlain=false);
 	
     /** Adds a function with five parameters.
      *
      *   You don't need to use this directly, but use the macro ADD_API_METHOD_5() for it. */
-    void addFunction5(const Identifier &id, call5 newFunction);
+    void addFunction5(const Identifier &id, call5 newFunction, bool returnsPlain=false);
 
     /** This will fill in the information for the given function. 
     *
@@ -247,6 +247,27 @@ public:
     /** Returns all constant names as alphabetically sorted array. This is used by the autocomplete popup. */
 	void getAllConstants(Array<Identifier> &ids) const;
 
+	/** Checks whether the function returns a number, a bool or nothing.
+	*
+	*	Calls to functions that return a String, an Array or an object are rejected in real-time safe callbacks. */
+	bool returnsPlainValue(int index, int numArgs) const;
+
+	/** Marks all functions that were added so far as functions that return a plain value.
+	*
+	*	Use this if the wrapped methods return a var that is always a number. */
+	void setAllFunctionsReturnPlainValues();
+
+	/** Used by the ADD_API_METHOD macros to find out whether the method returns a number, a bool or nothing. */
+	template <typename R, typename C, typename... Args> static constexpr bool returnsPlainValue(R (C::*)(Args...))
+	{
+		return std::is_arithmetic<typename std::decay<R>::type>::value || std::is_void<R>::value;
+	}
+
+	template <typename R, typename C, typename... Args> static constexpr bool returnsPlainValue(R (C::*)(Args...) const)
+	{
+		return std::is_arithmetic<typename std::decay<R>::type>::value || std::is_void<R>::value;
+	}
+
 	ReadWriteLock apiClassLock;
 
 private:
@@ -267,6 +288,9 @@ private:
 	call4 functions4[NUM_API_FUNCTION_SLOTS];
 	call5 functions5[NUM_API_FUNCTION_SLOTS];
 
+	/** One bit per argument amount (1 << numArgs) that is set if the function returns a plain value. */
+	uint8 plainReturnValueFlags[NUM_API_FUNCTION_SLOTS];
+
 	// ================================================================================================================
 
 	struct Constant
@@ -967,6 +967,7 @@ var HiseJavascriptEngine::RootObject::Callback::perform(RootObject *root)
 
 	const double post = Time::getMillisecondCounterHiRes();
 	lastExecutionTime = post - pre;
+	histogram.addValue(lastExecutionTime);
 #else
 	statements->perform(s, &returnValue);
 #endif
@@ -974,6 +975,83 @@ var HiseJavascriptEngine::RootObject::Callback::perform(RootObject *root)
 	return returnValue;
 }
 
+void HiseJavascriptEngine::RootObject::Callback::doubleClickCallback(const MouseEvent &, Component* componentToNotify)
+{
+#if USE_BACKEND
+	auto *editor = GET_BACKEND_ROOT_WINDOW(componentToNotify);
+
+	debugToConsole(editor->getMainSynthChain(), callbackName.toString() + "() execution times:\n" + histogram.toString());
+#else
+	ignoreUnused(componentToNotify);
+#endif
+}
+
+void HiseJavascriptEngine::RootObject::Callback::ExecutionHistogram::addValue(double milliSeconds) noexcept
+{
+	const double microSeconds = milliSeconds * 1000.0;
+
+	for (int i = 0; i < NumBuckets - 1; i++)
+	{
+		if (microSeconds < getUpperLimit(i))
+		{
+			counts[i].fetch_add(1);
+			return;
+		}
+	}
+
+	counts[NumBuckets - 1].fetch_add(1);
+}
+
+void HiseJavascriptEngine::RootObject::Callback::ExecutionHistogram::clear() noexcept
+{
+	for (auto& c : counts)
+		c.store(0);
+}
+
+double HiseJavascriptEngine::RootObject::Callback::ExecutionHistogram::getUpperLimit(int bucketIndex) noexcept
+{
+	static const double limits[NumBuckets] = { 1.0, 2.0, 5.0, 10.0, 20.0, 50.0, 100.0, 200.0, 500.0, 1000.0, 2000.0, std::numeric_limits<double>::infinity() };
+
+	return limits[jlimit(0, NumBuckets - 1, bucketIndex)];
+}
+
+String HiseJavascriptEngine::RootObject::Callback::ExecutionHistogram::toString() const
+{
+	int total = 0;
+
+	for (const auto& c : counts)
+		total += c.load();
+
+	if (total == 0)
+		return "No calls recorded";
+
+	String s;
+	double lowerLimit = 0.0;
+
+	for (int i = 0; i < NumBuckets; i++)
+	{
+		const int numInBucket = counts[i].load();
+		const double upperLimit = getUpperLimit(i);
+
+		if (numInBucket > 0)
+		{
+			s << String(lowerLimit, 0) << " - ";
+			s << (i == NumBuckets - 1 ? String("...") : String(upperLimit, 0)) << " us: ";
+			s << String(numInBucket) << " (" << String(100.0 * (double)numInBucket / (double)total, 1) << "%)\n";
+		}
+
+		lowerLimit = upperLimit;
+	}
+
+	return s;
+}
+
+void HiseJavascriptEngine::setCallbackIsRealtimeSafe(const Identifier& callbackName, bool shouldBeRealtimeSafe)
+{
+	if (auto c = root->hiseSpecialData.getCallback(callbackName))
+		c->setRealtimeSafe(shouldBeRealtimeSafe);
+}
+
 AttributedString DynamicObjectDebugInformation::getDescription() const
 {
 	return AttributedString();
@@ -369,6 +369,115 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 
 		NamedValueSet localProperties;
 
+		/** A call to another inline function from within the function body. */
+		struct Call
+		{
+			enum ArgumentType
+			{
+				PlainArgument = -1,
+				UnknownArgument = -2
+			};
+
+			/** The called function (it is owned by its namespace). */
+			Object* function;
+
+			/** The parameter index of the calling function or one of the ArgumentType values for every argument. */
+			Array<int> arguments;
+		};
+
+		/** Returns a description of the first operation that might allocate (including calls to other inline functions).
+		*
+		*	If the function is real-time safe, it returns an empty string.
+		*/
+		String getAllocatingOperation() const
+		{
+			Array<const Object*> functions;
+			Array<Array<int>> requiredParameters;
+			getCalledFunctions(functions, requiredParameters);
+
+			for (int i = 0; i < functions.size(); i++)
+			{
+				auto f = functions[i];
+				auto prefix = i == 0 ? String() : "call of " + f->name.toString() + "(): ";
+
+				if (f->body == nullptr)
+					return prefix + "the function is not defined yet";
+
+				if (f->allocatingOperation.isNotEmpty())
+					return prefix + f->allocatingOperation;
+
+				for (const auto& c : f->calls)
+				{
+					for (auto p : requiredParameters[functions.indexOf(c.function)])
+					{
+						if (c.arguments[p] == Call::UnknownArgument)
+							return prefix + "argument " + String(p + 1) + " of " + c.function->name.toString() + "() might be a String";
+					}
+				}
+			}
+
+			return {};
+		}
+
+		/** Returns the indexes of the parameters that must not be a String (including the parameters that are passed to other inline functions). */
+		Array<int> getPlainParameters() const
+		{
+			Array<const Object*> functions;
+			Array<Array<int>> requiredParameters;
+			getCalledFunctions(functions, requiredParameters);
+
+			return requiredParameters[0];
+		}
+
+		/** Collects this function and every function it calls and resolves the plain parameter requirements of the calls. */
+		void getCalledFunctions(Array<const Object*>& functions, Array<Array<int>>& requiredParameters) const
+		{
+			functions.add(this);
+
+			for (int i = 0; i < functions.size(); i++)
+			{
+				for (const auto& c : functions[i]->calls)
+					functions.addIfNotAlreadyThere(c.function);
+
+				requiredParameters.add(functions[i]->plainParameters);
+			}
+
+			bool changed = true;
+
+			while (changed)
+			{
+				changed = false;
+
+				for (int i = 0; i < functions.size(); i++)
+				{
+					for (const auto& c : functions[i]->calls)
+					{
+						for (auto p : requiredParameters[functions.indexOf(c.function)])
+						{
+							auto argument = c.arguments[p];
+
+							if (argument >= 0 && !requiredParameters.getReference(i).contains(argument))
+							{
+								requiredParameters.getReference(i).add(argument);
+								changed = true;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		/** The first operation in the function body that might allocate. */
+		String allocatingOperation;
+
+		/** The parameters that are used in a way that would allocate if they were Strings. */
+		Array<int> plainParameters;
+
+		/** false if a return statement might return a String or an object. */
+		bool returnsPlainValue = true;
+
+		Array<Call> calls;
+
 		bool enableCycleCheck = false;
 
 		var lastScopeForCycleCheck;
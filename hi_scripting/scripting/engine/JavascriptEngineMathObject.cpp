@@ -70,6 +70,9 @@ struct HiseJavascriptEngine::RootObject::MathClass : public ApiClass
 		ADD_API_METHOD_1(ceil);
 		ADD_API_METHOD_1(floor);
 
+		// The methods return a var, but it's always a number
+		setAllFunctionsReturnPlainValues();
+
 		addConstant("PI", double_Pi);
 		addConstant("E", exp(1.0));
 		addConstant("SQRT2", sqrt(2.0));
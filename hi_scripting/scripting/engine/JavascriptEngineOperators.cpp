@@ -145,6 +145,31 @@ struct HiseJavascriptEngine::RootObject::AdditionOp : public BinaryOperator
 
 };
 
+/** The addition operator that is used in real-time safe callbacks.
+*
+*	It throws an error instead of concatenating Strings so that the callback never allocates a String.
+*/
+struct HiseJavascriptEngine::RootObject::NumericAdditionOp : public AdditionOp
+{
+	NumericAdditionOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : AdditionOp(l, a, b) {}
+
+	var getResult(const Scope& s) const override
+	{
+		var a(lhs->getResult(s)), b(rhs->getResult(s));
+
+		if ((isNumericOrUndefined(a) || a.isVoid()) && (isNumericOrUndefined(b) || b.isVoid()))
+			return (a.isDouble() || b.isDouble()) ? getWithDoubles(a, b) : getWithInts(a, b);
+
+		if (a.isBuffer())
+			return getWithArrayOrObject(a, b);
+
+		if (a.isString() || b.isString())
+			location.throwError("String concatenation is not allowed in real-time safe callbacks");
+
+		return throwError(a.isArray() || b.isArray() ? "Array" : "Object");
+	}
+};
+
 struct HiseJavascriptEngine::RootObject::SubtractionOp : public BinaryOperator
 {
 	SubtractionOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator(l, a, b, TokenTypes::minus) {}
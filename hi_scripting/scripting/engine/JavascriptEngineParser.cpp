@@ -3,7 +3,13 @@ namespace hise { using namespace juce;
 //==============================================================================
 struct HiseJavascriptEngine::RootObject::TokenIterator
 {
-	TokenIterator(const String& code, const String &externalFile) : location(code, externalFile), p(code.getCharPointer()) { skip(); }
+	TokenIterator(const String& code, const String &externalFile) : 
+		location(code, externalFile), 
+		p(code.getCharPointer()),
+		snapshot(TokenSnapshot::getForCode(code))
+	{ 
+		skip(); 
+	}
 
 	DebugableObject::Location createDebugLocation()
 	{
@@ -17,6 +23,12 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 
 	void skip()
 	{
+		if (snapshot != nullptr)
+		{
+			skipFromSnapshot();
+			return;
+		}
+
 		skipWhitespaceAndComments();
 		location.location = p;
 		currentType = matchNextToken();
@@ -59,6 +71,7 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 	}
 
 	String lastComment;
+	int numCommentsSkipped = 0;
 
 	void skipWhitespaceAndComments()
 	{
@@ -77,6 +90,7 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 					location.location = p;
 
 					lastComment = String(p).upToFirstOccurrenceOf("*/", false, false).fromFirstOccurrenceOf("/**", false, false).trim();
+					numCommentsSkipped++;
 
 					p = CharacterFunctions::find(p + 2, CharPointer_ASCII("*/"));
 
@@ -93,6 +107,31 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 private:
 	String::CharPointerType p;
 
+	TokenSnapshot::Ptr snapshot;
+	int snapshotIndex = 0;
+
+	void skipFromSnapshot()
+	{
+		const auto& t = snapshot->tokens.getReference(snapshotIndex);
+
+		// the last token is always eof so we stay there...
+		if (snapshotIndex < snapshot->tokens.size() - 1)
+			snapshotIndex++;
+
+		if (t.hasComment)
+		{
+			lastComment = t.comment;
+			numCommentsSkipped++;
+		}
+
+		location.location = String::CharPointerType(location.program.getCharPointer().getAddress() + t.byteOffset);
+
+		if (t.hasValue)
+			currentValue = t.value;
+
+		currentType = t.type;
+	}
+
 	static bool isIdentifierStart(const juce_wchar c) noexcept{ return CharacterFunctions::isLetter(c) || c == '_'; }
 	static bool isIdentifierBody(const juce_wchar c) noexcept{ return CharacterFunctions::isLetterOrDigit(c) || c == '_'; }
 
@@ -508,7 +547,16 @@ struct HiseJavascriptEngine::RootObject::ExpressionTreeBuilder : private TokenIt
 		}
 
 		if (matchIf(TokenTypes::question))          return parseTerneryOperator(lhs);
-		if (matchIf(TokenTypes::assign))            { ExpPtr rhs(parseExpression()); return new Assignment(location, lhs, rhs); }
+		if (matchIf(TokenTypes::assign))
+		{
+			ExpPtr rhs(parseExpression());
+
+			if (isPlainLocalVariable(lhs.get()))
+				requirePlainValue(rhs.get(), "Assignment of a value that might be a String to a numeric local variable");
+
+			return new Assignment(location, lhs, rhs);
+		}
+
 		if (matchIf(TokenTypes::plusEquals))        return parseInPlaceOpExpression<AdditionOp>(lhs);
 		if (matchIf(TokenTypes::minusEquals))       return parseInPlaceOpExpression<SubtractionOp>(lhs);
         if (matchIf(TokenTypes::timesEquals))       return parseInPlaceOpExpression<MultiplyOp>(lhs);
@@ -541,6 +589,9 @@ private:
 
 	DynamicObject* currentInlineFunction = nullptr;
 
+	/** The local variables of the current callback or inline function that were only assigned plain values so far. */
+	Array<Identifier> plainLocalVariables;
+
 	JavascriptNamespace* currentNamespace = nullptr;
 
 	JavascriptNamespace* getCurrentNamespace()
@@ -552,12 +603,190 @@ private:
 
 	void throwError(const String& err) const  { location.throwError(err); }
 
+	/** Call this whenever the parsed code might allocate memory when executed.
+	*
+	*	Inside a real-time safe callback this throws a compile error. Inside an inline function, the
+	*	operation is stored so that calls to this function from real-time safe callbacks can be rejected.
+	*/
+	void checkRealtimeSafety(const String& operationName)
+	{
+		if (auto ifo = dynamic_cast<InlineFunction::Object*>(getCurrentInlineFunction()))
+		{
+			if (ifo->allocatingOperation.isEmpty())
+			{
+				int column, line;
+				location.fillColumnAndLines(column, line);
+				ifo->allocatingOperation = operationName + " in line " + String(line);
+			}
+		}
+		else if (auto c = getCurrentRealtimeSafeCallback())
+		{
+			throwError("Illegal operation in real-time safe callback " + c->getName().toString() + "(): " + operationName);
+		}
+	}
+
+	Callback* getCurrentRealtimeSafeCallback()
+	{
+		if (currentlyParsedCallback.isNull())
+			return nullptr;
+
+		auto c = hiseSpecialData->getCallback(currentlyParsedCallback);
+		return c != nullptr && c->isRealtimeSafe() ? c : nullptr;
+	}
+
+	static bool isStringLiteral(const Expression* e)
+	{
+		auto l = dynamic_cast<const LiteralValue*>(e);
+		return l != nullptr && l->value.isString();
+	}
+
+	/** Checks whether the expression can only evaluate to a number, a bool, a buffer or undefined.
+	*
+	*	This is used to decide whether an addition might concatenate Strings. Anything that can't be
+	*	resolved at compile time (register variables, callback parameters, properties, etc.) is not plain.
+	*/
+	bool isPlainValue(const Expression* e) const
+	{
+		if (auto l = dynamic_cast<const LiteralValue*>(e))
+			return isNumericOrUndefined(l->value);
+
+		if (dynamic_cast<const NumericAdditionOp*>(e) != nullptr)
+			return true;
+
+		if (auto a = dynamic_cast<const AdditionOp*>(e))
+			return isPlainValue(a->lhs.get()) && isPlainValue(a->rhs.get());
+
+		if (dynamic_cast<const BinaryOperatorBase*>(e) != nullptr || dynamic_cast<const IsDefinedTest*>(e) != nullptr)
+			return true;
+
+		if (auto c = dynamic_cast<const ConditionalOp*>(e))
+			return isPlainValue(c->trueBranch.get()) && isPlainValue(c->falseBranch.get());
+
+		if (auto pa = dynamic_cast<const PostAssignment*>(e))
+			return isPlainValue(pa->target) && isPlainValue(pa->newValue.get());
+
+		if (auto sa = dynamic_cast<const SelfAssignment*>(e))
+			return isPlainValue(sa->newValue.get());
+
+		if (auto a = dynamic_cast<const Assignment*>(e))
+			return isPlainValue(a->newValue.get());
+
+		if (auto ac = dynamic_cast<const ApiCall*>(e))
+			return ac->apiClass->returnsPlainValue(ac->functionIndex, ac->expectedNumArguments);
+
+		if (auto ac = dynamic_cast<const ApiConstant*>(e))
+			return isNumericOrUndefined(ac->value);
+
+		if (auto cr = dynamic_cast<const ConstReference*>(e))
+			return isNumericOrUndefined(cr->ns->constObjects.getValueAt(cr->index));
+
+		if (auto fc = dynamic_cast<const FunctionCall*>(e))
+			return isPlainConstObjectCall(fc);
+
+		if (auto ifc = dynamic_cast<const InlineFunction::FunctionCall*>(e))
+			return ifc->f->body != nullptr && ifc->f->returnsPlainValue;
+
+		if (auto pr = dynamic_cast<const InlineFunction::ParameterReference*>(e))
+			return pr->f->plainParameters.contains(pr->index);
+
+		return isPlainLocalVariable(e);
+	}
+
+	/** Checks whether the function call is a method call to a const object that returns a plain value. */
+	static bool isPlainConstObjectCall(const FunctionCall* call)
+	{
+		if (dynamic_cast<const NewOperator*>(call) != nullptr)
+			return false;
+
+		if (auto dot = dynamic_cast<const DotOperator*>(call->object.get()))
+		{
+			if (auto cr = dynamic_cast<const ConstReference*>(dot->parent.get()))
+			{
+				if (auto obj = dynamic_cast<ConstScriptingObject*>(cr->ns->constObjects.getValueAt(cr->index).getObject()))
+				{
+					int index, numArgs;
+					obj->getIndexAndNumArgsForFunction(dot->child, index, numArgs);
+
+					return index != -1 && numArgs == call->arguments.size() && obj->returnsPlainValue(index, numArgs);
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool isPlainLocalVariable(const Expression* e) const
+	{
+		if (auto lr = dynamic_cast<const LocalReference*>(e))
+			return lr->parentFunction == getCurrentInlineFunction() && plainLocalVariables.contains(lr->id);
+
+		if (auto clr = dynamic_cast<const CallbackLocalReference*>(e))
+			return getCurrentInlineFunction() == nullptr && plainLocalVariables.contains(clr->name);
+
+		return false;
+	}
+
+	/** Call this for expressions that would allocate if they evaluated to a String.
+	*
+	*	If the expression is a parameter of the current inline function, the parameter is marked as plain and the
+	*	call sites in real-time safe callbacks have to pass in a plain value.
+	*/
+	void requirePlainValue(const Expression* e, const String& operationName)
+	{
+		if (isPlainValue(e))
+			return;
+
+		if (auto ifo = dynamic_cast<InlineFunction::Object*>(getCurrentInlineFunction()))
+		{
+			if (auto pr = dynamic_cast<const InlineFunction::ParameterReference*>(e))
+			{
+				if (pr->f == ifo)
+				{
+					ifo->plainParameters.addIfNotAlreadyThere(pr->index);
+					return;
+				}
+			}
+		}
+
+		checkRealtimeSafety(operationName);
+	}
+
+	template <typename OpType> Expression* createBinaryOp(ExpPtr& a, ExpPtr& b, OpType*)
+	{
+		return new OpType(location, a, b);
+	}
+
+	/** Creates an addition that can't concatenate Strings in real-time safe callbacks. */
+	Expression* createBinaryOp(ExpPtr& a, ExpPtr& b, AdditionOp*)
+	{
+		if (getCurrentInlineFunction() != nullptr)
+		{
+			requirePlainValue(a.get(), "Addition of a value that might be a String");
+			requirePlainValue(b.get(), "Addition of a value that might be a String");
+		}
+		else if (getCurrentRealtimeSafeCallback() != nullptr)
+		{
+			if (isStringLiteral(a.get()) || isStringLiteral(b.get()))
+				checkRealtimeSafety("String concatenation");
+
+			return new NumericAdditionOp(location, a, b);
+		}
+
+		return new AdditionOp(location, a, b);
+	}
+
 	template <typename OpType>
 	Expression* parseInPlaceOpExpression(ExpPtr& lhs)
 	{
 		ExpPtr rhs(parseExpression());
+
 		Expression* bareLHS = lhs; // careful - bare pointer is deliberately alised
-		return new SelfAssignment(location, bareLHS, new OpType(location, lhs, rhs));
+		auto op = createBinaryOp(lhs, rhs, (OpType*)nullptr);
+
+		if (isPlainLocalVariable(bareLHS))
+			requirePlainValue(op, "Assignment of a value that might be a String to a numeric local variable");
+
+		return new SelfAssignment(location, bareLHS, op);
 	}
 
 	BlockStatement* parseBlock()
@@ -795,6 +1024,13 @@ private:
 			return new ReturnStatement(location, new Expression(location));
 
 		ReturnStatement* r = new ReturnStatement(location, parseExpression());
+
+		if (auto ifo = dynamic_cast<InlineFunction::Object*>(getCurrentInlineFunction()))
+		{
+			if (!isPlainValue(r->returnValue.get()))
+				ifo->returnsPlainValue = false;
+		}
+
 		matchIf(TokenTypes::semicolon);
 		return r;
 	}
@@ -808,6 +1044,8 @@ private:
 		}
 #endif
 
+		checkRealtimeSafety("var definition (use local or reg instead)");
+
 		ScopedPointer<VarStatement> s(new VarStatement(location));
 		s->name = parseIdentifier();
 
@@ -947,6 +1185,18 @@ private:
 		return s.release();
 	}
 
+	void parseLocalInitialiser(ExpPtr& initialiser, const Identifier& name)
+	{
+		const bool hasInitialiser = matchIf(TokenTypes::assign);
+
+		initialiser = hasInitialiser ? parseExpression() : new Expression(location);
+
+		if (!hasInitialiser || isPlainValue(initialiser.get()))
+			plainLocalVariables.addIfNotAlreadyThere(name);
+		else
+			plainLocalVariables.removeAllInstancesOf(name);
+	}
+
 	Statement* parseLocalAssignment()
 	{
 		if (InlineFunction::Object::Ptr ifo = dynamic_cast<InlineFunction::Object*>(getCurrentInlineFunction()))
@@ -958,7 +1208,7 @@ private:
 
 			ifo->localProperties.set(s->name, var::undefined());
 
-			s->initialiser = matchIf(TokenTypes::assign) ? parseExpression() : new Expression(location);
+			parseLocalInitialiser(s->initialiser, s->name);
 
 			if (matchIf(TokenTypes::comma))
 			{
@@ -982,7 +1232,7 @@ private:
 
 			callback->localProperties.set(s->name, var());
 
-			s->initialiser = matchIf(TokenTypes::assign) ? parseExpression() : new Expression(location);
+			parseLocalInitialiser(s->initialiser, s->name);
 
 			if (matchIf(TokenTypes::comma))
 			{
@@ -1022,6 +1272,8 @@ private:
 
 		ScopedValueSetter<Identifier> cParser(currentlyParsedCallback, name, Identifier::null);
 
+		plainLocalVariables.clear();
+
 		ScopedPointer<BlockStatement> s = parseBlock();
 
 		
@@ -1193,11 +1445,48 @@ private:
 		}
 	}
 
-	DynamicObject* getCurrentInlineFunction()
+	DynamicObject* getCurrentInlineFunction() const
 	{
 		return currentInlineFunction;
 	}
 
+	/** Records the call in the current inline function or checks the called function and its arguments in a real-time safe callback. */
+	void checkInlineFunctionCall(const InlineFunction::FunctionCall* call)
+	{
+		auto obj = call->f;
+
+		if (auto ifo = dynamic_cast<InlineFunction::Object*>(getCurrentInlineFunction()))
+		{
+			InlineFunction::Object::Call c;
+			c.function = obj;
+
+			for (auto p : call->parameterExpressions)
+			{
+				auto pr = dynamic_cast<InlineFunction::ParameterReference*>(p);
+
+				if (pr != nullptr && pr->f == ifo)
+					c.arguments.add(pr->index);
+				else
+					c.arguments.add(isPlainValue(p) ? InlineFunction::Object::Call::PlainArgument : InlineFunction::Object::Call::UnknownArgument);
+			}
+
+			ifo->calls.add(c);
+		}
+		else if (getCurrentRealtimeSafeCallback() != nullptr)
+		{
+			auto allocatingOperation = obj->getAllocatingOperation();
+
+			if (allocatingOperation.isNotEmpty())
+				checkRealtimeSafety("call of " + obj->name.toString() + "(): " + allocatingOperation);
+
+			for (auto p : obj->getPlainParameters())
+			{
+				if (!isPlainValue(call->parameterExpressions[p]))
+					checkRealtimeSafety("call of " + obj->name.toString() + "(): argument " + String(p + 1) + " might be a String");
+			}
+		}
+	}
+
 	Expression* parseInlineFunctionCall(InlineFunction::Object *obj)
 	{
 		ScopedPointer<InlineFunction::FunctionCall> f = new InlineFunction::FunctionCall(location, obj);
@@ -1221,6 +1510,8 @@ private:
 				throwError("Inline function call " + obj->name + ": parameter amount mismatch: " + String(f->parameterExpressions.size()) + " (Expected: " + String(f->numArgs) + ")");
 			}
 
+			checkInlineFunctionCall(f);
+
 			return matchCloseParen(f.release());
 		}
 		else
@@ -1290,6 +1581,7 @@ private:
 			}
 
 			currentInlineFunction = o;
+			plainLocalVariables.clear();
 
 			if (o != nullptr)
 			{
@@ -1620,6 +1912,9 @@ private:
 
 		if (numArgs != numActualArguments) throwError("Call to " + prettyName + "(): argument number mismatch : " + String(numActualArguments) + " (Expected : " + String(numArgs) + ")");
 
+		if (!apiClass->returnsPlainValue(functionIndex, numArgs))
+			checkRealtimeSafety("Call to " + prettyName + "(), which returns a String or an object");
+
 		return matchCloseParen(s.release());
 	}
 
@@ -1675,7 +1970,22 @@ private:
 			return parseSuffixes(new DotOperator(location, input, parseIdentifier()));
 
 		if (currentType == TokenTypes::openParen)
-			return parseSuffixes(parseFunctionCall(new FunctionCall(location), input));
+		{
+			if (auto n = dynamic_cast<UnqualifiedName*>(input.get()))
+			{
+				if (isFunction(hiseSpecialData->root->getProperty(n->name)))
+					checkRealtimeSafety("Non inline function call");
+			}
+
+			ExpPtr call(parseFunctionCall(new FunctionCall(location), input));
+
+			const bool checkCall = getCurrentInlineFunction() != nullptr || getCurrentRealtimeSafeCallback() != nullptr;
+
+			if (checkCall && !isPlainValue(call.get()))
+				checkRealtimeSafety("Call of a method that might return a String or an object");
+
+			return parseSuffixes(call.release());
+		}
 
 		if (matchIf(TokenTypes::openBracket))
 		{
@@ -1837,6 +2147,8 @@ private:
 
 		if (matchIf(TokenTypes::openBrace))
 		{
+			checkRealtimeSafety("Object creation");
+
 			ScopedPointer<ObjectDeclaration> e(new ObjectDeclaration(location));
 
 			while (currentType != TokenTypes::closeBrace)
@@ -1857,6 +2169,8 @@ private:
 
 		if (matchIf(TokenTypes::openBracket))
 		{
+			checkRealtimeSafety("Array creation");
+
 			ScopedPointer<ArrayDeclaration> e(new ArrayDeclaration(location));
 
 			while (currentType != TokenTypes::closeBracket)
@@ -1901,7 +2215,7 @@ private:
 	{
 		Expression* e = parseFactor(); // careful - bare pointer is deliberately alised
 		ExpPtr lhs(e), one(new LiteralValue(location, (int)1));
-		return new SelfAssignment(location, e, new OpType(location, lhs, one));
+		return new SelfAssignment(location, e, createBinaryOp(lhs, one, (OpType*)nullptr));
 	}
 
 	template <typename OpType>
@@ -1909,11 +2223,13 @@ private:
 	{
 		Expression* e = lhs.release(); // careful - bare pointer is deliberately alised
 		ExpPtr lhs2(e), one(new LiteralValue(location, (int)1));
-		return new PostAssignment(location, e, new OpType(location, lhs2, one));
+		return new PostAssignment(location, e, createBinaryOp(lhs2, one, (OpType*)nullptr));
 	}
 
 	Expression* parseTypeof()
 	{
+		checkRealtimeSafety("typeof (it creates a String)");
+
 		ScopedPointer<FunctionCall> f(new FunctionCall(location));
 		f->object = new UnqualifiedName(location, "typeof", true);
 		f->arguments.add(parseUnary());
@@ -1969,7 +2285,7 @@ private:
 
 		for (;;)
 		{
-			if (matchIf(TokenTypes::plus))            { ExpPtr b(parseMultiplyDivide()); a = new AdditionOp(location, a, b); }
+			if (matchIf(TokenTypes::plus))            { ExpPtr b(parseMultiplyDivide()); a = createBinaryOp(a, b, (AdditionOp*)nullptr); }
 			else if (matchIf(TokenTypes::minus))      { ExpPtr b(parseMultiplyDivide()); a = new SubtractionOp(location, a, b); }
 			else break;
 		}
@@ -2325,4 +2641,286 @@ HiseJavascriptEngine::RootObject::FunctionObject::FunctionObject(const FunctionO
 	tb.parseFunctionParamsAndBody(*this);
 }
 
+struct TokenSnapshotCache
+{
+	CriticalSection lock;
+	HashMap<int64, HiseJavascriptEngine::TokenSnapshot::Ptr> snapshots;
+	Atomic<int> numSnapshots;
+	Atomic<int> numRejected;
+};
+
+static TokenSnapshotCache& getTokenSnapshotCache()
+{
+	static TokenSnapshotCache cache;
+	return cache;
+}
+
+static const Array<const char*>& getAllTokenTypes()
+{
+	static const Array<const char*> allTypes = []()
+	{
+		Array<const char*> types;
+
+#define JUCE_JS_ADD_TOKEN_TYPE(name, str) types.add(TokenTypes::name);
+		JUCE_JS_KEYWORDS(JUCE_JS_ADD_TOKEN_TYPE)
+		JUCE_JS_OPERATORS(JUCE_JS_ADD_TOKEN_TYPE)
+#undef JUCE_JS_ADD_TOKEN_TYPE
+
+		types.add(TokenTypes::eof);
+		types.add(TokenTypes::literal);
+		types.add(TokenTypes::identifier);
+
+		return types;
+	}();
+
+	return allTypes;
+}
+
+bool HiseJavascriptEngine::TokenSnapshot::tokenise(const String& code, Array<Token>& tokens)
+{
+	try
+	{
+		RootObject::TokenIterator it(code, {});
+
+		auto start = it.location.program.getCharPointer().getAddress();
+		int lastNumComments = 0;
+
+		for (;;)
+		{
+			Token t;
+
+			t.type = it.currentType;
+			t.byteOffset = (int)(it.location.location.getAddress() - start);
+			t.hasValue = it.currentType == TokenTypes::identifier || it.currentType == TokenTypes::literal;
+			t.hasComment = it.numCommentsSkipped != lastNumComments;
+
+			lastNumComments = it.numCommentsSkipped;
+
+			if (t.hasValue)
+				t.value = it.currentValue;
+
+			if (t.hasComment)
+				t.comment = it.lastComment;
+
+			tokens.add(t);
+
+			if (it.currentType == TokenTypes::eof)
+				break;
+
+			it.skip();
+		}
+	}
+	catch (String& e)
+	{
+		DBG("Can't tokenise code: " + e);
+		return false;
+	}
+
+	return true;
+}
+
+bool HiseJavascriptEngine::TokenSnapshot::write(const String& code, OutputStream& output)
+{
+	enum Flags { HasValue = 1, HasComment = 2 };
+
+	const auto& types = getAllTokenTypes();
+
+	Array<Token> tokens;
+
+	if (!tokenise(code, tokens))
+		return false;
+
+	MemoryOutputStream tokenData;
+	const int numTokens = tokens.size();
+
+	for (const auto& t : tokens)
+	{
+		tokenData.writeByte((char)types.indexOf(t.type));
+		tokenData.writeCompressedInt(t.byteOffset);
+		tokenData.writeByte((char)((t.hasValue ? HasValue : 0) | (t.hasComment ? HasComment : 0)));
+
+		if (t.hasValue)
+			t.value.writeToStream(tokenData);
+
+		if (t.hasComment)
+			tokenData.writeString(t.comment);
+	}
+
+	output.writeInt(Version);
+	output.writeInt(types.size());
+	output.writeInt64(code.hashCode64());
+	output.writeInt((int)code.getNumBytesAsUTF8());
+	output << MD5(code.toUTF8()).getRawChecksumData();
+	output.writeCompressedInt(numTokens);
+	output << tokenData.getMemoryBlock();
+
+	return true;
+}
+
+HiseJavascriptEngine::TokenSnapshot::Ptr HiseJavascriptEngine::TokenSnapshot::read(InputStream& input)
+{
+	enum Flags { HasValue = 1, HasComment = 2 };
+
+	const auto& types = getAllTokenTypes();
+
+	if (input.readInt() != Version || input.readInt() != types.size())
+		return nullptr;
+
+	Ptr s = new TokenSnapshot();
+
+	s->hash = input.readInt64();
+	s->numBytes = input.readInt();
+
+	if (input.readIntoMemoryBlock(s->checksum, 16) != 16)
+		return nullptr;
+
+	const int numTokens = input.readCompressedInt();
+
+	if (numTokens <= 0)
+		return nullptr;
+
+	s->tokens.ensureStorageAllocated(numTokens);
+
+	for (int i = 0; i < numTokens; i++)
+	{
+		Token t;
+
+		const int typeIndex = (int)(uint8)input.readByte();
+		t.byteOffset = input.readCompressedInt();
+		const int flags = input.readByte();
+
+		if (!isPositiveAndBelow(typeIndex, types.size()) || !isPositiveAndNotGreaterThan(t.byteOffset, s->numBytes))
+			return nullptr;
+
+		t.type = types[typeIndex];
+		t.hasValue = (flags & HasValue) != 0;
+		t.hasComment = (flags & HasComment) != 0;
+
+		if (t.hasValue)
+			t.value = var::readFromStream(input);
+
+		if (t.hasComment)
+			t.comment = input.readString();
+
+		s->tokens.add(t);
+	}
+
+	if (input.isExhausted() && s->tokens.getLast().type == TokenTypes::eof)
+		return s;
+
+	return nullptr;
+}
+
+ValueTree HiseJavascriptEngine::TokenSnapshot::createSnapshotTree(const StringArray& scripts)
+{
+	ValueTree v("TokenSnapshots");
+
+	for (const auto& code : scripts)
+	{
+		MemoryOutputStream mos;
+
+		if (code.isNotEmpty() && write(code, mos))
+		{
+			ValueTree s("Snapshot");
+			s.setProperty("Data", mos.getMemoryBlock(), nullptr);
+			v.addChild(s, -1, nullptr);
+		}
+	}
+
+	return v;
+}
+
+int HiseJavascriptEngine::TokenSnapshot::restoreSnapshotTree(const ValueTree& snapshotTree)
+{
+	auto& cache = getTokenSnapshotCache();
+	int numRestored = 0;
+
+	for (auto c : snapshotTree)
+	{
+		if (auto mb = c.getProperty("Data").getBinaryData())
+		{
+			MemoryInputStream mis(*mb, false);
+
+			if (auto s = read(mis))
+			{
+				ScopedLock sl(cache.lock);
+
+				if (!cache.snapshots.contains(s->hash))
+				{
+					cache.snapshots.set(s->hash, s);
+					++cache.numSnapshots;
+					numRestored++;
+				}
+			}
+		}
+	}
+
+	return numRestored;
+}
+
+HiseJavascriptEngine::TokenSnapshot::Ptr HiseJavascriptEngine::TokenSnapshot::getForCode(const String& code)
+{
+	auto& cache = getTokenSnapshotCache();
+
+	// Don't bother calculating the hash if there are no snapshots (eg. in the backend)
+	if (cache.numSnapshots.get() == 0 || code.isEmpty())
+		return nullptr;
+
+	const auto hash = code.hashCode64();
+
+	Ptr s;
+
+	{
+		ScopedLock sl(cache.lock);
+		s = cache.snapshots[hash];
+	}
+
+	if (s == nullptr || s->numBytes != (int)code.getNumBytesAsUTF8())
+		return nullptr;
+
+	// The 64 bit hash is just the key, so make sure that it's really the same code
+	if (MD5(code.toUTF8()).getRawChecksumData() != s->checksum)
+	{
+		++cache.numRejected;
+		return nullptr;
+	}
+
+	++s->numHits;
+	return s;
+}
+
+HiseJavascriptEngine::TokenSnapshot::Statistics HiseJavascriptEngine::TokenSnapshot::getStatistics()
+{
+	auto& cache = getTokenSnapshotCache();
+
+	Statistics stats;
+	stats.numRejected = cache.numRejected.get();
+
+	ScopedLock sl(cache.lock);
+
+	for (auto s : cache.snapshots)
+	{
+		const auto numHits = s->numHits.get();
+
+		stats.numRestored++;
+		stats.numUsed += numHits > 0 ? 1 : 0;
+		stats.numHits += numHits;
+	}
+
+	return stats;
+}
+
+String HiseJavascriptEngine::TokenSnapshot::Statistics::toString() const
+{
+	String s;
+
+	s << numUsed << " of " << numRestored << " script snapshots used (" << numHits << " hits";
+
+	if (numRejected > 0)
+		s << ", " << numRejected << " checksum mismatches";
+
+	s << ")";
+	return s;
+}
+
 } // namespace hise
\ No newline at end of file
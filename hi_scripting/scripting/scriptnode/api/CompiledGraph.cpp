@@ -0,0 +1,259 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+namespace scriptnode
+{
+using namespace juce;
+using namespace hise;
+
+CompiledGraph::CompiledGraph(NodeBase* rootNode, const PrepareSpecs& ps) :
+	numChannels(ps.numChannels),
+	blockSize(ps.blockSize)
+{
+	jassert(isPositiveAndBelow(numChannels, NUM_MAX_CHANNELS + 1));
+
+	auto root = addChannelSet(-1, 0, numChannels, true);
+	addNode(rootNode, root);
+}
+
+void CompiledGraph::process(ProcessData& d) noexcept
+{
+	jassert(canProcess(d));
+
+	auto& root = channelSets.getReference(0);
+
+	for (int i = 0; i < d.numChannels; i++)
+		root.channels[i] = d.data[i];
+
+	// The buffer sets have fixed pointers, so we only need to update the sets that refer to the data
+	for (int i = 1; i < channelSets.size(); i++)
+	{
+		auto& s = channelSets.getReference(i);
+
+		if (s.parent != -1)
+		{
+			auto& p = channelSets.getReference(s.parent);
+
+			for (int c = 0; c < s.numChannels; c++)
+				s.channels[c] = p.channels[s.channelOffset + c];
+		}
+	}
+
+	for (const auto& op : operations)
+	{
+		switch (op.type)
+		{
+		case OperationType::ProcessNode:
+		{
+			if (op.target == 0)
+			{
+				op.node->process(d);
+				break;
+			}
+
+			auto& t = channelSets.getReference(op.target);
+
+			ProcessData thisData(t.channels, t.numChannels, d.size);
+
+			if (t.forwardEvents)
+				thisData.eventBuffer = d.eventBuffer;
+
+			op.node->process(thisData);
+			break;
+		}
+		case OperationType::CopyChannels:
+		{
+			auto& s = channelSets.getReference(op.source);
+			auto& t = channelSets.getReference(op.target);
+
+			for (int c = 0; c < t.numChannels; c++)
+				FloatVectorOperations::copy(t.channels[c], s.channels[c], d.size);
+
+			break;
+		}
+		case OperationType::AddChannels:
+		{
+			auto& s = channelSets.getReference(op.source);
+			auto& t = channelSets.getReference(op.target);
+
+			for (int c = 0; c < t.numChannels; c++)
+				FloatVectorOperations::add(t.channels[c], s.channels[c], d.size);
+
+			break;
+		}
+		}
+	}
+}
+
+int CompiledGraph::getNumProcessedNodes() const noexcept
+{
+	int numNodes = 0;
+
+	for (const auto& op : operations)
+	{
+		if (op.type == OperationType::ProcessNode)
+			numNodes++;
+	}
+
+	return numNodes;
+}
+
+void CompiledGraph::addNode(NodeBase* n, int channelSetIndex)
+{
+	if (auto chain = dynamic_cast<ChainNode*>(n))
+	{
+		// A bypassed chain doesn't process anything once the bypass ramp is done
+		if (!chain->isBypassed())
+			addChildNodes(chain, channelSetIndex);
+
+		return;
+	}
+
+	if (auto split = dynamic_cast<SplitNode*>(n))
+	{
+		if (!split->isBypassed())
+			addSplitNode(split, channelSetIndex);
+
+		return;
+	}
+
+	if (auto multi = dynamic_cast<MultiChannelNode*>(n))
+	{
+		addMultiChannelNode(multi, channelSetIndex);
+		return;
+	}
+
+	operations.add({ OperationType::ProcessNode, n, channelSetIndex, channelSetIndex });
+}
+
+void CompiledGraph::addChildNodes(NodeContainer* c, int channelSetIndex)
+{
+	for (auto n : c->getNodeList())
+		addNode(n, channelSetIndex);
+}
+
+void CompiledGraph::addSplitNode(SplitNode* s, int channelSetIndex)
+{
+	// This must match SplitNode::process(): the first child processes the data in place
+	// (or leaves the dry signal if it's bypassed) and the others add their output to it.
+	const auto& nodeList = s->getNodeList();
+
+	NodeBase* firstNode = nullptr;
+	NodeBase::List otherNodes;
+
+	for (int i = 0; i < nodeList.size(); i++)
+	{
+		auto n = nodeList[i].get();
+
+		if (n->isBypassed())
+			continue;
+
+		if (i == 0)
+			firstNode = n;
+		else
+			otherNodes.add(n);
+	}
+
+	if (otherNodes.isEmpty())
+	{
+		if (firstNode != nullptr)
+			addNode(firstNode, channelSetIndex);
+
+		return;
+	}
+
+	auto numSplitChannels = channelSets[channelSetIndex].numChannels;
+
+	auto b = buffers.add(new AudioSampleBuffer(numSplitChannels * 2, blockSize));
+	b->clear();
+
+	auto original = addBufferChannelSet(*b, 0, numSplitChannels);
+	auto work = addBufferChannelSet(*b, numSplitChannels, numSplitChannels);
+
+	operations.add({ OperationType::CopyChannels, nullptr, channelSetIndex, original });
+
+	if (firstNode != nullptr)
+		addNode(firstNode, channelSetIndex);
+
+	for (auto n : otherNodes)
+	{
+		operations.add({ OperationType::CopyChannels, nullptr, original, work });
+		addNode(n, work);
+		operations.add({ OperationType::AddChannels, nullptr, work, channelSetIndex });
+	}
+}
+
+void CompiledGraph::addMultiChannelNode(MultiChannelNode* m, int channelSetIndex)
+{
+	auto numAvailableChannels = channelSets[channelSetIndex].numChannels;
+	int channelIndex = 0;
+
+	for (auto n : m->getNodeList())
+	{
+		auto numChannelsThisTime = n->getNumChannelsToProcess();
+
+		if (channelIndex + numChannelsThisTime <= numAvailableChannels)
+		{
+			// The multi container doesn't forward the events to its children
+			auto subSet = addChannelSet(channelSetIndex, channelIndex, numChannelsThisTime, false);
+			addNode(n, subSet);
+		}
+
+		channelIndex += numChannelsThisTime;
+	}
+}
+
+int CompiledGraph::addChannelSet(int parent, int channelOffset, int numChannelsInSet, bool forwardEvents)
+{
+	ChannelSet s;
+	s.parent = parent;
+	s.channelOffset = channelOffset;
+	s.numChannels = numChannelsInSet;
+	s.forwardEvents = forwardEvents && (parent == -1 || channelSets[parent].forwardEvents);
+	zeromem(s.channels, sizeof(s.channels));
+
+	channelSets.add(s);
+	return channelSets.size() - 1;
+}
+
+int CompiledGraph::addBufferChannelSet(AudioSampleBuffer& b, int channelOffset, int numChannelsInSet)
+{
+	auto index = addChannelSet(-1, 0, numChannelsInSet, true);
+	auto& s = channelSets.getReference(index);
+
+	for (int i = 0; i < numChannelsInSet; i++)
+		s.channels[i] = b.getWritePointer(channelOffset + i);
+
+	return index;
+}
+
+}
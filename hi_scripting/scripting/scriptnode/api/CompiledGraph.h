@@ -0,0 +1,113 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+#pragma once
+
+namespace scriptnode
+{
+using namespace juce;
+using namespace hise;
+
+/** A flattened version of the node graph of a DspNetwork.
+
+	The dynamic containers (chain, split and multi) are resolved into a linear list of operations
+	that call the child nodes directly, so the per-block dispatch through the container objects,
+	their bypass wrappers and the nested ProcessData objects goes away.
+
+	Every other node (including containers that change the block size or the sample rate) is
+	processed as a single unit. The graph does not own any node and must be rebuilt whenever
+	the network structure changes (the DspNetwork takes care of this).
+*/
+class CompiledGraph
+{
+public:
+
+	CompiledGraph(NodeBase* rootNode, const PrepareSpecs& ps);
+
+	/** Returns true if the data matches the specs that were used to build the graph. */
+	bool canProcess(const ProcessData& d) const noexcept
+	{
+		return d.numChannels == numChannels && d.size <= blockSize;
+	}
+
+	/** Processes the data with the flattened graph. */
+	void process(ProcessData& d) noexcept;
+
+	/** Returns the number of nodes that are called directly. */
+	int getNumProcessedNodes() const noexcept;
+
+private:
+
+	enum class OperationType
+	{
+		ProcessNode,
+		CopyChannels,
+		AddChannels
+	};
+
+	struct Operation
+	{
+		OperationType type;
+		NodeBase* node;
+		int source;
+		int target;
+	};
+
+	/** A list of channel pointers that is either a part of another channel set or a preallocated buffer. */
+	struct ChannelSet
+	{
+		int parent;
+		int channelOffset;
+		int numChannels;
+		bool forwardEvents;
+		float* channels[NUM_MAX_CHANNELS];
+	};
+
+	void addNode(NodeBase* n, int channelSetIndex);
+	void addChildNodes(NodeContainer* c, int channelSetIndex);
+	void addSplitNode(SplitNode* s, int channelSetIndex);
+	void addMultiChannelNode(MultiChannelNode* m, int channelSetIndex);
+
+	int addChannelSet(int parent, int channelOffset, int numChannels, bool forwardEvents);
+	int addBufferChannelSet(AudioSampleBuffer& b, int channelOffset, int numChannels);
+
+	Array<Operation> operations;
+	Array<ChannelSet> channelSets;
+	OwnedArray<AudioSampleBuffer> buffers;
+
+	int numChannels = 0;
+	int blockSize = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CompiledGraph);
+};
+
+}
@@ -115,10 +115,16 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
     {
         n->postInit();
     }
+
+#if HISE_SCRIPTNODE_USE_COMPILED_GRAPH
+	graphCompiler = new GraphCompiler(*this);
+#endif
 }
 
 DspNetwork::~DspNetwork()
 {
+	graphCompiler = nullptr;
+	compiledGraph = nullptr;
 	selectionUpdater = nullptr;
 	nodes.clear();
     nodeFactories.clear();
@@ -268,7 +274,15 @@ void DspNetwork::process(AudioSampleBuffer& b, HiseEventBuffer* e)
 
 	d.eventBuffer = e;
 
-	signalPath->process(d);
+	process(d);
+}
+
+void DspNetwork::process(ProcessData& d)
+{
+	if (compiledGraph != nullptr && compiledGraph->canProcess(d))
+		compiledGraph->process(d);
+	else
+		signalPath->process(d);
 }
 
 juce::Identifier DspNetwork::getParameterIdentifier(int parameterIndex)
@@ -296,7 +310,10 @@ void DspNetwork::prepareToPlay(double sampleRate, double blockSize)
 		ps.voiceIndex = &voiceIndex;
 
 		signalPath->prepare(ps);
+		lastSpecs = ps;
 	}
+
+	rebuildCompiledGraph();
 }
 
 void DspNetwork::processBlock(var pData)
@@ -327,7 +344,7 @@ void DspNetwork::processBlock(var pData)
 
 		d.data = currentData;
 
-		signalPath->process(d);
+		process(d);
 	}
 }
 
@@ -773,5 +790,67 @@ void DspNetwork::SelectionUpdater::changeListenerCallback(ChangeBroadcaster*)
 	}
 }
 
+void DspNetwork::rebuildCompiledGraph()
+{
+	if (graphCompiler == nullptr || lastSpecs.sampleRate <= 0.0 || signalPath == nullptr)
+		return;
+
+	auto ps = lastSpecs;
+	ps.numChannels = signalPath->getNumChannelsToProcess();
+
+	ScopedPointer<CompiledGraph> newGraph = new CompiledGraph(signalPath, ps);
+
+	{
+		ScopedLock sl(getConnectionLock());
+		compiledGraph.swapWith(newGraph);
+	}
+}
+
+void DspNetwork::invalidateCompiledGraph()
+{
+	ScopedPointer<CompiledGraph> oldGraph;
+
+	{
+		ScopedLock sl(getConnectionLock());
+		compiledGraph.swapWith(oldGraph);
+	}
+
+	if (graphCompiler != nullptr)
+		graphCompiler->triggerAsyncUpdate();
+}
+
+DspNetwork::GraphCompiler::GraphCompiler(DspNetwork& parent_) :
+	parent(parent_)
+{
+	nodeListener.setTypeToWatch(PropertyIds::Nodes);
+	nodeListener.setCallback(parent.data, valuetree::AsyncMode::Synchronously, [this](ValueTree, bool)
+	{
+		parent.invalidateCompiledGraph();
+	});
+
+	propertyListener.setCallback(parent.data, { PropertyIds::Bypassed, PropertyIds::NumChannels }, valuetree::AsyncMode::Synchronously, [this](ValueTree, Identifier)
+	{
+		parent.invalidateCompiledGraph();
+	});
+}
+
+DspNetwork::GraphCompiler::~GraphCompiler()
+{
+	cancelPendingUpdate();
+	stopTimer();
+}
+
+void DspNetwork::GraphCompiler::handleAsyncUpdate()
+{
+	// Give the bypass ramps of the dynamic graph some time before switching back
+	startTimer(500);
+}
+
+void DspNetwork::GraphCompiler::timerCallback()
+{
+	stopTimer();
+	parent.rebuildCompiledGraph();
+}
+
 }
 
@@ -38,6 +38,7 @@ using namespace juce;
 using namespace hise;
 
 class NodeFactory;
+class CompiledGraph;
 
 /** A network of multiple DSP objects that are connected using a graph. */
 class DspNetwork : public ConstScriptingObject,
@@ -145,6 +146,15 @@ public:
 
 	void process(AudioSampleBuffer& b, HiseEventBuffer* e);
 
+	/** Processes the data with the compiled graph if it's available or the root node otherwise.
+	*
+	*	The caller must hold the connection lock, otherwise the compiled graph might be swapped during processing.
+	*/
+	void process(ProcessData& d);
+
+	/** Returns true if the network currently processes its data with the compiled graph. */
+	bool hasCompiledGraph() const noexcept { return compiledGraph != nullptr; }
+
 	bool isPolyphonic() const { return isPoly; }
 
 	NodeBase* getRootNode() { return signalPath.get(); }
@@ -340,6 +350,32 @@ private:
 
 	struct Wrapper;
 
+	/** Watches the network for changes and rebuilds the compiled graph after the edit. 
+	
+		The listeners can be called from any thread, so the timer is started asynchronously.
+	*/
+	struct GraphCompiler : public Timer,
+						   public AsyncUpdater
+	{
+		GraphCompiler(DspNetwork& parent_);
+		~GraphCompiler();
+
+		void handleAsyncUpdate() override;
+		void timerCallback() override;
+
+		DspNetwork& parent;
+
+		valuetree::RecursiveTypedChildListener nodeListener;
+		valuetree::RecursivePropertyListener propertyListener;
+	};
+
+	void rebuildCompiledGraph();
+	void invalidateCompiledGraph();
+
+	PrepareSpecs lastSpecs;
+	ScopedPointer<CompiledGraph> compiledGraph;
+	ScopedPointer<GraphCompiler> graphCompiler;
+
 	DynamicObject::Ptr loader;
 
 	ReferenceCountedArray<NodeBase> nodes;
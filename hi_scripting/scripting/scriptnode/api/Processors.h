@@ -360,32 +360,41 @@ public:
 
 	static constexpr bool isModulationSource = T::isModulationSource;
 
-	using Oversampler = juce::dsp::Oversampling<float>;
+	using Oversampler = PolyphaseOversampler;
 
 	void prepare(PrepareSpecs ps)
 	{
 		jassert(lock != nullptr);
 
-		ScopedPointer<Oversampler> newOverSampler;
-
-		auto originalBlockSize = ps.blockSize;
+		originalBlockSize = ps.blockSize;
+		lastNumChannels = ps.numChannels;
 
 		ps.sampleRate *= (double)OversamplingFactor;
 		ps.blockSize *= OversamplingFactor;
 
 		obj.prepare(ps);
 
-		newOverSampler = new Oversampler(ps.numChannels, (int)std::log2(OversamplingFactor), Oversampler::FilterType::filterHalfBandPolyphaseIIR, false);
-
-		if (originalBlockSize > 0)
-			newOverSampler->initProcessing(originalBlockSize);
+		rebuildOversampler();
+	}
 
+	/** Changes the filter profile. This only recreates the oversampler (the filter coefficients are shared). */
+	void setProfile(Oversampler::Profile newProfile)
+	{
+		if (profile != newProfile)
 		{
-			ScopedLock sl(*lock);
-			oversampler.swapWith(newOverSampler);
+			profile = newProfile;
+
+			if (lastNumChannels > 0)
+				rebuildOversampler();
 		}
 	}
 
+	/** Returns the latency of the oversampling filters at the original sample rate. */
+	float getLatencyInSamples() const
+	{
+		return oversampler != nullptr ? oversampler->getLatencyInSamples() : 0.0f;
+	}
+
 	forcedinline void reset() noexcept 
 	{
 		if (oversampler != nullptr)
@@ -445,8 +454,25 @@ public:
 
 private:
 
+	void rebuildOversampler()
+	{
+		ScopedPointer<Oversampler> newOverSampler = new Oversampler(lastNumChannels, (int)std::log2(OversamplingFactor), profile);
+
+		if (originalBlockSize > 0)
+			newOverSampler->initProcessing(originalBlockSize);
+
+		{
+			ScopedLock sl(*lock);
+			oversampler.swapWith(newOverSampler);
+		}
+	}
+
 	CriticalSection* lock = nullptr;
 
+	Oversampler::Profile profile = Oversampler::Profile::MinimumPhaseIIR;
+	int originalBlockSize = 0;
+	int lastNumChannels = 0;
+
 	ScopedPointer<Oversampler> oversampler;
 	T obj;
 };
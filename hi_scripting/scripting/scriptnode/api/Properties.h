@@ -115,6 +115,7 @@ DECLARE_ID(File);
 DECLARE_ID(PublicComponent);
 DECLARE_ID(Code);
 DECLARE_ID(AllowSubBlocks);
+DECLARE_ID(OversamplingProfile);
 DECLARE_ID(Enabled);
 
 enum EditType
@@ -202,6 +202,10 @@ void jit_impl<NV>::initialise(NodeBase* n)
 	scope.addOptimization(OptimizationIds::DeadCodeElimination);
 	scope.addOptimization(OptimizationIds::Inlining);
 	scope.addOptimization(OptimizationIds::BinaryOpOptimisation);
+	scope.addOptimization(OptimizationIds::LoopVectorisation);
+	scope.addOptimization(OptimizationIds::LoopInvariantCodeMotion);
+	scope.addOptimization(OptimizationIds::StrengthReduction);
+	scope.addOptimization(OptimizationIds::LoopUnrolling);
 
 	scope.setBufferHandler(new HiseBufferHandler(dynamic_cast<Processor*>(n->getScriptProcessor())));
 
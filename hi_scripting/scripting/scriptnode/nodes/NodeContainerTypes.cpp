@@ -284,12 +284,16 @@ juce::Rectangle<int> ModulationChainNode::getPositionInCanvas(Point<int> topLeft
 
 template <int OversampleFactor>
 OversampleNode<OversampleFactor>::OversampleNode(DspNetwork* network, ValueTree d) :
-	SerialNode(network, d)
+	SerialNode(network, d),
+	profile(PropertyIds::OversamplingProfile, PolyphaseOversampler::getProfileNames()[0])
 {
 	initListeners();
 
 	obj.initialise(this);
 
+	profile.setAdditionalCallback(BIND_MEMBER_FUNCTION_2(OversampleNode<OversampleFactor>::updateProfile));
+	profile.init(this, nullptr);
+
 	bypassListener.setCallback(d, { PropertyIds::Bypassed },
 		valuetree::AsyncMode::Synchronously,
 		BIND_MEMBER_FUNCTION_2(OversampleNode<OversampleFactor>::updateBypassState));
@@ -310,6 +314,13 @@ void OversampleNode<OversampleFactor>::updateBypassState(Identifier, var)
 	prepare(ps);
 }
 
+template <int OversampleFactor>
+void OversampleNode<OversampleFactor>::updateProfile(Identifier, var newValue)
+{
+	auto index = jmax(0, PolyphaseOversampler::getProfileNames().indexOf(newValue.toString()));
+	obj.setProfile((PolyphaseOversampler::Profile)index);
+}
+
 template <int OversampleFactor>
 void OversampleNode<OversampleFactor>::prepare(PrepareSpecs ps)
 {
@@ -122,6 +122,8 @@ public:
 
 	void updateBypassState(Identifier, var );
 
+	void updateProfile(Identifier, var newValue);
+
 	void prepare(PrepareSpecs ps) override;
 	void reset() final override;
 	void handleHiseEvent(HiseEvent& e) final override;
@@ -129,6 +131,7 @@ public:
 
 	wrap::oversample<OversampleFactor, SerialNode::DynamicSerialProcessor> obj;
 
+	NodePropertyT<String> profile;
 	valuetree::PropertyListener bypassListener;
 	int* lastVoiceIndex = nullptr;
 };
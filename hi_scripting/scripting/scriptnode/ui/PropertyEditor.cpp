@@ -202,7 +202,7 @@ NodePropertyComponent::Comp::Comp(ValueTree d, NodeBase* n) :
 		editor = t;
 		addAndMakeVisible(editor);
 	}
-	else if (propId == PropertyIds::Callback || propId == PropertyIds::Connection)
+	else if (propId == PropertyIds::Callback || propId == PropertyIds::Connection || propId == PropertyIds::OversamplingProfile)
 	{
 		Array<var> values;
 
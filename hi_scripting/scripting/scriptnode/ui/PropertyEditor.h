@@ -66,6 +66,10 @@ struct NodePropertyComponent : public PropertyComponent
 			{
 				return routing::Factory::getSourceNodeList(n);
 			}
+			else if (id == PropertyIds::OversamplingProfile)
+			{
+				return PolyphaseOversampler::getProfileNames();
+			}
 
 			return {};
 		}
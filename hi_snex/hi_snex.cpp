@@ -71,6 +71,7 @@ using String = juce::String;
 #include "snex_jit/snex_jit_JitCompiler.cpp"
 
 #include "snex_jit/snex_jit_UnitTests.cpp"
+#include "snex_jit/snex_jit_Benchmark.cpp"
 
 #include "snex_core/snex_CallbackCollection.cpp"
 #include "snex_components/snex_JitPlayground.cpp"
@@ -88,6 +88,7 @@ Set to 0 to disable SNEX compilation (default on iOS).
 #include "snex_core/snex_DynamicType.h"
 #include "snex_core/snex_TypeHelpers.h"
 #include "snex_jit/snex_jit_public.h"
+#include "snex_jit/snex_jit_Benchmark.h"
 
 #include "snex_core/snex_CallbackCollection.h"
 #include "snex_components/snex_JitPlayground.h"
@@ -64,6 +64,10 @@ SnexPlayground::SnexPlayground(Value externalCode, BufferHandler* toUse) :
 	memory.addOptimization(OptimizationIds::DeadCodeElimination);
 	memory.addOptimization(OptimizationIds::Inlining);
 	memory.addOptimization(OptimizationIds::BinaryOpOptimisation);
+	memory.addOptimization(OptimizationIds::LoopVectorisation);
+	memory.addOptimization(OptimizationIds::LoopInvariantCodeMotion);
+	memory.addOptimization(OptimizationIds::StrengthReduction);
+	memory.addOptimization(OptimizationIds::LoopUnrolling);
 	memory.setBufferHandler(toUse != nullptr ? toUse : new PlaygroundBufferHandler());
 	memory.getBreakpointHandler().setActive(true);
 
@@ -28,6 +28,12 @@ public:
 		data(other.data)
 	{};
 
+	VariableStorage& operator=(const VariableStorage& other)
+	{
+		data = other.data;
+		return *this;
+	}
+
 	VariableStorage(Types::ID type_, const var& value);
 	VariableStorage(FloatType s);
 	VariableStorage(double d);
@@ -255,6 +261,12 @@ private:
 			d(other.d)
 		{};
 
+		Data& operator=(const Data& other)
+		{
+			d = other.d;
+			return *this;
+		}
+
 		
 		block b;
 		DoubleData d;
@@ -416,6 +416,11 @@ bool AssemblyRegister::isMemoryLocation() const
 	return state == LoadedMemoryLocation;
 }
 
+bool AssemblyRegister::canBeLoadedFromMemory() const
+{
+	return state == UnloadedMemoryLocation || hasCustomMem;
+}
+
 
 void AssemblyRegister::setCustomMemoryLocation(X86Mem newLocation, bool isGlobalMemory_)
 {
@@ -482,6 +487,20 @@ snex::jit::AssemblyRegisterPool::RegList AssemblyRegisterPool::getListOfAllDirty
 }
 
 
+snex::jit::AssemblyRegisterPool::RegList AssemblyRegisterPool::getListOfAllRegistersWithMemory()
+{
+	RegList l;
+
+	for (auto r : currentRegisterPool)
+	{
+		if (r->isDirtyGlobalMemory() || (r->hasCustomMemoryLocation() && r->isActiveOrDirtyGlobalRegister()))
+			l.add(r);
+	}
+
+	return l;
+}
+
+
 snex::jit::AssemblyRegisterPool::RegPtr AssemblyRegisterPool::getRegisterForVariable(BaseScope* scope, const Symbol& s)
 {
 	for (const auto r : currentRegisterPool)
@@ -496,6 +515,18 @@ snex::jit::AssemblyRegisterPool::RegPtr AssemblyRegisterPool::getRegisterForVari
 }
 
 
+snex::jit::AssemblyRegisterPool::RegPtr AssemblyRegisterPool::getExistingRegisterForVariable(BaseScope* scope, const Symbol& s)
+{
+	for (const auto r : currentRegisterPool)
+	{
+		if (r->matchesScopeAndSymbol(scope, s))
+			return r;
+	}
+
+	return nullptr;
+}
+
+
 snex::jit::AssemblyRegisterPool::RegPtr AssemblyRegisterPool::getActiveRegisterForCustomMem(RegPtr regWithCustomMem)
 {
 	for (auto r : currentRegisterPool)
@@ -549,7 +580,9 @@ snex::jit::AssemblyRegisterPool::RegPtr AssemblyRegisterPool::getRegisterWithMem
 
 	for (auto r : currentRegisterPool)
 	{
-		if (!r->isMemoryLocation())
+		// A register that has already loaded the memory must be used too
+		// or it would read a stale value if the register is dirty
+		if (!r->isMemoryLocation() && !(r->hasCustomMemoryLocation() && r->isActiveOrDirtyGlobalRegister()))
 			continue;
 
 		if (r == other.get())
@@ -149,6 +149,9 @@ public:
 
 	bool isMemoryLocation() const;
 
+	/** Returns true if the value is not in a register but can be loaded from its memory location. */
+	bool canBeLoadedFromMemory() const;
+
 	void setCustomMemoryLocation(X86Mem newLocation, bool isGlobalMemory);
 
 	void setDataPointer(void* memLoc);
@@ -227,8 +230,15 @@ public:
 
 	void clear();
 	RegList getListOfAllDirtyGlobals();
+
+	/** Returns all registers that hold a value from memory (dirty globals and loaded member registers). */
+	RegList getListOfAllRegistersWithMemory();
+
 	RegPtr getRegisterForVariable(BaseScope* scope, const Symbol& variableId);
 
+	/** Returns the register that was already assigned to the variable or nullptr. */
+	RegPtr getExistingRegisterForVariable(BaseScope* scope, const Symbol& variableId);
+
 	RegPtr getActiveRegisterForCustomMem(RegPtr regWithCustomMem);
 
 	void removeIfUnreferenced(AssemblyRegister::Ptr ref);
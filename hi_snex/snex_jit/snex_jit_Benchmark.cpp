@@ -0,0 +1,673 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace snex {
+namespace jit {
+using namespace juce;
+
+namespace BenchmarkHelpers
+{
+/** The header that is prepended to the test file so that it can be compiled as C++ code. */
+static const char* nativeHeader = R"(
+#include <cmath>
+#include <algorithm>
+
+#if defined(_WIN32)
+#define SNEX_BENCHMARK_EXPORT extern "C" __declspec(dllexport)
+#else
+#define SNEX_BENCHMARK_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+template <typename T, int N> struct span
+{
+	T& operator[](int i) { return data_[i]; }
+	const T& operator[](int i) const { return data_[i]; }
+	T* begin() { return data_; }
+	T* end() { return data_ + N; }
+	int size() const { return N; }
+
+	T data_[N];
+};
+
+template <typename T> struct dyn
+{
+	T& operator[](int i) { return data_[i]; }
+	T* begin() const { return data_; }
+	T* end() const { return data_ + size_; }
+	int size() const { return size_; }
+
+	T* data_;
+	int size_;
+};
+
+using block = dyn<float>;
+
+struct MathFunctions
+{
+	static constexpr double PI = 3.1415926535897932384626433832795;
+	static constexpr double E = 2.7182818284590452353602874713527;
+	static constexpr double SQRT2 = 1.4142135623730950488016887242097;
+	static constexpr double FORTYTWO = 42.0;
+
+	template <typename T> static T sin(T x) { return std::sin(x); }
+	template <typename T> static T asin(T x) { return std::asin(x); }
+	template <typename T> static T cos(T x) { return std::cos(x); }
+	template <typename T> static T acos(T x) { return std::acos(x); }
+	template <typename T> static T sinh(T x) { return std::sinh(x); }
+	template <typename T> static T cosh(T x) { return std::cosh(x); }
+	template <typename T> static T tan(T x) { return std::tan(x); }
+	template <typename T> static T tanh(T x) { return std::tanh(x); }
+	template <typename T> static T atan(T x) { return std::atan(x); }
+	template <typename T> static T atanh(T x) { return std::atanh(x); }
+	template <typename T> static T log(T x) { return std::log(x); }
+	template <typename T> static T log10(T x) { return std::log10(x); }
+	template <typename T> static T exp(T x) { return std::exp(x); }
+	template <typename T> static T sqr(T x) { return x * x; }
+	template <typename T> static T sqrt(T x) { return std::sqrt(x); }
+	template <typename T> static T ceil(T x) { return std::ceil(x); }
+	template <typename T> static T floor(T x) { return std::floor(x); }
+	template <typename T> static T round(T x) { return std::round(x); }
+	template <typename T> static T abs(T x) { return std::abs(x); }
+	template <typename T> static T sign(T x) { return x < T(0) ? T(-1) : T(1); }
+	template <typename T> static T pow(T x, T e) { return std::pow(x, e); }
+	template <typename T> static T fmod(T x, T l) { return std::fmod(x, l); }
+	template <typename T> static T min(T a, T b) { return std::min(a, b); }
+	template <typename T> static T max(T a, T b) { return std::max(a, b); }
+	template <typename T> static T range(T x, T l, T u) { return std::min(std::max(x, l), u); }
+	template <typename T> static T map(T x, T l, T u) { return l + x * (u - l); }
+	template <typename T> static T db2gain(T x) { return x > T(-100) ? std::pow(T(10), x * T(0.05)) : T(0); }
+	template <typename T> static T gain2db(T x) { return x > T(0) ? std::max(T(-100), T(20) * std::log10(x)) : T(-100); }
+};
+
+static MathFunctions Math;
+
+// The test files use main() as function name
+#define main snex_main
+
+)";
+
+using NativeFunction = double(*)(const double*, float*, int, double*);
+
+static juce::String getNativeTypeName(Types::ID type)
+{
+	return type == Types::ID::Block ? "block" : Types::Helpers::getTypeName(type);
+}
+
+/** Creates the exported function that calls the test function for each sample. */
+static juce::String createNativeEntryPoint(const FunctionData& f)
+{
+	juce::String c;
+
+	c << "\nSNEX_BENCHMARK_EXPORT double snex_benchmark_run(const double* args, float* data, int numSamples, double* lastResult)\n";
+	c << "{\n";
+	c << "\tdouble sum = 0.0;\n";
+
+	auto returnsValue = f.returnType != Types::ID::Block && f.returnType != Types::ID::Void;
+	auto isBlockFunction = f.args.size() == 1 && f.args[0].typeInfo.getType() == Types::ID::Block;
+
+	// Call the test function through a volatile pointer so that
+	// the native compiler can't inline it into the loop
+	c << "\tauto* volatile function = &" << f.id.toString() << ";\n";
+
+	juce::String call;
+	call << "function(";
+
+	for (int i = 0; i < f.args.size(); i++)
+	{
+		auto t = f.args[i].typeInfo.getType();
+
+		if (t == Types::ID::Block)
+			call << "b";
+		else
+			call << "(" << getNativeTypeName(t) << ")a" << juce::String(i);
+
+		if (i != f.args.size() - 1)
+			call << ", ";
+	}
+
+	call << ")";
+
+	if (isBlockFunction)
+	{
+		c << "\tblock b = { data, numSamples };\n";
+
+		if (returnsValue)
+			c << "\tsum = (double)" << call << ";\n";
+		else
+			c << "\t" << call << ";\n";
+
+		c << "\t*lastResult = sum;\n";
+	}
+	else
+	{
+		c << "\tfor (int i = 0; i < numSamples; i++)\n";
+		c << "\t{\n";
+
+		// Read the arguments from volatile variables so that the compiler
+		// can't move the function call out of the loop
+		for (int i = 0; i < f.args.size(); i++)
+			c << "\t\tvolatile double a" << juce::String(i) << " = args[" << juce::String(i) << "];\n";
+
+		c << "\t\t*lastResult = (double)" << call << ";\n";
+		c << "\t\tsum += *lastResult;\n";
+		c << "\t}\n";
+	}
+
+	c << "\treturn sum;\n";
+	c << "}\n";
+
+	return c;
+}
+
+static juce::String getSharedLibraryExtension()
+{
+#if JUCE_WINDOWS
+	return ".dll";
+#elif JUCE_MAC
+	return ".dylib";
+#else
+	return ".so";
+#endif
+}
+
+/** Returns the size of the functions in the shared library using nm or -1 if it's not available. */
+static int64 getNativeCodeSize(const File& library)
+{
+	ChildProcess nm;
+
+	StringArray args;
+	args.add("nm");
+	args.add("-S");
+	args.add("--defined-only");
+	args.add(library.getFullPathName());
+
+	if (!nm.start(args))
+		return -1;
+
+	auto output = nm.readAllProcessOutput();
+
+	if (nm.getExitCode() != 0)
+		return -1;
+
+	// These are added by the C runtime for every shared library
+	static const StringArray runtimeFunctions("_init", "_fini", "frame_dummy", "register_tm_clones",
+											  "deregister_tm_clones", "__do_global_dtors_aux");
+
+	int64 numBytes = 0;
+
+	for (auto l : StringArray::fromLines(output))
+	{
+		auto tokens = StringArray::fromTokens(l, " ", "");
+
+		if (tokens.size() != 4 || !tokens[2].equalsIgnoreCase("t"))
+			continue;
+
+		if (runtimeFunctions.contains(tokens[3]))
+			continue;
+
+		numBytes += tokens[1].getHexValue64();
+	}
+
+	return numBytes;
+}
+
+static double getNanoSecondsPerSample(int64 startTicks, int numSamples)
+{
+	auto seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+	return seconds * 1000000000.0 / (double)jmax(1, numSamples);
+}
+
+static void fillWithInput(AudioSampleBuffer& longBuffer, const AudioSampleBuffer& input)
+{
+	auto numInput = input.getNumSamples();
+
+	if (numInput == 0)
+		return;
+
+	for (int i = 0; i < longBuffer.getNumSamples(); i += numInput)
+	{
+		auto numToCopy = jmin(numInput, longBuffer.getNumSamples() - i);
+		longBuffer.copyFrom(0, i, input, 0, 0, numToCopy);
+	}
+}
+
+/** Calls the function repeatedly with the arguments converted once before the loop. */
+template <typename R, typename... Args> static void callRepeatedly(const FunctionData& f, int numCalls, VariableStorage& lastResult, Args... args)
+{
+	R r = R();
+
+	for (int i = 0; i < numCalls; i++)
+		r = f.call<R>(args...);
+
+	lastResult = VariableStorage(r);
+}
+
+template <typename R, typename A1> static void callWithSecondArgument(const FunctionData& f, const Array<VariableStorage>& inputs, int numCalls, VariableStorage& lastResult, A1 a1)
+{
+	switch (f.args[1].typeInfo.getType())
+	{
+	case Types::ID::Integer: callRepeatedly<R>(f, numCalls, lastResult, a1, inputs[1].toInt()); break;
+	case Types::ID::Float:   callRepeatedly<R>(f, numCalls, lastResult, a1, inputs[1].toFloat()); break;
+	case Types::ID::Double:  callRepeatedly<R>(f, numCalls, lastResult, a1, inputs[1].toDouble()); break;
+	default: jassertfalse;
+	}
+}
+
+template <typename R, typename A1> static void callWithFirstArgument(const FunctionData& f, const Array<VariableStorage>& inputs, int numCalls, VariableStorage& lastResult, A1 a1)
+{
+	if (f.args.size() == 1)
+		callRepeatedly<R>(f, numCalls, lastResult, a1);
+	else
+		callWithSecondArgument<R>(f, inputs, numCalls, lastResult, a1);
+}
+
+/** Calls a function with up to two scalar arguments (just like the JitFileTestCase). */
+template <typename R> static void callScalarFunction(const FunctionData& f, const Array<VariableStorage>& inputs, int numCalls, VariableStorage& lastResult)
+{
+	if (f.args.isEmpty())
+	{
+		callRepeatedly<R>(f, numCalls, lastResult);
+		return;
+	}
+
+	switch (f.args[0].typeInfo.getType())
+	{
+	case Types::ID::Integer: callWithFirstArgument<R>(f, inputs, numCalls, lastResult, inputs[0].toInt()); break;
+	case Types::ID::Float:   callWithFirstArgument<R>(f, inputs, numCalls, lastResult, inputs[0].toFloat()); break;
+	case Types::ID::Double:  callWithFirstArgument<R>(f, inputs, numCalls, lastResult, inputs[0].toDouble()); break;
+	default: jassertfalse;
+	}
+}
+
+static var createError(const juce::String& message)
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+	obj->setProperty("error", message);
+	return var(obj.get());
+}
+
+static bool isSameValue(double a, double b)
+{
+	// The stateful tests might overflow when they are called for every sample
+	auto tolerance = 0.0001 * jmax(1.0, std::abs(a), std::abs(b));
+	return a == b || std::abs(a - b) <= tolerance || (std::isnan(a) && std::isnan(b));
+}
+
+/** Returns an error message if the outputs of the JIT and the native function are not the same. */
+static juce::String compareOutputs(const var& jit, const var& native, const AudioSampleBuffer& jitOutput, const AudioSampleBuffer& nativeOutput)
+{
+	if (jit.hasProperty("result") != native.hasProperty("result"))
+		return "Only one function returns a value";
+
+	if (jit.hasProperty("result") && !isSameValue((double)jit["result"], (double)native["result"]))
+		return "Results don't match: " + jit["result"].toString() + " != " + native["result"].toString();
+
+	if (jitOutput.getNumSamples() != nativeOutput.getNumSamples())
+		return "Output sizes don't match";
+
+	for (int i = 0; i < jitOutput.getNumSamples(); i++)
+	{
+		auto a = (double)jitOutput.getSample(0, i);
+		auto b = (double)nativeOutput.getSample(0, i);
+
+		if (!isSameValue(a, b))
+			return "Output doesn't match at sample " + juce::String(i) + ": " + juce::String(a) + " != " + juce::String(b);
+	}
+
+	return {};
+}
+
+}
+
+TestFileBenchmark::TestFileBenchmark(const Settings& s) :
+	settings(s)
+{
+	buildDirectory = File::getSpecialLocation(File::tempDirectory).getChildFile("snex_benchmark");
+	buildDirectory.createDirectory();
+}
+
+var TestFileBenchmark::run()
+{
+	auto root = settings.testDirectory;
+
+	if (settings.subDirectory.isNotEmpty())
+		root = root.getChildFile(settings.subDirectory);
+
+	auto fileList = root.findChildFiles(File::findFiles, true, "*.h");
+	fileList.sort();
+
+	Array<var> results;
+
+	for (auto f : fileList)
+		results.add(benchmarkFile(f));
+
+	Array<var> optimizations;
+
+	for (auto o : settings.optimizations)
+		optimizations.add(o.toString());
+
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("numSamples", settings.numSamples);
+	obj->setProperty("optimizations", var(optimizations));
+	obj->setProperty("nativeCompiler", (settings.nativeCompiler + " " + settings.nativeFlags.joinIntoString(" ")).trim());
+	obj->setProperty("results", var(results));
+
+	return var(obj.get());
+}
+
+var TestFileBenchmark::benchmarkFile(const File& f)
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("file", f.getRelativePathFrom(settings.testDirectory).replaceCharacter('\\', '/'));
+
+	AudioSampleBuffer jitOutput, nativeOutput;
+
+	auto jit = benchmarkJit(f, jitOutput);
+	obj->setProperty("jit", jit);
+
+	if (jit.hasProperty("error") || settings.nativeCompiler.isEmpty())
+		return var(obj.get());
+
+	auto native = benchmarkNative(f, nativeOutput);
+	obj->setProperty("native", native);
+
+	if (native.hasProperty("error"))
+		return var(obj.get());
+
+	auto mismatch = BenchmarkHelpers::compareOutputs(jit, native, jitOutput, nativeOutput);
+
+	if (mismatch.isNotEmpty())
+	{
+		// Timings of functions that compute different things can't be compared
+		jit.getDynamicObject()->removeProperty("nsPerSample");
+		native.getDynamicObject()->removeProperty("nsPerSample");
+		obj->setProperty("error", mismatch);
+		return var(obj.get());
+	}
+
+	auto jitTime = (double)jit["nsPerSample"];
+	auto nativeTime = (double)native["nsPerSample"];
+
+	if (nativeTime > 0.0)
+		obj->setProperty("jitToNativeRatio", jitTime / nativeTime);
+
+	return var(obj.get());
+}
+
+var TestFileBenchmark::benchmarkJit(const File& f, AudioSampleBuffer& output)
+{
+	GlobalScope memory;
+
+	for (auto o : settings.optimizations)
+		memory.addOptimization(o);
+
+	JitFileTestCase t(nullptr, memory, f);
+
+	if (t.r.failed())
+		return BenchmarkHelpers::createError(t.r.getErrorMessage());
+
+	if (t.expectedFail.isNotEmpty())
+		return BenchmarkHelpers::createError("Test expects a compile error");
+
+	Compiler c(memory);
+	SnexObjectDatabase::registerObjects(c);
+
+	auto start = Time::getMillisecondCounterHiRes();
+	auto obj = c.compileJitObject(t.code);
+	auto compileTime = Time::getMillisecondCounterHiRes() - start;
+
+	if (!c.getCompileResult().wasOk())
+		return BenchmarkHelpers::createError(c.getCompileResult().getErrorMessage());
+
+	auto compiledF = obj[t.function.id];
+
+	if (!compiledF.matchesArgumentTypes(t.function))
+		return BenchmarkHelpers::createError("Compiled function doesn't match test data");
+
+	t.function = compiledF;
+
+	auto numSamples = settings.numSamples;
+	auto isBlockFunction = t.function.args.size() == 1 && t.function.args[0].typeInfo.getType() == Types::ID::Block;
+
+	AudioSampleBuffer longBuffer;
+
+	if (isBlockFunction)
+	{
+		longBuffer.setSize(1, numSamples);
+		BenchmarkHelpers::fillWithInput(longBuffer, t.inputBuffers.getLast());
+		t.inputs.set(0, block(longBuffer.getWritePointer(0), numSamples));
+	}
+
+	auto numCalls = isBlockFunction ? 1 : numSamples;
+
+	VariableStorage lastResult;
+	auto startTicks = Time::getHighResolutionTicks();
+
+	if (isBlockFunction)
+	{
+		switch (t.function.returnType.getType())
+		{
+		case Types::ID::Integer: lastResult = t.call<int>(); break;
+		case Types::ID::Float:   lastResult = t.call<float>(); break;
+		case Types::ID::Double:  lastResult = t.call<double>(); break;
+		case Types::ID::Block:   t.call<block>(); break;
+		default: jassertfalse;
+		}
+	}
+	else
+	{
+		switch (t.function.returnType.getType())
+		{
+		case Types::ID::Integer: BenchmarkHelpers::callScalarFunction<int>(t.function, t.inputs, numCalls, lastResult); break;
+		case Types::ID::Float:   BenchmarkHelpers::callScalarFunction<float>(t.function, t.inputs, numCalls, lastResult); break;
+		case Types::ID::Double:  BenchmarkHelpers::callScalarFunction<double>(t.function, t.inputs, numCalls, lastResult); break;
+		default: jassertfalse;
+		}
+	}
+
+	auto nsPerSample = BenchmarkHelpers::getNanoSecondsPerSample(startTicks, numSamples);
+
+	if (isBlockFunction)
+		output.makeCopyOf(longBuffer);
+
+	DynamicObject::Ptr result = new DynamicObject();
+
+	result->setProperty("compileTimeMs", compileTime);
+	result->setProperty("codeBytes", (int64)c.getCompiledCodeSize());
+	result->setProperty("nsPerSample", nsPerSample);
+
+	if (t.function.returnType != Types::ID::Block && t.function.returnType != Types::ID::Void)
+		result->setProperty("result", lastResult.toDouble());
+
+	return var(result.get());
+}
+
+var TestFileBenchmark::benchmarkNative(const File& f, AudioSampleBuffer& output)
+{
+	GlobalScope memory;
+	JitFileTestCase t(nullptr, memory, f);
+
+	auto name = f.getRelativePathFrom(settings.testDirectory).replaceCharacter('\\', '_').replaceCharacter('/', '_').replaceCharacter(' ', '_');
+	auto sourceFile = buildDirectory.getChildFile(name).withFileExtension("cpp");
+	auto libraryFile = buildDirectory.getChildFile(name).withFileExtension(BenchmarkHelpers::getSharedLibraryExtension());
+
+	juce::String code;
+	code << BenchmarkHelpers::nativeHeader;
+	code << "#line 1 \"" << f.getFileName() << "\"\n";
+	code << t.code << "\n";
+	code << BenchmarkHelpers::createNativeEntryPoint(t.function);
+
+	sourceFile.replaceWithText(code);
+	libraryFile.deleteFile();
+
+	StringArray args;
+	args.add(settings.nativeCompiler);
+	args.addArray(settings.nativeFlags);
+	args.add("-o");
+	args.add(libraryFile.getFullPathName());
+	args.add(sourceFile.getFullPathName());
+
+	ChildProcess cp;
+
+	auto start = Time::getMillisecondCounterHiRes();
+
+	if (!cp.start(args))
+		return BenchmarkHelpers::createError("Can't start " + settings.nativeCompiler);
+
+	auto compilerOutput = cp.readAllProcessOutput();
+	auto compileTime = Time::getMillisecondCounterHiRes() - start;
+
+	if (cp.getExitCode() != 0 || !libraryFile.existsAsFile())
+	{
+		auto firstError = StringArray::fromLines(compilerOutput)[0];
+		return BenchmarkHelpers::createError("C++ compile error: " + firstError);
+	}
+
+	DynamicLibrary lib;
+
+	if (!lib.open(libraryFile.getFullPathName()))
+		return BenchmarkHelpers::createError("Can't open " + libraryFile.getFileName());
+
+	auto nf = (BenchmarkHelpers::NativeFunction)lib.getFunction("snex_benchmark_run");
+
+	if (nf == nullptr)
+		return BenchmarkHelpers::createError("Can't find the entry point");
+
+	double args_[2] = { 0.0, 0.0 };
+
+	for (int i = 0; i < jmin(2, t.inputs.size()); i++)
+	{
+		if (t.inputs[i].getType() != Types::ID::Block)
+			args_[i] = t.inputs[i].toDouble();
+	}
+
+	auto numSamples = settings.numSamples;
+	auto isBlockFunction = t.function.args.size() == 1 && t.function.args[0].typeInfo.getType() == Types::ID::Block;
+
+	AudioSampleBuffer longBuffer(1, numSamples);
+	longBuffer.clear();
+
+	if (isBlockFunction)
+		BenchmarkHelpers::fillWithInput(longBuffer, t.inputBuffers.getLast());
+
+	double lastResult = 0.0;
+	auto startTicks = Time::getHighResolutionTicks();
+
+	nf(args_, longBuffer.getWritePointer(0), numSamples, &lastResult);
+
+	auto nsPerSample = BenchmarkHelpers::getNanoSecondsPerSample(startTicks, numSamples);
+
+	if (isBlockFunction)
+		output.makeCopyOf(longBuffer);
+
+	DynamicObject::Ptr result = new DynamicObject();
+
+	result->setProperty("compileTimeMs", compileTime);
+	result->setProperty("codeBytes", BenchmarkHelpers::getNativeCodeSize(libraryFile));
+	result->setProperty("nsPerSample", nsPerSample);
+
+	if (t.function.returnType != Types::ID::Block && t.function.returnType != Types::ID::Void)
+		result->setProperty("result", lastResult);
+
+	return var(result.get());
+}
+
+int TestFileBenchmark::runFromCommandLine(const juce::String& commandLine)
+{
+	auto args = StringArray::fromTokens(commandLine, true);
+
+	auto getArgument = [&args](const juce::String& name)
+	{
+		for (auto a : args)
+		{
+			if (a.startsWith(name + "="))
+				return a.fromFirstOccurrenceOf("=", false, false).unquoted();
+		}
+
+		return juce::String();
+	};
+
+	Settings s;
+
+	auto testFiles = getArgument("--test-files");
+
+	if (testFiles.isNotEmpty())
+		s.testDirectory = File::getCurrentWorkingDirectory().getChildFile(testFiles);
+	else
+		s.testDirectory = JitFileTestCase::getTestFileDirectory();
+
+	if (!s.testDirectory.isDirectory())
+	{
+		std::cerr << "Can't find the test file directory. Use --test-files=PATH" << std::endl;
+		return 1;
+	}
+
+	JitFileTestCase::getCustomTestFileDirectory() = s.testDirectory;
+
+	s.subDirectory = getArgument("--folder");
+
+	auto numSamples = getArgument("--samples").getIntValue();
+
+	if (numSamples > 0)
+		s.numSamples = numSamples;
+
+	if (args.contains("--compiler=") || args.contains("--compiler=\"\""))
+		s.nativeCompiler = {};
+	else if (getArgument("--compiler").isNotEmpty())
+		s.nativeCompiler = getArgument("--compiler");
+
+	if (!args.contains("--no-optimizations"))
+	{
+		s.optimizations = { OptimizationIds::ConstantFolding, OptimizationIds::BinaryOpOptimisation, 
+							OptimizationIds::Inlining, OptimizationIds::LoopInvariantCodeMotion, 
+							OptimizationIds::StrengthReduction, OptimizationIds::LoopUnrolling, 
+							OptimizationIds::LoopVectorisation };
+	}
+
+	TestFileBenchmark b(s);
+	auto json = JSON::toString(b.run());
+
+	auto output = getArgument("--output");
+
+	if (output.isNotEmpty())
+		File::getCurrentWorkingDirectory().getChildFile(output).replaceWithText(json);
+	else
+		std::cout << json << std::endl;
+
+	return 0;
+}
+
+}
+}
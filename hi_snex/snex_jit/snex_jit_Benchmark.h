@@ -0,0 +1,118 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#pragma once
+
+namespace snex {
+namespace jit {
+using namespace juce;
+
+/** A headless benchmark that runs the SNEX test files through the JIT compiler and the system C++ compiler.
+
+	Every test file is compiled with the JIT compiler and (together with a small header that
+	mimics the SNEX types and the Math API) as shared library with the native compiler. Both
+	functions are then called with the input from the test data for the given amount of samples.
+	The native function is called through a volatile function pointer, so just like the JIT
+	function it can't be inlined into the benchmark loop. Functions that process a block are
+	called once with the whole buffer.
+
+	The timings are only reported if both builds produce the same output (the return value of
+	the last call and the processed buffer). Otherwise the file is reported with an error.
+
+	The result is a JSON object that contains the compile time, the machine code size and the
+	time per sample for each test file so that it can be compared between different builds.
+
+	Test files that are expected to fail or that can't be compiled as C++ code will be reported
+	with the error message.
+*/
+class TestFileBenchmark
+{
+public:
+
+	struct Settings
+	{
+		/** The root directory of the test files. */
+		File testDirectory;
+
+		/** If not empty, only the files in this subdirectory will be benchmarked. */
+		juce::String subDirectory;
+
+		/** The optimizations that are used for the JIT compiler. */
+		Array<Identifier> optimizations;
+
+		/** The amount of samples that are processed with each function. */
+		int numSamples = 441000;
+
+		/** The command that is used to invoke the C++ compiler. Leave it empty to skip the native tests. */
+		juce::String nativeCompiler = "c++";
+
+		/** The flags that are used to build the shared library. */
+		StringArray nativeFlags = { "-O3", "-std=c++14", "-shared", "-fPIC" };
+	};
+
+	TestFileBenchmark(const Settings& s);
+
+	/** Benchmarks all test files and returns the result as JSON object. */
+	var run();
+
+	/** Parses the command line arguments and writes the JSON result to the file or standard output.
+
+		Supported arguments are:
+
+		--test-files=PATH   the test file directory
+		--folder=NAME       only run the tests in this subdirectory
+		--output=FILE       writes the JSON to this file instead of the console
+		--samples=NUM       the amount of samples per test
+		--compiler=CMD      the C++ compiler command (pass an empty string to skip the native tests)
+		--no-optimizations  runs the JIT compiler without optimizations
+
+		Returns the exit code for the application.
+	*/
+	static int runFromCommandLine(const juce::String& commandLine);
+
+private:
+
+	var benchmarkFile(const File& f);
+
+	var benchmarkJit(const File& f, AudioSampleBuffer& output);
+
+	var benchmarkNative(const File& f, AudioSampleBuffer& output);
+
+	Settings settings;
+	File buildDirectory;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TestFileBenchmark);
+};
+
+}
+}
@@ -54,7 +54,9 @@ void AsmCodeGenerator::emitComment(const char* m)
 
 void AsmCodeGenerator::emitStore(RegPtr target, RegPtr value)
 {
-	if (target->hasCustomMemoryLocation())
+	// If the memory was loaded into a register, we write to the register and
+	// let the dirty register be written back at the end of the function
+	if (target->hasCustomMemoryLocation() && !target->isActiveOrDirtyGlobalRegister())
 	{
 		if (target->shouldLoadMemoryIntoRegister())
 		{
@@ -607,7 +609,20 @@ void AsmCodeGenerator::emitSpanReference(RegPtr target, RegPtr address, RegPtr i
 			auto ptr = address->getAsMemoryLocation();
 
 			if (index->isMemoryLocation())
-				p = ptr.cloneAdjusted(imm2ptr(INT_IMM(index) * elementSizeInBytes));
+			{
+				auto offset = INT_IMM(index) * elementSizeInBytes;
+
+				if (ptr.hasBaseReg())
+					p = ptr.cloneAdjusted(imm2ptr(offset));
+				else
+				{
+					// Only mov can use a 64bit absolute address, so we need a base register
+					// for everything else (eg. movss).
+					auto b_ = cc.newGpq();
+					cc.mov(b_, (int64_t)(ptr.offset() + offset));
+					p = x86::ptr(b_);
+				}
+			}
 			else
 			{
 				// for some reason uint64_t base + index reg doesn't create a 64bit address...
@@ -1463,6 +1478,248 @@ asmjit::X86Mem AsmCodeGenerator::createStack(Types::ID t)
 	return st;
 }
 
+/** Emits the body of a loop that was flagged by the LoopVectoriser with packed instructions.
+
+	All subexpressions that do not depend on the iterator are evaluated once before the
+	loop and broadcasted to all four lanes.
+*/
+struct PackedLoopBodyEmitter
+{
+	using OpType = AsmCodeGenerator::OpType;
+
+	PackedLoopBodyEmitter(X86Compiler& cc_, BaseCompiler* compiler_, const Symbol& iterator_) :
+		cc(cc_),
+		compiler(compiler_),
+		iterator(iterator_)
+	{}
+
+	/** Checks that every variable in the loop invariant parts of the expression can be read before the loop. */
+	bool canHoistInvariants(Operations::Expression* e) const
+	{
+		if (!dependsOnIterator(e))
+			return canBeReadBeforeLoop(e);
+
+		for (int i = 0; i < e->getNumChildStatements(); i++)
+		{
+			if (!canHoistInvariants(e->getSubExpr(i).get()))
+				return false;
+		}
+
+		return true;
+	}
+
+	void prepareInvariants(Operations::Expression* e)
+	{
+		if (!dependsOnIterator(e))
+		{
+			invariants.add({ e, emitInvariant(e) });
+			return;
+		}
+
+		for (int i = 0; i < e->getNumChildStatements(); i++)
+			prepareInvariants(e->getSubExpr(i).get());
+	}
+
+	void emitAssignment(Operations::Assignment* a, X86Xmm it)
+	{
+		iteratorRegister = it;
+
+		auto value = emitExpression(a->getSubExpr(0).get());
+		emitPackedOp(a->assignmentType, it, value);
+	}
+
+private:
+
+	bool dependsOnIterator(Operations::Statement* s) const
+	{
+		if (auto v = dynamic_cast<Operations::VariableReference*>(s))
+			return v->id == iterator;
+
+		for (int i = 0; i < s->getNumChildStatements(); i++)
+		{
+			if (dependsOnIterator(s->getChildStatement(i).get()))
+				return true;
+		}
+
+		return false;
+	}
+
+	bool canBeReadBeforeLoop(Operations::Statement* s) const
+	{
+		if (auto v = dynamic_cast<Operations::VariableReference*>(s))
+		{
+			// Don't create a register here, a variable without one has no value we could read
+			auto reg = compiler->registerPool.getExistingRegisterForVariable(v->variableScope, v->id);
+
+			if (reg == nullptr)
+				return false;
+
+			return reg->isActiveOrDirtyGlobalRegister() || reg->isMemoryLocation() || reg->canBeLoadedFromMemory();
+		}
+
+		for (int i = 0; i < s->getNumChildStatements(); i++)
+		{
+			if (!canBeReadBeforeLoop(s->getChildStatement(i).get()))
+				return false;
+		}
+
+		return true;
+	}
+
+	X86Xmm emitInvariant(Operations::Expression* e)
+	{
+		if (e->isConstExpr())
+		{
+			auto x = cc.newXmmPs();
+			cc.movaps(x, cc.newXmmConst(ConstPool::kScopeLocal, Data128::fromF32(e->getConstExprValue().toFloat())));
+			return x;
+		}
+
+		if (auto v = dynamic_cast<Operations::VariableReference*>(e))
+		{
+			auto reg = compiler->registerPool.getExistingRegisterForVariable(v->variableScope, v->id);
+			auto x = cc.newXmmPs();
+
+			// canHoistInvariants() must have rejected everything else
+			jassert(reg != nullptr);
+
+			if (!reg->isActiveOrDirtyGlobalRegister() && !reg->isMemoryLocation())
+				reg->loadMemoryIntoRegister(cc, true);
+
+			if (reg->isMemoryLocation())
+				cc.movss(x, reg->getAsMemoryLocation());
+			else
+				cc.movss(x, FP_REG_R(reg));
+
+			cc.shufps(x, x, 0);
+			return x;
+		}
+
+		return emitOperation(e, [this](Operations::Expression* c) { return emitInvariant(c); });
+	}
+
+	X86Xmm emitExpression(Operations::Expression* e)
+	{
+		for (const auto& i : invariants)
+		{
+			if (i.first == e)
+				return i.second;
+		}
+
+		// the only variable that is not loop invariant is the iterator
+		if (dynamic_cast<Operations::VariableReference*>(e) != nullptr)
+			return iteratorRegister;
+
+		return emitOperation(e, [this](Operations::Expression* c) { return emitExpression(c); });
+	}
+
+	/** Returns a register that can be overwritten with the result of an operation on x. */
+	X86Xmm getTemporaryRegister(const X86Xmm& x)
+	{
+		bool isPreserved = x.id() == iteratorRegister.id();
+
+		for (const auto& i : invariants)
+			isPreserved |= x.id() == i.second.id();
+
+		if (!isPreserved)
+			return x;
+
+		auto t = cc.newXmmPs();
+		cc.movaps(t, x);
+		return t;
+	}
+
+	template <typename ChildFunction> X86Xmm emitOperation(Operations::Expression* e, const ChildFunction& emitChild)
+	{
+		if (auto n = dynamic_cast<Operations::Negation*>(e))
+		{
+			auto x = getTemporaryRegister(emitChild(n->getSubExpr(0).get()));
+			cc.xorps(x, cc.newXmmConst(ConstPool::kScopeLocal, Data128::fromU32(0x80000000)));
+			return x;
+		}
+
+		auto bOp = dynamic_cast<Operations::BinaryOp*>(e);
+		jassert(bOp != nullptr);
+
+		auto x = getTemporaryRegister(emitChild(bOp->getSubExpr(0).get()));
+		auto r = emitChild(bOp->getSubExpr(1).get());
+
+		emitPackedOp(bOp->op, x, r);
+		return x;
+	}
+
+	void emitPackedOp(OpType op, X86Xmm target, X86Xmm value)
+	{
+		if (op == JitTokens::assign_) cc.movaps(target, value);
+		if (op == JitTokens::plus)	  cc.addps(target, value);
+		if (op == JitTokens::minus)	  cc.subps(target, value);
+		if (op == JitTokens::times)	  cc.mulps(target, value);
+		if (op == JitTokens::divide)  cc.divps(target, value);
+	}
+
+	X86Compiler& cc;
+	BaseCompiler* compiler;
+	Symbol iterator;
+	X86Xmm iteratorRegister;
+	Array<std::pair<Operations::Expression*, X86Xmm>> invariants;
+};
+
+bool AsmCodeGenerator::LoopEmitterBase::emitVectorisedLoop(AsmCodeGenerator& gen, BaseCompiler* compiler, X86Gp beg, X86Gp end)
+{
+	auto& cc = gen.cc;
+
+	PackedLoopBodyEmitter body(cc, compiler, iterator);
+	Array<Operations::Assignment*> assignments;
+
+	for (int i = 0; i < loopBody->getNumChildStatements(); i++)
+	{
+		if (auto a = dynamic_cast<Operations::Assignment*>(loopBody->getChildStatement(i).get()))
+		{
+			if (!body.canHoistInvariants(a->getSubExpr(0).get()))
+				return false;
+
+			assignments.add(a);
+		}
+	}
+
+	for (auto a : assignments)
+		body.prepareInvariants(a->getSubExpr(0).get());
+
+	static constexpr int64_t packedSize = 4 * sizeof(float);
+
+	auto vecEnd = cc.newIntPtr();
+	cc.mov(vecEnd, end);
+	cc.sub(vecEnd, beg);
+	cc.and_(vecEnd, ~(packedSize - 1));
+	cc.add(vecEnd, beg);
+
+	auto vecStart = cc.newLabel();
+	auto vecSkip = cc.newLabel();
+
+	cc.cmp(beg, vecEnd);
+	cc.je(vecSkip);
+
+	auto it = cc.newXmmPs();
+
+	cc.setInlineComment("loop_simd {");
+	cc.bind(vecStart);
+
+	if (loadIterator)
+		cc.movups(it, x86::ptr(beg));
+
+	for (auto a : assignments)
+		body.emitAssignment(a, it);
+
+	cc.movups(x86::ptr(beg), it);
+	cc.add(beg, packedSize);
+	cc.cmp(beg, vecEnd);
+	cc.setInlineComment("loop_simd }");
+	cc.jne(vecStart);
+	cc.bind(vecSkip);
+
+	return true;
+}
+
 void SpanLoopEmitter::emitLoop(AsmCodeGenerator& gen, BaseCompiler* compiler, BaseScope* scope)
 {
 	jassert(loopTarget->getType() == Types::ID::Pointer);
@@ -1495,6 +1752,12 @@ void SpanLoopEmitter::emitLoop(AsmCodeGenerator& gen, BaseCompiler* compiler, Ba
 	itReg->createRegister(cc);
 	itReg->setIsIteratorRegister(true);
 
+	if (vectorise && emitVectorisedLoop(gen, compiler, PTR_REG_W(loopTarget), end.get()))
+	{
+		cc.cmp(INT_REG_R(loopTarget), end.get());
+		cc.je(loopEnd);
+	}
+
 	cc.setInlineComment("loop_span {");
 	cc.bind(loopStart);
 
@@ -1579,6 +1842,12 @@ void BlockLoopEmitter::emitLoop(AsmCodeGenerator& gen, BaseCompiler* compiler, B
 	itReg->createRegister(cc);
 	itReg->setIsIteratorRegister(true);
 
+	if (vectorise && emitVectorisedLoop(gen, compiler, beg.get(), end.get()))
+	{
+		cc.cmp(beg.get(), end.get());
+		cc.je(loopEnd);
+	}
+
 	cc.setInlineComment("loop_block {");
 	cc.bind(loopStart);
 
@@ -1649,6 +1918,12 @@ void DynLoopEmitter::emitLoop(AsmCodeGenerator& gen, BaseCompiler* compiler, Bas
 	itReg->createRegister(cc);
 	itReg->setIsIteratorRegister(true);
 
+	if (vectorise && emitVectorisedLoop(gen, compiler, beg.get(), end.get()))
+	{
+		cc.cmp(beg.get(), end.get());
+		cc.je(loopEnd);
+	}
+
 	cc.setInlineComment("loop_span {");
 	cc.bind(loopStart);
 
@@ -43,7 +43,7 @@ using namespace asmjit;
 #define FP_MEM(x) x->getAsMemoryLocation()
 #define IS_MEM(x) x->isMemoryLocation()
 #define IS_CMEM(x) x->hasCustomMemoryLocation()
-#define IS_REG(x)  x->isActive()
+#define IS_REG(x)  x->isActiveOrDirtyGlobalRegister()
 
 
 #define INT_REG_W(x) x->getRegisterForWriteOp().as<X86Gp>()
@@ -108,8 +108,22 @@ struct AsmCodeGenerator
 			return getContinue ? continuePoint : loopEnd;
 		}
 
+		/** If this is true, the first (size & ~3) elements will be processed by a packed loop
+			and the loop body will only be used for the remaining elements.
+
+			The loop body must have been checked by the LoopVectoriser. */
+		bool vectorise = false;
+
 	protected:
 
+		/** Emits the packed loop over [beg, end) and advances beg to the first element that
+			still needs to be processed by the scalar loop.
+
+			Returns false without emitting anything if a loop invariant can't be read before
+			the loop. The scalar loop will then process all elements.
+		*/
+		bool emitVectorisedLoop(AsmCodeGenerator& gen, BaseCompiler* compiler, X86Gp beg, X86Gp end);
+
 		asmjit::Label continuePoint;
 		asmjit::Label loopEnd;
 
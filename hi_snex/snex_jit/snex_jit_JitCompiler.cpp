@@ -54,6 +54,11 @@ juce::String Compiler::getAssemblyCode()
 	return compiler->assembly;
 }
 
+size_t Compiler::getCompiledCodeSize() const
+{
+	return compiler->codeSize;
+}
+
 
 
 juce::String Compiler::dumpSyntaxTree() const
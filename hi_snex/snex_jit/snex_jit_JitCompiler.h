@@ -130,6 +130,9 @@ public:
 	Result getCompileResult();
 
 	juce::String getAssemblyCode();
+
+	/** Returns the size of the machine code of all compiled functions in bytes. */
+	size_t getCompiledCodeSize() const;
 	juce::String dumpSyntaxTree() const;
 	juce::String dumpNamespaceTree() const;
 	juce::String getLastCompiledCode() { return lastCode; }
@@ -253,6 +253,8 @@ void Operations::Function::process(BaseCompiler* compiler, BaseScope* scope)
 		ignoreUnused(success);
 		jassert(success);
 
+		dynamic_cast<ClassCompiler*>(compiler)->codeSize += ch->codeSize();
+
 		auto& as = dynamic_cast<ClassCompiler*>(compiler)->assembly;
 
 		as << "; function " << data.getSignature() << "\n";
@@ -487,6 +489,17 @@ void Operations::VariableReference::process(BaseCompiler* compiler, BaseScope* s
 				{
 					if (auto pf = dynamic_cast<Function*>(fs->parentFunction))
 					{
+						// Use the same register for all accesses to a member so that
+						// it doesn't get loaded from the object every time
+						if (auto existing = compiler->registerPool.getExistingRegisterForVariable(scope, id))
+						{
+							if (existing->canBeReused())
+								existing->removeReuseFlag();
+
+							reg = existing;
+							return;
+						}
+
 						reg = compiler->registerPool.getNextFreeRegister(scope, getTypeInfo());
 						reg->setReference(scope, id);
 						auto acg = CREATE_ASM_COMPILER(getType());
@@ -1157,6 +1170,9 @@ void Operations::FunctionCall::process(BaseCompiler* compiler, BaseScope* scope)
 			}
 		}
 
+		// The breakpoint function doesn't write back the dirty registers, so they must not be reloaded
+		bool reloadMemoryRegisters = false;
+
 		if (function.id.toString() == "stop")
 		{
 			asg.dumpVariables(scope, location.getLine());
@@ -1166,6 +1182,8 @@ void Operations::FunctionCall::process(BaseCompiler* compiler, BaseScope* scope)
 		}
 		else
 		{
+			reloadMemoryRegisters = true;
+
 			for (auto dv : compiler->registerPool.getListOfAllDirtyGlobals())
 			{
 				auto asg = CREATE_ASM_COMPILER(dv->getType());
@@ -1222,6 +1240,22 @@ void Operations::FunctionCall::process(BaseCompiler* compiler, BaseScope* scope)
 			if (!function.args[i].isReference())
 				parameterRegs[i]->flagForReuse();
 		}
+
+		// The function might have changed any value in memory (not only the ones that
+		// we've written back), so we need to reload all registers that are kept alive
+		if (reloadMemoryRegisters)
+		{
+			for (auto mr : compiler->registerPool.getListOfAllRegistersWithMemory())
+			{
+				auto t = mr->getType();
+
+				if (mr != reg.get() && mr->isActiveOrDirtyGlobalRegister() && (t == Types::ID::Float || t == Types::ID::Double || t == Types::ID::Integer))
+				{
+					auto acg = CREATE_ASM_COMPILER(t);
+					mr->loadMemoryIntoRegister(acg.cc, true);
+				}
+			}
+		}
 	}
 }
 
@@ -577,6 +577,12 @@ struct Operations::VariableReference : public Expression,
 		return scope->getRootClassScope()->rootData->contains(id.id);
 	}
 
+	/** Checks whether the variable is a member of the object that the function is called on. */
+	bool isThisMember() const
+	{
+		return objectExpression == nullptr && objectAdress.getType() == Types::ID::Integer;
+	}
+
     bool isFirstReference()
 	{
 		SyntaxTreeWalker walker(this);
@@ -1075,6 +1081,12 @@ struct Operations::FunctionCall : public Expression
 			newFC->setObjectExpression(dynamic_cast<Expression*>(clonedObject.get()));
 		}
 
+		for (int i = objExpr != nullptr ? 1 : 0; i < getNumChildStatements(); i++)
+		{
+			auto clonedArgument = getChildStatement(i)->clone(l);
+			newFC->addArgument(dynamic_cast<Expression*>(clonedArgument.get()));
+		}
+
 		return newFC;
 	}
 
@@ -1730,6 +1742,7 @@ struct Operations::Loop : public Expression,
 		static const StringArray loopTypes = { "Undefined", "Span", "Block", "CustomObject" };
 		t.setProperty("LoopType", loopTypes[loopTargetType], nullptr);
 		t.setProperty("LoadIterator", loadIterator, nullptr);
+		t.setProperty("Vectorise", vectorise, nullptr);
 		t.setProperty("Iterator", iterator.toString(), nullptr);
 		
 		return t;
@@ -1882,8 +1895,11 @@ struct Operations::Loop : public Expression,
 				loopEmitter = le;
 			}
 
-			if(loopEmitter != nullptr)
+			if (loopEmitter != nullptr)
+			{
+				loopEmitter->vectorise = vectorise;
 				loopEmitter->emitLoop(acg, compiler, scope);
+			}
 		}
 	}
 
@@ -1892,6 +1908,9 @@ struct Operations::Loop : public Expression,
 	
 	bool loadIterator = true;
 
+	/** Set by the LoopVectoriser if the body can be emitted with packed instructions. */
+	bool vectorise = false;
+
 	LoopTargetType loopTargetType;
 
 	asmjit::Label loopStart;
@@ -397,6 +397,16 @@ void Operations::Statement::addStatement(Statement* b, bool addFirst/*=false*/)
 	b->setParent(this);
 }
 
+void Operations::Statement::addStatementBefore(Statement* b, Statement* existingChild)
+{
+	auto index = childStatements.indexOf(existingChild);
+
+	jassert(index != -1);
+
+	childStatements.insert(index, b);
+	b->setParent(this);
+}
+
 Operations::Statement::Ptr Operations::Statement::replaceInParent(Statement::Ptr newExpression)
 {
 	if (parent != nullptr)
@@ -452,6 +462,12 @@ void Operations::Statement::logMessage(BaseCompiler* compiler, BaseCompiler::Mes
 	compiler->logMessage(type, m);
 }
 
+static bool isPrimitiveMember(Operations::VariableReference* v)
+{
+	auto t = v->getType();
+	return !v->id.isReference() && (t == Types::ID::Float || t == Types::ID::Double || t == Types::ID::Integer);
+}
+
 void Operations::ConditionalBranch::allocateDirtyGlobalVariables(Statement::Ptr statementToSearchFor, BaseCompiler* c, BaseScope* s)
 {
 	SyntaxTreeWalker w(statementToSearchFor, false);
@@ -462,6 +478,40 @@ void Operations::ConditionalBranch::allocateDirtyGlobalVariables(Statement::Ptr
 		// outside the loop
 		if (v->isClassVariable(s) && v->isFirstReference())
 			v->process(c, s);
+
+		// Members of the object are loaded into a register before the loop
+		// and kept there until they are written back at the end of the function
+		else if (v->isThisMember() && isPrimitiveMember(v))
+		{
+			if (v->reg == nullptr)
+				v->process(c, s);
+
+			if (v->reg != nullptr && v->reg->hasCustomMemoryLocation())
+			{
+				AsmCodeGenerator acg(getFunctionCompiler(c), &c->registerPool, v->getType());
+				v->reg->loadMemoryIntoRegister(acg.cc);
+			}
+		}
+	}
+
+	SyntaxTreeWalker dw(statementToSearchFor, false);
+
+	// Same thing for members of class objects (eg. from inlined member functions)
+	while (auto dot = dw.getNextStatementOfType<DotOperator>())
+	{
+		auto objectRef = dynamic_cast<VariableReference*>(dot->getDotParent().get());
+		auto memberRef = dynamic_cast<VariableReference*>(dot->getDotChild().get());
+
+		if (objectRef != nullptr && memberRef != nullptr && objectRef->isClassVariable(s) && isPrimitiveMember(memberRef))
+		{
+			dot->process(c, s);
+
+			if (dot->reg != nullptr && dot->reg->hasCustomMemoryLocation())
+			{
+				AsmCodeGenerator acg(getFunctionCompiler(c), &c->registerPool, dot->getType());
+				dot->reg->loadMemoryIntoRegister(acg.cc);
+			}
+		}
 	}
 }
 
@@ -227,6 +227,9 @@ public:
 
 		void addStatement(Statement* b, bool addFirst=false);
 
+		/** Inserts the statement before the given child statement. */
+		void addStatementBefore(Statement* b, Statement* existingChild);
+
 		Ptr replaceInParent(Ptr newExpression);
 		Ptr replaceChildStatement(int index, Ptr newExpr);
 
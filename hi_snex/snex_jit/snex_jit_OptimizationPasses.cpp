@@ -42,6 +42,33 @@ void OptimizationPass::replaceWithNoop(StatementPtr s)
 	replaceExpression(s, new Operations::Noop(s->location));
 }
 
+void OptimizationPass::processNewStatement(BaseCompiler* compiler, BaseScope* s, StatementPtr newStatement)
+{
+	for (auto p : { BaseCompiler::DataAllocation, BaseCompiler::DataInitialisation,
+					BaseCompiler::ResolvingSymbols, BaseCompiler::TypeCheck })
+	{
+		BaseCompiler::ScopedPassSwitcher sps(compiler, p);
+		newStatement->process(compiler, s);
+	}
+}
+
+bool OptimizationPass::isMathFunctionCall(Operations::FunctionCall* fc)
+{
+	if (fc->callType != Operations::FunctionCall::ApiFunction)
+		return false;
+
+	auto classId = fc->function.id.getParent();
+
+	if (auto obj = dynamic_cast<Operations::VariableReference*>(fc->objExpr.get()))
+		classId = obj->id.id;
+
+	if (!(classId == NamespacedIdentifier("Math")))
+		return false;
+
+	// Don't treat the random function as pure...
+	return !fc->function.id.toString().contains("rand");
+}
+
 struct VOps
 {
 #define VAR_OP(name, opChar) static VariableStorage name(VariableStorage l, VariableStorage r) { return VariableStorage(l.getType(), l.toDouble() opChar r.toDouble()); }
@@ -824,7 +851,12 @@ bool BinaryOpOptimizer::processStatementInternal(BaseCompiler* compiler, BaseSco
 
 				if (auto bOp = dynamic_cast<Operations::BinaryOp*>(a->getSubExpr(0).get()))
 				{
-					if (isAssignedVariable(bOp->getSubExpr(0)) && !SpanType::isSimdType(a->getSubExpr(1)->getTypeInfo()))
+					// The left operand must be the target itself, otherwise
+					// s = s * 2.0f + x would end up as s += x
+					auto isSelfOp = Operations::isStatementType<Operations::VariableReference>(bOp->getSubExpr(0).get()) &&
+									isAssignedVariable(bOp->getSubExpr(0));
+
+					if (isSelfOp && !SpanType::isSimdType(a->getSubExpr(1)->getTypeInfo()))
 					{
 						a->logOptimisationMessage("Replace " + juce::String(bOp->op) + " with self assignment");
 
@@ -1062,5 +1094,544 @@ void BinaryOpOptimizer::createSelfAssignmentFromBinaryOp(ExprPtr assignment)
 	}
 }
 
+bool LoopVectoriser::processStatementInternal(BaseCompiler* compiler, BaseScope* s, StatementPtr statement)
+{
+	// Run after all other optimizations so that the loop body has its final shape
+	if (compiler->getCurrentPass() != BaseCompiler::PreCodeGenerationOptimization)
+		return false;
+
+	if (auto l = as<Operations::Loop>(statement))
+	{
+		if (!l->vectorise && canBeVectorised(l))
+		{
+			l->vectorise = true;
+			l->logOptimisationMessage("Vectorise loop");
+		}
+	}
+
+	return false;
+}
+
+bool LoopVectoriser::canBeVectorised(Operations::Loop* l)
+{
+	auto& it = l->iterator;
+
+	if (it.typeInfo.getType() != Types::ID::Float)
+		return false;
+
+	switch (l->loopTargetType)
+	{
+	case Operations::Loop::Span:
+	{
+		auto sp = l->getTarget()->getTypeInfo().getTypedIfComplexType<SpanType>();
+
+		if (sp == nullptr || sp->getElementType().getType() != Types::ID::Float || sp->getNumElements() < 4)
+			return false;
+
+		break;
+	}
+	case Operations::Loop::Dyn:
+	{
+		auto dt = l->getTarget()->getTypeInfo().getTypedIfComplexType<DynType>();
+
+		if (dt == nullptr || dt->elementType.getType() != Types::ID::Float)
+			return false;
+
+		break;
+	}
+	case Operations::Loop::Block:
+		break;
+	default:
+		return false;
+	}
+
+	auto body = l->getLoopBlock();
+
+	if (body == nullptr)
+		return false;
+
+	int numAssignments = 0;
+
+	for (int i = 0; i < body->getNumChildStatements(); i++)
+	{
+		auto s = body->getChildStatement(i);
+
+		if (Operations::isStatementType<Operations::Noop>(s.get()))
+			continue;
+
+		auto a = dynamic_cast<Operations::Assignment*>(s.get());
+
+		if (a == nullptr || a->isFirstAssignment)
+			return false;
+
+		auto target = dynamic_cast<Operations::VariableReference*>(a->getSubExpr(1).get());
+
+		if (target == nullptr || !(target->id == it))
+			return false;
+
+		auto t = a->assignmentType;
+
+		if (t != JitTokens::assign_ && t != JitTokens::plus && t != JitTokens::minus &&
+			t != JitTokens::times && t != JitTokens::divide)
+			return false;
+
+		if (!isVectorisableExpression(l, a->getSubExpr(0).get()))
+			return false;
+
+		numAssignments++;
+	}
+
+	return numAssignments > 0;
+}
+
+bool LoopVectoriser::isVectorisableExpression(Operations::Loop* l, Operations::Expression* e)
+{
+	if (e == nullptr || e->getType() != Types::ID::Float)
+		return false;
+
+	if (Operations::isStatementType<Operations::Immediate>(e))
+		return true;
+
+	if (auto v = dynamic_cast<Operations::VariableReference*>(e))
+	{
+		if (v->id == l->iterator || v->isConstExpr())
+			return true;
+
+		// References might alias the loop target and members of
+		// objects need a pointer, so we only allow plain variables
+		if (v->id.isReference() || v->objectExpression != nullptr || !v->objectAdress.isVoid())
+			return false;
+
+		auto vs = v->variableScope.get();
+
+		if (vs == nullptr)
+			return false;
+
+		if (vs->getScopeType() == BaseScope::Class)
+			return v->isClassVariable(vs);
+
+		return vs->getScopeType() == BaseScope::Function || vs->getScopeType() == BaseScope::Anonymous;
+	}
+
+	if (auto n = dynamic_cast<Operations::Negation*>(e))
+		return isVectorisableExpression(l, n->getSubExpr(0).get());
+
+	if (auto bOp = dynamic_cast<Operations::BinaryOp*>(e))
+	{
+		auto op = bOp->op;
+
+		if (op != JitTokens::plus && op != JitTokens::minus && op != JitTokens::times && op != JitTokens::divide)
+			return false;
+
+		return isVectorisableExpression(l, bOp->getSubExpr(0).get()) &&
+			   isVectorisableExpression(l, bOp->getSubExpr(1).get());
+	}
+
+	return false;
+}
+bool LoopInvariantHoister::processStatementInternal(BaseCompiler* compiler, BaseScope* s, StatementPtr statement)
+{
+	if (compiler->getCurrentPass() != BaseCompiler::PostSymbolOptimization)
+		return false;
+
+	auto l = as<Operations::Loop>(statement);
+
+	if (l == nullptr)
+		return false;
+
+	// The invariant expressions will be defined as local variables right before the loop
+	// (the parent is either a statement block or the function's syntax tree)
+	auto parentScopeStatement = dynamic_cast<Operations::ScopeStatementBase*>(l->parent.get());
+
+	if (parentScopeStatement == nullptr)
+		return false;
+
+	Array<Symbol> writtenSymbols;
+
+	if (!collectWrittenSymbols(l, writtenSymbols))
+		return false;
+
+	Array<ExprPtr> invariantExpressions;
+	collectInvariantExpressions(l->getLoopBlock(), writtenSymbols, invariantExpressions);
+
+	if (invariantExpressions.isEmpty())
+		return false;
+
+	auto path = parentScopeStatement->getPath();
+
+	for (auto e : invariantExpressions)
+	{
+		auto id = path.getChildId(Identifier("_licm" + juce::String(numHoistedExpressions++)));
+		Symbol hoistedSymbol(id, TypeInfo(e->getType()));
+
+		{
+			NamespaceHandler::ScopedNamespaceSetter sns(compiler->namespaceHandler, path);
+			compiler->namespaceHandler.addSymbol(id, hoistedSymbol.typeInfo, NamespaceHandler::Variable);
+		}
+
+		StatementPtr newReference = new Operations::VariableReference(e->location, hoistedSymbol);
+		replaceExpression(e, newReference);
+
+		auto target = new Operations::VariableReference(e->location, hoistedSymbol);
+		StatementPtr definition = new Operations::Assignment(e->location, target, JitTokens::assign_, e, true);
+
+		l->parent->addStatementBefore(definition.get(), l);
+
+		l->logOptimisationMessage("Move loop invariant expression out of loop");
+
+		processNewStatement(compiler, s, definition);
+		processNewStatement(compiler, s, newReference);
+	}
+
+	return true;
+}
+
+bool LoopInvariantHoister::collectWrittenSymbols(Operations::Loop* l, Array<Symbol>& writtenSymbols)
+{
+	writtenSymbols.add(l->iterator);
+
+	auto cantBeAnalysed = l->getLoopBlock()->forEachRecursive([&writtenSymbols](StatementPtr p)
+	{
+		// Function calls might change class members or reference parameters
+		if (auto fc = dynamic_cast<Operations::FunctionCall*>(p.get()))
+			return !isMathFunctionCall(fc);
+
+		if (auto sb = dynamic_cast<Operations::StatementBlock*>(p.get()))
+			return sb->isInlinedFunction;
+
+		if (auto innerLoop = dynamic_cast<Operations::Loop*>(p.get()))
+			writtenSymbols.addIfNotAlreadyThere(innerLoop->iterator);
+
+		if (auto v = dynamic_cast<Operations::VariableReference*>(p.get()))
+		{
+			if (v->isBeingWritten() && !writtenSymbols.contains(v->id))
+			{
+				// A reference might point to any other variable
+				if (v->id.isReference())
+					return true;
+
+				writtenSymbols.add(v->id);
+			}
+		}
+
+		return false;
+	});
+
+	return !cantBeAnalysed;
+}
+
+void LoopInvariantHoister::collectInvariantExpressions(StatementPtr s, const Array<Symbol>& writtenSymbols, Array<ExprPtr>& result)
+{
+	if (auto a = dynamic_cast<Operations::Assignment*>(s.get()))
+	{
+		// Skip the assignment target
+		collectInvariantExpressions(a->getSubExpr(0), writtenSymbols, result);
+		return;
+	}
+
+	if (auto e = dynamic_cast<Operations::Expression*>(s.get()))
+	{
+		auto isComputation = Operations::isStatementType<Operations::BinaryOp>(e) ||
+							 Operations::isStatementType<Operations::Negation>(e) ||
+							 Operations::isStatementType<Operations::Cast>(e) ||
+							 Operations::isStatementType<Operations::FunctionCall>(e);
+
+		if (isComputation && !e->isConstExpr() && isInvariant(e, writtenSymbols))
+		{
+			result.add(e);
+			return;
+		}
+	}
+
+	for (int i = 0; i < s->getNumChildStatements(); i++)
+		collectInvariantExpressions(s->getChildStatement(i), writtenSymbols, result);
+}
+
+bool LoopInvariantHoister::isInvariant(Operations::Expression* e, const Array<Symbol>& writtenSymbols)
+{
+	if (e == nullptr || e->getTypeInfo().isComplexType())
+		return false;
+
+	auto type = e->getType();
+
+	if (type != Types::ID::Integer && type != Types::ID::Float && type != Types::ID::Double)
+		return false;
+
+	if (Operations::isStatementType<Operations::Immediate>(e))
+		return true;
+
+	if (auto v = dynamic_cast<Operations::VariableReference*>(e))
+	{
+		if (v->isConstExpr())
+			return true;
+
+		if (writtenSymbols.contains(v->id) || v->id.isReference())
+			return false;
+
+		// Members of objects need a pointer, so we only allow plain variables
+		return v->objectExpression == nullptr && v->objectAdress.isVoid() && v->variableScope != nullptr;
+	}
+
+	if (auto n = dynamic_cast<Operations::Negation*>(e))
+		return isInvariant(n->getSubExpr(0).get(), writtenSymbols);
+
+	if (auto c = dynamic_cast<Operations::Cast*>(e))
+		return isInvariant(c->getSubExpr(0).get(), writtenSymbols);
+
+	if (auto bOp = dynamic_cast<Operations::BinaryOp*>(e))
+	{
+		auto op = bOp->op;
+
+		// An integer division by zero would crash even if the loop is never executed
+		auto isFloatingPointDivision = op == JitTokens::divide && type != Types::ID::Integer;
+
+		if (op != JitTokens::plus && op != JitTokens::minus && op != JitTokens::times && !isFloatingPointDivision)
+			return false;
+
+		return isInvariant(bOp->getSubExpr(0).get(), writtenSymbols) &&
+			   isInvariant(bOp->getSubExpr(1).get(), writtenSymbols);
+	}
+
+	if (auto fc = dynamic_cast<Operations::FunctionCall*>(e))
+	{
+		if (!isMathFunctionCall(fc))
+			return false;
+
+		for (int i = 0; i < fc->getNumArguments(); i++)
+		{
+			if (!isInvariant(fc->getArgument(i), writtenSymbols))
+				return false;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+bool StrengthReducer::processStatementInternal(BaseCompiler* compiler, BaseScope* s, StatementPtr statement)
+{
+	if (compiler->getCurrentPass() != BaseCompiler::PostSymbolOptimization)
+		return false;
+
+	if (auto bOp = as<Operations::BinaryOp>(statement))
+	{
+		if (bOp->op == JitTokens::divide)
+		{
+			if (auto reciprocal = createReciprocal(bOp->getSubExpr(1)))
+			{
+				bOp->logOptimisationMessage("Replace division with multiplication");
+				bOp->op = JitTokens::times;
+				replaceExpression(bOp->getSubExpr(1), reciprocal);
+				return true;
+			}
+		}
+
+	}
+
+	if (auto a = as<Operations::Assignment>(statement))
+	{
+		if (a->assignmentType == JitTokens::divide)
+		{
+			if (auto reciprocal = createReciprocal(a->getSubExpr(0)))
+			{
+				a->logOptimisationMessage("Replace division with multiplication");
+				a->assignmentType = JitTokens::times;
+				replaceExpression(a->getSubExpr(0), reciprocal);
+				return true;
+			}
+		}
+	}
+
+	if (auto fc = as<Operations::FunctionCall>(statement))
+	{
+		if (isMathFunctionCall(fc) && fc->function.id.getIdentifier() == Identifier("pow") && fc->getNumArguments() == 2)
+		{
+			ExprPtr base = fc->getArgument(0);
+			ExprPtr exponent = fc->getArgument(1);
+
+			if (exponent->isConstExpr() && exponent->getConstExprValue().toDouble() == 2.0 &&
+				Operations::isStatementType<Operations::VariableReference>(base.get()))
+			{
+				ExprPtr l = dynamic_cast<Operations::Expression*>(base->clone(base->location).get());
+				ExprPtr r = dynamic_cast<Operations::Expression*>(base->clone(base->location).get());
+
+				StatementPtr square = new Operations::BinaryOp(fc->location, l, r, JitTokens::times);
+
+				fc->logOptimisationMessage("Replace Math.pow(x, 2) with x * x");
+				replaceExpression(fc, square);
+				processNewStatement(compiler, s, square);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+snex::jit::OptimizationPass::ExprPtr StrengthReducer::createReciprocal(ExprPtr e)
+{
+	auto type = e->getType();
+
+	if (!e->isConstExpr() || (type != Types::ID::Float && type != Types::ID::Double))
+		return nullptr;
+
+	auto v = e->getConstExprValue().toDouble();
+
+	int exponent = 0;
+
+	// Only the reciprocal of a power of two is exact
+	if (std::abs(std::frexp(v, &exponent)) != 0.5)
+		return nullptr;
+
+	auto reciprocal = 1.0 / v;
+
+	if (type == Types::ID::Float ? !std::isnormal((float)reciprocal) : !std::isnormal(reciprocal))
+		return nullptr;
+
+	return new Operations::Immediate(e->location, VariableStorage(type, reciprocal));
+}
+
+bool LoopUnroller::processStatementInternal(BaseCompiler* compiler, BaseScope* s, StatementPtr statement)
+{
+	if (compiler->getCurrentPass() != BaseCompiler::PostSymbolOptimization)
+		return false;
+
+	auto l = as<Operations::Loop>(statement);
+
+	if (l == nullptr || !canBeUnrolled(l))
+		return false;
+
+	auto numElements = l->getTarget()->getTypeInfo().getTypedComplexType<SpanType>()->getNumElements();
+	auto body = l->getLoopBlock();
+	auto target = l->getTarget();
+	auto iterator = l->iterator;
+
+	StatementPtr unrolled = new Operations::StatementBlock(l->location, body->getPath());
+
+	for (int i = 0; i < numElements; i++)
+	{
+		for (auto c : *body)
+		{
+			auto copy = c->clone(c->location);
+			unrolled->addStatement(copy.get());
+
+			copy->forEachRecursive([&](StatementPtr p)
+			{
+				if (auto v = dynamic_cast<Operations::VariableReference*>(p.get()))
+				{
+					if (v->id == iterator)
+					{
+						ExprPtr spanExpr = dynamic_cast<Operations::Expression*>(target->clone(v->location).get());
+						auto index = new Operations::Immediate(v->location, VariableStorage(i));
+
+						v->replaceInParent(new Operations::Subscript(v->location, spanExpr, index));
+					}
+				}
+
+				return false;
+			});
+		}
+	}
+
+	l->logOptimisationMessage("Unroll loop");
+
+	replaceExpression(l, unrolled);
+	processNewStatement(compiler, s, unrolled);
+
+	return true;
+}
+
+bool LoopUnroller::canBeUnrolled(Operations::Loop* l)
+{
+	if (l->loopTargetType != Operations::Loop::Span)
+		return false;
+
+	auto targetType = l->getTarget()->getTypeInfo();
+	auto sp = targetType.getTypedIfComplexType<SpanType>();
+
+	if (sp == nullptr || SpanType::isSimdType(targetType) || sp->getNumElements() > maxNumElements)
+		return false;
+
+	if (sp->getElementType().isComplexType())
+		return false;
+
+	// The target will be evaluated for each element
+	auto target = dynamic_cast<Operations::VariableReference*>(l->getTarget().get());
+
+	if (target == nullptr)
+		return false;
+
+	auto body = l->getLoopBlock();
+	auto iterator = l->iterator;
+
+	auto hasUnsupportedStatement = body->forEachRecursive([body](StatementPtr p)
+	{
+		// Variable definitions would end up multiple times in the same scope
+		if (auto a = dynamic_cast<Operations::Assignment*>(p.get()))
+			return a->isFirstAssignment;
+
+		if (auto sb = dynamic_cast<Operations::StatementBlock*>(p.get()))
+			return sb != body && sb->isInlinedFunction;
+
+		return Operations::isStatementType<Operations::Loop>(p.get()) ||
+			   dynamic_cast<Operations::ControlFlowStatement*>(p.get()) != nullptr;
+	});
+
+	if (hasUnsupportedStatement || writesIterator(l))
+		return false;
+
+	// Writes to a constant subscript are deferred by the code generator, so the
+	// elements must not be written anywhere else in the function
+	Operations::Statement* root = l;
+
+	while (root->parent != nullptr)
+		root = root->parent.get();
+
+	auto spanId = target->id;
+
+	auto isWritten = root->forEachRecursive([spanId](StatementPtr p)
+	{
+		auto v = dynamic_cast<Operations::VariableReference*>(p.get());
+
+		if (v == nullptr || !(v->id == spanId))
+			return false;
+
+		auto parent = v->parent.get();
+
+		if (auto a = dynamic_cast<Operations::Assignment*>(parent))
+			return !a->isFirstAssignment;
+
+		if (auto sub = dynamic_cast<Operations::Subscript*>(parent))
+		{
+			if (auto a = dynamic_cast<Operations::Assignment*>(sub->parent.get()))
+				return a->getSubExpr(1).get() == sub;
+
+			return Operations::isStatementType<Operations::Increment>(sub->parent.get());
+		}
+
+		if (auto otherLoop = dynamic_cast<Operations::Loop*>(parent))
+			return writesIterator(otherLoop);
+
+		// Any other usage (eg. toSimd() or passing it to a function) might write the span
+		return true;
+	});
+
+	return !isWritten;
+}
+
+bool LoopUnroller::writesIterator(Operations::Loop* l)
+{
+	auto iterator = l->iterator;
+
+	return l->getLoopBlock()->forEachRecursive([iterator](StatementPtr p)
+	{
+		if (auto v = dynamic_cast<Operations::VariableReference*>(p.get()))
+			return v->id == iterator && v->isBeingWritten();
+
+		return false;
+	});
+}
+
 }
 }
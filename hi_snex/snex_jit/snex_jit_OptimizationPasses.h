@@ -107,6 +107,14 @@ public:
     {
         return dynamic_cast<T*>(obj.get());
     }
+
+	/** Runs the passes from DataAllocation up to TypeCheck for a statement that was
+	    created by an optimization after the symbols have been resolved.
+	*/
+	static void processNewStatement(BaseCompiler* compiler, BaseScope* s, StatementPtr newStatement);
+
+	/** Checks whether the function call is a Math function without side effects. */
+	static bool isMathFunctionCall(Operations::FunctionCall* fc);
 };
 
     
@@ -118,8 +126,6 @@ juce::String getName() const override { return getStaticId().toString(); };
     /** TODO: Optimizations:
      
      1 Expression simplifications:
-       - x / constant => x * (1 / constant)
-       - x * 2 => x + x
        - 125 - x => -x + 125 ( => x *= -1; x += 125 )
        - x % pow2 => x & log2(pow2)-1;
      
@@ -244,6 +250,133 @@ public:
 
 };
 
+/** Moves computations that do not change between iterations out of a loop.
+
+	Every arithmetic expression (or Math function call) inside the loop body that only
+	uses literals and variables which are not written inside the loop will be stored
+	into a local variable right before the loop:
+
+		for(auto& s: data)
+			s *= Math.pow(gain, 2.0f) * 0.5f;
+
+	becomes
+
+		auto _licm0 = Math.pow(gain, 2.0f) * 0.5f;
+
+		for(auto& s: data)
+			s *= _licm0;
+
+	Loops that call other functions, contain inlined functions or write to references
+	are skipped because they might change any other variable.
+*/
+class LoopInvariantHoister : public OptimizationPass
+{
+public:
+
+	OPTIMIZATION_FACTORY(OptimizationIds::LoopInvariantCodeMotion, LoopInvariantHoister);
+
+	bool processStatementInternal(BaseCompiler* compiler, BaseScope* s, StatementPtr statement) override;
+
+private:
+
+	/** Collects all symbols that are changed inside the loop. Returns false if the loop can't be analysed. */
+	static bool collectWrittenSymbols(Operations::Loop* l, Array<Symbol>& writtenSymbols);
+
+	static void collectInvariantExpressions(StatementPtr s, const Array<Symbol>& writtenSymbols, Array<ExprPtr>& result);
+
+	static bool isInvariant(Operations::Expression* e, const Array<Symbol>& writtenSymbols);
+
+	int numHoistedExpressions = 0;
+};
+
+/** Replaces expensive operations with cheaper equivalents:
+
+	- x / constant => x * (1 / constant) for floating point types if the constant is a power of two
+	- Math.pow(x, 2) => x * x
+
+	The division is only replaced if the reciprocal is exact, so the result doesn't change.
+
+	Span index arithmetic doesn't need to be handled here as the code generator
+	already folds the element size into the address operand.
+*/
+class StrengthReducer : public OptimizationPass
+{
+public:
+
+	OPTIMIZATION_FACTORY(OptimizationIds::StrengthReduction, StrengthReducer);
+
+	bool processStatementInternal(BaseCompiler* compiler, BaseScope* s, StatementPtr statement) override;
+
+private:
+
+	/** Returns an immediate with the reciprocal value of a floating point constant or nullptr
+		if the constant is not a power of two. */
+	static ExprPtr createReciprocal(ExprPtr e);
+};
+
+/** Replaces loops over small spans with a copy of the loop body for each element.
+
+	The iterator is replaced with a subscript with a constant index, so this:
+
+		for(auto& s: data)
+			sum += s * 2.0f;
+
+	becomes
+
+		sum += data[0] * 2.0f;
+		sum += data[1] * 2.0f;
+		...
+
+	Only loops over spans of primitive types with up to maxNumElements elements are unrolled.
+	The loop must not write to the iterator and the loop body must not contain variable
+	definitions, nested loops or break / continue statements.
+*/
+class LoopUnroller : public OptimizationPass
+{
+public:
+
+	static constexpr int maxNumElements = 8;
+
+	OPTIMIZATION_FACTORY(OptimizationIds::LoopUnrolling, LoopUnroller);
+
+	bool processStatementInternal(BaseCompiler* compiler, BaseScope* s, StatementPtr statement) override;
+
+	/** Checks whether the loop can be replaced with an unrolled block. */
+	static bool canBeUnrolled(Operations::Loop* l);
+
+	/** Checks whether the loop body writes to the iterator. */
+	static bool writesIterator(Operations::Loop* l);
+};
+
+/** Emits element-wise loops over float spans, dyns and blocks with packed SSE instructions.
+
+	This pass only flags the loop, the loop emitter will then process four elements per
+	iteration and run the regular loop body for the remaining elements. A loop qualifies
+	if its body only contains assignments to the iterator which are built from
+	+, -, *, / and negations of the iterator, float literals and float variables that are
+	not written inside the loop:
+
+		for(auto& s: data)
+			s = s * gain + 0.5f;
+
+	Everything else (function calls, branches, subscripts, reductions into other variables)
+	will use the scalar loop.
+*/
+class LoopVectoriser : public OptimizationPass
+{
+public:
+
+	OPTIMIZATION_FACTORY(OptimizationIds::LoopVectorisation, LoopVectoriser);
+
+	bool processStatementInternal(BaseCompiler* compiler, BaseScope* s, StatementPtr statement) override;
+
+	/** Checks whether the given loop can be emitted with packed instructions. */
+	static bool canBeVectorised(Operations::Loop* l);
+
+	/** Checks whether the expression only uses the iterator, float literals and loop invariant float variables. */
+	static bool isVectorisableExpression(Operations::Loop* l, Operations::Expression* e);
+};
+
 struct OptimizationFactory
 {
 	using CreateFunction = std::function<BaseCompiler::OptimizationPassBase*(void)>;
@@ -255,6 +388,10 @@ struct OptimizationFactory
 		registerOptimization<DeadcodeEliminator>();
 		registerOptimization<BinaryOpOptimizer>();
 		registerOptimization<ConstExprEvaluator>();
+		registerOptimization<LoopVectoriser>();
+		registerOptimization<LoopInvariantHoister>();
+		registerOptimization<StrengthReducer>();
+		registerOptimization<LoopUnroller>();
 	}
 
 	struct Entry
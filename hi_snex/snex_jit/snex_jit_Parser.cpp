@@ -152,6 +152,8 @@ public:
 
 	juce::String assembly;
 
+	size_t codeSize = 0;
+
 	Result lastResult;
 
 	BaseScope* parentScope;
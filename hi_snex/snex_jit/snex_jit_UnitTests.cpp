@@ -267,8 +267,18 @@ public:
 	{
 	}
 
+	/** Overrides the location of the test files (eg. when running the benchmark from the command line). */
+	static File& getCustomTestFileDirectory()
+	{
+		static File customDirectory;
+		return customDirectory;
+	}
+
 	static File getTestFileDirectory()
 	{
+		if (getCustomTestFileDirectory().isDirectory())
+			return getCustomTestFileDirectory();
+
 		auto p = File::getSpecialLocation(File::currentApplicationFile);
 
 #if JUCE_WINDOWS
@@ -741,6 +751,8 @@ private:
 	{
 		throw s;
 	}
+
+	friend class TestFileBenchmark;
 	
 	File file;
 	File fileToBeWritten;
@@ -869,6 +881,8 @@ public:
 		runTestsWithOptimisation({ OptimizationIds::ConstantFolding });
 		runTestsWithOptimisation({ OptimizationIds::ConstantFolding, OptimizationIds::BinaryOpOptimisation });
 		runTestsWithOptimisation({ OptimizationIds::ConstantFolding, OptimizationIds::BinaryOpOptimisation, OptimizationIds::Inlining });
+		runTestsWithOptimisation({ OptimizationIds::ConstantFolding, OptimizationIds::BinaryOpOptimisation, OptimizationIds::Inlining, OptimizationIds::LoopVectorisation });
+		runTestsWithOptimisation({ OptimizationIds::ConstantFolding, OptimizationIds::BinaryOpOptimisation, OptimizationIds::Inlining, OptimizationIds::LoopInvariantCodeMotion, OptimizationIds::StrengthReduction, OptimizationIds::LoopUnrolling, OptimizationIds::LoopVectorisation });
 	}
 
 	void runTestFiles(juce::String soloTest = {}, bool isFolder=false)
@@ -943,6 +957,7 @@ public:
 		optimizations = ids;
 
 		runTestFiles();
+		testMemberRegisterPerformance();
 		testFpu();
 
 		testParser();
@@ -1208,6 +1223,61 @@ private:
 		pc.stop();
 	}
 
+	void testMemberRegisterPerformance()
+	{
+		beginTest("Testing member register performance");
+
+		juce::String size, index, code;
+
+		ADD_CODE_LINE("struct X");
+		ADD_CODE_LINE("{");
+		ADD_CODE_LINE("    float process(float input)");
+		ADD_CODE_LINE("    {");
+		ADD_CODE_LINE("        for(auto& s: data)");
+		ADD_CODE_LINE("        {");
+		ADD_CODE_LINE("            state = state * coefficient + input;");
+		ADD_CODE_LINE("            s = state * gain;");
+		ADD_CODE_LINE("        }");
+		ADD_CODE_LINE("        return state;");
+		ADD_CODE_LINE("    }");
+		ADD_CODE_LINE("    span<float, 441000> data;");
+		ADD_CODE_LINE("    float state = 0.0f;");
+		ADD_CODE_LINE("    float coefficient = 0.5f;");
+		ADD_CODE_LINE("    float gain = 2.0f;");
+		ADD_CODE_LINE("};");
+		ADD_CODE_LINE("X x;");
+		ADD_CODE_LINE("float test(float input)");
+		ADD_CODE_LINE("{");
+		ADD_CODE_LINE("    return x.process(input);");
+		ADD_CODE_LINE("}");
+
+		GlobalScope m;
+		for (auto o : optimizations)
+			m.addOptimization(o);
+
+		Compiler c(m);
+
+		auto obj = c.compileJitObject(code);
+
+		expectEquals(c.getCompileResult().getErrorMessage(), juce::String(), "compile error");
+
+		auto f = obj["test"];
+
+		juce::String mem;
+		mem << "Testing member register performance";
+
+		for (auto o : optimizations)
+			mem << " with " << o;
+
+		PerformanceCounter pc(mem);
+		pc.start();
+		auto result = f.call<float>(1.0f);
+		pc.stop();
+
+		// state converges to input / (1 - coefficient)
+		expectWithinAbsoluteError(result, 2.0f, 0.001f, "member register result");
+	}
+
 	template <typename T> void testExternalTypeDatabase()
 	{
 		juce::String size, index, code;
@@ -2025,6 +2095,44 @@ private:
 		}
 	}
 
+	template <typename T> void expectSameResultWithStrengthReduction(const juce::String& code, T input)
+	{
+		HiseJITTestCase<T> reference(code, {});
+		HiseJITTestCase<T> optimised(code, { OptimizationIds::StrengthReduction });
+
+		reference.setup();
+		optimised.setup();
+
+		auto expected = reference.func["test"].template call<T>(input);
+		auto actual = optimised.func["test"].template call<T>(input);
+
+		expect(actual == expected, code + " with input " + juce::String(input) + ": " + juce::String(actual) + " != " + juce::String(expected));
+	}
+
+	template <typename T> void testStrengthReduction()
+	{
+		auto t = Types::Helpers::getTypeNameFromTypeId<T>();
+		auto suffix = std::is_same<T, float>() ? "f" : "";
+
+		StringArray expressions = { "x / 4.0%s", "x / 0.5%s", "x / -8.0%s", "x / 3.0%s", "x / 10.0%s", "x * 2.0%s", "Math.pow(x, 2.0%s)" };
+
+		Array<T> inputs = { T(0.1), T(3.0), T(-7.3), T(0.001), T(12345.678) };
+
+		for (auto e : expressions)
+		{
+			auto expression = e.replace("%s", suffix);
+			auto code = t + " test(" + t + " x){ return " + expression + "; }";
+
+			for (auto i : inputs)
+				expectSameResultWithStrengthReduction<T>(code, i);
+		}
+
+		auto selfAssign = t + " test(" + t + " x){ " + t + " y = x; y /= 0.25" + suffix + "; return y; }";
+
+		for (auto i : inputs)
+			expectSameResultWithStrengthReduction<T>(selfAssign, i);
+	}
+
 	void testOptimizations()
 	{
 		beginTest("Testing match constant function folding");
@@ -2144,6 +2252,21 @@ private:
 				"Don't replace constant int self-assign division");
 		}
 
+		beginTest("Testing strength reduction");
+
+		{
+			OptimizationTestCase t;
+			t.setOptimizations({ OptimizationIds::StrengthReduction });
+			t.setExpressionBody("float test(float x){ return %BODY%; }");
+
+			expect(t.sameAssembly("x / 4.0f", "x * 0.25f"), "Replace power of two division");
+			expect(t.sameAssembly("x / 3.0f", "x / 3.0f"), "Don't replace inexact division");
+			expect(t.sameAssembly("x * 2.0f", "x * 2.0f"), "Don't replace multiplication");
+		}
+
+		testStrengthReduction<float>();
+		testStrengthReduction<double>();
+
 		beginTest("Testing complex binary op optimizations");
 
 		{
@@ -51,6 +51,10 @@ DECLARE_ID(ConstantFolding);
 DECLARE_ID(Inlining);
 DECLARE_ID(DeadCodeElimination);
 DECLARE_ID(BinaryOpOptimisation);
+DECLARE_ID(LoopVectorisation);
+DECLARE_ID(LoopInvariantCodeMotion);
+DECLARE_ID(StrengthReduction);
+DECLARE_ID(LoopUnrolling);
 }
 
 #undef DECLARE_ID
@@ -8,6 +8,8 @@
 #include "hi_streaming/StreamingSamplerSound.cpp"
 #include "hi_streaming/StreamingSamplerVoice.cpp"
 
+#include "hi_streaming/SampleThreadPoolTests.cpp"
+
 
 
 
@@ -79,6 +79,18 @@ Set this to true if you add this module to your existing C++ project and don't e
 #define STANDALONE_STREAMING 1
 #endif
 
+//=============================================================================
+/** Config: HISE_BATCH_STREAMING_READS
+
+If enabled, the sample loading thread collects the pending streaming requests between two jobs. Requests that must
+be served soon run in the order they arrive and only their overlapping regions of a monolith are decoded in one pass.
+Requests that can wait are executed after them, sorted by file and position, and nearby regions are read in one pass.
+Disable this to run all requests in the order they arrive without merging.
+*/
+#ifndef HISE_BATCH_STREAMING_READS
+#define HISE_BATCH_STREAMING_READS 1
+#endif
+
 
 #include "hi_streaming/lockfree_fifo/readerwriterqueue.h"
 #include "hi_streaming/lockfree_fifo/concurrentqueue.h"
@@ -203,12 +203,24 @@ void HlacMonolithInfo::fillMetadataInfo(const ValueTree& sampleMap)
 		memoryReaders.add(dynamic_cast<hlac::HlacMemoryMappedAudioFormatReader*>(reader.release()));
 
 		memoryReaders.getLast()->setTargetAudioDataType(AudioDataConverters::DataFormat::int16BE);
+		memoryReaders.getLast()->setDecodeCache(decodeCache, hlac::HlacDecodeCache::createKeyForFile(monolithicFiles[i]));
 
 		if (memoryReaders.getLast()->getMappedSection().isEmpty())
 		{
 			jassertfalse;
 			throw StreamingSamplerSound::LoadingError(monolithicFiles[i].getFileName(), "Error at memory mapping");
 		}
+#endif
+	}
+
+	readSources.clear();
+
+	for (int i = 0; i < fallbackReaders.size(); i++)
+	{
+#if USE_FALLBACK_READERS_FOR_MONOLITH
+		readSources.add(new ChannelReadSource(nullptr, fallbackReaders[i]));
+#else
+		readSources.add(new ChannelReadSource(memoryReaders[i], fallbackReaders[i]));
 #endif
 	}
 }
@@ -304,6 +304,11 @@ public:
 	{
 		return multiChannelSampleInformation[channelIndex][sampleIndex].fileName;
 	}
+
+	File getMonolithFile(int channelIndex) const
+	{
+		return isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()) ? monolithicFiles[channelIndex] : File();
+	}
     
     int64 getMonolithOffset(int sampleIndex) const
     {
@@ -328,6 +333,10 @@ public:
 		String fileName;
 	};
 
+	DiskLatencyTracker& getLatencyTracker() noexcept { return latencyTracker; }
+
+	SampleThreadPool::ReadRegion getReadRegion(int /*sampleIndex*/, int /*channelIndex*/, int64 /*positionInSample*/, int /*numSamples*/) const { return {}; }
+
 	private:
 
 	struct DummyReader: public AudioFormatReader
@@ -357,6 +366,8 @@ public:
     OwnedArray<FallbackMonolithAudioFormatReader> fallbackReaders;
 
 	OwnedArray<MonolithAudioFormatReader> memoryReaders;
+
+	DiskLatencyTracker latencyTracker;
 };
 
 typedef HiseMonolithAudioFormat MonolithInfoToUse;
@@ -390,6 +401,7 @@ public:
 
 			ScopedPointer<FileInputStream> fallbackStream = new FileInputStream(monolithicFiles_[i]);
 			fallbackReaders.add(new hlac::HiseLosslessAudioFormatReader(fallbackStream.release()));
+			fallbackReaders.getLast()->setDecodeCache(decodeCache, hlac::HlacDecodeCache::createKeyForFile(monolithicFiles_[i]));
 			isMonoChannel[i] = fallbackReaders.getLast()->numChannels == 1;
 		}
 
@@ -404,6 +416,11 @@ public:
 		return multiChannelSampleInformation[channelIndex][sampleIndex].fileName;
 	}
 
+	File getMonolithFile(int channelIndex) const
+	{
+		return isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()) ? monolithicFiles[channelIndex] : File();
+	}
+
 	int64 getMonolithOffset(int sampleIndex) const
 	{
 		return multiChannelSampleInformation[0][sampleIndex].start;
@@ -501,10 +518,56 @@ public:
 		String fileName;
 	};
 
+	/** Returns the latency measurement that is shared by all sounds streaming from this monolith. */
+	DiskLatencyTracker& getLatencyTracker() noexcept { return latencyTracker; }
+
+	/** Returns the region in the monolith file that a read of the given sample will touch.
+	
+		The sample loading thread uses this to sort and merge the reads of multiple voices.
+	*/
+	SampleThreadPool::ReadRegion getReadRegion(int sampleIndex, int channelIndex, int64 positionInSample, int numSamples) const
+	{
+		const int sizeOfFirstChannelList = (int)multiChannelSampleInformation[0].size();
+
+		if (isPositiveAndBelow(channelIndex, readSources.size()) && isPositiveAndBelow(sampleIndex, sizeOfFirstChannelList))
+		{
+			auto& info = multiChannelSampleInformation[channelIndex][sampleIndex];
+			return { readSources[channelIndex], info.start + positionInSample, (int64)numSamples };
+		}
+
+		return {};
+	}
+
 	typedef ReferenceCountedObjectPtr<HlacMonolithInfo> Ptr;
 
 private:
 
+	/** Forwards the batched reads of the sample loading thread to the reader of a channel file. */
+	struct ChannelReadSource : public SampleThreadPool::ReadSource
+	{
+		ChannelReadSource(hlac::HlacMemoryMappedAudioFormatReader* memoryReader_, hlac::HiseLosslessAudioFormatReader* fallbackReader_) :
+			memoryReader(memoryReader_),
+			fallbackReader(fallbackReader_)
+		{};
+
+		void hintRegion(int64 startSample, int64 numSamples) override
+		{
+			if (memoryReader != nullptr)
+				memoryReader->adviseWillNeed(startSample, numSamples);
+		}
+
+		void prefetchRegion(int64 startSample, int64 numSamples, hlac::HlacDecodeCache::PinnedBlocks* pinnedBlocks) override
+		{
+			if (memoryReader != nullptr)
+				memoryReader->decodeIntoCache(startSample, numSamples, pinnedBlocks);
+			else if (fallbackReader != nullptr)
+				fallbackReader->decodeIntoCache(startSample, numSamples, pinnedBlocks);
+		}
+
+		hlac::HlacMemoryMappedAudioFormatReader* memoryReader;
+		hlac::HiseLosslessAudioFormatReader* fallbackReader;
+	};
+
 	struct DummyReader : public AudioFormatReader
 	{
 	public:
@@ -537,8 +600,11 @@ private:
 
 	OwnedArray<hlac::HlacMemoryMappedAudioFormatReader> memoryReaders;
 
-	
+	SharedResourcePointer<hlac::HlacDecodeCache> decodeCache;
+
+	OwnedArray<ChannelReadSource> readSources;
 
+	DiskLatencyTracker latencyTracker;
 };
 
 typedef HlacMonolithInfo MonolithInfoToUse ;
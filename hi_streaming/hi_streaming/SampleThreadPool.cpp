@@ -32,6 +32,26 @@
 
 namespace hise { using namespace juce;
 
+void DiskLatencyTracker::addMeasurement(double latencySeconds) noexcept
+{
+	// The peak decays by about 50% every 140 reads
+	static constexpr float decay = 0.995f;
+
+	auto newValue = (float)latencySeconds;
+	auto current = peakLatency.load();
+
+	while (!peakLatency.compare_exchange_weak(current, jmax(newValue, current * decay)))
+		;
+
+	measured.store(true);
+}
+
+void DiskLatencyTracker::reset() noexcept
+{
+	peakLatency.store(0.0f);
+	measured.store(false);
+}
+
 
 struct SampleThreadPool::Pimpl
 {
@@ -39,7 +59,10 @@ struct SampleThreadPool::Pimpl
 		jobQueue(8192),
 		currentlyExecutedJob(nullptr),
 		diskUsage(0.0)
-	{};
+	{
+		batch.ensureStorageAllocated(maxBatchSize);
+		mergedReads.ensureStorageAllocated(maxBatchSize);
+	};
 
 	~Pimpl()
 	{
@@ -47,17 +70,223 @@ struct SampleThreadPool::Pimpl
 		{
 			currentJob->signalJobShouldExit();
 		}
+
+		releasePinnedBlocks();
 	}
 
+	/** A job that was collected from the queue. */
+	struct BatchItem
+	{
+		bool isBefore(const BatchItem& other) const noexcept
+		{
+			if (region.source != other.region.source)
+				return region.source < other.region.source;
+
+			return region.start < other.region.start;
+		}
+
+		WeakReference<Job> job;
+		ReadRegion region;
+		int mergedReadIndex = -1;
+		bool deferred = false;
+	};
+
+	/** A region that covers the reads of multiple jobs. */
+	struct MergedRead
+	{
+		ReadSource* source;
+		int64 start;
+		int64 end;
+		int numJobs;		// the jobs that haven't been executed yet
+		bool prefetched;
+		bool deferred;
+		hlac::HlacDecodeCache::PinnedBlocks pinnedBlocks;
+	};
+
+	bool collectBatch();
+	void addQueuedJobs();
+	void insertIntoBatch(const BatchItem& item);
+	void addToMergedRead(BatchItem& item);
+	void finishMergedRead(int mergedReadIndex);
+	void releasePinnedBlocks();
+
+	static constexpr int maxBatchSize = 8192;
+
+	// The first job of a group waits for the prefetch, so this limits the delay to decoding four HLAC blocks
+	static constexpr int64 maxMergedLength = 16384;
+
+	// Jobs that can wait this long are sorted and merged with the reads nearby
+	static constexpr double minSecondsToDefer = 0.05;
+	static constexpr int64 maxDeferredMergedLength = 65536;
+	static constexpr int64 maxDeferredMergeGap = COMPRESSION_BLOCK_SIZE;
+
 	CriticalSection clearLock;
 
 	std::atomic<double> diskUsage;
 	int64 startTime, endTime;
 	moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
 	std::atomic<Job*> currentlyExecutedJob;
+	SharedResourcePointer<hlac::HlacDecodeCache> decodeCache;
+
+	// The urgent jobs in queue order, followed by the jobs that can wait, sorted by file and position
+	Array<BatchItem> batch;
+	int batchPosition = 0;
+	int numPendingDeferred = 0;
+	Array<MergedRead> mergedReads;
+
+	std::atomic<int64> numJobs = { 0 };
+	std::atomic<int64> numMergedReads = { 0 };
+
 	static const String errorMessage;
 };
 
+bool SampleThreadPool::Pimpl::collectBatch()
+{
+	ScopedLock sl(clearLock);
+
+	releasePinnedBlocks();
+
+	batch.clearQuick();
+	mergedReads.clearQuick();
+	batchPosition = 0;
+	numPendingDeferred = 0;
+
+	addQueuedJobs();
+
+	return !batch.isEmpty();
+}
+
+void SampleThreadPool::Pimpl::addQueuedJobs()
+{
+	if (jobQueue.peek() == nullptr)
+		return;
+
+	// Remove the executed jobs so that the batch doesn't grow while new jobs keep coming in
+	batch.removeRange(0, batchPosition);
+	batchPosition = 0;
+
+	if (batch.isEmpty())
+	{
+		releasePinnedBlocks();
+		mergedReads.clearQuick();
+	}
+
+	WeakReference<Job> next;
+
+	while (batch.size() < maxBatchSize && jobQueue.try_dequeue(next))
+	{
+		if (auto j = next.get())
+		{
+			BatchItem item;
+			item.job = next;
+
+#if HISE_BATCH_STREAMING_READS
+			item.region = j->getReadRegion();
+			item.deferred = item.region.isValid() && j->getSecondsUntilDeadline() >= minSecondsToDefer;
+			addToMergedRead(item);
+#endif
+
+			insertIntoBatch(item);
+		}
+	}
+}
+
+void SampleThreadPool::Pimpl::insertIntoBatch(const BatchItem& item)
+{
+	const int firstDeferred = batch.size() - numPendingDeferred;
+
+	if (!item.deferred)
+	{
+		batch.insert(firstDeferred, item);
+		return;
+	}
+
+	auto pos = std::upper_bound(batch.begin() + firstDeferred, batch.end(), item, [](const BatchItem& a, const BatchItem& b)
+	{
+		return a.isBefore(b);
+	});
+
+	batch.insert((int)(pos - batch.begin()), item);
+	numPendingDeferred++;
+}
+
+void SampleThreadPool::Pimpl::addToMergedRead(BatchItem& item)
+{
+	if (!item.region.isValid())
+		return;
+
+	const auto start = item.region.start;
+	const auto end = start + item.region.numSamples;
+
+	// Let the OS fetch the region in the background while we process the jobs before it
+	item.region.source->hintRegion(start, item.region.numSamples);
+
+	for (int i = mergedReads.size() - 1; i >= 0; i--)
+	{
+		auto& m = mergedReads.getReference(i);
+
+		if (m.source != item.region.source || m.numJobs == 0)
+			continue;
+
+		// The urgent jobs run before the deferred jobs, so they can't share a read that hasn't been decoded yet
+		if (!m.prefetched && m.deferred != item.deferred)
+			continue;
+
+		if (m.prefetched)
+		{
+			// The region is decoded already, so the job can only use it if it lies inside
+			if (start >= m.start && end <= m.end)
+			{
+				m.numJobs++;
+				item.mergedReadIndex = i;
+				return;
+			}
+
+			continue;
+		}
+
+		// Urgent jobs only merge overlapping reads so that the prefetch never decodes samples that no job needs
+		const int64 maxGap = item.deferred ? maxDeferredMergeGap : 0;
+		const int64 maxLength = item.deferred ? maxDeferredMergedLength : maxMergedLength;
+
+		const bool isNearby = start <= m.end + maxGap && end + maxGap >= m.start;
+		const bool fits = jmax(m.end, end) - jmin(m.start, start) <= maxLength;
+
+		if (isNearby && fits)
+		{
+			m.start = jmin(m.start, start);
+			m.end = jmax(m.end, end);
+			m.numJobs++;
+			item.mergedReadIndex = i;
+			return;
+		}
+	}
+
+	if (mergedReads.size() < maxBatchSize)
+	{
+		mergedReads.add({ item.region.source, start, end, 1, false, item.deferred, {} });
+		item.mergedReadIndex = mergedReads.size() - 1;
+	}
+}
+
+void SampleThreadPool::Pimpl::finishMergedRead(int mergedReadIndex)
+{
+	if (mergedReadIndex == -1)
+		return;
+
+	auto& m = mergedReads.getReference(mergedReadIndex);
+
+	// All jobs have read their data, so the blocks can be evicted again
+	if (--m.numJobs == 0)
+		decodeCache->unpin(m.pinnedBlocks);
+}
+
+void SampleThreadPool::Pimpl::releasePinnedBlocks()
+{
+	for (auto& m : mergedReads)
+		decodeCache->unpin(m.pinnedBlocks);
+}
+
 SampleThreadPool::SampleThreadPool() :
 	Thread("Sample Loading Thread"),
 	pimpl(new Pimpl())
@@ -78,6 +307,30 @@ double SampleThreadPool::getDiskUsage() const noexcept
 	return pimpl->diskUsage.load();
 }
 
+hlac::HlacDecodeCache::Counters SampleThreadPool::getDecodeCacheCounters() const noexcept
+{
+	return pimpl->decodeCache->getCounters();
+}
+
+void SampleThreadPool::resetDecodeCacheCounters() noexcept
+{
+	pimpl->decodeCache->resetCounters();
+}
+
+SampleThreadPool::BatchCounters SampleThreadPool::getBatchCounters() const noexcept
+{
+	BatchCounters c;
+	c.numJobs = pimpl->numJobs.load();
+	c.numReads = pimpl->numMergedReads.load();
+	return c;
+}
+
+void SampleThreadPool::resetBatchCounters() noexcept
+{
+	pimpl->numJobs.store(0);
+	pimpl->numMergedReads.store(0);
+}
+
 void SampleThreadPool::clearPendingTasks()
 {
 	ScopedLock sl(pimpl->clearLock);
@@ -89,6 +342,21 @@ void SampleThreadPool::clearPendingTasks()
 		next->queued.store(false);
 		next->signalJobShouldExit();
 	}
+
+	for (int i = pimpl->batchPosition; i < pimpl->batch.size(); i++)
+	{
+		if (auto j = pimpl->batch.getReference(i).job.get())
+		{
+			j->queued.store(false);
+			j->signalJobShouldExit();
+		}
+	}
+
+	pimpl->releasePinnedBlocks();
+	pimpl->batch.clearQuick();
+	pimpl->mergedReads.clearQuick();
+	pimpl->batchPosition = 0;
+	pimpl->numPendingDeferred = 0;
 }
 
 void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
@@ -113,13 +381,38 @@ void SampleThreadPool::run()
 {
 	while (!threadShouldExit())
 	{
-		WeakReference<Job> next;
+		if (!pimpl->collectBatch())
+		{
+#if 0 // Set this to true to enable defective threading (for debugging purposes)
+			wait(2500);
+#else
+			wait(500);
+#endif
+			continue;
+		}
 
-		if (pimpl->jobQueue.try_dequeue(next))
+		while (!threadShouldExit())
 		{
 			ScopedLock sl(pimpl->clearLock);
 
-			Job* j = next.get();
+			// New jobs are added right away instead of waiting until the collected jobs are done
+			pimpl->addQueuedJobs();
+
+			if (pimpl->batchPosition >= pimpl->batch.size())
+				break;
+
+			auto item = pimpl->batch[pimpl->batchPosition++];
+
+			if (item.deferred)
+				pimpl->numPendingDeferred--;
+
+			Job* j = item.job.get();
+
+			if (j == nullptr)
+			{
+				pimpl->finishMergedRead(item.mergedReadIndex);
+				continue;
+			}
 
 #if ENABLE_CPU_MEASUREMENT
 
@@ -127,34 +420,43 @@ void SampleThreadPool::run()
 			pimpl->startTime = Time::getHighResolutionTicks();
 #endif
 
-			if (j != nullptr)
+			if (item.mergedReadIndex != -1)
 			{
-				pimpl->currentlyExecutedJob.store(j);
+				auto& m = pimpl->mergedReads.getReference(item.mergedReadIndex);
 
-				j->currentThread.store(this);
+				// Ask the job again, so we know that the source is still alive
+				if (!m.prefetched && m.numJobs > 1 && j->getReadRegion().source == m.source)
+				{
+					m.source->prefetchRegion(m.start, m.end - m.start, &m.pinnedBlocks);
+					m.prefetched = true;
+					++pimpl->numMergedReads;
+				}
+			}
 
-				j->running.store(true);
-				
-				Job::JobStatus status = j->runJob();
+			pimpl->currentlyExecutedJob.store(j);
 
-				j->running.store(false);
+			j->currentThread.store(this);
 
-				if (status == Job::jobHasFinished)
-				{
-					j->queued.store(false);
-				}
-				else if (status == Job::jobNeedsRunningAgain)
-				{
-					pimpl->jobQueue.enqueue(next);
-				}
+			j->running.store(true);
+				
+			Job::JobStatus status = j->runJob();
+
+			j->running.store(false);
 
-				pimpl->currentlyExecutedJob.store(nullptr);
+			if (status == Job::jobHasFinished)
+			{
+				j->queued.store(false);
 			}
-			else
+			else if (status == Job::jobNeedsRunningAgain)
 			{
-				pimpl->jobQueue.pop();
+				pimpl->jobQueue.enqueue(item.job);
 			}
 
+			pimpl->finishMergedRead(item.mergedReadIndex);
+
+			pimpl->currentlyExecutedJob.store(nullptr);
+			++pimpl->numJobs;
+
 #if ENABLE_CPU_MEASUREMENT
 			pimpl->endTime = Time::getHighResolutionTicks();
 
@@ -164,17 +466,6 @@ void SampleThreadPool::run()
 			pimpl->diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
 #endif
 		}
-
-#if 0 // Set this to true to enable defective threading (for debugging purposes)
-		wait(2500);
-#else
-		else
-		{
-			wait(500);
-		}
-#endif
-
-
 	}
 }
 
@@ -35,6 +35,33 @@
 
 namespace hise { using namespace juce;
 
+/** Keeps track of the time it takes to get new data from a sample file.
+*
+*	The SampleLoader reports the time between requesting a buffer and the buffer being filled, so the value includes
+*	the time the job spends waiting in the queue of the SampleThreadPool. It stores a peak value that decays slowly, so
+*	a single slow read is remembered for a while. All methods are lock free and can be called from any thread.
+*/
+class DiskLatencyTracker
+{
+public:
+
+	/** Adds a new measurement in seconds. */
+	void addMeasurement(double latencySeconds) noexcept;
+
+	/** Returns the decaying peak of the measured latency in seconds. */
+	double getPeakLatency() const noexcept { return (double)peakLatency.load(); }
+
+	/** Returns true if at least one read was measured. */
+	bool hasMeasurements() const noexcept { return measured.load(); }
+
+	void reset() noexcept;
+
+private:
+
+	std::atomic<float> peakLatency { 0.0f };
+	std::atomic<bool> measured { false };
+};
+
 class SampleThreadPool : public Thread
 {
 public:
@@ -43,6 +70,36 @@ public:
 
 	~SampleThreadPool();
 	
+	/** A file that can read a region in advance so that the jobs which read from it are served from memory.
+	*
+	*	All sounds that stream from the same monolith channel share one ReadSource, so the SampleThreadPool
+	*	can merge their reads.
+	*/
+	class ReadSource
+	{
+	public:
+
+		virtual ~ReadSource() {};
+
+		/** Tells the OS that the region will be read soon. This must not block. */
+		virtual void hintRegion(int64 startSample, int64 numSamples) = 0;
+
+		/** Reads the region in one pass so that the following reads of the jobs are cheap.
+		*
+		*	If pinnedBlocks is not null, the decoded blocks are pinned in the decode cache until the caller unpins them.
+		*/
+		virtual void prefetchRegion(int64 startSample, int64 numSamples, hlac::HlacDecodeCache::PinnedBlocks* pinnedBlocks=nullptr) = 0;
+	};
+
+	/** The region a job is going to read the next time it runs. */
+	struct ReadRegion
+	{
+		bool isValid() const noexcept { return source != nullptr && numSamples > 0; }
+
+		ReadSource* source = nullptr;
+		int64 start = 0;
+		int64 numSamples = 0;
+	};
 
 	class Job
 	{
@@ -65,6 +122,18 @@ public:
 
 		virtual JobStatus runJob() = 0;
 
+		/** Override this and return the region that the next runJob() call will read.
+		*
+		*	Jobs that must run soon are executed in the order they were added and only their overlapping regions
+		*	are decoded in one pass. Jobs that can wait (see getSecondsUntilDeadline()) are executed after them,
+		*	sorted by file and position, and their nearby regions are merged into a single read. */
+		virtual ReadRegion getReadRegion() const { return {}; }
+
+		/** Override this and return how long the job can wait in seconds before its result is needed.
+		*
+		*	The default returns 0.0, which means that the job is executed before all jobs that can wait. */
+		virtual double getSecondsUntilDeadline() const { return 0.0; }
+
 		bool shouldExit() const noexcept{ return shouldStop.load(); }
 
 		void signalJobShouldExit() { shouldStop.store(true); }
@@ -95,8 +164,24 @@ public:
 
 	double getDiskUsage() const noexcept;
 
+	/** Returns the hit / miss counters of the HLAC decode cache that is shared by all monoliths in this process. */
+	hlac::HlacDecodeCache::Counters getDecodeCacheCounters() const noexcept;
+
+	void resetDecodeCacheCounters() noexcept;
+
 	void clearPendingTasks();
 
+	struct BatchCounters
+	{
+		int64 numJobs = 0;		///< the number of executed jobs
+		int64 numReads = 0;		///< the number of merged regions that were prefetched
+	};
+
+	/** Returns the number of jobs and the number of merged reads since the last reset. */
+	BatchCounters getBatchCounters() const noexcept;
+
+	void resetBatchCounters() noexcept;
+
 	void addJob(Job* jobToAdd, bool unused);
 
 	void run() override;
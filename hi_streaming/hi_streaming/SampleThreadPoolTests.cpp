@@ -0,0 +1,284 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+#if HI_RUN_UNIT_TESTS
+
+/** Streams a HLAC file with multiple voices through the SampleThreadPool.
+*
+*	It checks that the batched reads return the original signal and compares the throughput of urgent jobs
+*	(queue order, only overlapping reads are merged) with jobs that can wait (sorted and nearby reads merged).
+*/
+class SampleThreadPoolTests : public UnitTest
+{
+public:
+
+	SampleThreadPoolTests() :
+		UnitTest("Testing the batched reads of the sample loading thread")
+	{}
+
+	void runTest() override
+	{
+		testBatchedReads(1);
+		testBatchedReads(8);
+		testBatchedReads(32);
+		testBatchedReads(128);
+	}
+
+private:
+
+	static constexpr int TotalLength = 441000;
+	static constexpr int ChunkSize = 4096;
+	static constexpr int NumRounds = 16;
+
+	/** A memory mapped HLAC file that uses the decode cache of the pool like a channel of a monolith. */
+	struct TestFile : public SampleThreadPool::ReadSource
+	{
+		TestFile(const AudioSampleBuffer& signal)
+		{
+			auto f = tempFile.getFile();
+
+			{
+				hlac::HiseLosslessAudioFormat hlaf;
+				StringPairArray empty;
+
+				ScopedPointer<AudioFormatWriter> writer = hlaf.createWriterFor(new FileOutputStream(f), 44100.0, signal.getNumChannels(), 0, empty, 0);
+
+				writer->writeFromAudioSampleBuffer(signal, 0, signal.getNumSamples());
+				writer->flush();
+			}
+
+			hlac::HiseLosslessAudioFormat hlaf;
+			reader = dynamic_cast<hlac::HlacMemoryMappedAudioFormatReader*>(hlaf.createMemoryMappedReader(f));
+
+			reader->mapEntireFile();
+			reader->setTargetAudioDataType(AudioDataConverters::DataFormat::int16BE);
+			reader->setDecodeCache(decodeCache, hlac::HlacDecodeCache::createKeyForFile(f));
+		}
+
+		void hintRegion(int64 startSample, int64 numSamples) override
+		{
+			reader->adviseWillNeed(startSample, numSamples);
+		}
+
+		void prefetchRegion(int64 startSample, int64 numSamples, hlac::HlacDecodeCache::PinnedBlocks* pinnedBlocks) override
+		{
+			reader->decodeIntoCache(startSample, numSamples, pinnedBlocks);
+		}
+
+		TemporaryFile tempFile;
+		SharedResourcePointer<hlac::HlacDecodeCache> decodeCache;
+		ScopedPointer<hlac::HlacMemoryMappedAudioFormatReader> reader;
+	};
+
+	struct VoiceJob : public SampleThreadPool::Job
+	{
+		VoiceJob(TestFile& file_, const AudioSampleBuffer& original_, int startPosition_, double secondsUntilDeadline_) :
+			Job("Test Voice"),
+			file(file_),
+			original(original_),
+			startPosition(startPosition_),
+			secondsUntilDeadline(secondsUntilDeadline_),
+			buffer(false, original_.getNumChannels(), ChunkSize),
+			floatBuffer(original_.getNumChannels(), ChunkSize),
+			expected(original_.getNumChannels(), ChunkSize)
+		{}
+
+		JobStatus runJob() override
+		{
+			hlac::HlacSubSectionReader subReader(file.reader, 0, TotalLength);
+
+			buffer.clearNormalisation({});
+			subReader.readIntoFixedBuffer(buffer, 0, ChunkSize, position);
+
+			if (checkResult)
+			{
+				buffer.convertToFloatWithNormalisation(floatBuffer.getArrayOfWritePointers(), original.getNumChannels(), 0, ChunkSize);
+
+				for (int c = 0; c < original.getNumChannels(); c++)
+					expected.copyFrom(c, 0, original, c, position, ChunkSize);
+
+				numErrors += hlac::CompressionHelpers::checkBuffersEqual(floatBuffer, expected);
+			}
+
+			return jobHasFinished;
+		}
+
+		SampleThreadPool::ReadRegion getReadRegion() const override
+		{
+			return { &file, position, ChunkSize };
+		}
+
+		double getSecondsUntilDeadline() const override { return secondsUntilDeadline; }
+
+		TestFile& file;
+		const AudioSampleBuffer& original;
+
+		const int startPosition;
+		const double secondsUntilDeadline;
+
+		int64 position = 0;
+		bool checkResult = false;
+		int numErrors = 0;
+
+		hlac::HiseSampleBuffer buffer;
+		AudioSampleBuffer floatBuffer;
+		AudioSampleBuffer expected;
+	};
+
+	/** Keeps the pool busy until all voices of a round are queued, like a slow read would do. */
+	struct BlockingJob : public SampleThreadPool::Job
+	{
+		BlockingJob() : Job("Blocking Job") {}
+
+		JobStatus runJob() override
+		{
+			released.wait();
+			return jobHasFinished;
+		}
+
+		WaitableEvent released;
+	};
+
+	static AudioSampleBuffer createTestSignal(int numChannels)
+	{
+		AudioSampleBuffer b(numChannels, TotalLength);
+		Random r(1);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			auto d = b.getWritePointer(c);
+
+			for (int i = 0; i < TotalLength; i++)
+				d[i] = 0.5f * std::sin((float)i * 0.01f * (float)(c + 1)) + 0.05f * (r.nextFloat() - 0.5f);
+		}
+
+		return b;
+	}
+
+	/** Runs all rounds of the voices through the pool and returns the time in seconds. */
+	double streamVoices(SampleThreadPool& pool, OwnedArray<VoiceJob>& voices, bool checkResult)
+	{
+		const double start = Time::getMillisecondCounterHiRes();
+
+		BlockingJob blocker;
+
+		for (int round = 0; round < NumRounds; round++)
+		{
+			pool.addJob(&blocker, false);
+
+			for (auto v : voices)
+			{
+				v->position = v->startPosition + round * ChunkSize;
+				v->checkResult = checkResult;
+				pool.addJob(v, false);
+			}
+
+			blocker.released.signal();
+
+			while (blocker.isQueued())
+				Thread::yield();
+
+			for (auto v : voices)
+			{
+				while (v->isQueued())
+					Thread::yield();
+			}
+		}
+
+		return (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+	}
+
+	void testBatchedReads(int numVoices)
+	{
+		beginTest("Testing batched reads with " + String(numVoices) + " voices");
+
+		auto original = createTestSignal(2);
+
+		SampleThreadPool pool;
+
+		// Use two files so that the second run doesn't read the blocks that the first run decoded
+		TestFile urgentFile(original);
+		TestFile deferredFile(original);
+
+		OwnedArray<VoiceJob> urgentVoices, deferredVoices;
+
+		Random r(numVoices);
+
+		for (int i = 0; i < numVoices; i++)
+		{
+			const int startPosition = r.nextInt(TotalLength - NumRounds * ChunkSize);
+
+			urgentVoices.add(new VoiceJob(urgentFile, original, startPosition, 0.0));
+			deferredVoices.add(new VoiceJob(deferredFile, original, startPosition, 1.0));
+		}
+
+		pool.resetBatchCounters();
+
+		const double urgentSeconds = streamVoices(pool, urgentVoices, false);
+		const auto urgentCounters = pool.getBatchCounters();
+
+		pool.resetBatchCounters();
+
+		const double deferredSeconds = streamVoices(pool, deferredVoices, false);
+		const auto deferredCounters = pool.getBatchCounters();
+
+		// Run again to check the data that is read from the cache and the merged reads
+		streamVoices(pool, urgentVoices, true);
+		streamVoices(pool, deferredVoices, true);
+
+		int numErrors = 0;
+
+		for (auto v : urgentVoices)
+			numErrors += v->numErrors;
+
+		for (auto v : deferredVoices)
+			numErrors += v->numErrors;
+
+		expectEquals<int>(numErrors, 0, "Batched reads don't match the original signal");
+		// The blocking job is counted as well
+		expectEquals<int>((int)deferredCounters.numJobs, (numVoices + 1) * NumRounds, "All jobs were executed");
+
+		const double numSecondsRead = (double)(numVoices * NumRounds * ChunkSize) / 44100.0;
+
+		logMessage("Urgent jobs: " + String(numSecondsRead / urgentSeconds, 1) + "x realtime, " + String(urgentCounters.numReads) + " merged reads");
+		logMessage("Deferred jobs: " + String(numSecondsRead / deferredSeconds, 1) + "x realtime, " + String(deferredCounters.numReads) + " merged reads");
+	}
+};
+
+static SampleThreadPoolTests sampleThreadPoolTests;
+
+#endif
+
+} // namespace hise
@@ -46,6 +46,19 @@ void StreamingHelpers::increaseBufferIfNeeded(hlac::HiseSampleBuffer& b, int num
 	}
 }
 
+int StreamingHelpers::getBufferSizeForLatency(double latencySeconds, double sampleRate, double pitchRatio, int blockSize)
+{
+	const double pitchToUse = jlimit<double>(1.0, (double)MAX_SAMPLER_PITCH, pitchRatio);
+	const double numSamplesDuringRead = ADAPTIVE_STREAMING_SAFETY_FACTOR * latencySeconds * sampleRate;
+	const int numSamples = roundToInt(pitchToUse * (numSamplesDuringRead + (double)blockSize));
+
+	// Round it up to the next multiple of 1024 so that small changes in the measurement don't cause a reallocation
+	const int rounded = ((numSamples + 1023) / 1024) * 1024;
+
+	// A latency that would need more than a few seconds of audio is a stuck disk, not a slow one
+	return jlimit<int>(2048, 262144, rounded);
+}
+
 bool StreamingHelpers::preloadSample(StreamingSamplerSound * s, const int preloadSize, String& errorMessage)
 {
 	try
@@ -55,6 +55,15 @@ struct StreamingHelpers
 
 	static bool preloadSample(StreamingSamplerSound * s, const int preloadSize, String& errorMessage);
 
+	/** Calculates the amount of samples a buffer needs so that it lasts until the next read is finished.
+	*
+	*	@param latencySeconds the time between requesting new data and the buffer being filled (see DiskLatencyTracker)
+	*	@param sampleRate the sample rate of the file
+	*	@param pitchRatio the highest playback speed of the file
+	*	@param blockSize the largest amount of samples that are rendered in one audio callback
+	*/
+	static int getBufferSizeForLatency(double latencySeconds, double sampleRate, double pitchRatio, int blockSize);
+
 	/** Creates a BasicMappingData object from the given samplemap entry. */
 	static BasicMappingData getBasicMappingDataFromSample(const ValueTree& sampleData);
 };
@@ -150,6 +159,18 @@ struct StereoChannelData
 // Same as the preload size.
 #define BUFFER_SIZE_FOR_STREAM_BUFFERS 4096
 
+// The adaptive buffer sizing multiplies the measured disk latency with this factor to cover reads that are slower than
+// everything that was measured so far.
+#ifndef ADAPTIVE_STREAMING_SAFETY_FACTOR
+#define ADAPTIVE_STREAMING_SAFETY_FACTOR 2.0
+#endif
+
+// The disk latency in milliseconds that the adaptive buffer sizing assumes before the voices measured their reads.
+// A probe read after preloading might be served from the file cache, so this covers the seek time of a hard disk.
+#ifndef ADAPTIVE_STREAMING_INITIAL_LATENCY_MS
+#define ADAPTIVE_STREAMING_INITIAL_LATENCY_MS 15.0
+#endif
+
 // Deactivate this to use one rounded pitch value for one a buffer (crucial for other interpolation methods than linear interpolation)
 #define USE_SAMPLE_ACCURATE_RESAMPLING 0
 
@@ -280,6 +280,65 @@ void StreamingSamplerSound::closeFileHandle()
 	fileReader.closeFileHandles();
 }
 
+SampleThreadPool::ReadRegion StreamingSamplerSound::getReadRegion(int uptime, int numSamples) const
+{
+	if (loopEnabled || entireSampleLoaded || !fileReader.isMonolithic())
+		return {};
+
+	const int start = uptime + (int)sampleStart;
+	const int end = jmin(start + numSamples, sampleEnd);
+
+	// These samples will be copied from the preload buffer
+	if (end <= start || end < internalPreloadSize)
+		return {};
+
+	return fileReader.getReadRegion(start + monolithOffset, end - start);
+}
+
+int StreamingSamplerSound::prefetchStreamingArea(int numSamples) const
+{
+	ScopedLock sl(getSampleLock());
+
+	auto region = getReadRegion(preloadBuffer.getNumSamples(), numSamples);
+
+	if (!region.isValid())
+		return 0;
+
+	region.source->prefetchRegion(region.start, region.numSamples);
+	return (int)region.numSamples;
+}
+
+void StreamingSamplerSound::measureReadLatency(int numSamplesToRead) const
+{
+	const int preloadEnd = preloadBuffer.getNumSamples();
+	const int numSamples = jmin<int>(numSamplesToRead, (int)sampleLength - preloadEnd);
+
+	if (entireSampleLoaded || preloadEnd == 0 || numSamples <= 0)
+		return;
+
+	// The probe might still be served from the file cache, so never assume less than the default
+	getLatencyTracker().addMeasurement(ADAPTIVE_STREAMING_INITIAL_LATENCY_MS * 0.001);
+
+	// Read the end of the sample so that the probe isn't covered by the read-ahead of the preloading
+	const int offset = (int)sampleLength - numSamples;
+
+	if (offset < preloadEnd + numSamples)
+		return;
+
+	hlac::HiseSampleBuffer probeBuffer(!fileReader.isMonolithic(), 2, numSamples);
+
+	// fillSampleBuffer() skips the read if no voice is using the file
+	increaseVoiceCount();
+
+	const double readStart = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
+	fillSampleBuffer(probeBuffer, numSamples, offset);
+	const double readStop = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
+
+	decreaseVoiceCount();
+
+	getLatencyTracker().addMeasurement(readStop - readStart);
+}
+
 void StreamingSamplerSound::openFileHandle()
 {
 	fileReader.openFileHandles();
@@ -988,6 +1047,22 @@ void StreamingSamplerSound::FileReader::openFileHandles(NotificationType notifyP
 }
 
 
+DiskLatencyTracker& StreamingSamplerSound::FileReader::getLatencyTracker()
+{
+	if (monolithicInfo != nullptr)
+		return monolithicInfo->getLatencyTracker();
+
+	return *sharedLatencyTracker;
+}
+
+SampleThreadPool::ReadRegion StreamingSamplerSound::FileReader::getReadRegion(int readerPosition, int numSamples) const
+{
+	if (monolithicInfo != nullptr)
+		return monolithicInfo->getReadRegion(monolithicIndex, monolithicChannelIndex, readerPosition, numSamples);
+
+	return {};
+}
+
 bool StreamingSamplerSound::FileReader::isStereo() const noexcept
 {
 	return stereo;
@@ -201,6 +201,31 @@ public:
 	void openFileHandle();
 	bool isOpened();
 
+	/** Returns the latency measurement of the file this sound streams from. All sounds of a monolith share one tracker. */
+	DiskLatencyTracker& getLatencyTracker() const { return fileReader.getLatencyTracker(); }
+
+	/** Seeds the latency tracker with a conservative default and measures a read at the end of the sample.
+	*
+	*	This gives an estimate of the disk latency before any voice has streamed from the file. The probe is not adjacent
+	*	to the preload buffer, so it is not served by the read-ahead of the preloading. Call it after the preload buffer
+	*	was loaded and before the file handle is closed.
+	*/
+	void measureReadLatency(int numSamplesToRead) const;
+
+	/** Returns the region in the file that fillSampleBuffer() will read from disk for the given position.
+	*
+	*	The region is only valid for monolithic files and if the samples are neither coming from the preload buffer nor
+	*	from a loop. The sample loading thread uses it to merge overlapping reads of all voices.
+	*/
+	SampleThreadPool::ReadRegion getReadRegion(int uptime, int numSamples) const;
+
+	/** Decodes the given amount of samples after the preload buffer into the HLAC decode cache.
+	*
+	*	Call this on the sample loading thread for sounds that are likely to be started soon. It does nothing for sounds
+	*	that are not streamed from a monolith. Returns the number of samples that were requested from the file.
+	*/
+	int prefetchStreamingArea(int numSamples) const;
+
 	bool isStereo() const;
 
 	int getBitRate() const;
@@ -213,6 +238,7 @@ public:
 	AudioFormatReader* createReaderForAnalysis();
 
 	int64 getMonolithOffset() const { return fileReader.getMonolithOffset(); }
+	File getMonolithFile() const { return fileReader.getMonolithFile(); }
 	int64 getMonolithLength() const { return fileReader.getMonolithLength(); }
 	double getMonolithSampleRate() const { return fileReader.getMonolithSampleRate(); }
 
@@ -329,6 +355,13 @@ private:
 
 		// ==============================================================================================================================================
 
+		DiskLatencyTracker& getLatencyTracker();
+
+		/** Returns the region of the monolith that a call to readFromDisk() will touch. */
+		SampleThreadPool::ReadRegion getReadRegion(int readerPosition, int numSamples) const;
+
+		// ==============================================================================================================================================
+
 		void increaseVoiceCount() { ++voiceCount; };
 		void decreaseVoiceCount() { --voiceCount; voiceCount.compareAndSetBool(0, -1); }
 
@@ -351,6 +384,14 @@ private:
 			return 0;
 		}
 
+		File getMonolithFile() const
+		{
+			if (monolithicInfo != nullptr)
+				return monolithicInfo->getMonolithFile(monolithicChannelIndex);
+
+			return {};
+		}
+
 		int64 getMonolithLength() const
 		{
 			if (monolithicInfo != nullptr)
@@ -413,6 +454,9 @@ private:
 
 		StreamingSamplerSound *sound;
 
+		// used by all sounds that are not part of a monolith
+		SharedResourcePointer<DiskLatencyTracker> sharedLatencyTracker;
+
 		ScopedPointer<MemoryMappedAudioFormatReader> memoryReader;
 		ScopedPointer<AudioFormatReader> normalReader;
 		bool fileHandlesOpen;
@@ -183,6 +183,13 @@ void SampleLoader::setStreamingBufferDataType(bool shouldBeFloat)
 {
 	if (b1.isFloatingPoint() != shouldBeFloat)
 	{
+		// Same as in refreshBufferSizes(), the buffers of a playing voice must not be replaced
+		if (sound.get() != nullptr)
+		{
+			jassertfalse;
+			return;
+		}
+
 		ScopedLock sl(getLock());
 
 		b1 = hlac::HiseSampleBuffer(shouldBeFloat, 2, 0);
@@ -362,6 +369,7 @@ int SampleLoader::getNumSamplesForStreamingBuffers() const
 bool SampleLoader::requestNewData()
 {
 	cancelled = false;
+	requestTime = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
 
 	if (nonRealtime)
 	{
@@ -425,9 +433,37 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 	diskUsage = diskUsageThisTime;
 	lastCallToRequestData = readStart;
 
+	if (localSound != nullptr)
+		localSound->getLatencyTracker().addMeasurement(readStop - requestTime.load());
+
 	return SampleThreadPoolJob::JobStatus::jobHasFinished;
 }
 
+SampleThreadPool::ReadRegion SampleLoader::getReadRegion() const
+{
+	const StreamingSamplerSound *localSound = sound.get();
+
+	if (cancelled || localSound == nullptr)
+		return {};
+
+	return localSound->getReadRegion(positionInSampleFile, getNumSamplesForStreamingBuffers());
+}
+
+double SampleLoader::getSecondsUntilDeadline() const
+{
+	const StreamingSamplerSound *localSound = sound.get();
+	auto localReadBuffer = readBuffer.get();
+
+	if (cancelled || localSound == nullptr || localReadBuffer == nullptr || localSound->getSampleRate() <= 0.0)
+		return 0.0;
+
+	// The pitch of the voice is not known here, so this assumes that it plays at the original speed
+	const double numSamplesLeft = (double)localReadBuffer->getNumSamples() - readIndexDouble;
+	const double secondsLeft = numSamplesLeft / localSound->getSampleRate();
+
+	return jmax(0.0, secondsLeft - localSound->getLatencyTracker().getPeakLatency());
+}
+
 size_t SampleLoader::getActualStreamingBufferSize() const
 {
 	return b1.getNumSamples() * 2 * 2;
@@ -491,16 +527,26 @@ void SampleLoader::refreshBufferSizes()
 {
 	const int numSamplesToUse = jmax<int>(idealBufferSize, minimumBufferSizeForSamplesPerBlock);
 
-	if (getNumSamplesForStreamingBuffers() < numSamplesToUse)
-	{
-		StreamingHelpers::increaseBufferIfNeeded(b1, numSamplesToUse);
-		StreamingHelpers::increaseBufferIfNeeded(b2, numSamplesToUse);
+	if (getNumSamplesForStreamingBuffers() == numSamplesToUse)
+		return;
 
-		readBuffer = &b1;
-		writeBuffer = &b2;
+	// A playing voice (or a read that hasn't finished yet) uses these buffers, so they must not be resized
+	// or cleared. The sampler resets its voices before it changes the size, so the new size is only postponed
+	// to the next refresh.
+	if (sound.get() != nullptr || isRunning())
+		return;
 
-		reset();
-	}
+	// The buffers can also shrink if the adaptive sizing found out that
+	// the disk is faster than the last guess
+	b1.setSize(b1.getNumChannels(), numSamplesToUse);
+	b1.clear();
+	b2.setSize(b2.getNumChannels(), numSamplesToUse);
+	b2.clear();
+
+	readBuffer = &b1;
+	writeBuffer = &b2;
+
+	reset();
 }
 
 bool SampleLoader::swapBuffers()
@@ -69,6 +69,12 @@ public:
 	*/
 	JobStatus runJob() override;
 
+	/** Returns the region of the sound that the next call to runJob() will read. */
+	SampleThreadPool::ReadRegion getReadRegion() const override;
+
+	/** Returns the time until the voice reaches the end of the current buffer minus the measured disk latency. */
+	double getSecondsUntilDeadline() const override;
+
 	size_t getActualStreamingBufferSize() const;
 
 	void setStreamingBufferDataType(bool shouldBeFloat);
@@ -197,6 +203,9 @@ private:
 	Atomic<float> diskUsage;
 	double lastCallToRequestData;
 
+	// the time of the last call to requestNewData() for the latency measurement
+	std::atomic<double> requestTime { 0.0 };
+
 	// just a pointer to the used pool
 	SampleThreadPool *backgroundPool;
 
@@ -581,12 +581,460 @@ void AudioSampleBufferComponentBase::paintOverChildren(Graphics& g)
 	}
 }
 
+PeakPyramid::PeakPyramid(const float* const* channels, int numChannels_, int numSamples_) :
+	numChannels(numChannels_),
+	numSamples(numSamples_)
+{
+	const int blockSize = getBlockSize(0);
+
+	Array<Array<Peak>> firstLevel;
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		Array<Peak> peaks;
+		peaks.ensureStorageAllocated(numSamples / blockSize + 1);
+
+		for (int i = 0; i < numSamples; i += blockSize)
+		{
+			Peak p;
+			addBlock(p, channels[c] + i, jmin(blockSize, numSamples - i));
+			peaks.add(p);
+		}
+
+		firstLevel.add(std::move(peaks));
+	}
+
+	buildLevels(firstLevel);
+}
+
+PeakPyramid::PeakPyramid(AudioFormatReader& reader, int64 numSamples_, const std::function<bool()>& shouldAbort) :
+	numChannels(jlimit(1, 2, (int)reader.numChannels)),
+	numSamples((int)jmin<int64>(numSamples_, reader.lengthInSamples))
+{
+	const int blockSize = getBlockSize(0);
+	const int chunkSize = blockSize * 4096;
+
+	AudioSampleBuffer chunk(numChannels, chunkSize);
+
+	Array<Array<Peak>> firstLevel;
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		firstLevel.add({});
+		firstLevel.getReference(c).ensureStorageAllocated(numSamples / blockSize + 1);
+	}
+
+	for (int pos = 0; pos < numSamples; pos += chunkSize)
+	{
+		if (shouldAbort && shouldAbort())
+		{
+			numSamples = 0;
+			return;
+		}
+
+		const int numThisTime = jmin(chunkSize, numSamples - pos);
+
+		reader.read(&chunk, 0, numThisTime, pos, true, true);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			auto data = chunk.getReadPointer(c);
+
+			for (int i = 0; i < numThisTime; i += blockSize)
+			{
+				Peak p;
+				addBlock(p, data + i, jmin(blockSize, numThisTime - i));
+				firstLevel.getReference(c).add(p);
+			}
+		}
+	}
+
+	buildLevels(firstLevel);
+}
+
+PeakPyramid::PeakPyramid(InputStream& input)
+{
+	static_assert(sizeof(Peak) == 3 * sizeof(float), "Peak must be tightly packed");
+
+	if (input.readInt() != (int)ByteOrder::littleEndianInt("HPKP"))
+		return;
+
+	auto numChannelsToRead = input.readInt();
+	auto numSamplesToRead = input.readInt();
+	auto numLevels = input.readInt();
+
+	if (!isPositiveAndBelow(numChannelsToRead - 1, 2) || numSamplesToRead <= 0 || !isPositiveAndNotGreaterThan(numLevels, (int)MaxNumLevels))
+		return;
+
+	for (int i = 0; i < numLevels * numChannelsToRead; i++)
+	{
+		auto numPeaks = input.readInt();
+
+		if (numPeaks <= 0 || numPeaks > numSamplesToRead)
+		{
+			levels.clear();
+			return;
+		}
+
+		Array<Peak> peaks;
+		peaks.resize(numPeaks);
+
+		auto numBytes = (int)(numPeaks * sizeof(Peak));
+
+		if (input.read(peaks.getRawDataPointer(), numBytes) != numBytes)
+		{
+			levels.clear();
+			return;
+		}
+
+		levels.add(std::move(peaks));
+	}
+
+	numChannels = numChannelsToRead;
+	numSamples = numSamplesToRead;
+}
+
+void PeakPyramid::writeToStream(OutputStream& output) const
+{
+	output.writeInt((int)ByteOrder::littleEndianInt("HPKP"));
+	output.writeInt(numChannels);
+	output.writeInt(numSamples);
+	output.writeInt(getNumLevels());
+
+	for (const auto& peaks : levels)
+	{
+		output.writeInt(peaks.size());
+		output.write(peaks.begin(), peaks.size() * sizeof(Peak));
+	}
+}
+
+int PeakPyramid::getLevelForStride(int stride) const
+{
+	if (stride < getBlockSize(0))
+		return -1;
+
+	int level = 0;
+
+	while (level < getNumLevels() - 1 && getBlockSize(level + 1) <= stride)
+		level++;
+
+	return level;
+}
+
+Range<float> PeakPyramid::getTotalRange(int channel) const
+{
+	if (!isValid())
+		return {};
+
+	const auto& peaks = getPeaks(channel, getNumLevels() - 1);
+
+	auto minValue = peaks.getReference(0).minValue;
+	auto maxValue = peaks.getReference(0).maxValue;
+
+	for (const auto& p : peaks)
+	{
+		minValue = jmin(minValue, p.minValue);
+		maxValue = jmax(maxValue, p.maxValue);
+	}
+
+	return { minValue, maxValue };
+}
+
+int64 PeakPyramid::createCacheKey(const String& sourceId, int64 offset, int64 length, const File& sourceFile)
+{
+	String s;
+	s << sourceId << "@" << String(offset) << ":" << String(length);
+
+	File f = sourceFile;
+
+	if (f == File() && File::isAbsolutePath(sourceId))
+		f = File(sourceId);
+
+	if (f.existsAsFile())
+		s << ":" << String(f.getLastModificationTime().toMilliseconds()) << ":" << String(f.getSize());
+
+	return s.hashCode64();
+}
+
+void PeakPyramid::buildLevels(const Array<Array<Peak>>& firstLevel)
+{
+	levels.clear();
+
+	if (numSamples == 0)
+		return;
+
+	levels.addArray(firstLevel);
+
+	for (int level = 1; level < MaxNumLevels; level++)
+	{
+		const auto numPrevious = levels.getReference((level - 1) * numChannels).size();
+
+		if (numPrevious <= 1)
+			break;
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			const auto& previous = levels.getReference((level - 1) * numChannels + c);
+
+			Array<Peak> peaks;
+			peaks.ensureStorageAllocated(numPrevious / 2 + 1);
+
+			for (int i = 0; i < numPrevious; i += 2)
+			{
+				auto p = previous.getReference(i);
+
+				if (i + 1 < numPrevious)
+				{
+					const auto& n = previous.getReference(i + 1);
+
+					p.minValue = jmin(p.minValue, n.minValue);
+					p.maxValue = jmax(p.maxValue, n.maxValue);
+					p.rms = std::sqrt((p.rms * p.rms + n.rms * n.rms) * 0.5f);
+				}
+
+				peaks.add(p);
+			}
+
+			levels.add(std::move(peaks));
+		}
+	}
+}
+
+void PeakPyramid::addBlock(Peak& p, const float* data, int numToCheck)
+{
+	auto r = FloatVectorOperations::findMinAndMax(data, numToCheck);
+
+	float sum = 0.0f;
+
+	for (int i = 0; i < numToCheck; i++)
+		sum += data[i] * data[i];
+
+	p.minValue = r.getStart();
+	p.maxValue = r.getEnd();
+	p.rms = std::sqrt(sum / (float)jmax(1, numToCheck));
+}
+
+struct PeakPyramid::Cache::Job : public ReferenceCountedObject
+{
+	using Ptr = ReferenceCountedObjectPtr<Job>;
+
+	Job(int64 key_, const File& cacheFile_, AudioFormatReader* r, int64 numSamples_) :
+		key(key_),
+		cacheFile(cacheFile_),
+		reader(r),
+		numSamples(numSamples_)
+	{}
+
+	struct Runner : public ThreadPoolJob
+	{
+		Runner(Cache& parent_, Job* job_) :
+			ThreadPoolJob("Peak Pyramid"),
+			parent(parent_),
+			job(job_)
+		{}
+
+		JobStatus runJob() override
+		{
+			job->run(*this);
+
+			{
+				ScopedLock sl(parent.lock);
+
+				if (job->result != nullptr)
+				{
+					// Drop the pyramids that are only referenced by the cache. This is
+					// safe because new references can only be created with the lock held.
+					Array<int64> unusedKeys;
+
+					for (HashMap<int64, PeakPyramid::Ptr>::Iterator it(parent.pyramids); it.next();)
+					{
+						if (it.getValue()->getReferenceCount() == 1)
+							unusedKeys.add(it.getKey());
+					}
+
+					for (auto k : unusedKeys)
+						parent.pyramids.remove(k);
+
+					parent.pyramids.set(job->key, job->result);
+				}
+
+				parent.pendingJobs.removeObject(job.get());
+			}
+
+			job->done.signal();
+			return jobHasFinished;
+		}
+
+		Cache& parent;
+		Job::Ptr job;
+	};
+
+	void run(ThreadPoolJob& runner)
+	{
+		if (cacheFile.existsAsFile())
+		{
+			FileInputStream fis(cacheFile);
+
+			if (fis.openedOk())
+			{
+				PeakPyramid::Ptr p = new PeakPyramid(fis);
+
+				if (p->isValid() && p->getNumSamples() == (int)numSamples)
+				{
+					// Mark it as recently used for purgeCacheDirectory()
+					cacheFile.setLastAccessTime(Time::getCurrentTime());
+
+					result = p;
+					reader = nullptr;
+					return;
+				}
+			}
+		}
+
+		if (reader != nullptr)
+		{
+			PeakPyramid::Ptr p = new PeakPyramid(*reader, numSamples, [&runner]() { return runner.shouldExit(); });
+
+			reader = nullptr;
+
+			if (p->isValid())
+			{
+				result = p;
+
+				cacheFile.getParentDirectory().createDirectory();
+
+				{
+					FileOutputStream fos(cacheFile);
+
+					if (fos.openedOk())
+					{
+						fos.setPosition(0);
+						fos.truncate();
+						p->writeToStream(fos);
+					}
+				}
+
+				Cache::purgeCacheDirectory(cacheFile);
+			}
+		}
+	}
+
+	const int64 key;
+	const File cacheFile;
+	ScopedPointer<AudioFormatReader> reader;
+	const int64 numSamples;
+
+	PeakPyramid::Ptr result;
+	WaitableEvent done{ true };
+};
+
+PeakPyramid::Cache::Cache() :
+	pool("Peak Pyramid Builder", 2)
+{}
+
+PeakPyramid::Cache::~Cache()
+{
+	pool.removeAllJobs(true, 2000);
+}
+
+PeakPyramid::Ptr PeakPyramid::Cache::getPyramid(int64 key, AudioFormatReader* readerToOwn, int64 numSamples, Thread* callingThread)
+{
+	ScopedPointer<AudioFormatReader> reader(readerToOwn);
+	Job::Ptr job;
+
+	{
+		ScopedLock sl(lock);
+
+		if (pyramids.contains(key))
+			return pyramids[key];
+
+		for (auto j : pendingJobs)
+		{
+			if (j->key == key)
+			{
+				job = j;
+				break;
+			}
+		}
+
+		if (job == nullptr)
+		{
+			job = new Job(key, getCacheFile(key), reader.release(), numSamples);
+			pendingJobs.add(job.get());
+			pool.addJob(new Job::Runner(*this, job.get()), true);
+		}
+	}
+
+	while (!job->done.wait(50))
+	{
+		if (callingThread != nullptr && callingThread->threadShouldExit())
+			return nullptr;
+	}
+
+	return job->result;
+}
+
+File PeakPyramid::Cache::getCacheDirectory()
+{
+	return File::getSpecialLocation(File::tempDirectory).getChildFile("HISE").getChildFile("PeakCache");
+}
+
+File PeakPyramid::Cache::getCacheFile(int64 key) const
+{
+	return getCacheDirectory().getChildFile(String::toHexString(key)).withFileExtension("hpk");
+}
+
+void PeakPyramid::Cache::purgeCacheDirectory(const File& fileToKeep)
+{
+	auto files = getCacheDirectory().findChildFiles(File::findFiles, false, "*.hpk");
+
+	int64 totalSize = 0;
+
+	for (const auto& f : files)
+		totalSize += f.getSize();
+
+	if (totalSize <= MaxCacheDirectorySize)
+		return;
+
+	struct AccessTimeSorter
+	{
+		static int compareElements(const File& first, const File& second)
+		{
+			const auto t1 = first.getLastAccessTime();
+			const auto t2 = second.getLastAccessTime();
+
+			if (t1 < t2) return -1;
+			if (t1 > t2) return 1;
+			return 0;
+		}
+	};
+
+	AccessTimeSorter sorter;
+	files.sort(sorter);
+
+	for (const auto& f : files)
+	{
+		if (totalSize <= MaxCacheDirectorySize)
+			break;
+
+		if (f == fileToKeep)
+			continue;
+
+		const auto size = f.getSize();
+
+		if (f.deleteFile())
+			totalSize -= size;
+	}
+}
+
 void HiseAudioThumbnail::LoadingThread::run()
 {
 	Rectangle<int> bounds;
 	var lb;
 	var rb;
 	ScopedPointer<AudioFormatReader> reader;
+	PeakPyramid::Ptr pyramid;
+	int64 cacheKey = 0;
 
 	bool sv = false;
 
@@ -603,43 +1051,62 @@ void HiseAudioThumbnail::LoadingThread::run()
 		if (parent->currentReader != nullptr)
 		{
 			reader.swapWith(parent->currentReader);
+			cacheKey = parent->currentCacheKey;
 		}
 		else
 		{
 			lb = parent->lBuffer;
 			rb = parent->rBuffer;
+			pyramid = parent->pyramid;
 		}
 	}
 
+	float width = (float)bounds.getWidth();
+
 	if (reader != nullptr)
 	{
-		VariantBuffer::Ptr l = new VariantBuffer((int)reader->lengthInSamples);
-		VariantBuffer::Ptr r;
+		// Long samples with a stable identity don't need to be read at all if
+		// the cached peaks are fine enough for the current width.
+		const bool usePeakCache = cacheKey != 0 && (float)reader->lengthInSamples / jmax(1.0f, width) >= (float)PeakPyramid::getBlockSize(0);
+
+		if (usePeakCache)
+		{
+			auto numSamples = reader->lengthInSamples;
+			pyramid = peakCache->getPyramid(cacheKey, reader.release(), numSamples, this);
+
+			if (threadShouldExit() || pyramid == nullptr)
+				return;
+		}
+		else
+		{
+			VariantBuffer::Ptr l = new VariantBuffer((int)reader->lengthInSamples);
+			VariantBuffer::Ptr r;
 
-		if (reader->numChannels > 1)
-			r = new VariantBuffer((int)reader->lengthInSamples);
+			if (reader->numChannels > 1)
+				r = new VariantBuffer((int)reader->lengthInSamples);
 
-		float* d[2];
+			float* d[2];
 
-		d[0] = l->buffer.getWritePointer(0);
-		d[1] = r != nullptr ? r->buffer.getWritePointer(0) : nullptr;
+			d[0] = l->buffer.getWritePointer(0);
+			d[1] = r != nullptr ? r->buffer.getWritePointer(0) : nullptr;
 
-		AudioSampleBuffer tempBuffer = AudioSampleBuffer(d, reader->numChannels, (int)reader->lengthInSamples);
-		
+			AudioSampleBuffer tempBuffer = AudioSampleBuffer(d, reader->numChannels, (int)reader->lengthInSamples);
 
-		if (threadShouldExit())
-			return;
 
-		reader->read(&tempBuffer, 0, (int)reader->lengthInSamples, 0, true, true);
+			if (threadShouldExit())
+				return;
 
-		if (threadShouldExit())
-			return;
+			reader->read(&tempBuffer, 0, (int)reader->lengthInSamples, 0, true, true);
+
+			if (threadShouldExit())
+				return;
 
-		lb = var(l.get());
+			lb = var(l.get());
 
-		if (reader->numChannels > 1)
-		{
-			rb = var(r.get());
+			if (reader->numChannels > 1)
+			{
+				rb = var(r.get());
+			}
 		}
 
 		if (parent.get() != nullptr)
@@ -651,65 +1118,65 @@ void HiseAudioThumbnail::LoadingThread::run()
 		}
 	}
 
+	VariantBuffer::Ptr r = rb.getBuffer();
+	VariantBuffer::Ptr l = lb.getBuffer();
+
+	const float* lData = (l != nullptr && l->size != 0) ? l->buffer.getReadPointer(0) : nullptr;
+	const float* rData = (r != nullptr && r->size != 0) ? r->buffer.getReadPointer(0) : nullptr;
+
+	// Build the pyramid once, so that resizing doesn't need to scan the whole buffer again
+	if (pyramid == nullptr && lData != nullptr && (float)l->size / jmax(1.0f, width) >= (float)PeakPyramid::getBlockSize(0))
+	{
+		const float* channels[2] = { lData, rData };
+		const int numSamples = rData != nullptr ? jmin(l->size, r->size) : l->size;
+
+		pyramid = new PeakPyramid(channels, rData != nullptr ? 2 : 1, numSamples);
+	}
+
+	if (pyramid != nullptr && !pyramid->isValid())
+		pyramid = nullptr;
+
+	const bool hasLeft = lData != nullptr || pyramid != nullptr;
+	const bool hasRight = rData != nullptr || (pyramid != nullptr && pyramid->getNumChannels() > 1);
+
 	Path lPath;
 	Path rPath;
 
 	RectangleList<float> lRects, rRects;
 
-	float width = (float)bounds.getWidth();
+	if (hasLeft)
+		calculatePath(lPath, width, lData, lData != nullptr ? l->size : 0, lRects, pyramid.get(), 0);
 
+	if (hasRight)
+		calculatePath(rPath, width, rData, rData != nullptr ? r->size : 0, rRects, pyramid.get(), 1);
 
-	VariantBuffer::Ptr r = rb.getBuffer();
-	VariantBuffer::Ptr l = lb.getBuffer();
+	if (threadShouldExit())
+		return;
 
-	
-	if (l != nullptr && l->size != 0)
+	auto getLevels = [&](const float* data, int numSamples, int channel)
 	{
-		const float* data = l->buffer.getReadPointer(0);
-		const int numSamples = l->size;
-
-		calculatePath(lPath, width, data, numSamples, lRects);
-	}
+		if (pyramid != nullptr)
+			return pyramid->getTotalRange(channel);
 
-	if (r != nullptr && r->size != 0)
-	{
-		const float* data = r->buffer.getReadPointer(0);
-		const int numSamples = r->size;
+		return FloatVectorOperations::findMinAndMax(data, numSamples);
+	};
 
-		calculatePath(rPath, width, data, numSamples, rRects);
-	}
-	
 	const bool isMono = rPath.isEmpty() && rRects.isEmpty();
 
 	if (isMono)
 	{
-		if (l != nullptr && l->size != 0)
-		{
-			const float* data = l->buffer.getReadPointer(0);
-			const int numSamples = l->size;
-
-			scalePathFromLevels(lPath, rRects, { 0.0f, 0.0f, (float)bounds.getWidth(), (float)bounds.getHeight() }, data, numSamples, sv);
-		}
+		if (hasLeft)
+			scalePathFromLevels(lPath, rRects, { 0.0f, 0.0f, (float)bounds.getWidth(), (float)bounds.getHeight() }, getLevels(lData, lData != nullptr ? l->size : 0, 0), sv);
 	}
 	else
 	{
 		float h = (float)bounds.getHeight() / 2.0f;
 
-		if (l != nullptr && l->size != 0)
-		{
-			const float* data = l->buffer.getReadPointer(0);
-			const int numSamples = l->size;
-
-			scalePathFromLevels(lPath, lRects, { 0.0f, 0.0f, (float)bounds.getWidth(), h }, data, numSamples, sv);
-		}
+		if (hasLeft)
+			scalePathFromLevels(lPath, lRects, { 0.0f, 0.0f, (float)bounds.getWidth(), h }, getLevels(lData, lData != nullptr ? l->size : 0, 0), sv);
 
-		if (r != nullptr && r->size != 0)
-		{
-			const float* data = r->buffer.getReadPointer(0);
-			const int numSamples = r->size;
-
-			scalePathFromLevels(rPath, rRects, { 0.0f, h, (float)bounds.getWidth(), h }, data, numSamples, sv);
-		}
+		if (hasRight)
+			scalePathFromLevels(rPath, rRects, { 0.0f, h, (float)bounds.getWidth(), h }, getLevels(rData, rData != nullptr ? r->size : 0, 1), sv);
 	}
 
 	{
@@ -722,6 +1189,9 @@ void HiseAudioThumbnail::LoadingThread::run()
 			parent->leftPeaks.swapWith(lRects);
 			parent->rightPeaks.swapWith(rRects);
 
+			parent->pyramid = pyramid;
+			parent->pyramidIsStereo = hasRight;
+
 			parent->isClear = false;
 
 			parent->refresh();
@@ -729,7 +1199,7 @@ void HiseAudioThumbnail::LoadingThread::run()
 	}
 }
 
-void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, RectangleList<float>& rects, Rectangle<float> bounds, const float* data, const int numSamples, bool scaleVertically)
+void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, RectangleList<float>& rects, Rectangle<float> bounds, Range<float> levels, bool scaleVertically)
 {
 	if (!rects.isEmpty())
 	{
@@ -743,8 +1213,6 @@ void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, RectangleLi
 	if (p.getBounds().getHeight() == 0)
 		return;
 
-	auto levels = FloatVectorOperations::findMinAndMax(data, numSamples);
-
 	if (levels.isEmpty())
 	{
 		p.clear();
@@ -776,11 +1244,53 @@ void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, RectangleLi
 #define USE_RECTS_FOR_WAVEFORM 0
 
 
-void HiseAudioThumbnail::LoadingThread::calculatePath(Path &p, float width, const float* l_, int numSamples, RectangleList<float>& rects)
+void HiseAudioThumbnail::LoadingThread::calculatePath(Path &p, float width, const float* l_, int numSamples, RectangleList<float>& rects, const PeakPyramid* pyramid, int channel)
 {
+	if (pyramid != nullptr)
+		numSamples = pyramid->getNumSamples();
+
 	int stride = roundToInt((float)numSamples / width);
 	stride = jmax<int>(1, stride * 2);
 
+	// Pick the coarsest pyramid level that still resolves the stride and
+	// fall back to the raw data if the view is zoomed in too far.
+	const Array<PeakPyramid::Peak>* peaks = nullptr;
+	int blockSize = 1;
+
+	if (pyramid != nullptr)
+	{
+		auto level = pyramid->getLevelForStride(stride);
+
+		if (level == -1 && l_ == nullptr)
+			level = 0;
+
+		if (level != -1)
+		{
+			peaks = &pyramid->getPeaks(channel, level);
+			blockSize = PeakPyramid::getBlockSize(level);
+		}
+	}
+
+	auto getRange = [&](int start, int numToCheck)
+	{
+		if (peaks == nullptr)
+			return FloatVectorOperations::findMinAndMax(l_ + start, numToCheck);
+
+		const int first = jmin(start / blockSize, peaks->size() - 1);
+		const int last = jlimit(first + 1, peaks->size(), (start + numToCheck + blockSize - 1) / blockSize);
+
+		auto minValue = peaks->getReference(first).minValue;
+		auto maxValue = peaks->getReference(first).maxValue;
+
+		for (int i = first + 1; i < last; i++)
+		{
+			minValue = jmin(minValue, peaks->getReference(i).minValue);
+			maxValue = jmax(maxValue, peaks->getReference(i).maxValue);
+		}
+
+		return Range<float>(minValue, maxValue);
+	};
+
 	if (numSamples != 0)
 	{
 		p.clear();
@@ -798,9 +1308,8 @@ void HiseAudioThumbnail::LoadingThread::calculatePath(Path &p, float width, cons
 				return;
 
 			const int numToCheck = jmin<int>(stride, numSamples - i);
-			auto minMax = FloatVectorOperations::findMinAndMax(l_ + i, numToCheck);
+			auto minMax = getRange(i, numToCheck);
 			auto value = jmax(std::abs(minMax.getStart()), std::abs(minMax.getEnd()));
-
 			value = jlimit<float>(0.0f, 1.0f, value);
 			value *= 10.f;
 			values.add({ (float)i / stride, value });
@@ -862,7 +1371,7 @@ void HiseAudioThumbnail::LoadingThread::calculatePath(Path &p, float width, cons
 				return;
 
 			const int numToCheck = jmin<int>(stride, numSamples - i);
-			auto value = jmax<float>(0.0f, FloatVectorOperations::findMaximum(l_ + i, numToCheck));
+			auto value = jmax<float>(0.0f, getRange(i, numToCheck).getEnd());
 			value = jlimit<float>(-1.0f, 1.0f, value);
 			p.lineTo((float)i, -1.0f * value);
 		};
@@ -873,7 +1382,7 @@ void HiseAudioThumbnail::LoadingThread::calculatePath(Path &p, float width, cons
 				return;
 
 			const int numToCheck = jmin<int>(stride, numSamples - i);
-			auto value = jmin<float>(0.0f, FloatVectorOperations::findMinimum(l_ + i, numToCheck));
+			auto value = jmin<float>(0.0f, getRange(i, numToCheck).getStart());
 			value = jlimit<float>(-1.0f, 1.0f, value);
 			p.lineTo((float)i, -1.0f * value);
 		};
@@ -914,8 +1423,13 @@ void HiseAudioThumbnail::setBuffer(var bufferL, var bufferR /*= var()*/, bool sy
 	if (!isNotEmpty && !shouldBeNotEmpty)
 		return;
 
-	lBuffer = bufferL;
-	rBuffer = bufferR;
+	{
+		ScopedLock sl(lock);
+
+		lBuffer = bufferL;
+		rBuffer = bufferR;
+		pyramid = nullptr;
+	}
 
 	if (auto l = bufferL.getBuffer())
 	{
@@ -968,7 +1482,7 @@ void HiseAudioThumbnail::paint(Graphics& g)
 
 void HiseAudioThumbnail::drawSection(Graphics &g, bool enabled)
 {
-	bool isStereo = rBuffer.isBuffer();
+	bool isStereo = rBuffer.isBuffer() || pyramidIsStereo;
 
 	Colour fillColour = findColour(AudioDisplayComponent::ColourIds::fillColour);
 	Colour outlineColour = findColour(AudioDisplayComponent::ColourIds::outlineColour);
@@ -1041,9 +1555,15 @@ void HiseAudioThumbnail::drawSection(Graphics &g, bool enabled)
 	}
 }
 
-void HiseAudioThumbnail::setReader(AudioFormatReader* r, int64 actualNumSamples)
+void HiseAudioThumbnail::setReader(AudioFormatReader* r, int64 actualNumSamples, int64 cacheKey)
 {
-	currentReader = r;
+	{
+		ScopedLock sl(lock);
+
+		currentReader = r;
+		currentCacheKey = cacheKey;
+		pyramid = nullptr;
+	}
 
 	if (actualNumSamples == -1)
 		actualNumSamples = currentReader->lengthInSamples;
@@ -1066,6 +1586,9 @@ void HiseAudioThumbnail::clear()
 	leftWaveform.clear();
 	rightWaveform.clear();
 
+	pyramid = nullptr;
+	pyramidIsStereo = false;
+
 	isClear = true;
 
 	currentReader = nullptr;
@@ -49,6 +49,117 @@ class AudioDisplayComponent;
 #endif
 
 
+/** A multi-resolution min / max / RMS summary of audio data.
+*
+*	The finest level stores one Peak for every 2^BaseShift samples, and every following level halves
+*	the resolution, so a waveform can be drawn at any zoom level without scanning the sample data again.
+*	Pyramids of samples with a stable identity are shared through the Cache, which builds them on a common
+*	worker pool and persists them to a cache folder so that reopening a sample map doesn't need to
+*	read the audio data just for the thumbnails.
+*/
+class PeakPyramid : public ReferenceCountedObject
+{
+public:
+
+	using Ptr = ReferenceCountedObjectPtr<PeakPyramid>;
+
+	enum
+	{
+		BaseShift = 4,
+		MaxNumLevels = 24
+	};
+
+	struct Peak
+	{
+		float minValue = 0.0f;
+		float maxValue = 0.0f;
+		float rms = 0.0f;
+	};
+
+	/** Creates a pyramid from the given channel data. */
+	PeakPyramid(const float* const* channels, int numChannels, int numSamples);
+
+	/** Creates a pyramid by reading the reader in chunks. If the abort function returns true, the pyramid will be invalid. */
+	PeakPyramid(AudioFormatReader& reader, int64 numSamples, const std::function<bool()>& shouldAbort={});
+
+	/** Restores a pyramid that was written with writeToStream(). */
+	PeakPyramid(InputStream& input);
+
+	bool isValid() const { return numSamples > 0 && !levels.isEmpty(); }
+
+	int getNumChannels() const noexcept { return numChannels; }
+	int getNumSamples() const noexcept { return numSamples; }
+	int getNumLevels() const noexcept { return levels.size() / jmax(1, numChannels); }
+
+	/** Returns the number of samples that are summarized by a single peak of the given level. */
+	static int getBlockSize(int level) noexcept { return 1 << (level + BaseShift); }
+
+	/** Returns the coarsest level whose block size doesn't exceed the given stride or -1 if the raw data is needed. */
+	int getLevelForStride(int stride) const;
+
+	const Array<Peak>& getPeaks(int channel, int level) const { return levels.getReference(level * numChannels + channel); }
+
+	/** Returns the minimum and maximum value of the whole channel. */
+	Range<float> getTotalRange(int channel) const;
+
+	void writeToStream(OutputStream& output) const;
+
+	/** Creates a cache key from the identifier of a sample.
+	*
+	*	The modification time and size of the file that contains the data will be included. For monoliths,
+	*	pass in the monolith file, otherwise the identifier is used if it's an absolute path.
+	*/
+	static int64 createCacheKey(const String& sourceId, int64 offset, int64 length, const File& sourceFile=File());
+
+	/** A process-wide cache that builds pyramids on a shared worker pool. */
+	class Cache
+	{
+	public:
+
+		Cache();
+		~Cache();
+
+		/** Returns the pyramid for the given key.
+		*
+		*	If the pyramid is neither in memory nor in the cache folder, the reader will be scanned on the
+		*	worker pool (the cache takes ownership of the reader). If another thumbnail is already waiting for the
+		*	same key, the job is shared. This blocks until the job is done or the calling thread should exit.
+		*/
+		Ptr getPyramid(int64 key, AudioFormatReader* readerToOwn, int64 numSamples, Thread* callingThread);
+
+		static File getCacheDirectory();
+
+		/** The maximum size of the cache folder. If a new file exceeds it, the least recently used files are deleted. */
+		static constexpr int64 MaxCacheDirectorySize = 64 * 1024 * 1024;
+
+	private:
+
+		struct Job;
+
+		File getCacheFile(int64 key) const;
+
+		static void purgeCacheDirectory(const File& fileToKeep);
+
+		CriticalSection lock;
+		HashMap<int64, Ptr> pyramids;
+		ReferenceCountedArray<Job> pendingJobs;
+		ThreadPool pool;
+
+		JUCE_DECLARE_NON_COPYABLE(Cache);
+	};
+
+private:
+
+	void buildLevels(const Array<Array<Peak>>& firstLevel);
+
+	static void addBlock(Peak& p, const float* data, int numToCheck);
+
+	int numChannels = 0;
+	int numSamples = 0;
+
+	Array<Array<Peak>> levels;
+};
+
 class HiseAudioThumbnail: public Component,
 						  public AsyncUpdater
 {
@@ -107,7 +218,10 @@ public:
 		scaleVertically = shouldScale;
 	};
 
-	void setReader(AudioFormatReader* r, int64 actualNumSamples=-1);
+	/** Sets the reader to display. If you pass in a cache key (see PeakPyramid::createCacheKey()),
+	*	the peaks will be shared with other thumbnails and persisted between sessions.
+	*/
+	void setReader(AudioFormatReader* r, int64 actualNumSamples=-1, int64 cacheKey=0);
 
 	void clear();
 
@@ -206,9 +320,9 @@ private:
 
 		void run() override;;
 
-		void scalePathFromLevels(Path &lPath, RectangleList<float>& rects, Rectangle<float> bounds, const float* data, const int numSamples, bool scaleVertically);
+		void scalePathFromLevels(Path &lPath, RectangleList<float>& rects, Rectangle<float> bounds, Range<float> levels, bool scaleVertically);
 
-		void calculatePath(Path &p, float width, const float* l_, int numSamples, RectangleList<float>& rects);
+		void calculatePath(Path &p, float width, const float* l_, int numSamples, RectangleList<float>& rects, const PeakPyramid* pyramid=nullptr, int channel=0);
 
 	private:
 
@@ -216,6 +330,8 @@ private:
 
 		WeakReference<HiseAudioThumbnail> parent;
 
+		SharedResourcePointer<PeakPyramid::Cache> peakCache;
+
 	};
 
 	JUCE_DECLARE_WEAK_REFERENCEABLE(HiseAudioThumbnail);
@@ -225,6 +341,10 @@ private:
 	LoadingThread loadingThread;
 
 	ScopedPointer<AudioFormatReader> currentReader;
+	int64 currentCacheKey = 0;
+
+	PeakPyramid::Ptr pyramid;
+	bool pyramidIsStereo = false;
 
 	ScopedPointer<ScrollBar> scrollBar;
 
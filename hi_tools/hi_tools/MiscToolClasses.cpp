@@ -426,6 +426,30 @@ bool RegexFunctions::matchesWildcard(const String &wildcard, const String &strin
 #endif
 }
 
+Array<int> RegexFunctions::getMatchingIndexes(const String &wildcard, const StringArray &stringsToTest)
+{
+	Array<int> indexes;
+
+#if !TRAVIS_CI
+	try
+	{
+		std::regex reg(wildcard.toStdString());
+
+		for (int i = 0; i < stringsToTest.size(); i++)
+		{
+			if (std::regex_search(stringsToTest[i].toStdString(), reg))
+				indexes.add(i);
+		}
+	}
+	catch (std::regex_error e)
+	{
+		DBG(e.what());
+	}
+#endif
+
+	return indexes;
+}
+
 ScopedNoDenormals::ScopedNoDenormals()
 {
 #if JUCE_IOS
@@ -590,6 +614,72 @@ float FloatSanitizers::sanitizeFloatNumber(float& input)
 	return *reinterpret_cast<const float*>(&sanitized);
 }
 
+float FusedVectorOperations::addWithMultiplyAndGetMagnitude(float* dst, const float* src, float gain, int numSamples, float* destinationMagnitude) noexcept
+{
+	using SSEFloat = dsp::SIMDRegister<float>;
+	constexpr int sseSize = (int)SSEFloat::SIMDNumElements;
+
+	float srcPeak = 0.0f;
+	float dstPeak = 0.0f;
+
+	auto processScalar = [&](int num)
+	{
+		for (int i = 0; i < num; i++)
+		{
+			const float s = *src++;
+			const float d = *dst + s * gain;
+			*dst++ = d;
+
+			srcPeak = jmax(srcPeak, std::abs(s));
+			dstPeak = jmax(dstPeak, std::abs(d));
+		}
+	};
+
+	const int numUnaligned = jmin(numSamples, (int)(SSEFloat::getNextSIMDAlignedPtr(src) - src));
+
+	processScalar(numUnaligned);
+	numSamples -= numUnaligned;
+
+	// The SSE loop can only be used if both buffers are aligned at the same offset
+	// (which is always the case for channels of an AudioSampleBuffer).
+	if (numSamples >= sseSize && SSEFloat::isSIMDAligned(dst))
+	{
+		// clears the sign bit
+		const uint32 absMask = 0x7fffffff;
+
+		auto g = SSEFloat::expand(gain);
+		auto sPeak = SSEFloat::expand(0.0f);
+		auto dPeak = SSEFloat::expand(0.0f);
+
+		while (numSamples >= sseSize)
+		{
+			auto s = SSEFloat::fromRawArray(src);
+			auto d = SSEFloat::fromRawArray(dst) + s * g;
+			d.copyToRawArray(dst);
+
+			sPeak = SSEFloat::max(sPeak, s & absMask);
+			dPeak = SSEFloat::max(dPeak, d & absMask);
+
+			src += sseSize;
+			dst += sseSize;
+			numSamples -= sseSize;
+		}
+
+		for (size_t i = 0; i < SSEFloat::SIMDNumElements; i++)
+		{
+			srcPeak = jmax(srcPeak, sPeak.get(i));
+			dstPeak = jmax(dstPeak, dPeak.get(i));
+		}
+	}
+
+	processScalar(numSamples);
+
+	if (destinationMagnitude != nullptr)
+		*destinationMagnitude = dstPeak;
+
+	return srcPeak;
+}
+
 void FloatSanitizers::Test::runTest()
 {
 	beginTest("Testing array method");
@@ -700,6 +790,115 @@ Rectangle<int> HiseDeviceSimulator::getDisplayResolution()
 }
 
 
+void PooledUIUpdater::timerCallback()
+{
+	const auto frameStart = Time::getMillisecondCounterHiRes();
+	++frameIndex;
+
+	// High priority timers are always called first
+	for (int i = 0; i < simpleTimers.size(); i++)
+	{
+		auto st = simpleTimers[i].get();
+
+		if (st != nullptr && st->priority == SimpleTimer::Priority::High && st->shouldBeCalled(frameIndex))
+			st->timerCallback();
+	}
+
+	WeakReference<Broadcaster> b;
+
+	while (!isOverBudget(frameStart) && pendingHandlers.pop(b))
+	{
+		if (b.get() != nullptr)
+		{
+			b->pending = false;
+
+			for (auto l : b->pooledListeners)
+			{
+				if (l != nullptr)
+					l->handlePooledMessage(b);
+			}
+		}
+	}
+
+	// The other timers are called in a round robin fashion so that
+	// deferred updates will be called first in the next frame
+	const int numTimers = simpleTimers.size();
+
+	for (int i = 0; i < numTimers; i++)
+	{
+		if (isOverBudget(frameStart))
+		{
+			// Only count the timers that would have been called in this frame
+			for (int j = i; j < numTimers && simpleTimers.size() > 0; j++)
+			{
+				auto deferred = simpleTimers[(timerCursor + j) % simpleTimers.size()].get();
+
+				if (deferred != nullptr && deferred->priority != SimpleTimer::Priority::High && deferred->shouldBeCalled(frameIndex))
+					frameStatistics.numDeferredUpdates++;
+			}
+
+			timerCursor += i;
+			break;
+		}
+
+		if (simpleTimers.size() == 0)
+			break;
+
+		auto st = simpleTimers[(timerCursor + i) % simpleTimers.size()].get();
+
+		if (st != nullptr && st->priority != SimpleTimer::Priority::High && st->shouldBeCalled(frameIndex))
+			st->timerCallback();
+	}
+
+	if (simpleTimers.size() > 0)
+		timerCursor %= simpleTimers.size();
+
+	frameStatistics.addFrame(Time::getMillisecondCounterHiRes() - frameStart);
+}
+
+void PooledUIUpdater::FrameStatistics::addFrame(double milliseconds)
+{
+	int bin = 0;
+	double limit = 1.0;
+
+	while (bin < NumBins - 1 && milliseconds >= limit)
+	{
+		bin++;
+		limit *= 2.0;
+	}
+
+	histogram[bin]++;
+	numFrames++;
+	maxFrameTime = jmax(maxFrameTime, milliseconds);
+}
+
+String PooledUIUpdater::FrameStatistics::toString() const
+{
+	String s;
+
+	s << "UI frame statistics (" << String(numFrames) << " frames)\n";
+
+	double limit = 1.0;
+
+	for (int i = 0; i < NumBins; i++)
+	{
+		auto percentage = numFrames > 0 ? 100.0 * (double)histogram[i] / (double)numFrames : 0.0;
+
+		if (i == NumBins - 1)
+			s << ">= " << String(limit / 2.0, 0) << "ms: ";
+		else
+			s << "< " << String(limit, 0) << "ms: ";
+
+		s << String(histogram[i]) << " (" << String(percentage, 1) << "%)\n";
+		limit *= 2.0;
+	}
+
+	s << "Max frame time: " << String(maxFrameTime, 2) << "ms\n";
+	s << "Deferred updates: " << String(numDeferredUpdates);
+
+	return s;
+}
+
 void PooledUIUpdater::Broadcaster::sendPooledChangeMessage()
 {
 	if (pending)
@@ -144,16 +144,27 @@ private:
 /** Coallescates timer updates.
 	@ingroup event_handling
 	
+	This class acts as frame scheduler for UI updates: instead of running lots of independent
+	timers, the components register a SimpleTimer or a Broadcaster and will be called in the same
+	frame. Updates with a lower priority are spread across multiple frames, components that are not
+	showing will be skipped and if a frame exceeds its time budget, the remaining updates will be
+	deferred to the next frame.
 */
 class PooledUIUpdater : public SuspendableTimer
 {
 public:
 
+	/** The interval between two frames in milliseconds. */
+	static constexpr int FrameInterval = 30;
+
+	/** Low priority timers will be called every nth frame. */
+	static constexpr int LowPriorityDivider = 4;
+
 	PooledUIUpdater() :
 		pendingHandlers(8192)
 	{
         suspendTimer(false);
-		startTimer(30);
+		startTimer(FrameInterval);
 	}
 
 	class Broadcaster;
@@ -171,13 +182,40 @@ public:
 		JUCE_DECLARE_WEAK_REFERENCEABLE(Listener);
 	};
 
+	/** A histogram of the time spent in each frame. */
+	struct FrameStatistics
+	{
+		enum { NumBins = 7 };
+
+		void addFrame(double milliseconds);
+
+		/** Creates a human readable summary of the histogram. */
+		String toString() const;
+
+		int64 histogram[NumBins] = {};
+		int64 numFrames = 0;
+		int64 numDeferredUpdates = 0;
+		double maxFrameTime = 0.0;
+	};
+
 	class SimpleTimer
 	{
 	public:
-		SimpleTimer(PooledUIUpdater* h):
-			updater(h)
+
+		enum class Priority
+		{
+			High = 0, ///< will be called first every frame and is never deferred
+			Normal,	  ///< will be called every frame unless the frame budget is exceeded
+			Low,	  ///< will be called every LowPriorityDivider frames
+			numPriorities
+		};
+
+		SimpleTimer(PooledUIUpdater* h, bool shouldStart=true, Priority p=Priority::Normal):
+			updater(h),
+			priority(p)
 		{
-			start();
+			if(shouldStart)
+				start();
 		}
 
 		virtual ~SimpleTimer()
@@ -187,21 +225,55 @@ public:
 
 		void start()
 		{
-			updater->simpleTimers.addIfNotAlreadyThere(this);
+			if (updater != nullptr)
+			{
+				phase = updater->simpleTimers.size() % LowPriorityDivider;
+				updater->simpleTimers.addIfNotAlreadyThere(this);
+			}
 		}
 
 		void stop()
 		{
-			updater->simpleTimers.removeAllInstancesOf(this);
+			if (updater != nullptr)
+				updater->simpleTimers.removeAllInstancesOf(this);
+		}
+
+		void setTimerPriority(Priority newPriority) { priority = newPriority; }
+
+		Priority getTimerPriority() const noexcept { return priority; }
+
+		/** If you set a component here, the timer callback will be skipped as long as the component is not showing. */
+		void setComponentToCheck(Component* c)
+		{
+			componentToCheck = c;
+			checkVisibility = c != nullptr;
 		}
 
 		virtual void timerCallback() = 0;
 
 	private:
 
+		friend class PooledUIUpdater;
+
+		bool shouldBeCalled(uint32 frameIndex) const
+		{
+			if (priority == Priority::Low && (frameIndex % LowPriorityDivider) != (uint32)phase)
+				return false;
+
+			if (checkVisibility)
+				return componentToCheck.getComponent() != nullptr && componentToCheck->isShowing();
+
+			return true;
+		}
+
 		JUCE_DECLARE_WEAK_REFERENCEABLE(SimpleTimer);
 
 		WeakReference<PooledUIUpdater> updater;
+		Priority priority;
+		int phase = 0;
+
+		Component::SafePointer<Component> componentToCheck;
+		bool checkVisibility = false;
 	};
 
 	class Broadcaster
@@ -235,36 +307,30 @@ public:
 		JUCE_DECLARE_WEAK_REFERENCEABLE(Broadcaster);
 	};
 
-	void timerCallback() override
-	{
-		for (auto st : simpleTimers)
-		{
-			if (st != nullptr)
-				st->timerCallback();
-		}
+	void timerCallback() override;
 
-		WeakReference<Broadcaster> b;
+	/** Sets the maximum time in milliseconds that a frame may spend with non-high priority updates. */
+	void setFrameBudget(double newBudgetMilliseconds) { frameBudget = newBudgetMilliseconds; }
 
-		while (pendingHandlers.pop(b))
-		{
-			if (b.get() != nullptr)
-			{
-				b->pending = false;
+	const FrameStatistics& getFrameStatistics() const noexcept { return frameStatistics; }
 
-				for (auto l : b->pooledListeners)
-				{
-					if (l != nullptr)
-						l->handlePooledMessage(b);
-				}
-			}
-		}
-	}
+	void resetFrameStatistics() { frameStatistics = {}; }
 
 private:
 
+	bool isOverBudget(double frameStart) const
+	{
+		return Time::getMillisecondCounterHiRes() - frameStart > frameBudget;
+	}
+
 	Array<WeakReference<SimpleTimer>> simpleTimers;
 	LockfreeQueue<WeakReference<Broadcaster>> pendingHandlers;
 
+	uint32 frameIndex = 0;
+	int timerCursor = 0;
+	double frameBudget = 15.0;
+	FrameStatistics frameStatistics;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(PooledUIUpdater);
 };
 
@@ -742,6 +808,11 @@ public:
 	/** Checks if the given string matches the regex wildcard. */
 	static bool matchesWildcard(const String &wildcard, const String &stringToTest);
 
+	/** Returns the indexes of all strings that match the regex wildcard. 
+	*
+	*	Use this instead of calling matchesWildcard() in a loop, as it compiles the regex only once. */
+	static Array<int> getMatchingIndexes(const String &wildcard, const StringArray &stringsToTest);
+
 };
 
 
@@ -773,6 +844,24 @@ struct FloatSanitizers
 static FloatSanitizers::Test floatSanitizerTest;
 
 
+/** Fused vector operations for the output stage of the sound generators.
+*	@ingroup utility
+*
+*	Every sound generator mixes its internal buffer into the parent buffer and then calculates
+*	the peak values of both buffers for the meters and the routing matrix. These functions do
+*	all this in a single pass so that the audio data is only read once per block.
+*/
+struct FusedVectorOperations
+{
+	/** Adds src * gain to dst and returns the peak value of the (unscaled) source.
+	*
+	*	If destinationMagnitude is not nullptr, it will be set to the peak value of the mixed
+	*	destination. It uses SSE instructions if the two pointers share the same alignment.
+	*/
+	static float addWithMultiplyAndGetMagnitude(float* dst, const float* src, float gain, int numSamples, float* destinationMagnitude=nullptr) noexcept;
+};
+
+
 /** This class is used to simulate different devices.
 *
 *	In the backend application you can choose the current device. In compiled apps
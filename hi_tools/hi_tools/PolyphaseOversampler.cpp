@@ -0,0 +1,621 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+namespace hise { using namespace juce;
+
+struct PolyphaseOversampler::CoefficientTable : public ReferenceCountedObject
+{
+	using Ptr = ReferenceCountedObjectPtr<CoefficientTable>;
+
+	struct Filter
+	{
+		/** FIR: the nonzero taps of the even polyphase branch and the centre tap of the odd branch. */
+		Array<float> taps;
+		float centreTap = 0.0f;
+		int centreDelay = 0;
+
+		/** IIR: the allpass coefficients of both polyphase branches. */
+		Array<float> direct;
+		Array<float> delayed;
+
+		/** The group delay at DC in samples at the oversampled rate. */
+		double latency = 0.0;
+	};
+
+	/** Returns the coefficients for the given stage. They are only designed once and then shared between all oversamplers. */
+	static Ptr get(Profile p, int stageIndex)
+	{
+		static CriticalSection tableLock;
+		static ReferenceCountedArray<CoefficientTable> tables;
+
+		ScopedLock sl(tableLock);
+
+		for (auto t : tables)
+		{
+			if (t->profile == p && t->stageIndex == stageIndex)
+				return t;
+		}
+
+		Ptr newTable = new CoefficientTable(p, stageIndex);
+		tables.add(newTable);
+		return newTable;
+	}
+
+	CoefficientTable(Profile p, int stageIndex_) :
+		profile(p),
+		stageIndex(stageIndex_)
+	{
+		// Same design parameters as juce::dsp::Oversampling so that the IIR profile sounds exactly like before
+		const bool isMaximumQuality = p == Profile::LinearPhase;
+		const float n = (float)stageIndex;
+
+		auto twUp = (isMaximumQuality ? 0.10f : 0.12f) * (stageIndex == 0 ? 0.5f : 1.0f);
+		auto twDown = (isMaximumQuality ? 0.12f : 0.15f) * (stageIndex == 0 ? 0.5f : 1.0f);
+
+		auto dBFactor = isMaximumQuality ? 10.0f : 8.0f;
+		auto dBUp = (isMaximumQuality ? -90.0f : -70.0f) + dBFactor * n;
+		auto dBDown = (isMaximumQuality ? -75.0f : -60.0f) + dBFactor * n;
+
+		if (p == Profile::MinimumPhaseIIR)
+		{
+			designIIR(up, twUp, dBUp);
+			designIIR(down, twDown, dBDown);
+		}
+		else
+		{
+			designFIR(up, twUp, dBUp, true);
+			designFIR(down, twDown, dBDown, false);
+		}
+	}
+
+	bool isFIR() const { return profile != Profile::MinimumPhaseIIR; }
+
+	const Profile profile;
+	const int stageIndex;
+
+	Filter up;
+	Filter down;
+
+private:
+
+	static void designFIR(Filter& f, float transitionWidth, float stopbandGain, bool isUpsampler)
+	{
+		auto c = dsp::FilterDesign<float>::designFIRLowpassHalfBandEquirippleMethod(transitionWidth, stopbandGain);
+		auto fir = c->getRawCoefficients();
+		auto N = (int)c->getFilterOrder() + 1;
+
+		// A halfband filter has every second coefficient except the centre one equal to zero,
+		// so it splits into a dense even branch and an odd branch with a single (delayed) tap.
+		// The upsampler compensates the zero stuffing and the odd input of the downsampler
+		// lags one sample behind the even input.
+		jassert((N - 3) % 4 == 0);
+
+		const float gain = isUpsampler ? 2.0f : 1.0f;
+
+		for (int i = 0; i < N; i += 2)
+			f.taps.add(fir[i] * gain);
+
+		f.centreTap = fir[N / 2] * gain;
+		f.centreDelay = (N - 3) / 4 + (isUpsampler ? 0 : 1);
+		f.latency = (double)(N - 1) * 0.5;
+	}
+
+	static void designIIR(Filter& f, float transitionWidth, float stopbandGain)
+	{
+		auto s = dsp::FilterDesign<float>::designIIRLowpassHalfBandPolyphaseAllpassMethod(transitionWidth, stopbandGain);
+
+		// The first element of the delayed path is the unit delay between the branches
+		for (int i = 0; i < s.directPath.size(); i++)
+			f.direct.add(s.directPath.getObjectPointer(i)->coefficients[0]);
+
+		for (int i = 1; i < s.delayedPath.size(); i++)
+			f.delayed.add(s.delayedPath.getObjectPointer(i)->coefficients[0]);
+
+		// Each allpass section (a + z^-2) / (1 + a*z^-2) delays DC by 2 * (1 - a) / (1 + a) samples
+		// and the filter is the average of both branches (plus the unit delay of the second branch).
+		auto getDelay = [](float a) { return (1.0 - (double)a) / (1.0 + (double)a); };
+
+		f.latency = 0.5;
+
+		for (auto a : f.direct)
+			f.latency += getDelay(a);
+
+		for (auto a : f.delayed)
+			f.latency += getDelay(a);
+	}
+};
+
+struct PolyphaseOversampler::Stage
+{
+	Stage(int numChannels_, CoefficientTable::Ptr table_) :
+		numChannels(numChannels_),
+		table(table_)
+	{}
+
+	virtual ~Stage() {}
+
+	virtual void initProcessing(int maxNumSamples)
+	{
+		buffer.setSize(numChannels, maxNumSamples * 2, false, false, true);
+	}
+
+	virtual void reset()
+	{
+		buffer.clear();
+	}
+
+	/** Upsamples the block into the internal buffer. */
+	virtual void processUp(const dsp::AudioBlock<float>& input) = 0;
+
+	/** Downsamples the internal buffer into the given block. */
+	virtual void processDown(dsp::AudioBlock<float>& output) = 0;
+
+	dsp::AudioBlock<float> getProcessedSamples(size_t numSamples)
+	{
+		return dsp::AudioBlock<float>(buffer).getSubBlock(0, numSamples);
+	}
+
+	double getLatency() const { return table->up.latency + table->down.latency; }
+
+	const int numChannels;
+	CoefficientTable::Ptr table;
+	AudioSampleBuffer buffer;
+};
+
+struct PolyphaseOversampler::FIRStage : public Stage
+{
+	FIRStage(int numChannels_, CoefficientTable::Ptr table_) :
+		Stage(numChannels_, table_)
+	{}
+
+	void initProcessing(int maxNumSamples) override
+	{
+		Stage::initProcessing(maxNumSamples);
+
+		// The histories keep the last (numTaps - 1) input samples in front of the current block
+		// so that every tap can be applied to the whole block at once.
+		upHistory.setSize(numChannels, getHistorySize(table->up) + maxNumSamples);
+		evenHistory.setSize(numChannels, getHistorySize(table->down) + maxNumSamples);
+		oddHistory.setSize(numChannels, table->down.centreDelay + maxNumSamples);
+		scratch.setSize(1, maxNumSamples * 2);
+
+		reset();
+	}
+
+	void reset() override
+	{
+		Stage::reset();
+		upHistory.clear();
+		evenHistory.clear();
+		oddHistory.clear();
+	}
+
+	void processUp(const dsp::AudioBlock<float>& input) override
+	{
+		const auto& f = table->up;
+		const int numSamples = (int)input.getNumSamples();
+		const int historySize = getHistorySize(f);
+
+		auto dense = scratch.getWritePointer(0);
+		auto centre = scratch.getWritePointer(0, numSamples);
+
+		for (int c = 0; c < (int)input.getNumChannels(); c++)
+		{
+			auto h = upHistory.getWritePointer(c);
+			FloatVectorOperations::copy(h + historySize, input.getChannelPointer(c), numSamples);
+
+			applyTaps(dense, h + historySize, f.taps, numSamples);
+			FloatVectorOperations::multiply(centre, h + historySize - f.centreDelay, f.centreTap, numSamples);
+
+			auto out = buffer.getWritePointer(c);
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				out[2 * i] = dense[i];
+				out[2 * i + 1] = centre[i];
+			}
+
+			memmove(h, h + numSamples, sizeof(float) * historySize);
+		}
+	}
+
+	void processDown(dsp::AudioBlock<float>& output) override
+	{
+		const auto& f = table->down;
+		const int numSamples = (int)output.getNumSamples();
+		const int historySize = getHistorySize(f);
+
+		for (int c = 0; c < (int)output.getNumChannels(); c++)
+		{
+			auto in = buffer.getReadPointer(c);
+			auto even = evenHistory.getWritePointer(c);
+			auto odd = oddHistory.getWritePointer(c);
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				even[historySize + i] = in[2 * i];
+				odd[f.centreDelay + i] = in[2 * i + 1];
+			}
+
+			auto out = output.getChannelPointer(c);
+
+			applyTaps(out, even + historySize, f.taps, numSamples);
+			FloatVectorOperations::addWithMultiply(out, odd, f.centreTap, numSamples);
+
+			memmove(even, even + numSamples, sizeof(float) * historySize);
+			memmove(odd, odd + numSamples, sizeof(float) * f.centreDelay);
+		}
+	}
+
+private:
+
+	static int getHistorySize(const CoefficientTable::Filter& f) { return f.taps.size() - 1; }
+
+	/** Convolves the block tap by tap. input must be preceded by (taps.size() - 1) history samples. */
+	static void applyTaps(float* output, const float* input, const Array<float>& taps, int numSamples)
+	{
+		FloatVectorOperations::multiply(output, input, taps[0], numSamples);
+
+		for (int j = 1; j < taps.size(); j++)
+			FloatVectorOperations::addWithMultiply(output, input - j, taps[j], numSamples);
+	}
+
+	AudioSampleBuffer upHistory;
+	AudioSampleBuffer evenHistory;
+	AudioSampleBuffer oddHistory;
+	AudioSampleBuffer scratch;
+};
+
+struct PolyphaseOversampler::IIRStage : public Stage
+{
+	using SSEFloat = dsp::SIMDRegister<float>;
+
+	/** Every channel occupies two lanes (one per polyphase branch), so a SSE register processes two channels at once. */
+	static constexpr int numLanes = (int)SSEFloat::SIMDNumElements;
+	static constexpr int channelsPerRegister = numLanes / 2;
+	static constexpr int MaxNumSections = 16;
+
+	IIRStage(int numChannels_, CoefficientTable::Ptr table_) :
+		Stage(numChannels_, table_),
+		numGroups((numChannels_ + channelsPerRegister - 1) / channelsPerRegister)
+	{
+		jassert(getNumSections(table->up) <= MaxNumSections);
+		jassert(getNumSections(table->down) <= MaxNumSections);
+	}
+
+	void initProcessing(int maxNumSamples) override
+	{
+		Stage::initProcessing(maxNumSamples);
+
+		upStates.calloc(numGroups * MaxNumSections * numLanes);
+		downStates.calloc(numGroups * MaxNumSections * numLanes);
+		downDelay.resize(numGroups * channelsPerRegister);
+
+		// the unused lanes of the last register read silence and write into the dummy buffer
+		silence.setSize(1, maxNumSamples * 2);
+		dummyOutput.setSize(1, maxNumSamples * 2);
+
+		reset();
+	}
+
+	void reset() override
+	{
+		Stage::reset();
+		upStates.clear(numGroups * MaxNumSections * numLanes);
+		downStates.clear(numGroups * MaxNumSections * numLanes);
+		FloatVectorOperations::clear(downDelay.getRawDataPointer(), downDelay.size());
+		silence.clear();
+	}
+
+	void processUp(const dsp::AudioBlock<float>& input) override
+	{
+		const auto& f = table->up;
+		const int numSamples = (int)input.getNumSamples();
+		const int numSections = getNumSections(f);
+
+		SSEFloat coefficients[MaxNumSections];
+		SSEFloat states[MaxNumSections];
+
+		loadCoefficients(f, coefficients);
+
+		for (int g = 0; g < getNumGroups((int)input.getNumChannels()); g++)
+		{
+			const float* in[channelsPerRegister];
+			float* out[channelsPerRegister];
+
+			for (int i = 0; i < channelsPerRegister; i++)
+			{
+				auto c = g * channelsPerRegister + i;
+				auto isUsed = c < (int)input.getNumChannels();
+
+				in[i] = isUsed ? input.getChannelPointer(c) : silence.getReadPointer(0);
+				out[i] = isUsed ? buffer.getWritePointer(c) : dummyOutput.getWritePointer(0);
+			}
+
+			auto stateData = upStates + g * MaxNumSections * numLanes;
+			loadStates(stateData, states, numSections);
+
+			alignas(32) float x[numLanes];
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				for (int c = 0; c < channelsPerRegister; c++)
+				{
+					x[2 * c] = in[c][i];
+					x[2 * c + 1] = in[c][i];
+				}
+
+				auto y = processCascade(SSEFloat::fromRawArray(x), coefficients, states, numSections);
+				y.copyToRawArray(x);
+
+				for (int c = 0; c < channelsPerRegister; c++)
+				{
+					out[c][2 * i] = x[2 * c];
+					out[c][2 * i + 1] = x[2 * c + 1];
+				}
+			}
+
+			storeStates(stateData, states, numSections);
+		}
+	}
+
+	void processDown(dsp::AudioBlock<float>& output) override
+	{
+		const auto& f = table->down;
+		const int numSamples = (int)output.getNumSamples();
+		const int numSections = getNumSections(f);
+
+		SSEFloat coefficients[MaxNumSections];
+		SSEFloat states[MaxNumSections];
+
+		loadCoefficients(f, coefficients);
+
+		for (int g = 0; g < getNumGroups((int)output.getNumChannels()); g++)
+		{
+			const float* in[channelsPerRegister];
+			float* out[channelsPerRegister];
+			float delay[channelsPerRegister];
+
+			for (int i = 0; i < channelsPerRegister; i++)
+			{
+				auto c = g * channelsPerRegister + i;
+				auto isUsed = c < (int)output.getNumChannels();
+
+				in[i] = isUsed ? buffer.getReadPointer(c) : silence.getReadPointer(0);
+				out[i] = isUsed ? output.getChannelPointer(c) : dummyOutput.getWritePointer(0);
+				delay[i] = downDelay[g * channelsPerRegister + i];
+			}
+
+			auto stateData = downStates + g * MaxNumSections * numLanes;
+			loadStates(stateData, states, numSections);
+
+			alignas(32) float x[numLanes];
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				for (int c = 0; c < channelsPerRegister; c++)
+				{
+					x[2 * c] = in[c][2 * i];
+					x[2 * c + 1] = in[c][2 * i + 1];
+				}
+
+				auto y = processCascade(SSEFloat::fromRawArray(x), coefficients, states, numSections);
+				y.copyToRawArray(x);
+
+				for (int c = 0; c < channelsPerRegister; c++)
+				{
+					out[c][i] = (delay[c] + x[2 * c]) * 0.5f;
+					delay[c] = x[2 * c + 1];
+				}
+			}
+
+			storeStates(stateData, states, numSections);
+
+			for (int i = 0; i < channelsPerRegister; i++)
+				downDelay.set(g * channelsPerRegister + i, delay[i]);
+		}
+	}
+
+private:
+
+	static int getNumSections(const CoefficientTable::Filter& f)
+	{
+		return jmax(f.direct.size(), f.delayed.size());
+	}
+
+	int getNumGroups(int numChannelsToProcess) const
+	{
+		return (numChannelsToProcess + channelsPerRegister - 1) / channelsPerRegister;
+	}
+
+	/** Interleaves the coefficients of both branches. A coefficient of 1 turns the missing sections of the shorter branch into a passthrough. */
+	static void loadCoefficients(const CoefficientTable::Filter& f, SSEFloat* coefficients)
+	{
+		alignas(32) float data[numLanes];
+
+		for (int k = 0; k < getNumSections(f); k++)
+		{
+			for (int c = 0; c < channelsPerRegister; c++)
+			{
+				data[2 * c] = k < f.direct.size() ? f.direct[k] : 1.0f;
+				data[2 * c + 1] = k < f.delayed.size() ? f.delayed[k] : 1.0f;
+			}
+
+			coefficients[k] = SSEFloat::fromRawArray(data);
+		}
+	}
+
+	static void loadStates(const float* data, SSEFloat* states, int numSections)
+	{
+		alignas(32) float lanes[numLanes];
+
+		for (int k = 0; k < numSections; k++)
+		{
+			memcpy(lanes, data + k * numLanes, sizeof(float) * numLanes);
+			states[k] = SSEFloat::fromRawArray(lanes);
+		}
+	}
+
+	static void storeStates(float* data, const SSEFloat* states, int numSections)
+	{
+		alignas(32) float lanes[numLanes];
+
+		for (int k = 0; k < numSections; k++)
+		{
+			states[k].copyToRawArray(lanes);
+
+			for (auto& l : lanes)
+				dsp::util::snapToZero(l);
+
+			memcpy(data + k * numLanes, lanes, sizeof(float) * numLanes);
+		}
+	}
+
+	static forcedinline SSEFloat processCascade(SSEFloat x, const SSEFloat* coefficients, SSEFloat* states, int numSections) noexcept
+	{
+		for (int k = 0; k < numSections; k++)
+		{
+			auto y = coefficients[k] * x + states[k];
+			states[k] = x - coefficients[k] * y;
+			x = y;
+		}
+
+		return x;
+	}
+
+	const int numGroups;
+
+	HeapBlock<float> upStates;
+	HeapBlock<float> downStates;
+	Array<float> downDelay;
+
+	AudioSampleBuffer silence;
+	AudioSampleBuffer dummyOutput;
+};
+
+StringArray PolyphaseOversampler::getProfileNames()
+{
+	return { "Minimum Phase IIR", "Linear Phase (Fast)", "Linear Phase" };
+}
+
+PolyphaseOversampler::PolyphaseOversampler(int numChannels_, int factorLog2, Profile profile_) :
+	numChannels(numChannels_),
+	profile(profile_)
+{
+	jassert(factorLog2 >= 0 && factorLog2 <= 4);
+
+	for (int i = 0; i < factorLog2; i++)
+	{
+		auto t = CoefficientTable::get(profile, i);
+
+		if (t->isFIR())
+			stages.add(new FIRStage(numChannels, t));
+		else
+			stages.add(new IIRStage(numChannels, t));
+	}
+}
+
+PolyphaseOversampler::~PolyphaseOversampler()
+{
+	stages.clear();
+}
+
+void PolyphaseOversampler::initProcessing(int maxNumSamplesBeforeOversampling)
+{
+	auto numSamples = maxNumSamplesBeforeOversampling;
+
+	for (auto s : stages)
+	{
+		s->initProcessing(numSamples);
+		numSamples *= 2;
+	}
+
+	isReady = true;
+}
+
+void PolyphaseOversampler::reset() noexcept
+{
+	for (auto s : stages)
+		s->reset();
+}
+
+dsp::AudioBlock<float> PolyphaseOversampler::processSamplesUp(const dsp::AudioBlock<float>& inputBlock) noexcept
+{
+	jassert(isReady);
+	jassert((int)inputBlock.getNumChannels() <= numChannels);
+
+	auto block = inputBlock;
+
+	for (auto s : stages)
+	{
+		s->processUp(block);
+		block = s->getProcessedSamples(block.getNumSamples() * 2).getSubsetChannelBlock(0, inputBlock.getNumChannels());
+	}
+
+	return block;
+}
+
+void PolyphaseOversampler::processSamplesDown(dsp::AudioBlock<float>& outputBlock) noexcept
+{
+	jassert(isReady);
+	jassert((int)outputBlock.getNumChannels() <= numChannels);
+
+	if (stages.isEmpty())
+		return;
+
+	auto numSamples = outputBlock.getNumSamples() << (stages.size() - 1);
+
+	for (int i = stages.size() - 1; i > 0; i--)
+	{
+		auto block = stages[i - 1]->getProcessedSamples(numSamples).getSubsetChannelBlock(0, outputBlock.getNumChannels());
+		stages[i]->processDown(block);
+		numSamples /= 2;
+	}
+
+	stages.getFirst()->processDown(outputBlock);
+}
+
+float PolyphaseOversampler::getLatencyInSamples() const noexcept
+{
+	double latency = 0.0;
+	double factor = 2.0;
+
+	for (auto s : stages)
+	{
+		latency += s->getLatency() / factor;
+		factor *= 2.0;
+	}
+
+	return (float)latency;
+}
+
+} // namespace hise
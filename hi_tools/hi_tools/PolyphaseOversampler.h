@@ -0,0 +1,110 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+#ifndef HI_POLYPHASE_OVERSAMPLER_H_INCLUDED
+#define HI_POLYPHASE_OVERSAMPLER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A multistage 2^n oversampler with polyphase halfband filters.
+
+	This is a drop-in replacement for juce::dsp::Oversampling<float> with a few additions:
+
+	- the filter coefficients are designed once per profile and stage and shared between
+	  all instances, so creating a new oversampler in prepareToPlay is cheap.
+	- the FIR stages process the entire block per filter tap with vectorised multiply-adds
+	  instead of running a scalar convolution per sample.
+	- the profile selects the trade-off between CPU usage, latency and phase response.
+
+	The latency returned by getLatencyInSamples() is the exact group delay at DC for both
+	filter types and can be reported to the host.
+*/
+class PolyphaseOversampler
+{
+public:
+
+	enum class Profile
+	{
+		MinimumPhaseIIR = 0, ///< cascaded allpass halfbands (lowest CPU and latency, nonlinear phase)
+		LinearPhaseFast,	 ///< short equiripple FIR halfbands with a wide transition band
+		LinearPhase,		 ///< long equiripple FIR halfbands with high stopband attenuation
+		numProfiles
+	};
+
+	/** Returns the names of the profiles (eg. for a combobox). */
+	static StringArray getProfileNames();
+
+	/** Creates an oversampler with 2^factorLog2 oversampling. A factor of 0 will just pass through the signal. */
+	PolyphaseOversampler(int numChannels, int factorLog2, Profile profile=Profile::MinimumPhaseIIR);
+
+	~PolyphaseOversampler();
+
+	/** Allocates the buffers. Call this before processing with the maximum block size at the original rate. */
+	void initProcessing(int maxNumSamplesBeforeOversampling);
+
+	/** Clears the filter states. */
+	void reset() noexcept;
+
+	/** Upsamples the given block and returns a block pointing to the internal buffer. */
+	dsp::AudioBlock<float> processSamplesUp(const dsp::AudioBlock<float>& inputBlock) noexcept;
+
+	/** Downsamples the internal buffer into the given block. */
+	void processSamplesDown(dsp::AudioBlock<float>& outputBlock) noexcept;
+
+	/** Returns the latency of the up- and downsampling filters in samples at the original sample rate. */
+	float getLatencyInSamples() const noexcept;
+
+	int getOversamplingFactor() const noexcept { return 1 << stages.size(); }
+
+	int getNumChannels() const noexcept { return numChannels; }
+
+	Profile getProfile() const noexcept { return profile; }
+
+private:
+
+	struct CoefficientTable;
+	struct Stage;
+	struct FIRStage;
+	struct IIRStage;
+
+	OwnedArray<Stage> stages;
+
+	const int numChannels;
+	const Profile profile;
+	bool isReady = false;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PolyphaseOversampler);
+};
+
+} // namespace hise
+
+#endif  // HI_POLYPHASE_OVERSAMPLER_H_INCLUDED
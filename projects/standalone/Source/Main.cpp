@@ -111,6 +111,11 @@ public:
 		print("--test [PLUGIN_FILE]" );
 		print("Tests the given plugin" );
 		print("");
+		print("render PRESET_FILE -m:MIDI_FILE -o:OUTPUT_FILE [-r:REPORT_FILE] [-sr:SAMPLERATE] [-bs:BLOCKSIZE] [-tail:SECONDS]");
+		print("Renders the MIDI file with the given preset (.hip or .xml) as fast as possible into a WAV file");
+		print("and writes a JSON report with the CPU time of each sound generator, the voice count, the disk statistics");
+		print("and the realtime factor. All paths must be absolute. If no report file is given, the report is printed.");
+		print("");
 		print("set_project_folder -p:PATH" );
 		print("Changes the current project folder." );
 		print("");
@@ -166,6 +171,258 @@ public:
 		exit(0);
 	}
 
+	static void renderProject(const String& commandLine)
+	{
+		auto args = getCommandLineArgs(commandLine);
+
+		File presetFile(args[0].unquoted());
+
+		if (!File::isAbsolutePath(args[0].unquoted()) || !presetFile.existsAsFile())
+			throwErrorAndQuit("`" + args[0] + "` is not a valid preset file");
+
+		auto midiPath = getArgument(args, "-m:");
+
+		if (!File::isAbsolutePath(midiPath) || !File(midiPath).existsAsFile())
+			throwErrorAndQuit("`" + midiPath + "` is not a valid MIDI file");
+
+		File midiFile(midiPath);
+
+		auto outputPath = getArgument(args, "-o:");
+
+		if (!File::isAbsolutePath(outputPath))
+			throwErrorAndQuit("`" + outputPath + "` is not a valid output path");
+
+		File outputFile(outputPath);
+		auto reportPath = getArgument(args, "-r:");
+
+		if (reportPath.isNotEmpty() && !File::isAbsolutePath(reportPath))
+			throwErrorAndQuit("`" + reportPath + "` is not a valid report path");
+
+		auto sampleRateArgument = getArgument(args, "-sr:");
+		auto blockSizeArgument = getArgument(args, "-bs:");
+		auto tailArgument = getArgument(args, "-tail:");
+
+		const double sampleRate = sampleRateArgument.isNotEmpty() ? sampleRateArgument.getDoubleValue() : 44100.0;
+		const int blockSize = blockSizeArgument.isNotEmpty() ? blockSizeArgument.getIntValue() : 512;
+		const double tailSeconds = tailArgument.isNotEmpty() ? tailArgument.getDoubleValue() : 2.0;
+
+		if (sampleRate <= 0.0 || blockSize <= 0)
+			throwErrorAndQuit("Invalid sample rate or block size");
+
+		MidiMessageSequence sequence;
+
+		{
+			FileInputStream fis(midiFile);
+			MidiFile mf;
+
+			if (!fis.openedOk() || !mf.readFrom(fis))
+				throwErrorAndQuit("Can't read " + midiFile.getFullPathName());
+
+			mf.convertTimestampTicksToSeconds();
+
+			for (int i = 0; i < mf.getNumTracks(); i++)
+				sequence.addSequence(*mf.getTrack(i), 0.0, 0.0, 1e9);
+
+			sequence.sort();
+		}
+
+		CompileExporter::setExportingFromCommandLine();
+
+		ScopedPointer<StandaloneProcessor> sp = new StandaloneProcessor();
+		ScopedPointer<BackendRootWindow> editor = dynamic_cast<BackendRootWindow*>(sp->createEditor());
+		auto bp = editor->getBackendProcessor();
+		auto chain = bp->getMainSynthChain();
+
+		auto currentProjectFolder = GET_PROJECT_HANDLER(chain).getWorkDirectory();
+		auto projectDirectory = presetFile.getParentDirectory().getParentDirectory();
+
+		if (currentProjectFolder != projectDirectory)
+			GET_PROJECT_HANDLER(chain).setWorkingProject(projectDirectory);
+
+		print("Loading " + presetFile.getFullPathName());
+
+		if (presetFile.getFileExtension() == ".hip")
+			bp->loadPresetFromFile(presetFile, editor);
+		else
+			BackendCommandTarget::Actions::openFileFromXml(editor, presetFile);
+
+		bp->prepareToPlay(sampleRate, blockSize);
+
+		// The samplers will read from disk synchronously instead of using the background thread
+		bp->setNonRealtime(true);
+
+		const int numChannels = jmax(2, chain->getMatrix().getNumDestinationChannels());
+		AudioSampleBuffer buffer(numChannels, blockSize);
+		MidiBuffer midiBuffer;
+
+		// Wait until the samples are preloaded and the audio rendering is allowed
+		for (int i = 0; i < 6000; i++)
+		{
+			if (!bp->getSampleManager().isPreloading() && bp->getKillStateHandler().isAudioRunning())
+				break;
+
+			MessageManager::getInstance()->runDispatchLoopUntil(10);
+
+			buffer.clear();
+			bp->processBlock(buffer, midiBuffer);
+		}
+
+		if (!bp->getKillStateHandler().isAudioRunning())
+			throwErrorAndQuit("The audio rendering could not be started");
+
+		Processor::Iterator<ModulatorSynth> synthIter(chain);
+
+		while (auto s = synthIter.getNextProcessor())
+			s->setProfileRendering(true);
+
+		auto pool = bp->getSampleManager().getGlobalSampleThreadPool();
+		pool->resetDecodeCacheCounters();
+		pool->resetBatchCounters();
+
+		outputFile.deleteFile();
+
+		WavAudioFormat wavFormat;
+		ScopedPointer<OutputStream> fos = new FileOutputStream(outputFile);
+		ScopedPointer<AudioFormatWriter> writer = wavFormat.createWriterFor(fos, sampleRate, numChannels, 24, {}, 0);
+
+		if (writer == nullptr)
+			throwErrorAndQuit("Can't write to " + outputFile.getFullPathName());
+
+		fos.release();
+
+		const double lastEventTime = sequence.getNumEvents() > 0 ? sequence.getEndTime() : 0.0;
+		const int64 numSamplesToRender = (int64)((lastEventTime + tailSeconds) * sampleRate);
+
+		print("Rendering " + String(lastEventTime + tailSeconds, 2) + " seconds...");
+
+		int eventIndex = 0;
+		int peakVoices = 0;
+		int64 voiceSum = 0;
+		int64 numBlocks = 0;
+		double renderTime = 0.0;
+
+		for (int64 blockStart = 0; blockStart < numSamplesToRender; blockStart += blockSize)
+		{
+			midiBuffer.clear();
+
+			while (eventIndex < sequence.getNumEvents())
+			{
+				auto& m = sequence.getEventPointer(eventIndex)->message;
+				const int64 position = (int64)(m.getTimeStamp() * sampleRate);
+
+				if (position >= blockStart + blockSize)
+					break;
+
+				if (!m.isMetaEvent() && !m.isSysEx())
+					midiBuffer.addEvent(m, (int)jmax<int64>(0, position - blockStart));
+
+				eventIndex++;
+			}
+
+			buffer.clear();
+
+			const int64 startTicks = Time::getHighResolutionTicks();
+			bp->processBlock(buffer, midiBuffer);
+			renderTime += Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+
+			const int numVoices = bp->getNumActiveVoices();
+			peakVoices = jmax(peakVoices, numVoices);
+			voiceSum += numVoices;
+			numBlocks++;
+
+			const int numThisTime = (int)jmin<int64>(blockSize, numSamplesToRender - blockStart);
+			writer->writeFromAudioSampleBuffer(buffer, 0, numThisTime);
+		}
+
+		writer = nullptr;
+
+		const double audioLength = (double)numSamplesToRender / sampleRate;
+
+		DynamicObject::Ptr report = new DynamicObject();
+
+		report->setProperty("Preset", presetFile.getFullPathName());
+		report->setProperty("MidiFile", midiFile.getFullPathName());
+		report->setProperty("Output", outputFile.getFullPathName());
+		report->setProperty("SampleRate", sampleRate);
+		report->setProperty("BlockSize", blockSize);
+		report->setProperty("AudioLength", audioLength);
+		report->setProperty("RenderTime", renderTime);
+		report->setProperty("RealtimeFactor", renderTime > 0.0 ? audioLength / renderTime : 0.0);
+
+		DynamicObject::Ptr voices = new DynamicObject();
+		voices->setProperty("Peak", peakVoices);
+		voices->setProperty("Average", numBlocks > 0 ? (double)voiceSum / (double)numBlocks : 0.0);
+		report->setProperty("Voices", var(voices.get()));
+
+		Array<var> processors;
+		Array<var> samplers;
+
+		Processor::Iterator<ModulatorSynth> reportIter(chain);
+
+		while (auto s = reportIter.getNextProcessor())
+		{
+			// The time is measured for the direct children of a container
+			if (s != chain && dynamic_cast<ModulatorSynthChain*>(ProcessorHelpers::findParentProcessor(s, true)) != nullptr)
+			{
+				DynamicObject::Ptr p = new DynamicObject();
+				p->setProperty("ID", s->getId());
+				p->setProperty("Type", s->getType().toString());
+				p->setProperty("CpuTime", s->getProfiledRenderTime());
+				p->setProperty("CpuPercentage", renderTime > 0.0 ? 100.0 * s->getProfiledRenderTime() / renderTime : 0.0);
+				processors.add(var(p.get()));
+			}
+
+			s->setProfileRendering(false);
+
+			if (auto sampler = dynamic_cast<ModulatorSampler*>(s))
+			{
+				auto stats = sampler->getStreamingStatistics();
+
+				DynamicObject::Ptr p = new DynamicObject();
+				p->setProperty("ID", sampler->getId());
+				p->setProperty("PreloadMemory", (double)stats.preloadMemory / 1024.0 / 1024.0);
+				p->setProperty("StreamingMemory", (double)stats.streamingMemory / 1024.0 / 1024.0);
+				p->setProperty("PeakLatency", stats.peakLatencySeconds * 1000.0);
+				p->setProperty("UnderrunRisk", stats.underrunRisk);
+				p->setProperty("PrefetchHitRate", stats.prefetchHitRate);
+				samplers.add(var(p.get()));
+			}
+		}
+
+		report->setProperty("Processors", processors);
+
+		const auto cacheCounters = pool->getDecodeCacheCounters();
+		const auto batchCounters = pool->getBatchCounters();
+
+		DynamicObject::Ptr disk = new DynamicObject();
+		disk->setProperty("DecodeCacheHits", cacheCounters.numHits);
+		disk->setProperty("DecodeCacheMisses", cacheCounters.numMisses);
+		disk->setProperty("BackgroundJobs", batchCounters.numJobs);
+		disk->setProperty("MergedReads", batchCounters.numReads);
+		disk->setProperty("Samplers", samplers);
+		report->setProperty("Disk", var(disk.get()));
+
+		auto json = JSON::toString(var(report.get()));
+
+		if (reportPath.isNotEmpty())
+		{
+			File(reportPath).replaceWithText(json);
+			print("Report written to " + reportPath);
+		}
+		else
+			print(json);
+
+		print("Rendered " + String(audioLength, 2) + " seconds in " + String(renderTime, 2) + " seconds (" + String(renderTime > 0.0 ? audioLength / renderTime : 0.0, 1) + "x realtime)");
+
+		if (currentProjectFolder != projectDirectory)
+			GET_PROJECT_HANDLER(chain).setWorkingProject(currentProjectFolder);
+
+		editor = nullptr;
+		sp = nullptr;
+
+		exit(0);
+	}
+
 	static void setProjectVersion(const String& commandLine)
 	{
 		auto args = getCommandLineArgs(commandLine);
@@ -402,6 +659,12 @@ public:
 			quit();
 			return;
 		}
+		else if (commandLine.startsWith("render"))
+		{
+			CommandLineActions::renderProject(commandLine);
+			quit();
+			return;
+		}
 		else if (commandLine.startsWith("clean"))
 		{
 			CommandLineActions::cleanBuildFolder(commandLine);
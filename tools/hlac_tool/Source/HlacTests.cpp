@@ -879,6 +879,9 @@ public:
 		testStreamingEngineOperation(1, 4095, 1024);
 		testStreamingEngineOperation(2, 8190, 16);
 
+		testDecodeCache(1, 1000);
+		testDecodeCache(2, 300);
+
 
 #if JUCE_64BIT
 		testMemoryMappedFileReaders(1, 3000000);
@@ -2015,6 +2018,82 @@ public:
 		expectEquals<int>(error, 0, "Sequenced copy doesn't work");
 	}
 
+	void testDecodeCache(int numChannels, int chunkSize)
+	{
+		beginTest("Testing decode cache with " + String(numChannels) + " channels");
+
+		auto original = createTestBuffer(numChannels, 30000);
+		int totalLength = original.getNumSamples();
+		int numBlocks = (totalLength + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+
+		Array<AudioSampleBuffer> buffers;
+		buffers.add(original);
+
+		auto mb = writeIntoMemory(buffers);
+
+		HlacDecodeCache cache;
+
+		ScopedPointer<HiseLosslessAudioFormatReader> reader = createReader(mb, false);
+		reader->setDecodeCache(&cache, 1);
+
+		for (int pass = 0; pass < 2; pass++)
+		{
+			HiseSampleBuffer b1(false, numChannels, chunkSize);
+			HiseSampleBuffer result(false, numChannels, totalLength);
+			result.clear();
+			result.allocateNormalisationTables(0);
+
+			for (int index = 0; index < totalLength; index += chunkSize)
+			{
+				int numThisTime = jmin<int>(chunkSize, totalLength - index);
+
+				HlacSubSectionReader subReader(reader, index, numThisTime);
+
+				b1.clearNormalisation({});
+				subReader.readIntoFixedBuffer(b1, 0, numThisTime, 0);
+
+				HiseSampleBuffer::copy(result, b1, index, 0, numThisTime);
+			}
+
+			result.minimizeNormalisationInfo();
+
+			auto rb = AudioSampleBuffer(numChannels, totalLength);
+			result.convertToFloatWithNormalisation(rb.getArrayOfWritePointers(), numChannels, 0, totalLength);
+
+			auto error = CompressionHelpers::checkBuffersEqual(rb, original);
+
+			expectEquals<int>(error, 0, pass == 0 ? "Read with empty cache" : "Read from cache");
+			expectEquals<int>((int)cache.getCounters().numMisses, numBlocks, "Every block is decoded only once");
+		}
+
+		HiseSampleBuffer block(false, numChannels, COMPRESSION_BLOCK_SIZE);
+		block.clear();
+
+		HlacDecodeCache pinCache;
+		pinCache.store(1, 0, block);
+
+		const int pinnedSlot = pinCache.pin(1, 0);
+		expect(pinnedSlot != -1, "Pinning a cached block");
+
+		for (uint32 i = 0; i < (uint32)pinCache.getNumSlots() * 2; i++)
+			pinCache.store(2, i, block);
+
+		expect(pinCache.contains(1, 0), "Pinned block survives eviction");
+
+		int numPinned = 1;
+
+		for (uint32 i = 0; i < (uint32)pinCache.getNumSlots() * 2; i++)
+		{
+			if (pinCache.contains(2, i) && pinCache.pin(2, i) != -1)
+				numPinned++;
+		}
+
+		expectEquals<int>(numPinned, pinCache.getMaxNumPinnedSlots(), "Number of pinned slots is limited");
+
+		pinCache.unpin(pinnedSlot);
+		expect(pinCache.pin(2, (uint32)pinCache.getNumSlots() * 2 - 1) != -1, "Unpinning frees a pin");
+	}
+
 	HlacEncoder::CompressorOptions currentOption;
 private:
 
@@ -25,6 +25,14 @@ public:
     //==============================================================================
     void initialise (const String& commandLine) override
     {
+		if (commandLine.contains("--benchmark"))
+		{
+			// Runs the test files through the JIT and the native compiler and quits
+			setApplicationReturnValue(snex::jit::TestFileBenchmark::runFromCommandLine(commandLine));
+			quit();
+			return;
+		}
+
 		UnitTestRunner runner;
 		runner.setAssertOnFailure(true);
 		runner.runAllTests();
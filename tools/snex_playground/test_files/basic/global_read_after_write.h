@@ -0,0 +1,19 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 3.0f
+  output: 11.0f
+  error: ""
+  filename: "basic/global_read_after_write"
+END_TEST_DATA
+*/
+span<float, 3> d = { 1.0f, 2.0f, 3.0f };
+float gain = 2.0f;
+float acc = 0.0f;
+float main(float input)
+{
+    acc += input * gain;
+    return acc + input + 2.0f;
+}
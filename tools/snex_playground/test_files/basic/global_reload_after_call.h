@@ -0,0 +1,29 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 3.0f
+  output: 12.0f
+  error: ""
+  filename: "basic/global_reload_after_call"
+END_TEST_DATA
+*/
+span<float, 3> data = { 1.0f, 2.0f, 3.0f };
+float state = 0.0f;
+
+void bump()
+{
+    state += 1.0f;
+}
+
+float main(float input)
+{
+    for(auto& s: data)
+    {
+        state += s;
+        bump();
+    }
+    
+    return state + input;
+}
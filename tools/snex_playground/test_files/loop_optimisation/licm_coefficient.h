@@ -0,0 +1,28 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 3.0f
+  output: 31.0f
+  error: ""
+  filename: "loop_optimisation/licm_coefficient"
+END_TEST_DATA
+*/
+
+span<float, 5> d = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+
+float gain = 2.0f;
+
+float main(float input)
+{
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+    {
+        s = s * Math.pow(gain, 2.0f) * 0.5f - input / 3.0f;
+        sum += s;
+    }
+    
+    return sum + input * 2.0f;
+}
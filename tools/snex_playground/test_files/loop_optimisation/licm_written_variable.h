@@ -0,0 +1,30 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: int
+  args: int
+  input: 2
+  output: 54
+  error: ""
+  filename: "loop_optimisation/licm_written_variable"
+END_TEST_DATA
+*/
+
+span<int, 3> d = { 1, 2, 3 };
+
+int main(int input)
+{
+    int x = input;
+    int sum = 0;
+    
+    for(auto& s: d)
+    {
+        sum += x * 2 + s;
+        x = x + 1;
+    }
+    
+    for(auto& s: d)
+        sum += input * x;
+    
+    return sum;
+}
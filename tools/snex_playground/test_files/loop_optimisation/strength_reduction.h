@@ -0,0 +1,21 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 8.0f
+  output: 85.0f
+  error: ""
+  filename: "loop_optimisation/strength_reduction"
+END_TEST_DATA
+*/
+
+float main(float input)
+{
+    float x = input / 4.0f;
+    float y = input * 2.0f;
+    
+    x /= 0.5f;
+    
+    return x + y + Math.pow(input, 2.0f) + 1.0f;
+}
@@ -0,0 +1,23 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: int
+  args: int
+  input: 3
+  output: 18
+  error: ""
+  filename: "loop_optimisation/unroll_local_span"
+END_TEST_DATA
+*/
+
+int main(int input)
+{
+    span<int, 3> d = { 1, 2, 3 };
+    
+    int sum = 0;
+    
+    for(auto& s: d)
+        sum += s * input;
+    
+    return sum;
+}
@@ -0,0 +1,28 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 2.0f
+  output: 15.0f
+  error: ""
+  filename: "loop_optimisation/unroll_span"
+END_TEST_DATA
+*/
+
+span<float, 3> d = { 1.0f, 2.0f, 3.0f };
+
+float main(float input)
+{
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+    {
+        if(s > 1.0f)
+            sum += s * input;
+        else
+            sum += s;
+    }
+    
+    return sum + 4.0f;
+}
@@ -0,0 +1,25 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 5.0f
+  output: 10.0f
+  error: ""
+  filename: "loop_optimisation/unroll_subscript_write"
+END_TEST_DATA
+*/
+
+span<float, 3> d = { 1.0f, 2.0f, 3.0f };
+
+float main(float input)
+{
+    d[0] = input;
+    
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+        sum += s;
+    
+    return sum;
+}
@@ -0,0 +1,31 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 2.0f
+  output: 12.0f
+  error: ""
+  filename: "loop_optimisation/unroll_writing_loop"
+END_TEST_DATA
+*/
+
+span<float, 3> d = { 1.0f, 2.0f, 3.0f };
+
+float main(float input)
+{
+    for(auto& s: d)
+    {
+        if(s > 2.0f)
+            s *= input;
+        
+        s += 1.0f;
+    }
+    
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+        sum += s;
+    
+    return sum;
+}
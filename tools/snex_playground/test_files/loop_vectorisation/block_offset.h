@@ -0,0 +1,23 @@
+/* Tests a vectorised block loop with a loop invariant class member.
+
+BEGIN_TEST_DATA
+  f: main
+  ret: block
+  args: block
+  input: "zero.wav"
+  output: "half.wav"
+  error: ""
+  filename: "loop_vectorisation/block_offset"
+END_TEST_DATA
+*/
+
+float offset = 0.5f;
+
+block main(block input)
+{
+    for(auto& s: input)
+        s = s * 4.0f + offset;
+    
+    return input;
+}
+
@@ -0,0 +1,31 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 2.0f
+  output: -10.0f
+  error: ""
+  filename: "loop_vectorisation/dyn_remainder"
+END_TEST_DATA
+*/
+
+span<float, 10> data = { 2.0f };
+
+float main(float input)
+{
+    dyn<float> d = data;
+    
+    for(auto& s: d)
+    {
+        s = -s / input;
+    }
+    
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+        sum += s;
+    
+    return sum;
+}
+
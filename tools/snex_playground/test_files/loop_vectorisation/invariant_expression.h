@@ -0,0 +1,34 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 4.0f
+  output: 24.0f
+  error: ""
+  filename: "loop_vectorisation/invariant_expression"
+END_TEST_DATA
+*/
+
+span<float, 6> d = { 1.0f, 2.0f, 3.0f, 1.0f, 2.0f, 3.0f };
+
+float g = 2.0f;
+
+float main(float input)
+{
+    float o = input * 0.5f;
+    
+    for(auto& s: d)
+    {
+        s = (s + g * o) * (g - 1.0f);
+        s -= o;
+    }
+    
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+        sum += s;
+    
+    return sum;
+}
+
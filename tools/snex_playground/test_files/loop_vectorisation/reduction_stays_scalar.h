@@ -0,0 +1,28 @@
+/* The sum is written inside the loop, so this loop must not be vectorised.
+
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 1.0f
+  output: 35.0f
+  error: ""
+  filename: "loop_vectorisation/reduction_stays_scalar"
+END_TEST_DATA
+*/
+
+span<float, 5> d = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+
+float main(float input)
+{
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+    {
+        s = s * 2.0f + input;
+        sum += s;
+    }
+    
+    return sum;
+}
+
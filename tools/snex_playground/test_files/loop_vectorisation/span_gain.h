@@ -0,0 +1,27 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 0.5f
+  output: 8.0f
+  error: ""
+  filename: "loop_vectorisation/span_gain"
+END_TEST_DATA
+*/
+
+span<float, 8> d = { 2.0f };
+
+float main(float input)
+{
+    for(auto& s: d)
+        s *= input;
+    
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+        sum += s;
+    
+    return sum;
+}
+
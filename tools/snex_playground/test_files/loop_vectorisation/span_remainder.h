@@ -0,0 +1,29 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 1.0f
+  output: 63.0f
+  error: ""
+  filename: "loop_vectorisation/span_remainder"
+END_TEST_DATA
+*/
+
+span<float, 7> d = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+
+float main(float input)
+{
+    for(auto& s: d)
+    {
+        s = s * 2.0f + input;
+    }
+    
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+        sum += s;
+    
+    return sum;
+}
+
@@ -0,0 +1,28 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 2.0f
+  output: 48.0f
+  error: ""
+  filename: "loop_vectorisation/unloaded_invariant"
+END_TEST_DATA
+*/
+
+span<float, 6> d = { 1.0f, 2.0f, 3.0f, 1.0f, 2.0f, 3.0f };
+
+float g = 3.0f;
+
+float main(float input)
+{
+    for(auto& s: d)
+        s = s * g + input;
+    
+    float sum = 0.0f;
+    
+    for(auto& s: d)
+        sum += s;
+    
+    return sum;
+}
@@ -0,0 +1,22 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 3.0f
+  output: 17.0f
+  error: ""
+  filename: "span/loop_accumulate_global"
+END_TEST_DATA
+*/
+span<float, 3> d = { 1.0f, 2.0f, 3.0f };
+float gain = 2.0f;
+float acc = 0.0f;
+float main(float input)
+{
+    for(auto& s: d)
+    {
+        acc += s * gain;
+    }
+    return acc + input + 2.0f;
+}
@@ -0,0 +1,31 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 3.0f
+  output: 15.0f
+  error: ""
+  filename: "struct/member_register_in_loop"
+END_TEST_DATA
+*/
+struct X
+{
+    float process(float input)
+    {
+        for(auto& s: data)
+        {
+            state += s * gain;
+            s = state;
+        }
+        return state + input;
+    }
+    span<float, 3> data = { 1.0f, 2.0f, 3.0f };
+    float gain = 1.0f;
+    float state = 0.0f;
+};
+X x;
+float main(float input)
+{
+    return x.process(input) + 6.0f;
+}
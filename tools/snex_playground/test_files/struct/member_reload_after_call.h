@@ -0,0 +1,34 @@
+/*
+BEGIN_TEST_DATA
+  f: main
+  ret: float
+  args: float
+  input: 3.0f
+  output: 9.0f
+  error: ""
+  filename: "struct/member_reload_after_call"
+END_TEST_DATA
+*/
+struct X
+{
+    void bump()
+    {
+        value += 1.0f;
+    }
+    
+    float value = 1.0f;
+};
+X x;
+span<float, 3> data = { 1.0f, 2.0f, 3.0f };
+float main(float input)
+{
+    float sum = 0.0f;
+    
+    for(auto& s: data)
+    {
+        sum += x.value;
+        x.bump();
+    }
+    
+    return sum + input;
+}